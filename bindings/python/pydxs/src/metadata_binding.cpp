@@ -420,6 +420,7 @@ PYBIND11_MODULE(pydxs, m) {
         .def_readwrite("label", &DXFrameMeta::_label, "Primary classification label index (-1 if absent)")
         .def_readwrite("label_name", &DXFrameMeta::_label_name, "Primary classification label name")
         .def_readwrite("label_confidence", &DXFrameMeta::_label_confidence, "Primary classification confidence score")
+        .def_readwrite("skipped_branches", &DXFrameMeta::_skipped_branches, "dxgather partial join: bit i set when branch sink_i contributed nothing")
 
         .def_property_readonly(
             "seg_format",
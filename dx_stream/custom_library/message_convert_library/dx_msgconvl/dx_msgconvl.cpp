@@ -3,7 +3,7 @@
 #include <stddef.h>
 #include <string.h>
 
-#define MAX_EXPECTED_JSON_SIZE ((size_t)(10 * 1024 * 1024))
+#define MAX_EXPECTED_PAYLOAD_SIZE ((size_t)(10 * 1024 * 1024))
 
 DX_CUSTOM_EXPORT DxMsgContext *dxmsg_create_context() {
     auto *context = g_new0(DxMsgContext, 1);
@@ -28,33 +28,30 @@ DX_CUSTOM_EXPORT DxMsgPayload *dxmsg_convert_payload(DxMsgContext *context,
         return nullptr;
     }
 
-    gchar *json_data = dxpayload_convert_to_json(context, meta_info);
-
-    if (json_data == nullptr) {
-        g_warning("dxpayload_convert_to_json returned null");
-        g_free(payload);
-        return nullptr;
+    gsize length = 0;
+    gpointer data = nullptr;
+    if (meta_info->_message_format == DXMSG_FORMAT_BINARY) {
+        data = dxpayload_convert_to_binary(context, meta_info, &length);
+    } else {
+        data = dxpayload_convert_to_json(context, meta_info, &length);
     }
-    size_t json_len = strnlen(json_data, MAX_EXPECTED_JSON_SIZE);
-    if (json_len == MAX_EXPECTED_JSON_SIZE &&
-        json_data[MAX_EXPECTED_JSON_SIZE - 1] != '\0') {
-        g_warning("JSON data is too long (>= %zu bytes) or not null-terminated "
-                  "within the checked limit.",
-                  MAX_EXPECTED_JSON_SIZE);
-        g_free(json_data);
+
+    if (data == nullptr) {
+        g_warning("dxpayload conversion returned null");
         g_free(payload);
         return nullptr;
     }
 
-    if (json_len > G_MAXUINT) {
-        g_warning("JSON data size (%zu bytes) exceeds maximum guint value", json_len);
-        g_free(json_data);
+    if (length >= MAX_EXPECTED_PAYLOAD_SIZE) {
+        g_warning("Payload is too long (%zu bytes, limit %zu)", length,
+                  MAX_EXPECTED_PAYLOAD_SIZE);
+        g_free(data);
         g_free(payload);
         return nullptr;
     }
 
-    payload->_size = (guint)json_len;
-    payload->_data = json_data;
+    payload->_size = (guint)length;
+    payload->_data = data;
 
     return payload;
 }
@@ -1,149 +1,103 @@
 #include <gst/gst.h>
 
-#include <json-glib/json-glib.h>
-
 #include "dx_msgconvl_priv.hpp"
+#include "dx_msgconvl_schema.hpp"
 #include "gstdxstream/gst-dxframemeta.hpp"
 #include "gstdxstream/gst-dxobjectmeta.hpp"
 
+#include <algorithm>
+#include <cstddef>
+
 DxMsgContextPriv *dxcontext_create_contextPriv(void) {
-    auto *contextPriv = g_new0(DxMsgContextPriv, 1);
-    return contextPriv;
+    return new DxMsgContextPriv();
 }
 
 void dxcontext_delete_contextPriv(DxMsgContextPriv *contextPriv) {
     g_return_if_fail(contextPriv != nullptr);
-    contextPriv->_object_include_list.clear();
-    g_free(contextPriv);
+    delete contextPriv;
 }
 
-static void add_object_to_json(JsonObject *jobj_parent,
-                               DXObjectMeta *obj_meta) {
-    if (obj_meta->_label == -1)
-        return;
+static DxMsgArena &context_arena(DxMsgContext *context) {
+    auto *priv = static_cast<DxMsgContextPriv *>(context->_priv_data);
+    priv->_arena.reset();
+    return priv->_arena;
+}
 
+static void write_object_json(DxJsonWriter &w, const DXObjectMeta *obj_meta) {
     GST_DEBUG("|OBJECT| LabelId: %d, Confidence: %.2f, Box: {%f, %f, %f, %f}, "
               "Label Name: %s",
               obj_meta->_label, obj_meta->_confidence, obj_meta->_box[0],
               obj_meta->_box[1], obj_meta->_box[2], obj_meta->_box[3],
               obj_meta->_label_name.c_str());
 
-    JsonObject *jobj_object = json_object_new();
-    json_object_set_int_member(jobj_object, "label_id", obj_meta->_label);
-    json_object_set_int_member(jobj_object, "track_id", obj_meta->_track_id);
-    json_object_set_double_member(jobj_object, "confidence",
-                                  obj_meta->_confidence);
-    json_object_set_string_member(jobj_object, "name",
-                                  obj_meta->_label_name.c_str());
-
-    JsonObject *jobj_box = json_object_new();
-    json_object_set_double_member(jobj_box, "startX", obj_meta->_box[0]);
-    json_object_set_double_member(jobj_box, "startY", obj_meta->_box[1]);
-    json_object_set_double_member(jobj_box, "endX", obj_meta->_box[2]);
-    json_object_set_double_member(jobj_box, "endY", obj_meta->_box[3]);
-    json_object_set_object_member(jobj_object, "box", jobj_box);
-    
-    // body_feature 추가
+    w.begin_object();
+    w.key("object");
+    w.begin_object();
+    w.member("label_id", obj_meta->_label);
+    w.member("track_id", obj_meta->_track_id);
+    w.member("confidence", obj_meta->_confidence);
+    w.key("name");
+    w.value(obj_meta->_label_name.data(), obj_meta->_label_name.size());
+    w.member("box", obj_meta->_box);
+
     if (!obj_meta->_body_feature.empty()) {
-        JsonArray *jarray_body = json_array_new();
-        for (const auto &val : obj_meta->_body_feature) {
-            json_array_add_element(jarray_body, json_node_init_double(json_node_alloc(), val));
-        }
-        json_object_set_array_member(jobj_object, "body_feature", jarray_body);
+        w.key("body_feature");
+        w.value_array(obj_meta->_body_feature.data(), obj_meta->_body_feature.size());
     }
-    
-    // segment 추가 (object 내부로)
+
     if (!obj_meta->_seg_data.empty()) {
-        JsonObject *jobj_segment = json_object_new();
-        json_object_set_int_member(jobj_segment, "height",
-                                   obj_meta->_seg_height);
-        json_object_set_int_member(jobj_segment, "width",
-                                   obj_meta->_seg_width);
-        json_object_set_string_member(jobj_segment, "format",
-                                      "roi-binary-mask");
-        json_object_set_int_member(jobj_segment, "background_value", 0);
-        json_object_set_int_member(jobj_segment, "foreground_value", 255);
-
-        JsonObject *jobj_segment_box = json_object_new();
-        json_object_set_double_member(jobj_segment_box, "startX", obj_meta->_box[0]);
-        json_object_set_double_member(jobj_segment_box, "startY", obj_meta->_box[1]);
-        json_object_set_double_member(jobj_segment_box, "endX", obj_meta->_box[2]);
-        json_object_set_double_member(jobj_segment_box, "endY", obj_meta->_box[3]);
-        json_object_set_object_member(jobj_segment, "box", jobj_segment_box);
-
-        json_object_set_int_member(
-            jobj_segment, "data",
-            reinterpret_cast<uintptr_t>(obj_meta->_seg_data.data()));
-        json_object_set_object_member(jobj_object, "segment", jobj_segment);
+        w.key("segment");
+        w.begin_object();
+        w.member("height", obj_meta->_seg_height);
+        w.member("width", obj_meta->_seg_width);
+        w.member("format", "roi-binary-mask");
+        w.member("background_value", 0);
+        w.member("foreground_value", 255);
+        w.member("box", obj_meta->_box);
+        w.member("data", static_cast<guint64>(
+                             reinterpret_cast<uintptr_t>(obj_meta->_seg_data.data())));
+        w.end_object();
     }
-    
-    // pose 추가 (object 내부로)
+
     if (!obj_meta->_keypoints.empty()) {
-        JsonArray *jarray = json_array_new();
-        for (int k = 0; k < 17; k++) {
-            float kx = obj_meta->_keypoints[k * 3 + 0];
-            float ky = obj_meta->_keypoints[k * 3 + 1];
-            float ks = obj_meta->_keypoints[k * 3 + 2];
-            JsonObject *jobj_keyset = json_object_new();
-            json_object_set_double_member(jobj_keyset, "kx", kx);
-            json_object_set_double_member(jobj_keyset, "ky", ky);
-            json_object_set_double_member(jobj_keyset, "ks", ks);
-            json_array_add_element(
-                jarray, json_node_init_object(json_node_alloc(), jobj_keyset));
+        w.key("pose");
+        w.begin_object();
+        w.key("keypoints");
+        w.begin_array();
+        for (size_t k = 0; k + 2 < obj_meta->_keypoints.size(); k += 3) {
+            w.begin_object();
+            w.member("kx", obj_meta->_keypoints[k]);
+            w.member("ky", obj_meta->_keypoints[k + 1]);
+            w.member("ks", obj_meta->_keypoints[k + 2]);
+            w.end_object();
         }
-        JsonObject *jobj_pose = json_object_new();
-        json_object_set_array_member(jobj_pose, "keypoints", jarray);
-        json_object_set_object_member(jobj_object, "pose", jobj_pose);
+        w.end_array();
+        w.end_object();
     }
-    
-    // face 추가 (object 내부로)
+
     if (!obj_meta->_face_landmarks.empty()) {
-        JsonArray *jarray = json_array_new();
-        for (size_t i = 0; i < obj_meta->_face_landmarks.size(); i += 3) {
-            JsonObject *jobj_point = json_object_new();
-            json_object_set_double_member(jobj_point, "x", obj_meta->_face_landmarks[i]);
-            json_object_set_double_member(jobj_point, "y", obj_meta->_face_landmarks[i+1]);
-            json_array_add_element(
-                jarray, json_node_init_object(json_node_alloc(), jobj_point));
+        w.key("face");
+        w.begin_object();
+        w.key("landmark");
+        w.begin_array();
+        for (size_t i = 0; i + 1 < obj_meta->_face_landmarks.size(); i += 3) {
+            w.begin_object();
+            w.member("x", obj_meta->_face_landmarks[i]);
+            w.member("y", obj_meta->_face_landmarks[i + 1]);
+            w.end_object();
         }
-        JsonObject *jobj_face = json_object_new();
-        json_object_set_array_member(jobj_face, "landmark", jarray);
-        
-        // face_box 추가
-        JsonObject *jobj_face_box = json_object_new();
-        json_object_set_double_member(jobj_face_box, "startX", obj_meta->_face_box[0]);
-        json_object_set_double_member(jobj_face_box, "startY", obj_meta->_face_box[1]);
-        json_object_set_double_member(jobj_face_box, "endX", obj_meta->_face_box[2]);
-        json_object_set_double_member(jobj_face_box, "endY", obj_meta->_face_box[3]);
-        json_object_set_object_member(jobj_face, "box", jobj_face_box);
-        
-        // face_confidence 추가
-        json_object_set_double_member(jobj_face, "confidence", obj_meta->_face_confidence);
-        
-        // face_feature 추가
+        w.end_array();
+        w.member("box", obj_meta->_face_box);
+        w.member("confidence", obj_meta->_face_confidence);
         if (!obj_meta->_face_feature.empty()) {
-            JsonArray *jarray_face = json_array_new();
-            for (const auto &val : obj_meta->_face_feature) {
-                json_array_add_element(jarray_face, json_node_init_double(json_node_alloc(), val));
-            }
-            json_object_set_array_member(jobj_face, "face_feature", jarray_face);
+            w.key("face_feature");
+            w.value_array(obj_meta->_face_feature.data(), obj_meta->_face_feature.size());
         }
-        
-        json_object_set_object_member(jobj_object, "face", jobj_face);
+        w.end_object();
     }
-    
-    json_object_set_object_member(jobj_parent, "object", jobj_object);
-}
-
-static void add_object_meta_to_json(JsonArray *jarray_objects,
-                                    DXObjectMeta *obj_meta) {
-    JsonNode *jnode_object = json_node_new(JSON_NODE_OBJECT);
-    JsonObject *jobj_parent = json_object_new();
-
-    add_object_to_json(jobj_parent, obj_meta);
 
-    json_node_set_object(jnode_object, jobj_parent);
-    json_array_add_element(jarray_objects, jnode_object);
+    w.end_object();
+    w.end_object();
 }
 
 /*
@@ -207,35 +161,118 @@ static void add_object_meta_to_json(JsonArray *jarray_objects,
  * }
  */
 gchar *dxpayload_convert_to_json(DxMsgContext *context,
-                                 GstDxMsgMetaInfo *meta_info) {
-    std::ignore = context;
+                                 GstDxMsgMetaInfo *meta_info, gsize *length) {
     const auto *frame_meta = (DXFrameMeta *)(meta_info->_frame_meta);
+    DxMsgArena &arena = context_arena(context);
+    DxJsonWriter w(arena);
 
-    JsonNode *jnode_root = json_node_new(JSON_NODE_OBJECT);
-    JsonObject *jobj_root = json_object_new();
-
-    json_object_set_int_member(jobj_root, "streamId", frame_meta->_stream_id);
-    json_object_set_int_member(jobj_root, "seqId", meta_info->_seq_id);
-    json_object_set_int_member(jobj_root, "width", frame_meta->_width);
-    json_object_set_int_member(jobj_root, "height", frame_meta->_height);
-
+    w.begin_object();
+    w.member("streamId", frame_meta->_stream_id);
+    w.member("seqId", meta_info->_seq_id);
+    w.member("width", frame_meta->_width);
+    w.member("height", frame_meta->_height);
     if (meta_info->_frame_base64) {
-        json_object_set_string_member(jobj_root, "frameData",
-                                      meta_info->_frame_base64);
+        w.member("frameData", meta_info->_frame_base64);
+    }
+    w.key("objects");
+    w.begin_array();
+    for (const auto *obj_meta : frame_meta->_object_meta_list) {
+        if (obj_meta->_label != -1)
+            write_object_json(w, obj_meta);
     }
+    w.end_array();
+    w.end_object();
 
-    JsonArray *jarray_objects = json_array_new();
-    json_object_set_array_member(jobj_root, "objects", jarray_objects);
+    if (length)
+        *length = arena.size();
+    return static_cast<gchar *>(arena.take());
+}
+
+template <typename T> static void put(DxMsgArena &arena, const T &value) {
+    arena.append(&value, sizeof(value));
+}
+
+static void put_floats(DxMsgArena &arena, const float *values, size_t count) {
+    arena.append(values, count * sizeof(float));
+}
+
+static void write_object_binary(DxMsgArena &arena, const DXObjectMeta *obj_meta) {
+    size_t start = arena.size();
+    size_t landmarks = obj_meta->_face_landmarks.size() / 3;
+    bool has_face = !obj_meta->_face_landmarks.empty();
+    size_t mask_size = std::min(obj_meta->_seg_data.size(),
+                                static_cast<size_t>(std::max(obj_meta->_seg_width, 0)) *
+                                    static_cast<size_t>(std::max(obj_meta->_seg_height, 0)));
+    bool has_segment = mask_size > 0;
+
+    DxMsgBinObject obj = {};
+    obj.flags = (has_face ? DXMSG_BIN_HAS_FACE : 0) | (has_segment ? DXMSG_BIN_HAS_SEGMENT : 0);
+    obj.label_id = obj_meta->_label;
+    obj.track_id = obj_meta->_track_id;
+    obj.confidence = obj_meta->_confidence;
+    std::copy(obj_meta->_box.begin(), obj_meta->_box.end(), obj.box);
+    obj.name_size = static_cast<guint16>(std::min<size_t>(obj_meta->_label_name.size(), G_MAXUINT16));
+    obj.body_feature_count = static_cast<guint32>(obj_meta->_body_feature.size());
+    obj.keypoint_count = static_cast<guint32>(obj_meta->_keypoints.size() / 3);
+    obj.face_landmark_count = has_face ? static_cast<guint32>(landmarks) : 0;
+    obj.face_feature_count = has_face ? static_cast<guint32>(obj_meta->_face_feature.size()) : 0;
+    put(arena, obj);
 
-    for (const auto obj_meta : frame_meta->_object_meta_list) {
-        add_object_meta_to_json(jarray_objects, obj_meta);
+    arena.append(obj_meta->_label_name.data(), obj.name_size);
+    arena.pad(4);
+    put_floats(arena, obj_meta->_body_feature.data(), obj.body_feature_count);
+    put_floats(arena, obj_meta->_keypoints.data(), obj.keypoint_count * 3u);
+    if (has_face) {
+        put_floats(arena, obj_meta->_face_box.data(), 4);
+        put(arena, obj_meta->_face_confidence);
+        for (size_t i = 0; i < landmarks; i++)
+            put_floats(arena, &obj_meta->_face_landmarks[i * 3], 2);
+        put_floats(arena, obj_meta->_face_feature.data(), obj.face_feature_count);
     }
+    if (has_segment) {
+        put(arena, static_cast<guint32>(obj_meta->_seg_width));
+        put(arena, static_cast<guint32>(obj_meta->_seg_height));
+        arena.append(obj_meta->_seg_data.data(), mask_size);
+        arena.pad(4);
+    }
+
+    auto record_size = static_cast<guint32>(arena.size() - start);
+    memcpy(arena.at(start) + offsetof(DxMsgBinObject, record_size), &record_size,
+           sizeof(record_size));
+}
 
-    json_node_set_object(jnode_root, jobj_root);
-    gchar *json_data = json_to_string(jnode_root, TRUE);
+gpointer dxpayload_convert_to_binary(DxMsgContext *context,
+                                     GstDxMsgMetaInfo *meta_info, gsize *length) {
+    const auto *frame_meta = (DXFrameMeta *)(meta_info->_frame_meta);
+    DxMsgArena &arena = context_arena(context);
+
+    DxMsgBinHeader header = {};
+    memcpy(header.magic, DXMSG_BIN_MAGIC, sizeof(header.magic));
+    header.version = DXMSG_BIN_VERSION;
+    header.header_size = sizeof(DxMsgBinHeader);
+    header.stream_id = frame_meta->_stream_id;
+    header.width = frame_meta->_width;
+    header.height = frame_meta->_height;
+    header.seq_id = meta_info->_seq_id;
+    size_t frame_size = meta_info->_frame_base64 ? strlen(meta_info->_frame_base64) : 0;
+    header.frame_data_size = static_cast<guint32>(frame_size);
+    put(arena, header);
+    arena.append(meta_info->_frame_base64, frame_size);
+    arena.pad(4);
+
+    guint32 num_objects = 0;
+    for (const auto *obj_meta : frame_meta->_object_meta_list) {
+        if (obj_meta->_label == -1)
+            continue;
+        write_object_binary(arena, obj_meta);
+        num_objects++;
+    }
 
-    json_node_free(jnode_root);
-    json_object_unref(jobj_root);
+    auto total_size = static_cast<guint32>(arena.size());
+    memcpy(arena.at(offsetof(DxMsgBinHeader, total_size)), &total_size, sizeof(total_size));
+    memcpy(arena.at(offsetof(DxMsgBinHeader, num_objects)), &num_objects,
+           sizeof(num_objects));
 
-    return json_data;
+    *length = arena.size();
+    return arena.take();
 }
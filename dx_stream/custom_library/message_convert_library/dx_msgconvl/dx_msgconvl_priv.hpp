@@ -2,14 +2,16 @@
 #define __DX_MSGCONVL_PRIV_H__
 
 #include "gstdxstream/gst-dxmsgmeta.hpp"
+#include "gstdxstream/dx_json_writer.hpp"
 #include <vector>
 #include <string>
 
 // private property from config file
 struct _DxMsgContextPriv {
-    guint _customId;
+    guint _customId = 0;
     std::vector<std::string> _object_include_list;
 
+    DxMsgArena _arena; /**< reused by every message of the context */
 };
 using DxMsgContextPriv = _DxMsgContextPriv;
 
@@ -19,7 +21,14 @@ void dxcontext_delete_contextPriv(DxMsgContextPriv *contextPriv);
 bool dxcontext_parse_json_config(const gchar *file,
                                  DxMsgContextPriv *contextPriv);
 
+/** NUL-terminated JSON (g_malloc'd); its length without the NUL is stored
+ *  in `length` when given. */
 gchar *dxpayload_convert_to_json(DxMsgContext *context,
-                                 GstDxMsgMetaInfo *meta_info);
+                                 GstDxMsgMetaInfo *meta_info,
+                                 gsize *length = nullptr);
+
+/** Message in the binary schema of dx_msgconvl_schema.hpp (g_malloc'd). */
+gpointer dxpayload_convert_to_binary(DxMsgContext *context,
+                                     GstDxMsgMetaInfo *meta_info, gsize *length);
 
 #endif /* __DX_MSGCONVL_PRIV_H__ */
\ No newline at end of file
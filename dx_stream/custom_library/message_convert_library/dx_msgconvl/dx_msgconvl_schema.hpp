@@ -0,0 +1,73 @@
+#ifndef __DX_MSGCONVL_SCHEMA_H__
+#define __DX_MSGCONVL_SCHEMA_H__
+
+#include <glib.h>
+
+/*
+ * Binary message schema (message-format=binary), version 1.
+ *
+ * Fields are written in the host byte order of the producer (little-endian
+ * on every supported target: x86-64 and aarch64); a reader on a big-endian
+ * host must swap them. Every section is 4-byte aligned:
+ *
+ *   DxMsgBinHeader
+ *   frame data      frame_data_size bytes (base64 JPEG), padded to 4
+ *   object 0        DxMsgBinObject + sections below
+ *   object 1        ...
+ *
+ * Each object is a DxMsgBinObject followed, in this order, by
+ *
+ *   name            name_size bytes (no NUL), padded to 4
+ *   body feature    float[body_feature_count]
+ *   pose            float[keypoint_count][3]       (kx, ky, ks)
+ *   face            if DXMSG_BIN_HAS_FACE:
+ *                     float box[4], float confidence,
+ *                     float[face_landmark_count][2] (x, y),
+ *                     float[face_feature_count]
+ *   segment         if DXMSG_BIN_HAS_SEGMENT:
+ *                     guint32 width, guint32 height,
+ *                     guint8 mask[height][width], padded to 4
+ *
+ * record_size always points at the next object, so readers can skip
+ * sections (or whole objects) they do not know. New fields are only ever
+ * appended, behind a version bump.
+ */
+
+#define DXMSG_BIN_MAGIC "DXMB"
+#define DXMSG_BIN_VERSION 1
+
+#define DXMSG_BIN_HAS_FACE (1u << 0)
+#define DXMSG_BIN_HAS_SEGMENT (1u << 1)
+
+struct DxMsgBinHeader {
+    char magic[4];
+    guint16 version;
+    guint16 header_size;     /**< sizeof(DxMsgBinHeader) */
+    guint32 total_size;      /**< whole message */
+    gint32 stream_id;
+    gint32 width;
+    gint32 height;
+    guint64 seq_id;
+    guint32 num_objects;
+    guint32 frame_data_size; /**< 0 without include-frame */
+};
+
+struct DxMsgBinObject {
+    guint32 record_size;     /**< this header + sections */
+    guint32 flags;           /**< DXMSG_BIN_HAS_* */
+    gint32 label_id;
+    gint32 track_id;
+    gfloat confidence;
+    gfloat box[4];           /**< startX, startY, endX, endY */
+    guint16 name_size;
+    guint16 reserved;
+    guint32 body_feature_count;
+    guint32 keypoint_count;
+    guint32 face_landmark_count;
+    guint32 face_feature_count;
+};
+
+static_assert(sizeof(DxMsgBinHeader) == 40, "DxMsgBinHeader layout changed");
+static_assert(sizeof(DxMsgBinObject) == 56, "DxMsgBinObject layout changed");
+
+#endif /* __DX_MSGCONVL_SCHEMA_H__ */
@@ -0,0 +1,174 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Minimal timing harness shared by the dx-stream microbenchmarks.
+//
+// Each executable is one suite of named cases. A case is timed in samples of
+// `batch` calls until both min_time and a minimum sample count are reached;
+// the per-call statistics of every case are written as one JSON document
+// (stdout, or the file given with --json) so results can be diffed across
+// releases with compare_benchmarks.py.
+//
+// Command line (all optional):
+//   --json <path>      write the JSON report to <path> instead of stdout
+//   --min-time <ms>    minimum measured time per case (default 200)
+//   --filter <substr>  only run cases whose name contains <substr>
+// ---------------------------------------------------------------------------
+
+#include <gst/gst.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+GST_DEBUG_CATEGORY_EXTERN(dxmeta_cat);
+GST_DEBUG_CATEGORY_EXTERN(transform_kernel_cat);
+
+namespace dxbench {
+
+/** key -> already JSON-encoded value */
+using Params = std::vector<std::pair<std::string, std::string>>;
+
+inline std::string json_str(const std::string &s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+inline std::string json_num(double v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.1f", v);
+    return buf;
+}
+
+struct Result {
+    std::string name;
+    Params params;
+    size_t samples = 0;
+    size_t batch = 1;
+    double mean_ns = 0;
+    double min_ns = 0;
+    double median_ns = 0;
+    double p99_ns = 0;
+    double max_ns = 0;
+};
+
+class Runner {
+  public:
+    Runner(const char *suite, int argc, char **argv) : suite_(suite) {
+        for (int i = 1; i + 1 < argc; i++) {
+            if (!strcmp(argv[i], "--json"))
+                json_path_ = argv[++i];
+            else if (!strcmp(argv[i], "--min-time"))
+                min_time_ms_ = atof(argv[++i]);
+            else if (!strcmp(argv[i], "--filter"))
+                filter_ = argv[++i];
+        }
+
+        // The plugin library is linked directly, so plugin_init never runs
+        // and the categories its code logs to must be set up here.
+        gst_init(&argc, &argv);
+        GST_DEBUG_CATEGORY_INIT(dxmeta_cat, "dxmeta", 0, "DX Metadata");
+        GST_DEBUG_CATEGORY_INIT(transform_kernel_cat, "transform_kernel", 0,
+                                "DX video transform kernels");
+    }
+
+    /** Times fn() (one call = one operation). `batch` calls are timed
+     *  together when a single call is too short for the clock. */
+    template <typename Fn>
+    void run(const std::string &name, const Params &params, Fn &&fn,
+             size_t batch = 1) {
+        if (!filter_.empty() && name.find(filter_) == std::string::npos)
+            return;
+
+        using clock = std::chrono::steady_clock;
+        fn(); // warm-up: first-call allocations, page faults, lazy init
+
+        std::vector<double> samples;
+        double total_ns = 0;
+        while ((total_ns < min_time_ms_ * 1e6 || samples.size() < kMinSamples) &&
+               samples.size() < kMaxSamples) {
+            auto start = clock::now();
+            for (size_t i = 0; i < batch; i++)
+                fn();
+            double ns = std::chrono::duration<double, std::nano>(clock::now() - start)
+                            .count();
+            total_ns += ns;
+            samples.push_back(ns / batch);
+        }
+
+        std::sort(samples.begin(), samples.end());
+        Result r;
+        r.name = name;
+        r.params = params;
+        r.samples = samples.size();
+        r.batch = batch;
+        r.mean_ns = total_ns / (samples.size() * batch);
+        r.min_ns = samples.front();
+        r.median_ns = samples[samples.size() / 2];
+        r.p99_ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        r.max_ns = samples.back();
+        fprintf(stderr, "%-56s %12.1f ns/op (median %.1f, %zu samples)\n",
+                name.c_str(), r.mean_ns, r.median_ns, r.samples);
+        results_.push_back(std::move(r));
+    }
+
+    /** Writes the report; returns the process exit code. */
+    int finish() const {
+        FILE *out = stdout;
+        if (!json_path_.empty()) {
+            out = fopen(json_path_.c_str(), "w");
+            if (!out) {
+                fprintf(stderr, "Cannot open %s\n", json_path_.c_str());
+                return 1;
+            }
+        }
+
+        fprintf(out, "{\"suite\":%s,\"results\":[", json_str(suite_).c_str());
+        for (size_t i = 0; i < results_.size(); i++) {
+            const Result &r = results_[i];
+            fprintf(out, "%s\n{\"name\":%s,\"params\":{", i ? "," : "",
+                    json_str(r.name).c_str());
+            for (size_t p = 0; p < r.params.size(); p++)
+                fprintf(out, "%s%s:%s", p ? "," : "",
+                        json_str(r.params[p].first).c_str(),
+                        r.params[p].second.c_str());
+            fprintf(out,
+                    "},\"samples\":%zu,\"batch\":%zu,\"mean_ns\":%s,\"min_ns\":%s,"
+                    "\"median_ns\":%s,\"p99_ns\":%s,\"max_ns\":%s}",
+                    r.samples, r.batch, json_num(r.mean_ns).c_str(),
+                    json_num(r.min_ns).c_str(), json_num(r.median_ns).c_str(),
+                    json_num(r.p99_ns).c_str(), json_num(r.max_ns).c_str());
+        }
+        fputs("\n]}\n", out);
+        if (out != stdout)
+            fclose(out);
+        return 0;
+    }
+
+  private:
+    static constexpr size_t kMinSamples = 10;
+    static constexpr size_t kMaxSamples = 100000;
+
+    std::string suite_;
+    std::string json_path_;
+    std::string filter_;
+    double min_time_ms_ = 200;
+    std::vector<Result> results_;
+};
+
+/** Keeps the optimizer from discarding a computed value. */
+template <typename T> inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace dxbench
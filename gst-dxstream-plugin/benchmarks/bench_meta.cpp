@@ -0,0 +1,86 @@
+// Metadata hot paths: object meta acquire/release/copy, DXFrameMeta
+// attach/free, and dx_frame_meta_copy with a realistic number of objects.
+
+#include "bench_common.hpp"
+#include "gst-dxframemeta.hpp"
+#include "gst-dxobjectmeta.hpp"
+
+namespace {
+
+void fill_object(DXObjectMeta *obj, int i) {
+    obj->_label = i % 80;
+    obj->_label_name = "person";
+    obj->_confidence = 0.9f;
+    obj->_track_id = i;
+    obj->_box[0] = static_cast<float>(i);
+    obj->_box[1] = static_cast<float>(i);
+    obj->_box[2] = static_cast<float>(i + 40);
+    obj->_box[3] = static_cast<float>(i + 80);
+    obj->_keypoints.assign(17 * 3, 0.5f);
+}
+
+/** Buffer with a DXFrameMeta holding `objects` populated object metas. */
+GstBuffer *make_source_buffer(int objects) {
+    GstBuffer *buf = dx_create_frame_meta(gst_buffer_new());
+    DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+    frame_meta->_stream_id = 0;
+    frame_meta->_width = 1920;
+    frame_meta->_height = 1080;
+    for (int i = 0; i < objects; i++) {
+        DXObjectMeta *obj = dx_acquire_obj_meta_from_pool();
+        fill_object(obj, i);
+        dx_add_obj_meta_to_frame(frame_meta, obj);
+    }
+    return buf;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    dxbench::Runner runner("meta", argc, argv);
+
+    runner.run("obj_meta/acquire_release", {}, []() {
+        DXObjectMeta *obj = dx_acquire_obj_meta_from_pool();
+        dx_release_obj_meta(obj);
+    }, 100);
+
+    DXObjectMeta *src_obj = dx_acquire_obj_meta_from_pool();
+    fill_object(src_obj, 1);
+    runner.run("obj_meta/copy", {}, [&]() {
+        DXObjectMeta *dst_obj = dx_acquire_obj_meta_from_pool();
+        dx_copy_obj_meta(src_obj, dst_obj);
+        dx_release_obj_meta(dst_obj);
+    }, 100);
+    dx_release_obj_meta(src_obj);
+
+    runner.run("frame_meta/create_free", {}, []() {
+        GstBuffer *buf = dx_create_frame_meta(gst_buffer_new());
+        gst_buffer_unref(buf);
+    }, 100);
+
+    for (int objects : {0, 10, 100}) {
+        GstBuffer *src = make_source_buffer(objects);
+        DXFrameMeta *src_meta = dx_get_frame_meta(src);
+        dxbench::Params params = {{"objects", std::to_string(objects)}};
+
+        // dx_frame_meta_copy expects a fresh destination, so each call
+        // includes one create_free.
+        char name[64];
+        snprintf(name, sizeof(name), "frame_meta/copy/%d_objects", objects);
+        runner.run(name, params, [&]() {
+            GstBuffer *dst = dx_create_frame_meta(gst_buffer_new());
+            dx_frame_meta_copy(src, src_meta, dst, dx_get_frame_meta(dst));
+            gst_buffer_unref(dst);
+        }, 10);
+
+        // What elements hit through gst_buffer_make_writable().
+        snprintf(name, sizeof(name), "frame_meta/buffer_copy/%d_objects", objects);
+        runner.run(name, params, [&]() {
+            GstBuffer *dst = gst_buffer_copy(src);
+            gst_buffer_unref(dst);
+        }, 10);
+
+        gst_buffer_unref(src);
+    }
+    return runner.finish();
+}
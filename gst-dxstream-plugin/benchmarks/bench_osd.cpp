@@ -0,0 +1,157 @@
+// dxosd rendering of a busy 4K frame (boxes, labels, pose, instance masks
+// over a semantic segmentation map), serial and band-parallel with 2, 4
+// and 8 threads. Before timing, every parallel render is compared byte for
+// byte with the serial one; a mismatch fails the benchmark.
+
+#include "bench_common.hpp"
+#include "dxosd_band.hpp"
+#include "dxosd_cache.hpp"
+#include "dxosd_common.hpp"
+#include "gst-dxframemeta.hpp"
+#include "gst-dxobjectmeta.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const int kWidth = 3840;
+const int kHeight = 2160;
+
+/** 4K frame meta with `objects` people spread over the frame; every fourth
+ *  has a pose, every eighth an instance mask. */
+GstBuffer *make_scene(int objects) {
+    GstBuffer *buf = dx_create_frame_meta(gst_buffer_new());
+    DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+    frame_meta->_stream_id = 0;
+    frame_meta->_width = kWidth;
+    frame_meta->_height = kHeight;
+    frame_meta->_seg_width = 480;
+    frame_meta->_seg_height = 270;
+    frame_meta->_seg_data.resize(480 * 270);
+    for (size_t i = 0; i < frame_meta->_seg_data.size(); i++)
+        frame_meta->_seg_data[i] = static_cast<unsigned char>((i / 480 / 30 + i % 480 / 40) % 8);
+
+    for (int i = 0; i < objects; i++) {
+        DXObjectMeta *obj = dx_acquire_obj_meta_from_pool();
+        float x = static_cast<float>((i * 397) % (kWidth - 240));
+        float y = static_cast<float>((i * 211) % (kHeight - 480) + 40);
+        obj->_label = i % 80;
+        obj->_label_name = "person";
+        obj->_confidence = 0.5f + (i % 50) / 100.0f;
+        obj->_track_id = i % 3 ? i : -1;
+        obj->_box[0] = x;
+        obj->_box[1] = y;
+        obj->_box[2] = x + 200;
+        obj->_box[3] = y + 420;
+        if (i % 4 == 0) {
+            obj->_keypoints.resize(17 * 3);
+            for (int k = 0; k < 17; k++) {
+                obj->_keypoints[k * 3] = x + 20 + (k * 37) % 160;
+                obj->_keypoints[k * 3 + 1] = y + 20 + k * 22;
+                obj->_keypoints[k * 3 + 2] = 0.9f;
+            }
+        }
+        if (i % 8 == 0) {
+            obj->_seg_width = 40;
+            obj->_seg_height = 84;
+            obj->_seg_data.resize(40 * 84);
+            for (size_t k = 0; k < obj->_seg_data.size(); k++)
+                obj->_seg_data[k] = (k % 40 + k / 40) % 3 != 0;
+        }
+        dx_add_obj_meta_to_frame(frame_meta, obj);
+    }
+    return buf;
+}
+
+struct Frame {
+    std::vector<uint8_t> data;
+    OsdFrame osd;
+};
+
+Frame make_frame(OsdFrame::Format format) {
+    Frame f;
+    f.osd.format = format;
+    f.osd.width = kWidth;
+    f.osd.height = kHeight;
+    size_t luma = static_cast<size_t>(kWidth) * kHeight;
+    if (format == OsdFrame::Format::PACKED) {
+        f.data.resize(luma * 3);
+        f.osd.strides[0] = kWidth * 3;
+    } else {
+        f.data.resize(luma * 3 / 2);
+        f.osd.strides[0] = kWidth;
+        f.osd.strides[1] = kWidth;
+    }
+    for (size_t i = 0; i < f.data.size(); i++)
+        f.data[i] = static_cast<uint8_t>(i * 31 + (i >> 11));
+    f.osd.planes[0] = f.data.data();
+    if (format == OsdFrame::Format::NV12)
+        f.osd.planes[1] = f.data.data() + luma;
+    return f;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    dxbench::Runner runner("osd", argc, argv);
+    int failures = 0;
+
+    const struct {
+        OsdFrame::Format format;
+        const char *name;
+    } formats[] = {{OsdFrame::Format::PACKED, "BGR"}, {OsdFrame::Format::NV12, "NV12"}};
+
+    for (int objects : {50, 200}) {
+        GstBuffer *scene = make_scene(objects);
+        const DXFrameMeta *meta = dx_get_frame_meta(scene);
+
+        for (const auto &fmt : formats) {
+            Frame serial = make_frame(fmt.format);
+            dxs::OsdRenderCache serial_cache;
+            draw_frame_meta(serial.osd, meta, serial_cache.prepare(meta, serial.osd));
+
+            for (guint threads : {1u, 2u, 4u, 8u}) {
+                std::unique_ptr<dxs::BandPool> pool;
+                if (threads > 1)
+                    pool.reset(new dxs::BandPool(threads));
+                Frame frame = make_frame(fmt.format);
+                // One cache per stream, as in the element: after the first
+                // frame every label is a hit.
+                dxs::OsdRenderCache cache;
+                auto render = [&]() {
+                    const OsdFrameStyle &style = cache.prepare(meta, frame.osd);
+                    if (!pool) {
+                        draw_frame_meta(frame.osd, meta, style);
+                        return;
+                    }
+                    pool->run(frame.osd.height, [&](const OsdBand &band) {
+                        draw_frame_meta(frame.osd, meta, style, band);
+                    });
+                };
+
+                render();
+                if (memcmp(frame.data.data(), serial.data.data(), frame.data.size()) != 0) {
+                    fprintf(stderr, "%s/%d objects: %u threads differ from serial\n",
+                            fmt.name, objects, threads);
+                    failures++;
+                }
+
+                char name[96];
+                snprintf(name, sizeof(name), "draw/%s/%dx%d/%d_objects/%u_threads", fmt.name,
+                         kWidth, kHeight, objects, threads);
+                dxbench::Params params = {
+                    {"format", dxbench::json_str(fmt.name)},
+                    {"objects", std::to_string(objects)},
+                    {"threads", std::to_string(threads)},
+                };
+                runner.run(name, params, render);
+            }
+        }
+        gst_buffer_unref(scene);
+    }
+
+    int rc = runner.finish();
+    return failures ? 1 : rc;
+}
@@ -0,0 +1,143 @@
+// Postprocess libraries (decode + NMS + object meta creation) run against
+// recorded output tensors, no NPU involved.
+//
+// --data <dir> holds one sub-directory per case, each a recorded tensor set
+// (manifest.json naming the library, see dxtensor_io.hpp). A case holding a
+// recording.dxtrec captured by dxtensorcapture cycles through its records
+// instead; its manifest then only needs the library ("tensors": []).
+// Exits 77 (skipped) when no case is found.
+
+#include "bench_common.hpp"
+#include "../src/dxtensor_io.hpp"
+#include "gst-dxframemeta.hpp"
+#include "gst-dxobjectmeta.hpp"
+
+#include <dlfcn.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using PostProcessFunc = void (*)(GstBuffer *, std::vector<dxs::DXTensor>,
+                                 DXFrameMeta *, DXObjectMeta *);
+
+struct Case {
+    std::string name;
+    void *handle = nullptr;
+    PostProcessFunc func = nullptr;
+    dxs::TensorManifest manifest;
+    std::shared_ptr<dxs::TensorRecordReader> recording;
+};
+
+bool load_case(const std::string &dir, const std::string &name, Case &c) {
+    std::string error;
+    if (!dxs::load_tensor_manifest(dir, c.manifest, error)) {
+        fprintf(stderr, "%s: %s\n", name.c_str(), error.c_str());
+        return false;
+    }
+    c.name = name;
+    std::string recording = dir + "/recording.dxtrec";
+    if (g_file_test(recording.c_str(), G_FILE_TEST_EXISTS)) {
+        c.recording = std::make_shared<dxs::TensorRecordReader>();
+        if (!c.recording->open(recording, error) || c.recording->size() == 0) {
+            fprintf(stderr, "%s: %s\n", name.c_str(),
+                    error.empty() ? "empty recording" : error.c_str());
+            return false;
+        }
+    }
+    c.handle = dlopen(c.manifest.library.c_str(), RTLD_NOW);
+    if (!c.handle) {
+        fprintf(stderr, "%s: %s\n", name.c_str(), dlerror());
+        return false;
+    }
+    c.func = reinterpret_cast<PostProcessFunc>(
+        dlsym(c.handle, c.manifest.function.c_str()));
+    if (!c.func) {
+        fprintf(stderr, "%s: no function '%s' in %s\n", name.c_str(),
+                c.manifest.function.c_str(), c.manifest.library.c_str());
+        dlclose(c.handle);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    dxbench::Runner runner("postprocess", argc, argv);
+
+    const char *data_dir = nullptr;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (!strcmp(argv[i], "--data"))
+            data_dir = argv[++i];
+    }
+    GDir *dir = data_dir && *data_dir ? g_dir_open(data_dir, 0, nullptr) : nullptr;
+    if (!dir) {
+        fprintf(stderr, "No recorded tensors (--data <dir>), skipping\n");
+        return 77;
+    }
+
+    std::vector<Case> cases;
+    while (const gchar *entry = g_dir_read_name(dir)) {
+        std::string path = std::string(data_dir) + "/" + entry;
+        if (!g_file_test((path + "/manifest.json").c_str(), G_FILE_TEST_EXISTS))
+            continue;
+        Case c;
+        if (load_case(path, entry, c))
+            cases.push_back(std::move(c));
+    }
+    g_dir_close(dir);
+    if (cases.empty()) {
+        fprintf(stderr, "No usable case in %s, skipping\n", data_dir);
+        return 77;
+    }
+
+    for (Case &c : cases) {
+        if (c.recording) {
+            dxs::TensorRecordFrame frame;
+            dxs::DXTensors tensors;
+            c.recording->read(0, frame, tensors);
+            dxbench::Params params = {
+                {"case", dxbench::json_str(c.name)},
+                {"records", std::to_string(c.recording->size())},
+                {"tensors", std::to_string(tensors._tensors.size())},
+                {"width", std::to_string(frame.width)},
+                {"height", std::to_string(frame.height)},
+            };
+            size_t next = 0;
+            runner.run("postprocess/" + c.name, params, [&c, &next]() {
+                dxs::TensorRecordFrame frame;
+                dxs::DXTensors tensors;
+                c.recording->read(next, frame, tensors);
+                next = (next + 1) % c.recording->size();
+                GstBuffer *buf = dx_create_frame_meta(gst_buffer_new());
+                DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+                frame_meta->_stream_id = frame.stream_id;
+                frame_meta->_width = frame.width;
+                frame_meta->_height = frame.height;
+                c.func(buf, tensors._tensors, frame_meta, nullptr);
+                gst_buffer_unref(buf);
+            });
+            dlclose(c.handle);
+            continue;
+        }
+        dxbench::Params params = {
+            {"case", dxbench::json_str(c.name)},
+            {"tensors", std::to_string(c.manifest.tensors._tensors.size())},
+            {"width", std::to_string(c.manifest.width)},
+            {"height", std::to_string(c.manifest.height)},
+        };
+        runner.run("postprocess/" + c.name, params, [&c]() {
+            GstBuffer *buf = dx_create_frame_meta(gst_buffer_new());
+            DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+            frame_meta->_width = c.manifest.width;
+            frame_meta->_height = c.manifest.height;
+            c.func(buf, c.manifest.tensors._tensors, frame_meta, nullptr);
+            gst_buffer_unref(buf);
+        });
+        dlclose(c.handle);
+    }
+    return runner.finish();
+}
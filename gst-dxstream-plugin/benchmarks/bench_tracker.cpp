@@ -0,0 +1,87 @@
+// OC_SORT update() cost per frame with 10/100/500 concurrently tracked
+// objects moving at constant velocity (bouncing off the frame edges), so the
+// association runs against confirmed tracks as it does in a live stream.
+
+#include "bench_common.hpp"
+#include "TrackerFactory.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr float kFrameW = 1920.0f;
+constexpr float kFrameH = 1080.0f;
+
+struct Object {
+    float x, y, vx, vy, w, h;
+};
+
+class Scene {
+  public:
+    explicit Scene(int count) {
+        // Spread objects on a grid so boxes start out non-overlapping.
+        int cols = 1;
+        while (cols * cols < count)
+            cols++;
+        float cell_w = kFrameW / cols, cell_h = kFrameH / cols;
+        for (int i = 0; i < count; i++) {
+            Object o;
+            o.w = std::max(8.0f, cell_w * 0.5f);
+            o.h = std::max(8.0f, cell_h * 0.5f);
+            o.x = (i % cols) * cell_w;
+            o.y = (i / cols) * cell_h;
+            o.vx = static_cast<float>((i * 7) % 5) - 2.0f;
+            o.vy = static_cast<float>((i * 3) % 5) - 2.0f;
+            objects_.push_back(o);
+        }
+    }
+
+    /** Advances one frame; rows are x1,y1,x2,y2,conf,label,input_idx as
+     *  built by dxtracker. */
+    Eigen::MatrixXf step() {
+        Eigen::MatrixXf dets(objects_.size(), 7);
+        for (size_t i = 0; i < objects_.size(); i++) {
+            Object &o = objects_[i];
+            o.x += o.vx;
+            o.y += o.vy;
+            if (o.x < 0 || o.x + o.w > kFrameW)
+                o.vx = -o.vx;
+            if (o.y < 0 || o.y + o.h > kFrameH)
+                o.vy = -o.vy;
+            dets.row(i) << o.x, o.y, o.x + o.w, o.y + o.h, 0.9f, 0.0f,
+                static_cast<float>(i);
+        }
+        return dets;
+    }
+
+  private:
+    std::vector<Object> objects_;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    dxbench::Runner runner("tracker", argc, argv);
+
+    for (int count : {10, 100, 500}) {
+        std::unique_ptr<Tracker> tracker = TrackerFactory::createTracker("OC_SORT");
+        tracker->init({});
+        Scene scene(count);
+        // Past min_hits every object has a confirmed track.
+        for (int i = 0; i < 10; i++)
+            tracker->update(scene.step());
+
+        char name[64];
+        snprintf(name, sizeof(name), "oc_sort_update/%d_tracks", count);
+        dxbench::Params params = {
+            {"tracker", dxbench::json_str("OC_SORT")},
+            {"tracks", std::to_string(count)},
+        };
+        runner.run(name, params, [&]() {
+            std::vector<Eigen::RowVectorXf> out = tracker->update(scene.step());
+            dxbench::do_not_optimize(out.size());
+        });
+    }
+    return runner.finish();
+}
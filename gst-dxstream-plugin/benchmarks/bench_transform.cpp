@@ -0,0 +1,98 @@
+// libyuv transform kernel: every src/dst format pair at common camera and
+// model resolutions, convert-only (same size) and scale+convert.
+
+#include "bench_common.hpp"
+#include "gst_frame_desc.hpp"
+#include "libyuv_transform_kernel.hpp"
+
+#include <vector>
+
+using namespace dxt;
+
+namespace {
+
+const char *format_name(VideoFormat fmt) {
+    switch (fmt) {
+        case VideoFormat::I420: return "I420";
+        case VideoFormat::NV12: return "NV12";
+        case VideoFormat::RGB:  return "RGB";
+        case VideoFormat::BGR:  return "BGR";
+    }
+    return "?";
+}
+
+size_t frame_size(int w, int h, VideoFormat fmt) {
+    return bytes_per_pixel(fmt) ? static_cast<size_t>(w) * h * bytes_per_pixel(fmt)
+                                : static_cast<size_t>(w) * h * 3 / 2;
+}
+
+/** Points the planes of a make_dst_template() descriptor into `data`. */
+FrameDesc bind_frame(int w, int h, VideoFormat fmt, std::vector<uint8_t> &data) {
+    FrameDesc desc = make_dst_template(w, h, fmt);
+    uint8_t *p = data.data();
+    for (int i = 0; i < desc.num_planes; i++) {
+        desc.planes[i].data = p;
+        p += static_cast<size_t>(desc.planes[i].stride) * desc.planes[i].height;
+    }
+    return desc;
+}
+
+struct Size {
+    int w, h;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    dxbench::Runner runner("transform", argc, argv);
+
+    const VideoFormat formats[] = {VideoFormat::I420, VideoFormat::NV12,
+                                   VideoFormat::RGB, VideoFormat::BGR};
+    const Size sources[] = {{1280, 720}, {1920, 1080}};
+    const Size model = {640, 640};
+
+    for (const Size &src_size : sources) {
+        for (VideoFormat src_fmt : formats) {
+            std::vector<uint8_t> src_data(frame_size(src_size.w, src_size.h, src_fmt));
+            for (size_t i = 0; i < src_data.size(); i++)
+                src_data[i] = static_cast<uint8_t>(i * 31 + (i >> 11));
+            FrameDesc src = bind_frame(src_size.w, src_size.h, src_fmt, src_data);
+
+            for (VideoFormat dst_fmt : formats) {
+                for (bool scale : {false, true}) {
+                    const Size dst_size = scale ? model : src_size;
+                    std::vector<uint8_t> dst_data(
+                        frame_size(dst_size.w, dst_size.h, dst_fmt));
+                    FrameDesc dst = bind_frame(dst_size.w, dst_size.h, dst_fmt, dst_data);
+
+                    TransformOps ops;
+                    ops.keep_aspect_ratio = scale;
+                    ops.padding.enabled = scale;
+                    LibyuvTransformKernel kernel;
+                    if (!kernel.init(make_dst_template(dst_size.w, dst_size.h, dst_fmt),
+                                     ops))
+                        continue;
+
+                    char name[128];
+                    snprintf(name, sizeof(name), "%s->%s/%dx%d->%dx%d",
+                             format_name(src_fmt), format_name(dst_fmt), src_size.w,
+                             src_size.h, dst_size.w, dst_size.h);
+                    dxbench::Params params = {
+                        {"backend", dxbench::json_str(kernel.backend_name())},
+                        {"src_format", dxbench::json_str(format_name(src_fmt))},
+                        {"dst_format", dxbench::json_str(format_name(dst_fmt))},
+                        {"src_width", std::to_string(src_size.w)},
+                        {"src_height", std::to_string(src_size.h)},
+                        {"dst_width", std::to_string(dst_size.w)},
+                        {"dst_height", std::to_string(dst_size.h)},
+                    };
+                    runner.run(name, params, [&]() {
+                        TransformResult res = kernel.transform(src, dst);
+                        dxbench::do_not_optimize(res.success);
+                    });
+                }
+            }
+        }
+    }
+    return runner.finish();
+}
@@ -0,0 +1,46 @@
+// Preprocessor::transpose_hwc_to_chw at typical model input sizes.
+
+#include "bench_common.hpp"
+#include "preprocessor.h"
+
+#include <vector>
+
+namespace {
+
+/** Exposes the protected transpose; it needs neither element nor kernels. */
+class BenchPreprocessor : public Preprocessor {
+  public:
+    BenchPreprocessor() : Preprocessor(nullptr, nullptr) {}
+    using Preprocessor::transpose_hwc_to_chw;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    dxbench::Runner runner("transpose", argc, argv);
+    BenchPreprocessor preprocessor;
+
+    const guint sizes[][3] = {{224, 224, 3}, {320, 320, 3}, {512, 512, 3},
+                              {640, 640, 3}};
+    for (const auto &size : sizes) {
+        guint width = size[0], height = size[1], channels = size[2];
+        std::vector<uint8_t> input(width * height * channels);
+        std::vector<uint8_t> output(input.size());
+        for (size_t i = 0; i < input.size(); i++)
+            input[i] = static_cast<uint8_t>(i);
+
+        char name[64];
+        snprintf(name, sizeof(name), "hwc_to_chw/%ux%ux%u", width, height, channels);
+        dxbench::Params params = {
+            {"width", std::to_string(width)},
+            {"height", std::to_string(height)},
+            {"channels", std::to_string(channels)},
+        };
+        runner.run(name, params, [&]() {
+            preprocessor.transpose_hwc_to_chw(output.data(), input.data(), channels,
+                                              height, width);
+            dxbench::do_not_optimize(output[0]);
+        });
+    }
+    return runner.finish();
+}
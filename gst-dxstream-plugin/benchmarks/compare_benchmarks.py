@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Compare two sets of dx-stream benchmark reports.
+
+Usage:
+    compare_benchmarks.py <baseline> <current> [--threshold 10]
+
+<baseline> and <current> are bench_*.json files or directories holding them
+(e.g. two meson build directories). Cases are matched by suite and name and
+compared on median_ns. Exits 1 when any case is slower than the baseline by
+more than --threshold percent.
+"""
+
+import argparse
+import glob
+import json
+import os
+import sys
+
+
+def load(path):
+    files = sorted(glob.glob(os.path.join(path, "**", "bench_*.json"), recursive=True)) \
+        if os.path.isdir(path) else [path]
+    results = {}
+    for f in files:
+        with open(f) as fp:
+            report = json.load(fp)
+        for r in report["results"]:
+            results[(report["suite"], r["name"])] = r["median_ns"]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default: 10)")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    regressions = 0
+    for key in sorted(base.keys() & cur.keys()):
+        delta = (cur[key] - base[key]) / base[key] * 100.0 if base[key] else 0.0
+        mark = ""
+        if delta > args.threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        print("%-12s %-52s %12.1f -> %12.1f ns  %+6.1f%%%s"
+              % (key[0], key[1], base[key], cur[key], delta, mark))
+    for key in sorted(base.keys() - cur.keys()):
+        print("%-12s %-52s missing in current" % key)
+
+    print("%d regression(s) over %.1f%%" % (regressions, args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,223 @@
+#ifndef DX_JSON_WRITER_H
+#define DX_JSON_WRITER_H
+
+#include <glib.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/**
+ * Growable byte buffer reused for every message of a context. Its storage
+ * only grows, so after the first few frames building a message does not
+ * allocate at all; the finished message is copied out once by take().
+ */
+class DxMsgArena {
+  public:
+    void reset() { size_ = 0; }
+
+    /** Reserves `n` bytes at the end and returns them (uninitialized). */
+    guint8 *grow(size_t n) {
+        if (size_ + n > buf_.size())
+            buf_.resize(std::max(buf_.size() * 2, size_ + n));
+        guint8 *p = buf_.data() + size_;
+        size_ += n;
+        return p;
+    }
+    void append(const void *data, size_t n) {
+        if (n > 0)
+            memcpy(grow(n), data, n);
+    }
+    void append_char(char c) { *grow(1) = static_cast<guint8>(c); }
+    /** Zero-fills up to the next multiple of `align`. */
+    void pad(size_t align) {
+        size_t rest = size_ % align;
+        if (rest)
+            memset(grow(align - rest), 0, align - rest);
+    }
+
+    size_t size() const { return size_; }
+    guint8 *at(size_t offset) { return buf_.data() + offset; }
+
+    /** g_malloc'd copy of the contents plus a trailing NUL. */
+    gpointer take() const {
+        auto *out = static_cast<guint8 *>(g_malloc(size_ + 1));
+        memcpy(out, buf_.data(), size_);
+        out[size_] = '\0';
+        return out;
+    }
+    /** The contents as GBytes (one copy, NUL-terminated like take()). */
+    GBytes *take_bytes() const { return g_bytes_new_take(take(), size_); }
+
+  private:
+    std::vector<guint8> buf_;
+    size_t size_ = 0;
+};
+
+/**
+ * Streaming JSON writer on top of DxMsgArena: values are formatted straight
+ * into the arena, with no intermediate tree. Output is compact (no
+ * whitespace); numbers use the C locale. Shared by the dxmsgconv element
+ * and the message converter library.
+ */
+class DxJsonWriter {
+  public:
+    explicit DxJsonWriter(DxMsgArena &arena) : arena_(arena) {}
+
+    void begin_object() { open('{'); }
+    void end_object() { close('}'); }
+    void begin_array() { open('['); }
+    void end_array() { close(']'); }
+
+    void key(const char *name);
+    void value(gint64 v);
+    void value(double v);
+    void value(const char *s, size_t length);
+    void value(const char *s) { value(s, s ? strlen(s) : 0); }
+    void value_array(const float *values, size_t count);
+
+    template <typename T> void member(const char *name, T v) {
+        key(name);
+        value(v);
+    }
+    void member(const char *name, int v) { member<gint64>(name, v); }
+    void member(const char *name, guint64 v) { member<gint64>(name, static_cast<gint64>(v)); }
+    void member(const char *name, float v) { member<double>(name, v); }
+    /** A DXObjectMeta-style box as {"startX","startY","endX","endY"}. */
+    void member(const char *name, const std::array<float, 4> &box);
+
+  private:
+    static constexpr int MAX_DEPTH = 32;
+
+    void separator();
+    void open(char c);
+    void close(char c);
+    void number(double v);
+    void string(const char *s, size_t length);
+
+    DxMsgArena &arena_;
+    int depth_ = 0;
+    bool first_[MAX_DEPTH] = {true};
+    bool after_key_ = false;
+};
+
+
+inline void DxJsonWriter::separator() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (depth_ > 0) {
+        if (!first_[depth_])
+            arena_.append_char(',');
+        first_[depth_] = false;
+    }
+}
+
+inline void DxJsonWriter::open(char c) {
+    separator();
+    arena_.append_char(c);
+    if (depth_ < MAX_DEPTH - 1)
+        depth_++;
+    first_[depth_] = true;
+}
+
+inline void DxJsonWriter::close(char c) {
+    arena_.append_char(c);
+    if (depth_ > 0)
+        depth_--;
+}
+
+inline void DxJsonWriter::key(const char *name) {
+    separator();
+    string(name, strlen(name));
+    arena_.append_char(':');
+    after_key_ = true;
+}
+
+inline void DxJsonWriter::value(gint64 v) {
+    separator();
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *p = end;
+    guint64 u = v < 0 ? 0 - static_cast<guint64>(v) : static_cast<guint64>(v);
+    do {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0)
+        *--p = '-';
+    arena_.append(p, static_cast<size_t>(end - p));
+}
+
+inline void DxJsonWriter::number(double v) {
+    if (!std::isfinite(v)) {
+        arena_.append("null", 4);
+        return;
+    }
+    // 9 significant digits round-trip every float, which is what all
+    // metadata values are.
+    char buf[G_ASCII_DTOSTR_BUF_SIZE];
+    g_ascii_formatd(buf, sizeof(buf), "%.9g", v);
+    arena_.append(buf, strlen(buf));
+}
+
+inline void DxJsonWriter::value(double v) {
+    separator();
+    number(v);
+}
+
+inline void DxJsonWriter::value(const char *s, size_t length) {
+    separator();
+    string(s, length);
+}
+
+inline void DxJsonWriter::string(const char *s, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    arena_.append_char('"');
+    size_t run = 0; // bytes copied verbatim in one go
+    for (size_t i = 0; i < length; i++) {
+        auto c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        arena_.append(s + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"': arena_.append("\\\"", 2); break;
+        case '\\': arena_.append("\\\\", 2); break;
+        case '\n': arena_.append("\\n", 2); break;
+        case '\r': arena_.append("\\r", 2); break;
+        case '\t': arena_.append("\\t", 2); break;
+        default: {
+            char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+            arena_.append(esc, sizeof(esc));
+        }
+        }
+    }
+    arena_.append(s + run, length - run);
+    arena_.append_char('"');
+}
+
+inline void DxJsonWriter::value_array(const float *values, size_t count) {
+    begin_array();
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0)
+            arena_.append_char(',');
+        number(values[i]);
+    }
+    end_array();
+}
+
+inline void DxJsonWriter::member(const char *name, const std::array<float, 4> &box) {
+    key(name);
+    begin_object();
+    member("startX", box[0]);
+    member("startY", box[1]);
+    member("endX", box[2]);
+    member("endY", box[3]);
+    end_object();
+}
+
+#endif /* DX_JSON_WRITER_H */
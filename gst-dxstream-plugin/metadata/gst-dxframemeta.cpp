@@ -83,6 +83,8 @@ static gboolean dx_frame_meta_init(GstMeta *meta, gpointer params,
     dx_meta->_label = -1;
     dx_meta->_label_confidence = 0.0f;
 
+    dx_meta->_skipped_branches = 0;
+
     // Initialize C++ objects with placement new
     new (&dx_meta->_format) std::string();
     new (&dx_meta->_name) std::string();
@@ -159,6 +161,8 @@ void dx_frame_meta_copy(GstBuffer *src_buffer, DXFrameMeta *src_frame_meta,
     dst_frame_meta->_label_name = src_frame_meta->_label_name;
     dst_frame_meta->_label_confidence = src_frame_meta->_label_confidence;
 
+    dst_frame_meta->_skipped_branches = src_frame_meta->_skipped_branches;
+
     dst_frame_meta->_roi[0] = src_frame_meta->_roi[0];
     dst_frame_meta->_roi[1] = src_frame_meta->_roi[1];
     dst_frame_meta->_roi[2] = src_frame_meta->_roi[2];
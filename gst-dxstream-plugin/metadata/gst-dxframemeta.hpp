@@ -45,6 +45,10 @@ struct _DXFrameMeta {
     // RAII-managed tensors (shallow copy through shared_ptr)
     std::map<int, dxs::DXTensors> _input_tensors;   // preproc_id -> input tensors
     std::map<int, dxs::DXTensors> _output_tensors;   // infer_id -> output tensors
+
+    // dxgather partial join: bit i set when branch sink_i had no frame to
+    // contribute to this one. Kept last so existing field offsets are stable.
+    guint64 _skipped_branches;
 };
 
 DX_API GType dx_frame_meta_api_get_type(void);
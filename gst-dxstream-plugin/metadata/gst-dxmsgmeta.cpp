@@ -66,6 +66,8 @@ static gboolean gst_dxmsg_meta_init(GstMeta *meta, gpointer params,
     GST_CAT_DEBUG_SAFE(dxmeta_cat, "Initializing GstDxMsgMeta");
     auto *dxmsg_meta = (GstDxMsgMeta *)meta;
     dxmsg_meta->_payload = nullptr;
+    dxmsg_meta->_bytes = nullptr;
+    dxmsg_meta->_extra_bytes = nullptr;
     return TRUE;
 }
 
@@ -78,10 +80,35 @@ static void gst_dxmsg_meta_free(GstMeta *meta, GstBuffer *buffer) {
 
     if (payload) {
         GST_CAT_DEBUG_SAFE(dxmeta_cat, "Freeing payload data (size=%u)", payload->_size);
-        g_free(payload->_data);
+        // Without _bytes the payload was set directly and owns its data.
+        if (!dxmsg_meta->_bytes)
+            g_free(payload->_data);
         g_free(payload);
         payload = nullptr;
     }
+    if (dxmsg_meta->_bytes) {
+        g_bytes_unref(dxmsg_meta->_bytes);
+        dxmsg_meta->_bytes = nullptr;
+    }
+    if (dxmsg_meta->_extra_bytes) {
+        g_ptr_array_unref(dxmsg_meta->_extra_bytes);
+        dxmsg_meta->_extra_bytes = nullptr;
+    }
+}
+
+static GPtrArray *new_extra_bytes() {
+    return g_ptr_array_new_with_free_func((GDestroyNotify)g_bytes_unref);
+}
+
+// Takes ownership of `bytes`.
+static void set_payload_bytes(GstDxMsgMeta *msg_meta, GBytes *bytes) {
+    gsize size = 0;
+    auto *msgPayload = g_new0(DxMsgPayload, 1);
+    msgPayload->_data = const_cast<gpointer>(g_bytes_get_data(bytes, &size));
+    msgPayload->_size = (guint)size;
+
+    msg_meta->_payload = (gpointer)msgPayload;
+    msg_meta->_bytes = bytes;
 }
 
 // NOSONAR - GStreamer GstMetaTransformFunction signature requires non-const GstBuffer* parameters
@@ -102,7 +129,9 @@ static gboolean gst_dxmsg_meta_transform(GstBuffer *dest, GstMeta *meta,
     auto *dst_msg_meta = dx_get_msg_meta(dest);
     
     const auto *src_payload = (const DxMsgPayload *)src_msg_meta->_payload;
-    if (src_payload) {
+    if (src_msg_meta->_bytes) {
+        set_payload_bytes(dst_msg_meta, g_bytes_ref(src_msg_meta->_bytes));
+    } else if (src_payload) {
         auto *dst_payload = g_new0(DxMsgPayload, 1);
         dst_payload->_data = g_memdup(src_payload->_data, src_payload->_size);
         dst_payload->_size = src_payload->_size;
@@ -110,6 +139,13 @@ static gboolean gst_dxmsg_meta_transform(GstBuffer *dest, GstMeta *meta,
     } else {
         dst_msg_meta->_payload = nullptr;
     }
+    if (src_msg_meta->_extra_bytes) {
+        // Own array: later additions to either buffer stay separate.
+        dst_msg_meta->_extra_bytes = new_extra_bytes();
+        for (guint i = 0; i < src_msg_meta->_extra_bytes->len; i++)
+            g_ptr_array_add(dst_msg_meta->_extra_bytes,
+                            g_bytes_ref((GBytes *)g_ptr_array_index(src_msg_meta->_extra_bytes, i)));
+    }
     return TRUE;
 }
 
@@ -136,11 +172,35 @@ void dx_add_payload_to_buffer(GstBuffer *buffer, const DxMsgPayload *payload) {
     GST_CAT_DEBUG_SAFE(dxmeta_cat, "Adding payload to buffer (size=%u)", payload->_size);
     buffer = dx_create_msg_meta(buffer);
     auto *msg_meta = dx_get_msg_meta(buffer);
+    set_payload_bytes(msg_meta, g_bytes_new(payload->_data, payload->_size));
+}
 
-    auto *msgPayload = g_new0(DxMsgPayload, 1);
-    msgPayload->_data = g_memdup(payload->_data, payload->_size);
-    msgPayload->_size = payload->_size;
+void dx_take_payload_to_buffer(GstBuffer *buffer, DxMsgPayload *payload) {
+    GST_CAT_DEBUG_SAFE(dxmeta_cat, "Taking payload into buffer (size=%u)", payload->_size);
+    buffer = dx_create_msg_meta(buffer);
+    auto *msg_meta = dx_get_msg_meta(buffer);
+    set_payload_bytes(msg_meta, g_bytes_new_take(payload->_data, payload->_size));
+    g_free(payload);
+}
 
-    msg_meta->_payload = (gpointer)msgPayload;
+void dx_add_payload_bytes_to_buffer(GstBuffer *buffer, GBytes *bytes) {
+    GST_CAT_DEBUG_SAFE(dxmeta_cat, "Adding payload bytes to buffer (size=%zu)",
+                       g_bytes_get_size(bytes));
+    buffer = dx_create_msg_meta(buffer);
+    auto *msg_meta = dx_get_msg_meta(buffer);
+    set_payload_bytes(msg_meta, g_bytes_ref(bytes));
 }
 
+
+void dx_add_extra_payload_bytes_to_buffer(GstBuffer *buffer, GBytes *bytes) {
+    GST_CAT_DEBUG_SAFE(dxmeta_cat, "Adding extra payload bytes to buffer (size=%zu)",
+                       g_bytes_get_size(bytes));
+    auto *msg_meta = dx_get_msg_meta(buffer);
+    if (!msg_meta) {
+        buffer = dx_create_msg_meta(buffer);
+        msg_meta = dx_get_msg_meta(buffer);
+    }
+    if (!msg_meta->_extra_bytes)
+        msg_meta->_extra_bytes = new_extra_bytes();
+    g_ptr_array_add(msg_meta->_extra_bytes, g_bytes_ref(bytes));
+}
@@ -10,6 +10,8 @@ G_BEGIN_DECLS
 #define GST_DXMSG_META_API_TYPE (gst_dxmsg_meta_api_get_type())
 #define GST_DXMSG_META_INFO (gst_dxmsg_meta_get_info())
 
+/** Serialized message. Returned by msgconv libraries with _data allocated
+ *  by g_malloc; dxmsgconv takes ownership of it without copying. */
 struct _DxMsgPayload {
     gpointer _data;
     guint _size;
@@ -19,6 +21,9 @@ struct _DxMsgContext {
     gpointer _priv_data;
 };
 
+/** Payload encoding requested by dxmsgconv (message-format). */
+enum DxMsgFormat { DXMSG_FORMAT_JSON = 0, DXMSG_FORMAT_BINARY = 1 };
+
 struct _GstDxMsgMetaInfo {
     gpointer _frame_meta;
     gpointer _input_info;
@@ -27,12 +32,18 @@ struct _GstDxMsgMetaInfo {
     guint64 _seq_id;
 
     const gchar *_frame_base64;
+
+    guint _message_format; /**< DxMsgFormat; libraries may support JSON only */
 };
 
 struct _GstDxMsgMeta {
     GstMeta meta;
 
-    gpointer _payload;
+    gpointer _payload;  /**< DxMsgPayload view of _bytes, owned by the meta */
+    GBytes *_bytes;     /**< payload data, shared (not copied) by buffer copies
+                             and handed to the broker by reference */
+    GPtrArray *_extra_bytes; /**< GBytes published after _payload, in order
+                                  (e.g. dxmsgconv snapshots); may be nullptr */
 };
 
 using DxMsgPayload = struct _DxMsgPayload;
@@ -46,7 +57,15 @@ DX_API const GstMetaInfo *gst_dxmsg_meta_get_info(void);
 
 DX_API GstBuffer*dx_create_msg_meta(GstBuffer *buffer);
 DX_API GstDxMsgMeta *dx_get_msg_meta(GstBuffer *buffer);
+/** Attaches a copy of payload->_data; the caller keeps `payload`. */
 DX_API void dx_add_payload_to_buffer(GstBuffer *buffer, const DxMsgPayload *payload);
+/** Attaches payload->_data without copying and frees `payload` itself. */
+DX_API void dx_take_payload_to_buffer(GstBuffer *buffer, DxMsgPayload *payload);
+/** Attaches a reference to `bytes`. */
+DX_API void dx_add_payload_bytes_to_buffer(GstBuffer *buffer, GBytes *bytes);
+/** Queues a reference to `bytes` as a further message of the buffer, sent
+ *  by dxmsgbroker after the payload (if any). */
+DX_API void dx_add_extra_payload_bytes_to_buffer(GstBuffer *buffer, GBytes *bytes);
 
 G_END_DECLS
 
@@ -0,0 +1,318 @@
+#include <gst/gst.h>
+
+#include "dx_msgbroker_publisher.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+/* debug */
+GST_DEBUG_CATEGORY_STATIC(publisher);
+#define GST_CAT_DEFAULT publisher
+
+#define DXMSG_BACKOFF_MIN_MS 50
+#define DXMSG_BACKOFF_MAX_MS 2000
+#define DXMSG_IDLE_WAIT_US (100 * 1000)
+
+DxMsgSpscQueue::DxMsgSpscQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {
+    size_t slots = 2;
+    while (slots < capacity_)
+        slots <<= 1;
+    slots_.resize(slots);
+    mask_ = slots - 1;
+}
+
+bool DxMsgSpscQueue::push(const DxMsgQueueItem &item) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= capacity_)
+        return false;
+    slots_[tail & mask_] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool DxMsgSpscQueue::pop(DxMsgQueueItem &item) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+        return false;
+    item = slots_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+DxMsgPublisher::DxMsgPublisher(const DxMsgPublisherConfig &config,
+                               const std::string &topic, DxMsg_Bal_Handle_t handle,
+                               ConnectFunc connect, DxMsg_Bal_SendFptr_t send)
+    : config_(config), topic_(topic), handle_(handle), connect_(std::move(connect)),
+      send_(send), queue_(config.max_queue_size) {
+    GST_DEBUG_CATEGORY_INIT(publisher, "dxmsgpublisher", 0,
+                            "dxmsgbroker asynchronous publisher");
+    config_.batch_size = std::max(config_.batch_size, 1u);
+}
+
+DxMsgPublisher::~DxMsgPublisher() {
+    if (thread_)
+        stop();
+}
+
+bool DxMsgPublisher::start(std::string &error) {
+    spill_enabled_ = false;
+    if (!config_.spill_dir.empty()) {
+        if (!spill_.open(config_.spill_dir, config_.spill_segment_size,
+                         config_.spill_max_size, error))
+            return false;
+        spill_enabled_ = true;
+        spill_depth_ = spill_.size();
+    }
+    running_ = true;
+    thread_ = g_thread_new("dxmsgpublisher", thread_func, this);
+    return true;
+}
+
+DxMsg_Bal_Handle_t DxMsgPublisher::stop() {
+    {
+        std::lock_guard<std::mutex> lk(lock_);
+        running_ = false;
+        cond_.notify_all();
+    }
+    if (thread_) {
+        g_thread_join(thread_);
+        thread_ = nullptr;
+    }
+
+    // Whatever is left goes to disk for the next run, or is lost.
+    for (const DxMsgQueueItem &item : pending_) {
+        dropped_++;
+        release(item);
+    }
+    pending_.clear();
+    spill_queued();
+    DxMsgQueueItem item;
+    while (queue_.pop(item)) {
+        dropped_++;
+        release(item);
+    }
+    if (spill_enabled_) {
+        if (spill_.size() > 0)
+            GST_INFO("%" G_GUINT64_FORMAT " messages left in %s", spill_.size(),
+                     config_.spill_dir.c_str());
+        spill_.close();
+    }
+
+    DxMsg_Bal_Handle_t handle = handle_;
+    handle_ = nullptr;
+    return handle;
+}
+
+bool DxMsgPublisher::push(GBytes *payload) {
+    DxMsgQueueItem item = {g_bytes_ref(payload), g_get_monotonic_time()};
+    outstanding_++;
+    if (!queue_.push(item)) {
+        dropped_++;
+        release(item);
+        GST_LOG("Publish queue full, dropping message");
+        return false;
+    }
+    if (waiting_.load()) {
+        std::lock_guard<std::mutex> lk(lock_);
+        cond_.notify_one();
+    }
+    return true;
+}
+
+bool DxMsgPublisher::drain(guint timeout_ms) {
+    gint64 deadline = g_get_monotonic_time() + static_cast<gint64>(timeout_ms) * 1000;
+    while (outstanding_.load() > 0) {
+        if (!running_ || g_get_monotonic_time() >= deadline)
+            return false;
+        g_usleep(2000);
+    }
+    return true;
+}
+
+gpointer DxMsgPublisher::thread_func(gpointer data) {
+    static_cast<DxMsgPublisher *>(data)->run();
+    return nullptr;
+}
+
+void DxMsgPublisher::run() {
+    while (running_) {
+        if (!ensure_connected() || !send_pending() || !send_spilled()) {
+            // Outage: keep the queue free for the pipeline and retry later.
+            spill_queued();
+            backoff();
+            continue;
+        }
+        if (backoff_ms_ > 0) {
+            GST_INFO("Broker reachable again");
+            backoff_ms_ = 0;
+        }
+        if (queue_.size() == 0) {
+            wait_for_work(g_get_monotonic_time() + DXMSG_IDLE_WAIT_US);
+            continue;
+        }
+        send_queued();
+    }
+}
+
+bool DxMsgPublisher::wait_for_work(gint64 deadline_us) {
+    gint64 remaining = deadline_us - g_get_monotonic_time();
+    if (remaining <= 0)
+        return queue_.size() > 0;
+    std::unique_lock<std::mutex> lk(lock_);
+    waiting_ = true;
+    cond_.wait_for(lk, std::chrono::microseconds(remaining),
+                   [this] { return queue_.size() > 0 || !running_; });
+    waiting_ = false;
+    return queue_.size() > 0;
+}
+
+bool DxMsgPublisher::ensure_connected() {
+    if (handle_)
+        return true;
+    if (!connect_)
+        return false;
+    handle_ = connect_();
+    if (handle_)
+        GST_INFO("Reconnected to broker");
+    return handle_ != nullptr;
+}
+
+bool DxMsgPublisher::send(const DxMsgQueueItem &item) {
+    if (send_(handle_, topic_.c_str(), item.payload) != DxMsg_Bal_Error::DXMSG_BAL_OK) {
+        send_failures_++;
+        return false;
+    }
+    record_sent(item.enqueue_time);
+    return true;
+}
+
+bool DxMsgPublisher::send_pending() {
+    while (!pending_.empty()) {
+        if (!send(pending_.front()))
+            return false;
+        release(pending_.front());
+        pending_.pop_front();
+    }
+    return true;
+}
+
+bool DxMsgPublisher::send_spilled() {
+    if (!spill_enabled_)
+        return true;
+    guint sent = 0;
+    while (running_) {
+        GBytes *payload = spill_.peek();
+        if (!payload)
+            break;
+        bool ok = send_(handle_, topic_.c_str(), payload) == DxMsg_Bal_Error::DXMSG_BAL_OK;
+        g_bytes_unref(payload);
+        if (!ok) {
+            send_failures_++;
+            spill_depth_ = spill_.size();
+            return false;
+        }
+        spill_.pop();
+        published_++;
+        // A long replay must not let the memory queue overflow meanwhile;
+        // queued messages are newer, so they go behind the spill.
+        sent++;
+        if (queue_.size() * 2 >= config_.max_queue_size)
+            spill_queued();
+        spill_depth_ = spill_.size();
+    }
+    if (sent > 0)
+        GST_INFO("Replayed %u spilled messages", sent);
+    return spill_.size() == 0;
+}
+
+void DxMsgPublisher::send_queued() {
+    std::vector<DxMsgQueueItem> batch;
+    batch.reserve(config_.batch_size);
+    gint64 deadline = g_get_monotonic_time() + static_cast<gint64>(config_.linger_ms) * 1000;
+    DxMsgQueueItem item;
+    while (batch.size() < config_.batch_size) {
+        if (queue_.pop(item)) {
+            batch.push_back(item);
+            continue;
+        }
+        if (config_.linger_ms == 0 || !wait_for_work(deadline))
+            break;
+    }
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (send(batch[i])) {
+            release(batch[i]);
+            continue;
+        }
+        // Keep the unsent tail ahead of everything newer. With spill it
+        // becomes the head of the (empty) spill ring.
+        for (size_t j = i; j < batch.size(); j++) {
+            if (!spill_enabled_) {
+                pending_.push_back(batch[j]);
+                continue;
+            }
+            if (spill_.push(batch[j].payload))
+                spilled_++;
+            else
+                dropped_++;
+            release(batch[j]);
+        }
+        spill_depth_ = spill_.size();
+        spill_dropped_ = spill_.dropped();
+        GST_WARNING("Broker publish failed, %zu messages held for retry", batch.size() - i);
+        return;
+    }
+}
+
+void DxMsgPublisher::spill_queued() {
+    if (!spill_enabled_)
+        return;
+    DxMsgQueueItem item;
+    while (queue_.pop(item)) {
+        if (spill_.push(item.payload))
+            spilled_++;
+        else
+            dropped_++;
+        release(item);
+    }
+    spill_depth_ = spill_.size();
+    spill_dropped_ = spill_.dropped();
+}
+
+void DxMsgPublisher::backoff() {
+    backoff_ms_ = backoff_ms_ ? std::min(backoff_ms_ * 2, static_cast<guint>(DXMSG_BACKOFF_MAX_MS))
+                              : DXMSG_BACKOFF_MIN_MS;
+    GST_DEBUG("Broker unavailable, retrying in %u ms", backoff_ms_);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(backoff_ms_);
+    // Keep spilling while waiting so the queue never fills up during an outage.
+    auto filling = [this] {
+        return !running_ || (spill_enabled_ && queue_.size() * 2 >= config_.max_queue_size);
+    };
+    while (running_) {
+        bool woken;
+        {
+            std::unique_lock<std::mutex> lk(lock_);
+            waiting_ = true;
+            woken = cond_.wait_until(lk, deadline, filling);
+            waiting_ = false;
+        }
+        if (!woken)
+            break;
+        spill_queued();
+    }
+}
+
+void DxMsgPublisher::record_sent(gint64 enqueue_time) {
+    published_++;
+    auto latency = static_cast<gint64>((g_get_monotonic_time() - enqueue_time) * 1000);
+    auto average = static_cast<gint64>(latency_ns_.load());
+    average = average == 0 ? latency : average + (latency - average) / 16;
+    latency_ns_ = static_cast<guint64>(average);
+    if (static_cast<guint64>(latency) > max_latency_ns_.load())
+        max_latency_ns_ = static_cast<guint64>(latency);
+}
+
+void DxMsgPublisher::release(const DxMsgQueueItem &item) {
+    g_bytes_unref(item.payload);
+    outstanding_--;
+}
@@ -0,0 +1,136 @@
+#ifndef __DX_MSGBROKER_PUBLISHER_H__
+#define __DX_MSGBROKER_PUBLISHER_H__
+
+#include "gst-dxmsgbroker.hpp"
+#include "dx_msgbroker_spill.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct DxMsgQueueItem {
+    GBytes *payload;
+    gint64 enqueue_time; /**< g_get_monotonic_time() at push */
+};
+
+/**
+ * Bounded single-producer single-consumer ring: render() pushes on the
+ * streaming thread, the sender thread pops. Lock-free; the two indices
+ * live on separate cache lines.
+ */
+class DxMsgSpscQueue {
+  public:
+    explicit DxMsgSpscQueue(size_t capacity);
+
+    bool push(const DxMsgQueueItem &item);
+    bool pop(DxMsgQueueItem &item);
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::vector<DxMsgQueueItem> slots_;
+    size_t mask_;
+    size_t capacity_;
+    std::atomic<size_t> head_{0}; /**< next slot to pop (consumer) */
+    char pad_[64];
+    std::atomic<size_t> tail_{0}; /**< next slot to push (producer) */
+};
+
+struct DxMsgPublisherConfig {
+    guint max_queue_size;
+    guint batch_size;          /**< messages sent per sender wakeup */
+    guint linger_ms;           /**< wait for a batch to fill */
+    std::string spill_dir;     /**< empty: no disk spill */
+    guint64 spill_segment_size;
+    guint64 spill_max_size;
+};
+
+/**
+ * Asynchronous publisher behind dxmsgbroker async=true.
+ *
+ * Messages go through DxMsgSpscQueue to a sender thread that publishes them
+ * in batches through the BAL. When sending fails or there is no connection,
+ * the thread retries with backoff (reconnecting if needed) and, with a spill
+ * directory, moves queued messages to DxMsgSpillRing so the queue never
+ * blocks the pipeline. Delivery order is kept: the failed batch, then the
+ * spill, then the queue. Without spill, a full queue drops new messages.
+ */
+class DxMsgPublisher {
+  public:
+    using ConnectFunc = std::function<DxMsg_Bal_Handle_t()>;
+
+    DxMsgPublisher(const DxMsgPublisherConfig &config, const std::string &topic,
+                   DxMsg_Bal_Handle_t handle, ConnectFunc connect,
+                   DxMsg_Bal_SendFptr_t send);
+    ~DxMsgPublisher();
+
+    bool start(std::string &error);
+    /** Stops the sender; unsent messages are spilled or dropped. Returns
+     *  the BAL handle (may be nullptr) for the caller to disconnect. */
+    DxMsg_Bal_Handle_t stop();
+
+    /** Queues a reference to `payload`; false if it was dropped. */
+    bool push(GBytes *payload);
+    /** Waits until everything queued in memory was sent or spilled. */
+    bool drain(guint timeout_ms);
+
+    guint queue_depth() const { return static_cast<guint>(queue_.size()); }
+    guint64 spill_depth() const { return spill_depth_.load(); }
+    guint64 published() const { return published_.load(); }
+    guint64 dropped() const { return dropped_.load() + spill_dropped_.load(); }
+    guint64 spilled() const { return spilled_.load(); }
+    guint64 send_failures() const { return send_failures_.load(); }
+    /** Enqueue-to-sent time, exponential moving average over ~16 messages. */
+    guint64 latency_ns() const { return latency_ns_.load(); }
+    guint64 max_latency_ns() const { return max_latency_ns_.load(); }
+
+  private:
+    static gpointer thread_func(gpointer data);
+    void run();
+    bool wait_for_work(gint64 deadline_us);
+    bool ensure_connected();
+    bool send(const DxMsgQueueItem &item);
+    bool send_pending();
+    bool send_spilled();
+    void send_queued();
+    void spill_queued();
+    void backoff();
+    void record_sent(gint64 enqueue_time);
+    /** Drops the reference of an item leaving memory (sent, spilled, lost). */
+    void release(const DxMsgQueueItem &item);
+
+    DxMsgPublisherConfig config_;
+    std::string topic_;
+    DxMsg_Bal_Handle_t handle_;
+    ConnectFunc connect_;
+    DxMsg_Bal_SendFptr_t send_;
+
+    DxMsgSpscQueue queue_;
+    DxMsgSpillRing spill_;
+    bool spill_enabled_ = false;
+    std::deque<DxMsgQueueItem> pending_; /**< failed batch, sent first */
+
+    GThread *thread_ = nullptr;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> waiting_{false};  /**< sender sleeps on cond_ */
+    std::atomic<guint64> outstanding_{0}; /**< pushed, not yet out of memory */
+    std::mutex lock_;
+    std::condition_variable cond_;
+    guint backoff_ms_ = 0;
+
+    std::atomic<guint64> spill_depth_{0};
+    std::atomic<guint64> published_{0};
+    std::atomic<guint64> dropped_{0};
+    std::atomic<guint64> spill_dropped_{0};
+    std::atomic<guint64> spilled_{0};
+    std::atomic<guint64> send_failures_{0};
+    std::atomic<guint64> latency_ns_{0};
+    std::atomic<guint64> max_latency_ns_{0};
+};
+
+#endif /* __DX_MSGBROKER_PUBLISHER_H__ */
@@ -0,0 +1,285 @@
+#include <gst/gst.h>
+
+#include "dx_msgbroker_spill.hpp"
+
+#include <glib/gstdio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+#ifndef G_OS_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/* debug */
+GST_DEBUG_CATEGORY_STATIC(spill);
+#define GST_CAT_DEFAULT spill
+
+/* Each record: guint32 length, guint32 reserved, data, padded to 8 bytes. */
+static constexpr guint64 RECORD_HEADER_SIZE = 8;
+
+static guint64 record_size(guint64 length) {
+    return RECORD_HEADER_SIZE + ((length + 7) & ~static_cast<guint64>(7));
+}
+
+std::string DxMsgSpillRing::segment_path(guint32 index) const {
+    gchar *name = g_strdup_printf("dxmsg-%08u.spill", index);
+    std::string path = dir_ + G_DIR_SEPARATOR_S + name;
+    g_free(name);
+    return path;
+}
+
+#ifndef G_OS_WIN32
+
+bool DxMsgSpillRing::map_segment(guint32 index, bool create, Segment &seg) {
+    std::string path = segment_path(index);
+    int fd = ::open(path.c_str(), create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+    if (fd < 0) {
+        GST_ERROR("Cannot open spill segment %s: %s", path.c_str(), g_strerror(errno));
+        return false;
+    }
+
+    guint64 size = segment_size_;
+    if (create) {
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            GST_ERROR("Cannot size spill segment %s: %s", path.c_str(), g_strerror(errno));
+            ::close(fd);
+            g_unlink(path.c_str());
+            return false;
+        }
+    } else {
+        off_t end = lseek(fd, 0, SEEK_END);
+        size = end > 0 ? static_cast<guint64>(end) : 0;
+        if (size < sizeof(DxMsgSpillHeader)) {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        GST_ERROR("Cannot map spill segment %s: %s", path.c_str(), g_strerror(errno));
+        ::close(fd);
+        if (create)
+            g_unlink(path.c_str());
+        return false;
+    }
+
+    seg.index = index;
+    seg.fd = fd;
+    seg.base = static_cast<guint8 *>(base);
+    seg.size = size;
+
+    DxMsgSpillHeader *h = header(seg);
+    if (create) {
+        memset(h, 0, sizeof(*h));
+        memcpy(h->magic, DXMSG_SPILL_MAGIC, sizeof(h->magic));
+        h->version = DXMSG_SPILL_VERSION;
+        h->read_offset = sizeof(DxMsgSpillHeader);
+        h->write_offset = sizeof(DxMsgSpillHeader);
+    } else if (memcmp(h->magic, DXMSG_SPILL_MAGIC, sizeof(h->magic)) != 0 ||
+               h->version != DXMSG_SPILL_VERSION ||
+               h->read_offset < sizeof(DxMsgSpillHeader) ||
+               h->read_offset > h->write_offset || h->write_offset > size) {
+        GST_WARNING("Ignoring invalid spill segment %s", path.c_str());
+        munmap(seg.base, seg.size);
+        ::close(fd);
+        return false;
+    }
+    return true;
+}
+
+void DxMsgSpillRing::unmap_segment(const Segment &seg, bool remove_file) {
+    if (!remove_file)
+        msync(seg.base, seg.size, MS_SYNC);
+    munmap(seg.base, seg.size);
+    ::close(seg.fd);
+    if (remove_file)
+        g_unlink(segment_path(seg.index).c_str());
+}
+
+void DxMsgSpillRing::close() {
+    // Unread messages stay on disk for the next run.
+    for (const Segment &seg : segments_)
+        unmap_segment(seg, false);
+    segments_.clear();
+    count_ = 0;
+}
+
+#else /* G_OS_WIN32 */
+
+bool DxMsgSpillRing::map_segment(guint32 index, bool create, Segment &seg) {
+    std::ignore = index;
+    std::ignore = create;
+    std::ignore = seg;
+    return false;
+}
+
+void DxMsgSpillRing::unmap_segment(const Segment &seg, bool remove_file) {
+    std::ignore = seg;
+    std::ignore = remove_file;
+}
+
+void DxMsgSpillRing::close() {
+    segments_.clear();
+    count_ = 0;
+}
+
+#endif /* G_OS_WIN32 */
+
+void DxMsgSpillRing::remove_front() {
+    Segment seg = segments_.front();
+    segments_.pop_front();
+    count_ -= std::min(count_, header(seg)->count);
+    unmap_segment(seg, true);
+}
+
+bool DxMsgSpillRing::open(const std::string &dir, guint64 segment_size,
+                          guint64 max_size, std::string &error) {
+    GST_DEBUG_CATEGORY_INIT(spill, "dxmsgspill", 0, "dxmsgbroker disk spill");
+#ifdef G_OS_WIN32
+    std::ignore = dir;
+    std::ignore = segment_size;
+    std::ignore = max_size;
+    error = "disk spill is not supported on Windows";
+    return false;
+#else
+    close();
+    dir_ = dir;
+    segment_size_ = segment_size;
+    max_size_ = std::max(max_size, segment_size);
+    dropped_ = 0;
+    next_index_ = 0;
+
+    if (g_mkdir_with_parents(dir.c_str(), 0755) != 0) {
+        error = dir + ": " + g_strerror(errno);
+        return false;
+    }
+
+    GDir *d = g_dir_open(dir.c_str(), 0, nullptr);
+    if (!d) {
+        error = dir + ": cannot list directory";
+        return false;
+    }
+    std::vector<guint32> found;
+    while (const gchar *name = g_dir_read_name(d)) {
+        if (!g_str_has_prefix(name, "dxmsg-") || !g_str_has_suffix(name, ".spill"))
+            continue;
+        gchar *end = nullptr;
+        guint64 index = g_ascii_strtoull(name + strlen("dxmsg-"), &end, 10);
+        if (end && g_str_equal(end, ".spill") && index < G_MAXUINT32)
+            found.push_back(static_cast<guint32>(index));
+    }
+    g_dir_close(d);
+    std::sort(found.begin(), found.end());
+
+    // Recover what a previous run left behind, oldest first.
+    for (guint32 index : found) {
+        next_index_ = std::max(next_index_, index + 1);
+        Segment seg;
+        if (!map_segment(index, false, seg))
+            continue;
+        if (header(seg)->count == 0) {
+            unmap_segment(seg, true);
+            continue;
+        }
+        count_ += header(seg)->count;
+        segments_.push_back(seg);
+    }
+    if (count_ > 0)
+        GST_INFO("Recovered %" G_GUINT64_FORMAT " spilled messages from %s", count_,
+                 dir.c_str());
+    return true;
+#endif
+}
+
+bool DxMsgSpillRing::add_segment() {
+    Segment seg;
+    if (!map_segment(next_index_, true, seg))
+        return false;
+    next_index_++;
+    segments_.push_back(seg);
+
+    // Over the limit: recycle the oldest segment, losing its messages.
+    while (segments_.size() > 1 && segments_.size() * segment_size_ > max_size_) {
+        guint64 lost = header(segments_.front())->count;
+        dropped_ += lost;
+        GST_WARNING("Spill ring full, dropping %" G_GUINT64_FORMAT " oldest messages", lost);
+        remove_front();
+    }
+    return true;
+}
+
+bool DxMsgSpillRing::push(GBytes *payload) {
+    gsize length = 0;
+    const void *data = g_bytes_get_data(payload, &length);
+    guint64 needed = record_size(length);
+    if (length > G_MAXUINT32 || needed > segment_size_ - sizeof(DxMsgSpillHeader))
+        return false;
+
+    if (segments_.empty() ||
+        header(segments_.back())->write_offset + needed > segments_.back().size) {
+        if (!add_segment())
+            return false;
+    }
+
+    const Segment &seg = segments_.back();
+    DxMsgSpillHeader *h = header(seg);
+    guint8 *record = seg.base + h->write_offset;
+    auto length32 = static_cast<guint32>(length);
+    memcpy(record, &length32, sizeof(length32));
+    memset(record + sizeof(length32), 0, RECORD_HEADER_SIZE - sizeof(length32));
+    memcpy(record + RECORD_HEADER_SIZE, data, length);
+    // Publish the record only once its bytes are in place.
+    h->write_offset += needed;
+    h->count++;
+    count_++;
+    return true;
+}
+
+GBytes *DxMsgSpillRing::peek() {
+    while (!segments_.empty()) {
+        const Segment &seg = segments_.front();
+        DxMsgSpillHeader *h = header(seg);
+        if (h->read_offset + RECORD_HEADER_SIZE <= h->write_offset) {
+            guint32 length = 0;
+            memcpy(&length, seg.base + h->read_offset, sizeof(length));
+            if (h->read_offset + record_size(length) <= h->write_offset)
+                return g_bytes_new(seg.base + h->read_offset + RECORD_HEADER_SIZE, length);
+            GST_WARNING("Truncated record in spill segment %u, skipping the rest",
+                        seg.index);
+        }
+        if (segments_.size() == 1) {
+            // Keep the writable segment and start it over.
+            h->read_offset = sizeof(DxMsgSpillHeader);
+            h->write_offset = sizeof(DxMsgSpillHeader);
+            count_ -= std::min(count_, h->count);
+            h->count = 0;
+            return nullptr;
+        }
+        remove_front();
+    }
+    return nullptr;
+}
+
+void DxMsgSpillRing::pop() {
+    if (segments_.empty())
+        return;
+    DxMsgSpillHeader *h = header(segments_.front());
+    if (h->read_offset + RECORD_HEADER_SIZE > h->write_offset)
+        return;
+    guint32 length = 0;
+    memcpy(&length, segments_.front().base + h->read_offset, sizeof(length));
+    h->read_offset += record_size(length);
+    if (h->count > 0)
+        h->count--;
+    if (count_ > 0)
+        count_--;
+    if (h->read_offset >= h->write_offset && segments_.size() > 1)
+        remove_front();
+}
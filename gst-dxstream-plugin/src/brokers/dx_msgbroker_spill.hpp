@@ -0,0 +1,83 @@
+#ifndef __DX_MSGBROKER_SPILL_H__
+#define __DX_MSGBROKER_SPILL_H__
+
+#include <glib.h>
+
+#include <deque>
+#include <string>
+
+/**
+ * On-disk FIFO of broker messages kept while the broker is unreachable.
+ *
+ * Messages are appended to memory-mapped segment files
+ * (<dir>/dxmsg-NNNNNNNN.spill) and read back in the same order. A segment
+ * is deleted once fully read; when the ring exceeds its maximum size the
+ * oldest segment is recycled and its messages are counted as dropped.
+ * Segments left by a previous run are picked up again by open(), so a
+ * restart does not lose what was spilled.
+ *
+ * Not thread-safe: used by the publisher's sender thread only.
+ */
+
+#define DXMSG_SPILL_MAGIC "DXSPILL\0"
+#define DXMSG_SPILL_VERSION 1
+
+struct DxMsgSpillHeader {
+    char magic[8];
+    guint32 version;
+    guint32 reserved;
+    guint64 read_offset;   /**< next record to read */
+    guint64 write_offset;  /**< end of the last record */
+    guint64 count;         /**< records not read yet */
+    guint8 pad[24];
+};
+
+class DxMsgSpillRing {
+  public:
+    DxMsgSpillRing() = default;
+    DxMsgSpillRing(const DxMsgSpillRing &) = delete;
+    DxMsgSpillRing &operator=(const DxMsgSpillRing &) = delete;
+    ~DxMsgSpillRing() { close(); }
+
+    /** Creates `dir` if needed and recovers segments found there. */
+    bool open(const std::string &dir, guint64 segment_size, guint64 max_size,
+              std::string &error);
+    void close();
+
+    /** Appends a copy of `payload`; false if it cannot be stored. */
+    bool push(GBytes *payload);
+    /** Oldest message (new reference), nullptr when empty. */
+    GBytes *peek();
+    /** Removes the message returned by peek(). */
+    void pop();
+
+    guint64 size() const { return count_; }
+    guint64 dropped() const { return dropped_; }
+
+  private:
+    struct Segment {
+        guint32 index;
+        int fd;
+        guint8 *base;
+        guint64 size;
+    };
+
+    static DxMsgSpillHeader *header(const Segment &seg) {
+        return reinterpret_cast<DxMsgSpillHeader *>(seg.base);
+    }
+    std::string segment_path(guint32 index) const;
+    bool map_segment(guint32 index, bool create, Segment &seg);
+    void unmap_segment(const Segment &seg, bool remove_file);
+    bool add_segment();
+    void remove_front();
+
+    std::deque<Segment> segments_;
+    std::string dir_;
+    guint64 segment_size_ = 0;
+    guint64 max_size_ = 0;
+    guint32 next_index_ = 0;
+    guint64 count_ = 0;
+    guint64 dropped_ = 0;
+};
+
+#endif /* __DX_MSGBROKER_SPILL_H__ */
@@ -172,6 +172,9 @@ static void dr_msg_cb(rd_kafka_t *rk, const rd_kafka_message_t *rkmessage,
                       void *opaque) {
     std::ignore = rk;
     std::ignore = opaque;
+    /* release the payload reference taken in dxmsg_bal_send_kafka */
+    if (rkmessage->_private)
+        g_bytes_unref(static_cast<GBytes *>(rkmessage->_private));
     if (rkmessage->err)
         GST_WARNING("Message delivery failed: %s",
                     rd_kafka_err2str(rkmessage->err));
@@ -279,24 +282,30 @@ DxMsg_Bal_Handle_t dxmsg_bal_connect_kafka(char *conn_info, char *cfg_path) {
 }
 
 DxMsg_Bal_Error_t dxmsg_bal_send_kafka(DxMsg_Bal_Handle_t handle, const char *topic,
-                                       const void *payload, int payload_len) {
+                                       GBytes *payload) {
     auto *pClient = (KafkaClientInfo_t *)handle;
     DxMsg_Bal_Error_t balError = DxMsg_Bal_Error::DXMSG_BAL_OK;
     rd_kafka_resp_err_t err; /* Error code */
+    gsize payload_len = payload ? g_bytes_get_size(payload) : 0;
 
     GST_TRACE("|JCP|");
     if (pClient == nullptr || topic == nullptr || payload == nullptr ||
-        payload_len <= 0) {
+        payload_len == 0) {
         GST_ERROR("Error, Failed to publish message: %s", "Invalid argument");
         return DxMsg_Bal_Error::DXMSG_BAL_ERR_INVALID;
     }
 
+    /* No RD_KAFKA_MSG_F_COPY: librdkafka sends straight from the payload,
+     * which stays referenced until dr_msg_cb reports the delivery. */
+    GBytes *ref = g_bytes_ref(payload);
     err = rd_kafka_producev(
         pClient->_rk, RD_KAFKA_V_TOPIC(topic),
-        RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
-        RD_KAFKA_V_VALUE((void *)payload, payload_len),
-        RD_KAFKA_V_OPAQUE(nullptr), RD_KAFKA_V_END);
+        RD_KAFKA_V_MSGFLAGS(0),
+        RD_KAFKA_V_VALUE(const_cast<void *>(g_bytes_get_data(payload, nullptr)),
+                         payload_len),
+        RD_KAFKA_V_OPAQUE(ref), RD_KAFKA_V_END);
     if (err) {
+        g_bytes_unref(ref);
         if (err == RD_KAFKA_RESP_ERR__QUEUE_FULL) {
             GST_WARNING("Queue full, discarding message...");
             // rd_kafka_poll(pClient->_rk, 1000);  //for events callbacks
@@ -305,7 +314,7 @@ DxMsg_Bal_Error_t dxmsg_bal_send_kafka(DxMsg_Bal_Handle_t handle, const char *to
                       rd_kafka_err2str(err));
         }
     } else {
-        GST_INFO("Produced message (%d bytes)", payload_len);
+        GST_INFO("Produced message (%" G_GSIZE_FORMAT " bytes)", payload_len);
     }
 
     /* A producer application should continually serve
@@ -337,6 +346,15 @@ DxMsg_Bal_Error_t dxmsg_bal_disconnect_kafka(DxMsg_Bal_Handle_t handle) {
     /* Wait for messages to be delivered */
     rd_kafka_flush(pClient->_rk, 10000);
 
+#if RD_KAFKA_VERSION >= 0x010000ff
+    /* Drop what is still queued; the delivery reports release the payloads. */
+    if (rd_kafka_outq_len(pClient->_rk) > 0) {
+        GST_WARNING("Dropping %d undelivered messages", rd_kafka_outq_len(pClient->_rk));
+        rd_kafka_purge(pClient->_rk, RD_KAFKA_PURGE_F_QUEUE | RD_KAFKA_PURGE_F_INFLIGHT);
+        rd_kafka_poll(pClient->_rk, 0);
+    }
+#endif
+
     /* Destroy Kafka producer instance */
     rd_kafka_destroy(pClient->_rk);
 
@@ -5,7 +5,7 @@
 
 DxMsg_Bal_Handle_t dxmsg_bal_connect_kafka(char *conn_info, char *cfg_file);
 DxMsg_Bal_Error_t dxmsg_bal_send_kafka(DxMsg_Bal_Handle_t handle, const char *topic,
-                                       const void *payload, int payload_len);
+                                       GBytes *payload);
 DxMsg_Bal_Error_t dxmsg_bal_disconnect_kafka(DxMsg_Bal_Handle_t handle);
 
 #endif /* __DX_MSGBROKERL_KAFKA_H__ */
\ No newline at end of file
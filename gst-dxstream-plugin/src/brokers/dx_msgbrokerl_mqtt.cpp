@@ -312,15 +312,16 @@ DxMsg_Bal_Handle_t dxmsg_bal_connect_mqtt(char *conn_info, char *cfg_path) {
 }
 
 DxMsg_Bal_Error_t dxmsg_bal_send_mqtt(DxMsg_Bal_Handle_t handle, const char *topic,
-                                      const void *payload, int payload_len) {
+                                      GBytes *payload) {
     auto *pClient = (MqttClientInfo_t *)handle;
     DxMsg_Bal_Error_t balError = DxMsg_Bal_Error::DXMSG_BAL_OK;
     int rc;
+    gsize payload_len = payload ? g_bytes_get_size(payload) : 0;
 
     GST_TRACE("|JCP|");
 
     if (pClient == nullptr || topic == nullptr || payload == nullptr ||
-        payload_len <= 0) {
+        payload_len == 0 || payload_len > G_MAXINT) {
         GST_ERROR("Error, Failed to publish message: %s", "Invalid argument");
         return DxMsg_Bal_Error::DXMSG_BAL_ERR_INVALID;
     }
@@ -331,14 +332,15 @@ DxMsg_Bal_Error_t dxmsg_bal_send_mqtt(DxMsg_Bal_Handle_t handle, const char *top
         return DxMsg_Bal_Error::DXMSG_BAL_ERR_BROKER;
     }
 
-    rc = mosquitto_publish(pClient->_mosq, nullptr, topic, payload_len, payload,
-                           0, false);
+    /* mosquitto copies the payload into its packet: the only copy made. */
+    rc = mosquitto_publish(pClient->_mosq, nullptr, topic, (int)payload_len,
+                           g_bytes_get_data(payload, nullptr), 0, false);
     if (rc != MOSQ_ERR_SUCCESS) {
         GST_ERROR("Error, Failed to publish message: %s",
                   mosquitto_strerror(rc));
         balError = DxMsg_Bal_Error::DXMSG_BAL_ERR_BROKER;
     } else {
-        GST_INFO("Publish message (%d bytes)", payload_len);
+        GST_INFO("Publish message (%" G_GSIZE_FORMAT " bytes)", payload_len);
     }
 
     return balError;
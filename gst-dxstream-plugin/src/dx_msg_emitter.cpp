@@ -0,0 +1,204 @@
+#include "dx_msg_emitter.hpp"
+#include "dx_json_writer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dxs {
+
+static bool box_moved(const std::array<float, 4> &a, const std::array<float, 4> &b,
+                      float threshold) {
+    float dx = threshold * std::max(a[2] - a[0], 1.0f);
+    float dy = threshold * std::max(a[3] - a[1], 1.0f);
+    return std::fabs(a[0] - b[0]) > dx || std::fabs(a[2] - b[2]) > dx ||
+           std::fabs(a[1] - b[1]) > dy || std::fabs(a[3] - b[3]) > dy;
+}
+
+bool StreamEmitState::changed(const std::vector<EmitObject> &objects, float threshold) {
+    bool differs = !emitted_any_;
+    size_t tracked = 0;
+    std::map<int, guint> untracked;
+    for (const EmitObject &obj : objects) {
+        if (obj.track_id < 0) {
+            untracked[obj.label]++;
+            continue;
+        }
+        tracked++;
+        if (differs)
+            continue;
+        auto it = emitted_.find(obj.track_id);
+        differs = it == emitted_.end() || it->second.label != obj.label ||
+                  box_moved(it->second.box, obj.box, threshold);
+    }
+    differs = differs || tracked != emitted_.size() || untracked != emitted_untracked_;
+    if (!differs)
+        return false;
+
+    emitted_any_ = true;
+    emitted_.clear();
+    for (const EmitObject &obj : objects) {
+        if (obj.track_id >= 0)
+            emitted_[obj.track_id] = {obj.label, obj.box};
+    }
+    emitted_untracked_.swap(untracked);
+    return true;
+}
+
+void StreamEmitState::track(const std::vector<EmitObject> &objects, gint64 now_ns,
+                            gint64 timeout_ns, gint64 dwell_ns,
+                            std::vector<TrackEvent> &events) {
+    if (now_ns < last_ns_)
+        tracks_.clear();
+    last_ns_ = now_ns;
+
+    for (const EmitObject &obj : objects) {
+        if (obj.track_id < 0)
+            continue;
+        auto it = tracks_.find(obj.track_id);
+        if (it == tracks_.end()) {
+            Track t = {obj.label, obj.name ? *obj.name : std::string(), obj.box,
+                       now_ns, now_ns, false};
+            it = tracks_.emplace(obj.track_id, std::move(t)).first;
+            events.push_back({TrackEventType::ENTER, obj.track_id, obj.label,
+                              it->second.name, obj.box, 0.0});
+        }
+        Track &t = it->second;
+        t.label = obj.label;
+        t.box = obj.box;
+        t.seen_ns = now_ns;
+        if (dwell_ns > 0 && !t.dwelled && now_ns - t.enter_ns >= dwell_ns) {
+            t.dwelled = true;
+            events.push_back({TrackEventType::DWELL, obj.track_id, t.label, t.name, t.box,
+                              (now_ns - t.enter_ns) / 1e9});
+        }
+    }
+
+    for (auto it = tracks_.begin(); it != tracks_.end();) {
+        const Track &t = it->second;
+        if (now_ns - t.seen_ns <= timeout_ns) {
+            ++it;
+            continue;
+        }
+        events.push_back({TrackEventType::EXIT, it->first, t.label, t.name, t.box,
+                          (t.seen_ns - t.enter_ns) / 1e9});
+        it = tracks_.erase(it);
+    }
+}
+
+void StreamEmitState::flush_tracks(std::vector<TrackEvent> &events) {
+    for (const auto &entry : tracks_) {
+        const Track &t = entry.second;
+        events.push_back({TrackEventType::EXIT, entry.first, t.label, t.name, t.box,
+                          (t.seen_ns - t.enter_ns) / 1e9});
+    }
+    tracks_.clear();
+}
+
+void StreamEmitState::close_window(std::vector<ClassCount> &counts, gint64 &start_ns) {
+    counts.clear();
+    for (const auto &entry : window_) {
+        counts.push_back({entry.first, entry.second.name,
+                          static_cast<guint>(entry.second.tracks.size()), entry.second.max});
+    }
+    start_ns = window_start_ns_;
+    window_.clear();
+    window_start_ns_ = -1;
+}
+
+bool StreamEmitState::count(const std::vector<EmitObject> &objects, gint64 now_ns,
+                            gint64 window_ns, std::vector<ClassCount> &counts,
+                            gint64 &start_ns) {
+    bool closed = false;
+    if (window_start_ns_ >= 0 &&
+        (now_ns - window_start_ns_ >= window_ns || now_ns < window_start_ns_)) {
+        close_window(counts, start_ns);
+        closed = true;
+    }
+    if (window_start_ns_ < 0)
+        window_start_ns_ = now_ns;
+    window_last_ns_ = now_ns;
+
+    std::map<int, guint> frame_counts;
+    for (const EmitObject &obj : objects) {
+        ClassWindow &w = window_[obj.label];
+        if (w.name.empty() && obj.name)
+            w.name = *obj.name;
+        if (obj.track_id >= 0)
+            w.tracks.insert(obj.track_id);
+        frame_counts[obj.label]++;
+    }
+    for (const auto &entry : frame_counts) {
+        ClassWindow &w = window_[entry.first];
+        w.max = std::max(w.max, entry.second);
+    }
+    return closed;
+}
+
+bool StreamEmitState::flush_count(std::vector<ClassCount> &counts, gint64 &start_ns,
+                                  gint64 &end_ns) {
+    if (window_start_ns_ < 0)
+        return false;
+    end_ns = window_last_ns_;
+    close_window(counts, start_ns);
+    return true;
+}
+
+// -- messages ---------------------------------------------------------------
+
+static void begin_message(DxJsonWriter &w, int stream_id, guint64 seq_id) {
+    w.begin_object();
+    w.member("streamId", stream_id);
+    w.member("seqId", seq_id);
+}
+
+GBytes *track_events_message(int stream_id, guint64 seq_id,
+                             const std::vector<TrackEvent> &events) {
+    static const char *names[] = {"enter", "exit", "dwell"};
+    DxMsgArena arena;
+    DxJsonWriter w(arena);
+    begin_message(w, stream_id, seq_id);
+    w.key("events");
+    w.begin_array();
+    for (const TrackEvent &e : events) {
+        w.begin_object();
+        w.member("event", names[static_cast<int>(e.type)]);
+        w.member("track_id", e.track_id);
+        w.member("label_id", e.label);
+        w.key("name");
+        w.value(e.name.data(), e.name.size());
+        w.member("box", e.box);
+        w.member("duration", e.duration);
+        w.end_object();
+    }
+    w.end_array();
+    w.end_object();
+    return arena.take_bytes();
+}
+
+GBytes *class_counts_message(int stream_id, guint64 seq_id, gint64 start_ns, gint64 end_ns,
+                             const std::vector<ClassCount> &counts) {
+    DxMsgArena arena;
+    DxJsonWriter w(arena);
+    begin_message(w, stream_id, seq_id);
+    w.key("window");
+    w.begin_object();
+    w.member("start", start_ns / 1e9);
+    w.member("end", end_ns / 1e9);
+    w.end_object();
+    w.key("counts");
+    w.begin_array();
+    for (const ClassCount &c : counts) {
+        w.begin_object();
+        w.member("label_id", c.label);
+        w.key("name");
+        w.value(c.name.data(), c.name.size());
+        w.member<gint64>("tracks", c.tracks);
+        w.member<gint64>("max", c.max);
+        w.end_object();
+    }
+    w.end_array();
+    w.end_object();
+    return arena.take_bytes();
+}
+
+} // namespace dxs
@@ -0,0 +1,126 @@
+#ifndef DX_MSG_EMITTER_HPP
+#define DX_MSG_EMITTER_HPP
+
+#include <glib.h>
+
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Emission policies for dxmsgconv (emit-mode)
+// ---------------------------------------------------------------------------
+// StreamEmitState keeps what one stream has sent so far, keyed by track_id,
+// and decides from it whether a frame needs a message:
+//   on-change  the full message, only when tracks or labels change or a box
+//              moves by more than a fraction of its size
+//   events     enter / exit / dwell events per track
+//   counts     objects per class over a time window
+// Times are in nanoseconds (buffer PTS).
+
+namespace dxs {
+
+struct EmitObject {
+    int track_id;             /**< < 0: untracked */
+    int label;
+    const std::string *name;  /**< valid during the call */
+    std::array<float, 4> box; /**< startX, startY, endX, endY */
+};
+
+enum class TrackEventType { ENTER, EXIT, DWELL };
+
+struct TrackEvent {
+    TrackEventType type;
+    int track_id;
+    int label;
+    std::string name;
+    std::array<float, 4> box;  /**< last known box */
+    double duration;           /**< seconds since the track entered */
+};
+
+struct ClassCount {
+    int label;
+    std::string name;
+    guint tracks;              /**< distinct track_ids in the window */
+    guint max;                 /**< most objects in a single frame */
+};
+
+class StreamEmitState {
+  public:
+    /** on-change: true if `objects` differ from the last frame that returned
+     *  true, which they then replace. Untracked objects only count per
+     *  label. `threshold` is the box movement, relative to its size, that
+     *  counts as a change. */
+    bool changed(const std::vector<EmitObject> &objects, float threshold);
+
+    /** events: updates the tracks with one frame and appends what happened.
+     *  A track exits after `timeout_ns` unseen; it dwells (once) after
+     *  `dwell_ns` (0: never). Time going backwards (seek, loop) forgets all
+     *  tracks without events. */
+    void track(const std::vector<EmitObject> &objects, gint64 now_ns, gint64 timeout_ns,
+               gint64 dwell_ns, std::vector<TrackEvent> &events);
+
+    /** counts: adds one frame to the window. When the window of `window_ns`
+     *  was already complete, it is returned in `counts` / `start_ns` first
+     *  and a new window starts with this frame. */
+    bool count(const std::vector<EmitObject> &objects, gint64 now_ns, gint64 window_ns,
+               std::vector<ClassCount> &counts, gint64 &start_ns);
+
+    /** End of stream, events: appends an exit event for every live track
+     *  and forgets them. */
+    void flush_tracks(std::vector<TrackEvent> &events);
+
+    /** End of stream, counts: returns the open window, ending at the last
+     *  counted frame, in `counts` / `start_ns` / `end_ns`. False if there
+     *  is none. */
+    bool flush_count(std::vector<ClassCount> &counts, gint64 &start_ns, gint64 &end_ns);
+
+  private:
+    void close_window(std::vector<ClassCount> &counts, gint64 &start_ns);
+
+    struct Emitted {
+        int label;
+        std::array<float, 4> box;
+    };
+    struct Track {
+        int label;
+        std::string name;
+        std::array<float, 4> box;
+        gint64 enter_ns;
+        gint64 seen_ns;
+        bool dwelled;
+    };
+    struct ClassWindow {
+        std::string name;
+        std::set<int> tracks;
+        guint max = 0;
+    };
+
+    bool emitted_any_ = false;
+    std::unordered_map<int, Emitted> emitted_;
+    std::map<int, guint> emitted_untracked_;   /**< label -> count */
+
+    std::unordered_map<int, Track> tracks_;
+    gint64 last_ns_ = -1;
+
+    gint64 window_start_ns_ = -1;
+    gint64 window_last_ns_ = -1;
+    std::map<int, ClassWindow> window_;
+};
+
+/** {"streamId","seqId","events":[{"event","track_id","label_id","name",
+ *  "box","duration"}, ...]} */
+GBytes *track_events_message(int stream_id, guint64 seq_id,
+                             const std::vector<TrackEvent> &events);
+
+/** {"streamId","seqId","window":{"start","end"},"counts":[{"label_id",
+ *  "name","tracks","max"}, ...]}, times in seconds */
+GBytes *class_counts_message(int stream_id, guint64 seq_id, gint64 start_ns, gint64 end_ns,
+                             const std::vector<ClassCount> &counts);
+
+} // namespace dxs
+
+#endif // DX_MSG_EMITTER_HPP
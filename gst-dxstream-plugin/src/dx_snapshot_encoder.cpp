@@ -0,0 +1,232 @@
+#include "dx_snapshot_encoder.hpp"
+#include "dx_json_writer.hpp"
+
+#include <libyuv.h>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#ifdef HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+
+#include <algorithm>
+
+namespace dxs {
+
+void snapshot_size(int src_w, int src_h, int width, int height, int &out_w, int &out_h) {
+    out_w = 0;
+    out_h = 0;
+    if (src_w < 2 || src_h < 2)
+        return;
+    double w = src_w;
+    double h = src_h;
+    if (width > 0 && height > 0) {
+        w = width;
+        h = height;
+    } else if (width > 0) {
+        w = width;
+        h = static_cast<double>(src_h) * width / src_w;
+    } else if (height > 0) {
+        h = height;
+        w = static_cast<double>(src_w) * height / src_h;
+    }
+    out_w = std::max(2, std::min(static_cast<int>(w + 0.5), src_w) & ~1);
+    out_h = std::max(2, std::min(static_cast<int>(h + 0.5), src_h) & ~1);
+}
+
+bool snapshot_capture(const dxt::FrameDesc &src, const dxt::CropRect &roi,
+                      int out_w, int out_h, SnapshotImage &out) {
+    const dxt::PlaneDesc &py = src.planes[0];
+    if (!py.data || out_w < 2 || out_h < 2)
+        return false;
+
+    int x = 0, y = 0, w = src.width, h = src.height;
+    if (roi.enabled) {
+        x = std::max(0, std::min(roi.x, src.width - 1));
+        y = std::max(0, std::min(roi.y, src.height - 1));
+        w = std::min(roi.w, src.width - x);
+        h = std::min(roi.h, src.height - y);
+    }
+
+    out.width = out_w;
+    out.height = out_h;
+
+    switch (src.format) {
+    case dxt::VideoFormat::I420:
+    case dxt::VideoFormat::NV12: {
+        // Chroma is subsampled: start the region on an even pixel.
+        w += x & 1;
+        h += y & 1;
+        x &= ~1;
+        y &= ~1;
+        if (w < 2 || h < 2)
+            return false;
+
+        int cw = out_w / 2, ch = out_h / 2;
+        out.format = dxt::VideoFormat::I420;
+        out.data.resize(static_cast<size_t>(out_w) * out_h + 2 * static_cast<size_t>(cw) * ch);
+        uint8_t *dy = out.data.data();
+        uint8_t *du = dy + static_cast<size_t>(out_w) * out_h;
+        uint8_t *dv = du + static_cast<size_t>(cw) * ch;
+        const uint8_t *sy = py.data + static_cast<size_t>(y) * py.stride + x;
+        const dxt::PlaneDesc &p1 = src.planes[1];
+
+        if (src.format == dxt::VideoFormat::I420) {
+            const dxt::PlaneDesc &p2 = src.planes[2];
+            const uint8_t *su = p1.data + static_cast<size_t>(y / 2) * p1.stride + x / 2;
+            const uint8_t *sv = p2.data + static_cast<size_t>(y / 2) * p2.stride + x / 2;
+            return libyuv::I420Scale(sy, py.stride, su, p1.stride, sv, p2.stride, w, h,
+                                     dy, out_w, du, cw, dv, cw, out_w, out_h,
+                                     libyuv::kFilterBox) == 0;
+        }
+
+        const uint8_t *suv = p1.data + static_cast<size_t>(y / 2) * p1.stride + x;
+        if (w == out_w && h == out_h)
+            return libyuv::NV12ToI420(sy, py.stride, suv, p1.stride, dy, out_w,
+                                      du, cw, dv, cw, out_w, out_h) == 0;
+        // Scale with UV still interleaved; only the small result is split.
+        static thread_local std::vector<uint8_t> uv;
+        uv.resize(static_cast<size_t>(cw) * ch * 2);
+        if (libyuv::NV12Scale(sy, py.stride, suv, p1.stride, w, h, dy, out_w,
+                              uv.data(), cw * 2, out_w, out_h, libyuv::kFilterBox) != 0)
+            return false;
+        libyuv::SplitUVPlane(uv.data(), cw * 2, du, cw, dv, cw, cw, ch);
+        return true;
+    }
+    case dxt::VideoFormat::RGB:
+    case dxt::VideoFormat::BGR: {
+        if (w < 1 || h < 1)
+            return false;
+        out.format = src.format;
+        out.data.resize(static_cast<size_t>(out_w) * out_h * 3);
+        cv::Mat frame(src.height, src.width, CV_8UC3, py.data, py.stride);
+        cv::Mat region = frame(cv::Rect(x, y, w, h));
+        cv::Mat dst(out_h, out_w, CV_8UC3, out.data.data());
+        if (w == out_w && h == out_h)
+            region.copyTo(dst);
+        else
+            cv::resize(region, dst, dst.size(), 0, 0, cv::INTER_AREA);
+        return true;
+    }
+    }
+    return false;
+}
+
+SnapshotJpegEncoder::SnapshotJpegEncoder() {
+#ifdef HAVE_TURBOJPEG
+    handle_ = tjInitCompress();
+#endif
+}
+
+SnapshotJpegEncoder::~SnapshotJpegEncoder() {
+#ifdef HAVE_TURBOJPEG
+    if (tj_buf_)
+        tjFree(tj_buf_);
+    if (handle_)
+        tjDestroy(static_cast<tjhandle>(handle_));
+#endif
+}
+
+gchar *SnapshotJpegEncoder::encode_base64(const SnapshotImage &image, int quality) {
+    int w = image.width, h = image.height;
+    if (w < 2 || h < 2 || image.data.empty())
+        return nullptr;
+
+#ifdef HAVE_TURBOJPEG
+    if (handle_) {
+        auto handle = static_cast<tjhandle>(handle_);
+        unsigned long need = tjBufSize(w, h, TJSAMP_420);
+        if (need > tj_size_) {
+            if (tj_buf_)
+                tjFree(tj_buf_);
+            tj_buf_ = tjAlloc(static_cast<int>(need));
+            tj_size_ = tj_buf_ ? need : 0;
+        }
+        unsigned long size = tj_size_;
+        int flags = TJFLAG_NOREALLOC | TJFLAG_FASTDCT;
+        int rc;
+        if (image.format == dxt::VideoFormat::I420) {
+            const unsigned char *y = image.data.data();
+            const unsigned char *planes[3] = {y, y + w * h, y + w * h + (w / 2) * (h / 2)};
+            rc = tjCompressFromYUVPlanes(handle, planes, w, nullptr, h, TJSAMP_420,
+                                         &tj_buf_, &size, quality, flags);
+        } else {
+            int pixel_format = image.format == dxt::VideoFormat::RGB ? TJPF_RGB : TJPF_BGR;
+            rc = tjCompress2(handle, image.data.data(), w, 0, h, pixel_format, &tj_buf_,
+                             &size, TJSAMP_420, quality, flags);
+        }
+        if (rc == 0 && size > 0)
+            return g_base64_encode(tj_buf_, size);
+        return nullptr;
+    }
+#endif
+
+    // OpenCV expects BGR.
+    auto *data = const_cast<uint8_t *>(image.data.data());
+    cv::Mat bgr;
+    switch (image.format) {
+    case dxt::VideoFormat::I420:
+        cv::cvtColor(cv::Mat(h * 3 / 2, w, CV_8UC1, data), bgr, cv::COLOR_YUV2BGR_I420);
+        break;
+    case dxt::VideoFormat::RGB:
+        cv::cvtColor(cv::Mat(h, w, CV_8UC3, data), bgr, cv::COLOR_RGB2BGR);
+        break;
+    case dxt::VideoFormat::BGR:
+        bgr = cv::Mat(h, w, CV_8UC3, data);
+        break;
+    default:
+        return nullptr;
+    }
+    const std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, quality};
+    buf_.clear();
+    if (!cv::imencode(".jpg", bgr, buf_, params) || buf_.empty())
+        return nullptr;
+    return g_base64_encode(buf_.data(), buf_.size());
+}
+
+GBytes *snapshot_message(const SnapshotJob &job, SnapshotJpegEncoder &encoder, int quality) {
+    DxMsgArena arena;
+    DxJsonWriter w(arena);
+    w.begin_object();
+    w.member("streamId", job.stream_id);
+    w.member("seqId", job.seq_id);
+
+    if (!job.crops) {
+        gchar *data = encoder.encode_base64(job.frame, quality);
+        if (!data)
+            return nullptr;
+        w.key("snapshot");
+        w.begin_object();
+        w.member("width", job.frame.width);
+        w.member("height", job.frame.height);
+        w.member("frameData", static_cast<const char *>(data));
+        w.end_object();
+        g_free(data);
+    } else {
+        w.key("crops");
+        w.begin_array();
+        int count = 0;
+        for (const SnapshotCrop &crop : job.crop_list) {
+            gchar *data = encoder.encode_base64(crop.image, quality);
+            if (!data)
+                continue;
+            w.begin_object();
+            w.member("label_id", crop.label_id);
+            w.member("track_id", crop.track_id);
+            w.member("box", crop.box);
+            w.member("width", crop.image.width);
+            w.member("height", crop.image.height);
+            w.member("data", static_cast<const char *>(data));
+            w.end_object();
+            g_free(data);
+            count++;
+        }
+        if (count == 0)
+            return nullptr;
+        w.end_array();
+    }
+    w.end_object();
+    return arena.take_bytes();
+}
+
+} // namespace dxs
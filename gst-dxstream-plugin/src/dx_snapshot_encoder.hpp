@@ -0,0 +1,126 @@
+#ifndef DX_SNAPSHOT_ENCODER_HPP
+#define DX_SNAPSHOT_ENCODER_HPP
+
+#include "video_transform_kernel.hpp"
+#include <glib.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Frame snapshots for dxmsgconv (include-frame)
+// ---------------------------------------------------------------------------
+// A snapshot is taken in two steps. snapshot_capture() runs on the streaming
+// thread and only copies the wanted region, scaled to the output size, out
+// of the frame: one libyuv pass for NV12/I420, which stay YUV. JPEG and
+// base64 encoding then run on the caller (synchronous mode) or on the
+// SnapshotEncoder worker pool, so the GstBuffer is never held by a worker.
+
+namespace dxs {
+
+/** Job-owned copy of a frame region: tightly packed I420, or packed RGB/BGR. */
+struct SnapshotImage {
+    int width = 0;
+    int height = 0;
+    dxt::VideoFormat format = dxt::VideoFormat::I420;
+    std::vector<uint8_t> data;
+};
+
+/** Output size for a `src_w` x `src_h` region. A `width` or `height` of 0
+ *  follows the aspect ratio, both 0 keep the source size; the result never
+ *  exceeds the source and is even (JPEG 4:2:0). */
+void snapshot_size(int src_w, int src_h, int width, int height, int &out_w, int &out_h);
+
+/** Copies `roi` of `src` (CPU memory) scaled to out_w x out_h into `out`.
+ *  NV12 and I420 become I420, RGB and BGR stay packed. */
+bool snapshot_capture(const dxt::FrameDesc &src, const dxt::CropRect &roi,
+                      int out_w, int out_h, SnapshotImage &out);
+
+/** JPEG + base64 encoder, one per thread. With libjpeg-turbo (HAVE_TURBOJPEG)
+ *  I420 images are compressed straight from their planes; otherwise they
+ *  go through OpenCV. */
+class SnapshotJpegEncoder {
+  public:
+    SnapshotJpegEncoder();
+    ~SnapshotJpegEncoder();
+    SnapshotJpegEncoder(const SnapshotJpegEncoder &) = delete;
+    SnapshotJpegEncoder &operator=(const SnapshotJpegEncoder &) = delete;
+
+    /** Returns the base64 JPEG (g_free), or nullptr on failure. */
+    gchar *encode_base64(const SnapshotImage &image, int quality);
+
+  private:
+    void *handle_ = nullptr;        /**< tjhandle */
+    unsigned char *tj_buf_ = nullptr;
+    unsigned long tj_size_ = 0;
+    std::vector<unsigned char> buf_;
+};
+
+struct SnapshotCrop {
+    int track_id = -1;
+    int label_id = -1;
+    std::array<float, 4> box = {}; /**< startX, startY, endX, endY */
+    SnapshotImage image;
+};
+
+/** Everything a follow-up snapshot message is built from. */
+struct SnapshotJob {
+    int stream_id = 0;
+    guint64 seq_id = 0;
+    bool crops = false;            /**< crop thumbnails instead of `frame` */
+    SnapshotImage frame;
+    std::vector<SnapshotCrop> crop_list;
+};
+
+/** Encodes `job` into its follow-up JSON message:
+ *    {"streamId","seqId","snapshot":{"width","height","frameData"}}  or
+ *    {"streamId","seqId","crops":[{"label_id","track_id","box",
+ *                                  "width","height","data"}, ...]}
+ *  Returns nullptr if nothing could be encoded. */
+GBytes *snapshot_message(const SnapshotJob &job, SnapshotJpegEncoder &encoder, int quality);
+
+/**
+ * Worker pool behind dxmsgconv snapshot-async=true. submit() never blocks:
+ * with `max_pending` jobs queued or encoding, new jobs are dropped. Finished
+ * messages are collected by take_finished() on the streaming thread.
+ */
+class SnapshotEncoder {
+  public:
+    SnapshotEncoder(guint workers, guint max_pending, int quality);
+    ~SnapshotEncoder();
+
+    /** Queues `job`; false if it was dropped. */
+    bool submit(std::unique_ptr<SnapshotJob> job);
+    /** Moves out finished messages (caller owns the references). */
+    std::vector<GBytes *> take_finished();
+    /** Blocks until every submitted job has been encoded. */
+    void drain();
+
+    guint64 dropped() const { return dropped_.load(); }
+
+  private:
+    static gpointer worker_func(gpointer data);
+    void run();
+
+    guint max_pending_;
+    int quality_;
+
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::condition_variable idle_;   /**< signalled when the pool runs dry */
+    std::deque<std::unique_ptr<SnapshotJob>> jobs_;
+    std::vector<GBytes *> finished_;
+    guint busy_ = 0;               /**< jobs being encoded */
+    bool running_ = true;
+    std::atomic<guint64> dropped_{0};
+    std::vector<GThread *> threads_;
+};
+
+} // namespace dxs
+
+#endif // DX_SNAPSHOT_ENCODER_HPP
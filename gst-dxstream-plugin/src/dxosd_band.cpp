@@ -0,0 +1,86 @@
+#include "dxosd_band.hpp"
+
+#include <algorithm>
+
+namespace dxs {
+
+// Bands per thread: small enough that a thread which drew an empty band
+// picks up part of a busy one.
+static constexpr int BANDS_PER_THREAD = 2;
+
+BandPool::BandPool(guint threads) {
+    for (guint i = 1; i < std::max(threads, 1u); i++)
+        threads_.push_back(g_thread_new("dxosd-band", worker_func, this));
+}
+
+BandPool::~BandPool() {
+    {
+        std::lock_guard<std::mutex> lk(lock_);
+        running_ = false;
+        start_.notify_all();
+    }
+    for (GThread *thread : threads_)
+        g_thread_join(thread);
+}
+
+void BandPool::run_bands(int height, BandFn fn, void *ctx) {
+    if (height <= 0)
+        return;
+    int bands = std::min(static_cast<int>(threads()) * BANDS_PER_THREAD, (height + 1) / 2);
+    if (threads_.empty() || bands <= 1) {
+        fn(ctx, OsdBand());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(lock_);
+        fn_ = fn;
+        ctx_ = ctx;
+        height_ = height;
+        band_rows_ = ((height + bands - 1) / bands + 1) & ~1;
+        bands_ = (height + band_rows_ - 1) / band_rows_;
+        next_.store(0);
+        pending_ = static_cast<guint>(threads_.size());
+        generation_++;
+        start_.notify_all();
+    }
+    draw_bands();
+
+    std::unique_lock<std::mutex> lk(lock_);
+    done_.wait(lk, [this] { return pending_ == 0; });
+}
+
+void BandPool::draw_bands() {
+    int i;
+    while ((i = next_.fetch_add(1)) < bands_) {
+        OsdBand band;
+        band.begin = i * band_rows_;
+        band.end = std::min(band.begin + band_rows_, height_);
+        fn_(ctx_, band);
+    }
+}
+
+gpointer BandPool::worker_func(gpointer data) {
+    static_cast<BandPool *>(data)->work();
+    return nullptr;
+}
+
+void BandPool::work() {
+    guint64 seen = 0;
+    std::unique_lock<std::mutex> lk(lock_);
+    while (true) {
+        start_.wait(lk, [this, seen] { return !running_ || generation_ != seen; });
+        if (!running_)
+            return;
+        seen = generation_;
+        lk.unlock();
+
+        draw_bands();
+
+        lk.lock();
+        if (--pending_ == 0)
+            done_.notify_one();
+    }
+}
+
+} // namespace dxs
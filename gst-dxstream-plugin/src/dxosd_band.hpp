@@ -0,0 +1,75 @@
+#ifndef DXOSD_BAND_HPP
+#define DXOSD_BAND_HPP
+
+#include "dxosd_common.hpp"
+#include <glib.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Band-parallel OSD rendering for dxosd (render-threads)
+// ---------------------------------------------------------------------------
+// A frame is cut into horizontal bands of even height. The caller and the
+// pool workers claim bands from a shared counter and draw all of the
+// frame's meta into each, every primitive clipped to the band (OsdBand), so
+// busy regions of the frame are spread over the threads and the result is
+// pixel-identical to serial rendering. run() returns once every band is
+// drawn; the pool is meant to be driven by one streaming thread.
+
+namespace dxs {
+
+class BandPool {
+  public:
+    /** `threads` drawing threads in total, the caller included. */
+    explicit BandPool(guint threads);
+    ~BandPool();
+
+    BandPool(const BandPool &) = delete;
+    BandPool &operator=(const BandPool &) = delete;
+
+    guint threads() const { return static_cast<guint>(threads_.size()) + 1; }
+
+    /** Calls `fn(const OsdBand &)` once per band of a `height`-row frame,
+     *  concurrently. */
+    template <typename Fn>
+    void run(int height, Fn &&fn) {
+        run_bands(height, &call<typename std::remove_reference<Fn>::type>, &fn);
+    }
+
+  private:
+    using BandFn = void (*)(void *, const OsdBand &);
+
+    template <typename Fn>
+    static void call(void *fn, const OsdBand &band) {
+        (*static_cast<Fn *>(fn))(band);
+    }
+
+    void run_bands(int height, BandFn fn, void *ctx);
+    void draw_bands();
+    static gpointer worker_func(gpointer data);
+    void work();
+
+    std::vector<GThread *> threads_;
+    std::mutex lock_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    bool running_ = true;
+    guint64 generation_ = 0;
+    guint pending_ = 0;        /**< workers still in the current run */
+
+    // Current run; written under lock_ before generation_ changes.
+    BandFn fn_ = nullptr;
+    void *ctx_ = nullptr;
+    int height_ = 0;
+    int band_rows_ = 0;
+    int bands_ = 0;
+    std::atomic<int> next_{0};
+};
+
+} // namespace dxs
+
+#endif // DXOSD_BAND_HPP
@@ -0,0 +1,129 @@
+#include "dxosd_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace dxs {
+
+size_t OsdRenderCache::KeyHash::operator()(const Key &k) const {
+    return label_key_hash(k.track_id, k.label, k.bucket);
+}
+
+void OsdRenderCache::clear() {
+    entries_.clear();
+    captions_.clear();
+    style_.objects.clear();
+}
+
+const OsdRenderCache::Entry &OsdRenderCache::entry(const DXObjectMeta *obj, char sep,
+                                                   double font_scale) {
+    bool tracked = obj->_track_id != -1;
+    Key key = {obj->_track_id, -1, 0};
+    if (!tracked) {
+        key.label = obj->_label;
+        key.bucket = confidence_bucket(obj->_confidence);
+    }
+    int scale = static_cast<int>(std::lround(font_scale * 1000.0));
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        it = entries_.emplace(key, Entry()).first;
+        Entry &e = it->second;
+        int idx = tracked ? obj->_track_id : obj->_label;
+        e.color = COLORS[std::max(idx, 0) % COLORS.size()];
+        e.yuv = bgr_to_yuv_bt601(static_cast<uint8_t>(e.color[0]),
+                                 static_cast<uint8_t>(e.color[1]),
+                                 static_cast<uint8_t>(e.color[2]));
+        e.has_label = tracked || obj->_label != -1;
+    }
+
+    Entry &e = it->second;
+    e.frame = frame_;
+    bool stale = e.sep != sep || e.scale != scale || (!tracked && e.name != obj->_label_name);
+    if (e.has_label && stale) {
+        format_label(obj->_track_id, obj->_label_name, key.bucket, sep, text_);
+        render_text(text_.c_str(), font_scale, 1, e.sprite);
+        e.sep = sep;
+        e.scale = scale;
+        if (!tracked)
+            e.name = obj->_label_name;
+    }
+    return e;
+}
+
+const TextSprite *OsdRenderCache::caption(const DXObjectMeta *obj, int width, int height,
+                                          bool v3) {
+    for (Caption &c : captions_) {
+        if (c.confidence == obj->_confidence && c.v3 == v3 && c.width == width &&
+            c.height == height && c.name == obj->_label_name) {
+            c.frame = frame_;
+            return &c.sprite;
+        }
+    }
+
+    text_.assign(obj->_label_name);
+    if (!v3) {
+        char number[32];
+        std::snprintf(number, sizeof(number), "=%.2f", obj->_confidence);
+        text_.append(number);
+    }
+    // Largest font (down to 0.3) whose text fits 90% of the width and the
+    // bottom 15% of the frame.
+    auto text_area_height = int(height * 0.15);
+    auto text_area_width = int(width * 0.9);
+    auto margin_y = int(height * 0.02);
+    double font_scale = 0.002 * std::min(width, height);
+    do {
+        cv::Size size = text_size(text_.c_str(), font_scale, 2, nullptr);
+        if (size.width <= text_area_width && size.height <= text_area_height - margin_y)
+            break;
+        font_scale *= 0.9;
+    } while (font_scale > 0.3);
+
+    captions_.emplace_back();
+    Caption &c = captions_.back();
+    c.name = obj->_label_name;
+    c.confidence = obj->_confidence;
+    c.v3 = v3;
+    c.width = width;
+    c.height = height;
+    c.frame = frame_;
+    render_text(text_.c_str(), font_scale, 2, c.sprite);
+    return &c.sprite;
+}
+
+const OsdFrameStyle &OsdRenderCache::prepare(const DXFrameMeta *meta, const OsdFrame &frame,
+                                             bool v3_clip_text) {
+    frame_++;
+    // Packed frames print "name=0.87", YUV frames "name 0.87".
+    char sep = frame.format == OsdFrame::Format::PACKED ? '=' : ' ';
+    double font_scale = 0.00075 * std::min(frame.width, frame.height);
+
+    const auto &objects = meta->_object_meta_list;
+    style_.objects.resize(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        const DXObjectMeta *obj = objects[i];
+        const Entry &e = entry(obj, sep, font_scale);
+        OsdObjectStyle &style = style_.objects[i];
+        style.label = e.has_label ? &e.sprite : nullptr;
+        style.color = e.color;
+        style.yuv = e.yuv;
+        // CLIP captions are only drawn on packed frames.
+        style.caption = frame.format == OsdFrame::Format::PACKED && is_clip(obj)
+                            ? caption(obj, frame.width, frame.height, v3_clip_text)
+                            : nullptr;
+    }
+
+    // Tracks (and untracked labels, captions) missing from this frame are gone.
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.frame == frame_)
+            ++it;
+        else
+            it = entries_.erase(it);
+    }
+    captions_.remove_if([this](const Caption &c) { return c.frame != frame_; });
+    return style_;
+}
+
+} // namespace dxs
@@ -0,0 +1,86 @@
+#ifndef DXOSD_CACHE_HPP
+#define DXOSD_CACHE_HPP
+
+#include "dxosd_common.hpp"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Per-stream render cache for dxosd
+// ---------------------------------------------------------------------------
+// Tracked scenes barely change between frames, yet every frame used to
+// resolve each object's colour, format its label and look up (or render)
+// the label sprite again, once per band. OsdRenderCache keeps that per
+// stream, keyed by track_id (untracked objects: by label and confidence
+// bucket):
+//   label sprite   rendered once; re-rendered only when the name, the font
+//                  scale (frame size) or the separator (format) changes
+//   colour         BGR and BT.601 YUV of the palette entry
+//   CLIP caption   text, fitted font size and sprite
+// prepare() runs on the streaming thread before the bands are drawn and
+// fills an OsdFrameStyle that the bands only read. Entries of tracks that
+// are missing from a frame are evicted. Once every track has its entry, a
+// frame allocates nothing here.
+
+namespace dxs {
+
+class OsdRenderCache {
+  public:
+    /** Styles for the objects of `meta` drawn on `frame`, valid until the
+     *  next prepare() or clear(). */
+    const OsdFrameStyle &prepare(const DXFrameMeta *meta, const OsdFrame &frame,
+                                 bool v3_clip_text = false);
+
+    size_t entries() const { return entries_.size(); }
+    size_t captions() const { return captions_.size(); }
+    void clear();
+
+  private:
+    struct Key {
+        int track_id;
+        int label;                 /**< untracked only */
+        int bucket;                /**< confidence * 100, untracked only */
+        bool operator==(const Key &o) const {
+            return track_id == o.track_id && label == o.label && bucket == o.bucket;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key &k) const;
+    };
+    struct Entry {
+        std::string name;          /**< untracked only */
+        char sep = 0;
+        int scale = 0;             /**< font scale * 1000 */
+        bool has_label = false;
+        TextSprite sprite;
+        cv::Scalar color;
+        YUVColor yuv = {0, 0, 0};
+        uint64_t frame = 0;         /**< last prepare() that used it */
+    };
+    struct Caption {
+        std::string name;
+        float confidence = 0.0f;
+        bool v3 = false;
+        int width = 0;
+        int height = 0;
+        TextSprite sprite;
+        uint64_t frame = 0;
+    };
+
+    const Entry &entry(const DXObjectMeta *obj, char sep, double font_scale);
+    const TextSprite *caption(const DXObjectMeta *obj, int width, int height, bool v3);
+
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    std::list<Caption> captions_;  /**< node-stable: styles point into it */
+    OsdFrameStyle style_;
+    std::string text_;             /**< label / caption text scratch */
+    uint64_t frame_ = 0;
+};
+
+} // namespace dxs
+
+#endif // DXOSD_CACHE_HPP
@@ -1,41 +1,245 @@
 #include "dxosd_common.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+
+// ==================== Band clipping ====================
+// Rows of a plane with `rows` rows that `band` lets a draw call touch;
+// chroma planes of 4:2:0 formats pass `subsample` 2.
+static void band_rows(const OsdBand &band, int rows, int subsample, int &row0, int &row1) {
+    row0 = std::max(0, band.begin / subsample);
+    row1 = std::min(rows, band.end / subsample);
+}
+
+// Draws one OpenCV primitive whose geometry (thickness and anti-aliasing
+// included) lies within `bounds`, keeping only rows [row0, row1) of `img`.
+// `draw(target, offset)` must add `offset` to every coordinate.
+//
+// OpenCV clips lines and polygons against the image before rasterizing, so
+// simply drawing into the band would shift sloped edges where they cross a
+// band edge. Instead the primitive is drawn on a view whose edges either
+// lie outside the primitive or coincide with the frame edges: the band
+// itself when the primitive fits, otherwise a scratch copy of the primitive
+// bounds (clipped to the frame) of which only the band rows are written back.
+// Drawing is translation invariant, so the pixels are the same as when
+// drawing on the whole frame.
+template <typename Fn>
+static void draw_banded(cv::Mat &img, int row0, int row1, const cv::Rect &bounds, Fn &&draw) {
+    if (row0 <= 0 && row1 >= img.rows) {
+        draw(img, cv::Point());
+        return;
+    }
+    cv::Rect clipped = bounds & cv::Rect(0, 0, img.cols, img.rows);
+    int y0 = std::max(clipped.y, row0);
+    int y1 = std::min(clipped.y + clipped.height, row1);
+    if (clipped.empty() || y0 >= y1)
+        return;
+    if (clipped.y >= row0 && clipped.y + clipped.height <= row1) {
+        cv::Mat rows = img.rowRange(row0, row1);
+        draw(rows, cv::Point(0, -row0));
+        return;
+    }
+
+    static thread_local std::vector<uint8_t> buffer;
+    buffer.resize(clipped.area() * img.elemSize());
+    cv::Mat scratch(clipped.height, clipped.width, img.type(), buffer.data());
+    cv::Rect own(clipped.x, y0, clipped.width, y1 - y0);
+    cv::Rect own_scratch(0, y0 - clipped.y, clipped.width, y1 - y0);
+    img(own).copyTo(scratch(own_scratch));
+    draw(scratch, cv::Point(-clipped.x, -clipped.y));
+    scratch(own_scratch).copyTo(img(own));
+}
+
+static cv::Rect line_bounds(const cv::Point &a, const cv::Point &b, int thickness) {
+    int m = thickness + 2;
+    return cv::Rect(cv::Point(std::min(a.x, b.x) - m, std::min(a.y, b.y) - m),
+                    cv::Point(std::max(a.x, b.x) + m + 1, std::max(a.y, b.y) + m + 1));
+}
+
+static cv::Rect circle_bounds(const cv::Point &c, int radius) {
+    int m = radius + 2;
+    return cv::Rect(c.x - m, c.y - m, 2 * m + 1, 2 * m + 1);
+}
+
+static void banded_line(cv::Mat &img, int row0, int row1, const cv::Point &a, const cv::Point &b,
+                        const cv::Scalar &color, int thickness, int line_type) {
+    draw_banded(img, row0, row1, line_bounds(a, b, thickness),
+                [&](cv::Mat &dst, const cv::Point &o) {
+                    cv::line(dst, a + o, b + o, color, thickness, line_type);
+                });
+}
+
+static void banded_circle(cv::Mat &img, int row0, int row1, const cv::Point &c, int radius,
+                          const cv::Scalar &color) {
+    draw_banded(img, row0, row1, circle_bounds(c, radius),
+                [&](cv::Mat &dst, const cv::Point &o) {
+                    cv::circle(dst, c + o, radius, color, -1, cv::LINE_AA);
+                });
+}
+
+// cv::rectangle(img, Rect(a, b), color, thickness)
+static void banded_rectangle(cv::Mat &img, int row0, int row1, const cv::Point &a,
+                             const cv::Point &b, const cv::Scalar &color, int thickness) {
+    draw_banded(img, row0, row1, line_bounds(a, b, std::max(thickness, 1)),
+                [&](cv::Mat &dst, const cv::Point &o) {
+                    cv::rectangle(dst, cv::Rect(a + o, b + o), color, thickness);
+                });
+}
+
+static void banded_blit(cv::Mat &img, int row0, int row1, const dxs::TextSprite &sprite,
+                        int x, int y, const cv::Scalar &color = cv::Scalar(255, 255, 255)) {
+    if (row0 >= row1)
+        return;
+    cv::Mat rows = img.rowRange(row0, row1);
+    dxs::blit_text(rows, sprite, x, y - row0, color);
+}
+
+// ==================== Segmentation blend ====================
+// Masks are blended in place at ~40% opacity in a single pass: each output
+// row samples its nearest mask row and columns on the fly, so no
+// frame-sized map, colour image or mask is allocated. Colours are weighted
+// for the fixed-point blend
+//   dst = (dst * 154 + color * 102 + 128) >> 8      (154 + 102 = 256)
+// and, for semantic segmentation, looked up per class in a LUT for each
+// output plane layout. A row is expanded once per mask row; the inner loop
+// is plain 16-bit arithmetic that the compiler vectorizes.
+
+enum class SegPlane { BGR, Y, U, V, UV };
+
+static constexpr int SEG_KEEP = 154;
+static constexpr int SEG_MIX = 102;
+
+struct SegLut {
+    int channels;
+    uint16_t color[256 * 3];
+};
+
+static SegLut make_seg_lut(SegPlane plane) {
+    SegLut lut = {};
+    lut.channels = plane == SegPlane::BGR ? 3 : (plane == SegPlane::UV ? 2 : 1);
+    for (int cls = 0; cls < 256; cls++) {
+        const cv::Scalar &c = COLORS[cls % COLORS.size()];
+        auto b = static_cast<uint8_t>(c[0]);
+        auto g = static_cast<uint8_t>(c[1]);
+        auto r = static_cast<uint8_t>(c[2]);
+        YUVColor yuv = bgr_to_yuv_bt601(b, g, r);
+        uint8_t value[3] = {b, g, r};
+        switch (plane) {
+        case SegPlane::BGR: break;
+        case SegPlane::Y: value[0] = yuv.y; break;
+        case SegPlane::U: value[0] = yuv.u; break;
+        case SegPlane::V: value[0] = yuv.v; break;
+        case SegPlane::UV: value[0] = yuv.u; value[1] = yuv.v; break;
+        }
+        for (int k = 0; k < lut.channels; k++)
+            lut.color[cls * lut.channels + k] = static_cast<uint16_t>(value[k] * SEG_MIX + 128);
+    }
+    return lut;
+}
+
+static const SegLut &seg_lut(SegPlane plane) {
+    static const SegLut luts[] = {
+        make_seg_lut(SegPlane::BGR), make_seg_lut(SegPlane::Y), make_seg_lut(SegPlane::U),
+        make_seg_lut(SegPlane::V), make_seg_lut(SegPlane::UV),
+    };
+    return luts[static_cast<int>(plane)];
+}
+
+// Blends sample rows [row0, row1) of a plane of `cols` samples per row, each
+// covering `subsample` frame pixels per direction (2 for 4:2:0 chroma),
+// with the class map.
+static void blend_seg_plane(uint8_t *plane, int stride, int cols, int row0, int row1,
+                            int subsample, int frame_w, int frame_h, const unsigned char *seg,
+                            int seg_w, int seg_h, SegPlane layout) {
+    const SegLut &lut = seg_lut(layout);
+    const int channels = lut.channels;
+    const size_t row_len = static_cast<size_t>(cols) * channels;
+
+    // Row-sized scratch, reused across frames.
+    static thread_local std::vector<int> src_x;
+    static thread_local std::vector<uint16_t> mix;
+    src_x.resize(cols);
+    mix.resize(row_len);
+    for (int x = 0; x < cols; x++) {
+        auto sx = static_cast<int64_t>(x) * subsample * seg_w / frame_w;
+        src_x[x] = std::min(static_cast<int>(sx), seg_w - 1);
+    }
+
+    int expanded = -1;
+    for (int y = row0; y < row1; y++) {
+        auto sy = static_cast<int64_t>(y) * subsample * seg_h / frame_h;
+        int seg_row = std::min(static_cast<int>(sy), seg_h - 1);
+        if (seg_row != expanded) {
+            const unsigned char *classes = seg + static_cast<size_t>(seg_row) * seg_w;
+            for (int x = 0; x < cols; x++) {
+                const uint16_t *color = lut.color + classes[src_x[x]] * channels;
+                for (int k = 0; k < channels; k++)
+                    mix[x * channels + k] = color[k];
+            }
+            expanded = seg_row;
+        }
+        uint8_t *dst = plane + static_cast<size_t>(y) * stride;
+        const uint16_t *mp = mix.data();
+        for (size_t i = 0; i < row_len; i++)
+            dst[i] = static_cast<uint8_t>((dst[i] * SEG_KEEP + mp[i]) >> 8);
+    }
+}
 
-// Internal helper: draw segmentation from raw data buffer
-// Resizes the class-index map with INTER_NEAREST first, then colorizes at target resolution
-// to avoid mosaic artifacts from interpolating color values.
-static void draw_seg_bgr(cv::Mat &img, const unsigned char* data, int seg_w, int seg_h, bool skip_bg) {
-    // Resize the class-index map to target resolution with nearest-neighbor
-    cv::Mat seg_map(seg_h, seg_w, CV_8UC1, const_cast<unsigned char*>(data));
-    cv::Mat resized_map;
-    cv::resize(seg_map, resized_map, img.size(), 0, 0, cv::INTER_NEAREST);
-
-    // Colorize at target resolution
-    int total_pixels = img.rows * img.cols;
-    cv::Mat seg_vis(img.rows, img.cols, CV_8UC3, cv::Scalar(0, 0, 0));
-    cv::Mat seg_mask(img.rows, img.cols, CV_8UC1, cv::Scalar(0));
-    uchar* vis_ptr = seg_vis.data;
-    uchar* map_ptr = resized_map.data;
-    uchar* mask_ptr = seg_mask.data;
-    size_t color_count = COLORS.size();
-    for (int i = 0; i < total_pixels; ++i) {
-        int cls = map_ptr[i];
-        if (skip_bg && cls == 255) continue;
-        const cv::Scalar& color = COLORS[cls % color_count];
-        vis_ptr[i * 3 + 0] = static_cast<uchar>(color[0]);
-        vis_ptr[i * 3 + 1] = static_cast<uchar>(color[1]);
-        vis_ptr[i * 3 + 2] = static_cast<uchar>(color[2]);
-        mask_ptr[i] = 255;
+// Blends `color` into the samples of `roi` (plane coordinates) where the
+// object's mask, stretched nearest-neighbour over `roi`, is set; only sample
+// rows [row0, row1) are touched.
+static void blend_mask_plane(uint8_t *plane, int stride, int channels, const cv::Rect &roi,
+                             int row0, int row1, const DXObjectMeta *meta, const uint8_t *color) {
+    int y0 = std::max(roi.y, row0);
+    int y1 = std::min(roi.y + roi.height, row1);
+    if (roi.width <= 0 || y0 >= y1)
+        return;
+    const int mask_w = meta->_seg_width;
+    const int mask_h = meta->_seg_height;
+    uint16_t mix[3] = {0, 0, 0};
+    for (int k = 0; k < channels; k++)
+        mix[k] = static_cast<uint16_t>(color[k] * SEG_MIX + 128);
+
+    static thread_local std::vector<int> src_x;
+    src_x.resize(roi.width);
+    for (int x = 0; x < roi.width; x++)
+        src_x[x] = static_cast<int>(static_cast<int64_t>(x) * mask_w / roi.width);
+
+    for (int y = y0; y < y1; y++) {
+        auto my = static_cast<int64_t>(y - roi.y) * mask_h / roi.height;
+        const unsigned char *mask = meta->_seg_data.data() + my * mask_w;
+        uint8_t *dst = plane + static_cast<size_t>(y) * stride +
+                       static_cast<size_t>(roi.x) * channels;
+        for (int x = 0; x < roi.width; x++) {
+            if (!mask[src_x[x]])
+                continue;
+            for (int k = 0; k < channels; k++) {
+                uint8_t &px = dst[x * channels + k];
+                px = static_cast<uint8_t>((px * SEG_KEEP + mix[k]) >> 8);
+            }
+        }
     }
-    cv::Mat blend;
-    cv::addWeighted(img, 0.6, seg_vis, 0.4, 0.0, blend);
-    blend.copyTo(img, seg_mask);
 }
 
-void draw_semantic_segmentation(cv::Mat &img, const DXFrameMeta *meta) {
-    if (meta->_seg_data.empty()) return;
-    draw_seg_bgr(img, meta->_seg_data.data(), meta->_seg_width, meta->_seg_height, false);
+template <typename Meta>
+static bool has_seg_map(const Meta *meta) {
+    return meta->_seg_width > 0 && meta->_seg_height > 0 &&
+           meta->_seg_data.size() >= static_cast<size_t>(meta->_seg_width) * meta->_seg_height;
+}
+
+bool is_clip(const DXObjectMeta *meta) {
+    return meta->_confidence > 0.24 && meta->_label == -1 && meta->_box[0] == -1 &&
+           meta->_box[1] == -1 && meta->_box[2] == -1 && meta->_box[3] == -1;
+}
+
+void draw_semantic_segmentation(cv::Mat &img, const DXFrameMeta *meta, const OsdBand &band) {
+    if (!has_seg_map(meta)) return;
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
+    blend_seg_plane(img.data, static_cast<int>(img.step), img.cols, row0, row1, 1,
+                    img.cols, img.rows, meta->_seg_data.data(), meta->_seg_width,
+                    meta->_seg_height, SegPlane::BGR);
 }
 
 static cv::Scalar get_instance_color_bgr(const DXObjectMeta *meta) {
@@ -50,7 +254,7 @@ static bool get_instance_mask_roi(const DXObjectMeta *meta,
                                   int width, int height,
                                   float sx, float sy,
                                   cv::Rect &roi) {
-    if (meta->_seg_data.empty() || meta->_seg_width <= 0 || meta->_seg_height <= 0)
+    if (!has_seg_map(meta))
         return false;
     if (meta->_box[2] <= meta->_box[0] || meta->_box[3] <= meta->_box[1])
         return false;
@@ -81,48 +285,47 @@ static cv::Rect get_uv_roi(const cv::Rect &roi, int width, int height) {
     return cv::Rect(x1, y1, std::max(0, x2 - x1), std::max(0, y2 - y1));
 }
 
-static cv::Mat resize_instance_mask(const DXObjectMeta *meta, const cv::Size &size) {
-    cv::Mat mask(meta->_seg_height, meta->_seg_width, CV_8UC1,
-                 const_cast<unsigned char *>(meta->_seg_data.data()));
-    cv::Mat resized_mask;
-    cv::resize(mask, resized_mask, size, 0, 0, cv::INTER_NEAREST);
-    return resized_mask;
-}
-
-void draw_instance_segmentation(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
+void draw_instance_segmentation(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy,
+                                const OsdBand &band) {
     cv::Rect roi;
     if (!get_instance_mask_roi(meta, img.cols, img.rows, sx, sy, roi))
         return;
 
-    cv::Mat mask = resize_instance_mask(meta, roi.size());
-    cv::Mat img_roi = img(roi);
-    cv::Mat seg_vis(roi.height, roi.width, CV_8UC3, get_instance_color_bgr(meta));
-    cv::Mat blend;
-    cv::addWeighted(img_roi, 0.6, seg_vis, 0.4, 0.0, blend);
-    blend.copyTo(img_roi, mask);
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
+    cv::Scalar c = get_instance_color_bgr(meta);
+    const uint8_t color[3] = {static_cast<uint8_t>(c[0]), static_cast<uint8_t>(c[1]),
+                              static_cast<uint8_t>(c[2])};
+    blend_mask_plane(img.data, static_cast<int>(img.step), 3, roi, row0, row1, meta, color);
 }
 
-void draw_keypoints(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
+void draw_keypoints(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy,
+                    const OsdBand &band) {
     if (meta->_keypoints.empty())
         return;
-    std::vector<cv::Point> pts;
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
+    cv::Point pts[17];
     for (int i = 0; i < 17; ++i) {
         float x = meta->_keypoints[i * 3] / sx;
         float y = meta->_keypoints[i * 3 + 1] / sy;
         float s = meta->_keypoints[i * 3 + 2];
-        pts.emplace_back((s > 0.5f) ? cv::Point(int(x), int(y)) : cv::Point(-1, -1));
+        pts[i] = (s > 0.5f) ? cv::Point(int(x), int(y)) : cv::Point(-1, -1);
     }
     for (size_t i = 0; i < skeleton.size(); ++i) {
         auto &p = skeleton[i];
         if (pts[p[0]].x >= 0 && pts[p[1]].x >= 0)
-            cv::line(img, pts[p[0]], pts[p[1]], pose_limb_color[i], 2, cv::LINE_AA);
+            banded_line(img, row0, row1, pts[p[0]], pts[p[1]], pose_limb_color[i], 2, cv::LINE_AA);
     }
-    for (size_t i = 0; i < pts.size(); ++i)
-        cv::circle(img, pts[i], 3, pose_kpt_color[i], -1, cv::LINE_AA);
+    for (int i = 0; i < 17; ++i)
+        banded_circle(img, row0, row1, pts[i], 3, pose_kpt_color[i]);
 }
 
-void draw_obb(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
+void draw_obb(cv::Mat &img, const DXObjectMeta *meta, const OsdObjectStyle &style, float sx,
+              float sy, const OsdBand &band) {
     if (meta->_obb.size() != 5) return;
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
     float cx = meta->_obb[0] / sx;
     float cy = meta->_obb[1] / sy;
     float w = meta->_obb[2] / sx;
@@ -132,21 +335,13 @@ void draw_obb(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
                           angle_rad * 180.0f / static_cast<float>(CV_PI));
     cv::Point2f pts[4];
     rrect.points(pts);
-    int id = meta->_track_id;
-    int label = meta->_label;
-    int color_idx = (id != -1) ? id : (label >= 0 ? label : 0);
-    cv::Scalar color = COLORS[color_idx % COLORS.size()];
+    const cv::Scalar &color = style.color;
     for (int i = 0; i < 4; i++)
-        cv::line(img, pts[i], pts[(i + 1) % 4], color, 2, cv::LINE_AA);
+        banded_line(img, row0, row1, pts[i], pts[(i + 1) % 4], color, 2, cv::LINE_AA);
 
     // Draw label text near the top of the OBB
-    std::string text;
-    if (id != -1) {
-        text = std::to_string(id);
-    } else if (label != -1) {
-        text = cv::format("%s=%.2f", meta->_label_name.c_str(), meta->_confidence);
-    }
-    if (!text.empty()) {
+    const dxs::TextSprite *text = style.label;
+    if (text) {
         // Find top-most point of OBB for label placement
         float min_y = pts[0].y;
         int min_idx = 0;
@@ -155,114 +350,77 @@ void draw_obb(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
         }
         int tx = static_cast<int>(pts[min_idx].x);
         int ty = static_cast<int>(pts[min_idx].y);
-        double font_scale = 0.00075 * std::min(img.cols, img.rows);
-        int baseline = 0;
-        auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 1, &baseline);
-        cv::rectangle(img,
-                      cv::Rect(cv::Point(tx, ty - text_size.height),
-                               cv::Point(tx + text_size.width, ty)),
-                      color, cv::FILLED);
-        cv::putText(img, text, cv::Point(tx, ty), cv::FONT_HERSHEY_SIMPLEX,
-                    font_scale, cv::Scalar(255, 255, 255));
+        banded_rectangle(img, row0, row1, cv::Point(tx, ty - text->height),
+                         cv::Point(tx + text->width, ty), color, cv::FILLED);
+        banded_blit(img, row0, row1, *text, tx, ty);
     }
 }
 
-void draw_face(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
+void draw_face(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy, const OsdBand &band) {
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
     // face_landmarks is now std::vector<float> with pairs of x,y,conf coordinates
     for (size_t i = 0; i + 2 < meta->_face_landmarks.size(); i += 3) {
         float x = meta->_face_landmarks[i];
         float y = meta->_face_landmarks[i + 1];
-        cv::circle(img, cv::Point(int(x / sx), int(y / sy)), 3, cv::Scalar(0, 255, 0), -1, cv::LINE_AA);
+        banded_circle(img, row0, row1, cv::Point(int(x / sx), int(y / sy)), 3, cv::Scalar(0, 255, 0));
     }
     if (meta->_face_box[2] > meta->_face_box[0] && meta->_face_box[3] > meta->_face_box[1]) {
-        cv::rectangle(
-            img,
-            cv::Rect(
-                cv::Point(int(meta->_face_box[0] / sx), int(meta->_face_box[1] / sy)),
-                cv::Point(int(meta->_face_box[2] / sx), int(meta->_face_box[3] / sy))),
-            cv::Scalar(255, 0, 0), 2);
+        banded_rectangle(img, row0, row1,
+                         cv::Point(int(meta->_face_box[0] / sx), int(meta->_face_box[1] / sy)),
+                         cv::Point(int(meta->_face_box[2] / sx), int(meta->_face_box[3] / sy)),
+                         cv::Scalar(255, 0, 0), 2);
     }
 }
 
-void draw_label_or_id(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy) {
+void draw_label_or_id(cv::Mat &img, const DXObjectMeta *meta, const OsdObjectStyle &style,
+                      float sx, float sy, const OsdBand &band) {
     // OBB objects are drawn by draw_obb — skip AABB here
     if (meta->_obb.size() == 5) return;
     if (meta->_box[2] - meta->_box[0] <= 0 || meta->_box[3] - meta->_box[1] <= 0)
         return;
-    int id = meta->_track_id;
-    bool has_id = (id != -1);
-    int label = meta->_label;
-    bool has_label = (!has_id && label != -1);
-    if (!has_id && !has_label)
+    const dxs::TextSprite *text = style.label;
+    if (!text)
         return;
-    std::string text;
-    cv::Scalar color;
-    if (has_id) {
-        text = std::to_string(id);
-        color = COLORS[id % COLORS.size()];
-    } else {
-        text = cv::format("%s=%.2f", meta->_label_name.c_str(), meta->_confidence);
-        color = COLORS[label % COLORS.size()];
-    }
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
+    const cv::Scalar &color = style.color;
     auto x = int(meta->_box[0] / sx);
     auto y = int(meta->_box[1] / sy);
     auto x2 = int(meta->_box[2] / sx);
     auto y2 = int(meta->_box[3] / sy);
-    double font_scale = 0.00075 * std::min(img.cols, img.rows);
-    int baseline = 0;
-    auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 1, &baseline);
-    cv::rectangle(img, cv::Rect(cv::Point(x, y), cv::Point(x2, y2)), color, 2);
-    cv::rectangle(img,
-                  cv::Rect(cv::Point(x, y - text_size.height),
-                           cv::Point(x + text_size.width, y)),
-                  color, cv::FILLED);
-    cv::putText(img, text, cv::Point(x, y), cv::FONT_HERSHEY_SIMPLEX,
-                font_scale, cv::Scalar(255, 255, 255));
+    banded_rectangle(img, row0, row1, cv::Point(x, y), cv::Point(x2, y2), color, 2);
+    banded_rectangle(img, row0, row1, cv::Point(x, y - text->height),
+                     cv::Point(x + text->width, y), color, cv::FILLED);
+    banded_blit(img, row0, row1, *text, x, y);
 }
 
-void draw_clip(cv::Mat &img, const DXObjectMeta *meta, bool v3_clip_text) {
-    if (meta->_confidence > 0.24 && meta->_label == -1 && meta->_box[0] == -1 && meta->_box[1] == -1 && meta->_box[2] == -1 && meta->_box[3] == -1) {
-        std::string text;
-        if (v3_clip_text) {
-            text = cv::format("%s", meta->_label_name.c_str());
-        } else {
-            text = cv::format("%s=%.2f", meta->_label_name.c_str(), meta->_confidence);
-        }
-        auto text_area_height = int(img.rows * 0.15);
-        auto text_area_width = int(img.cols * 0.9);
-        auto margin_x = int(img.cols * 0.05);
-        auto margin_y = int(img.rows * 0.02);
-        double font_scale = 0.002 * std::min(img.cols, img.rows);
-        int baseline = 0;
-        cv::Size text_size;
-        do {
-            text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 2, &baseline);
-            if (text_size.width <= text_area_width && text_size.height <= text_area_height - margin_y) {
-                break;
-            }
-            font_scale *= 0.9;
-        } while (font_scale > 0.3);
-        int box_y_start = img.rows - text_size.height - margin_y * 2;
-        int box_width = text_size.width + margin_x * 2;
-        cv::rectangle(img, 
-                     cv::Rect(cv::Point(0, box_y_start), 
-                             cv::Point(box_width, img.rows)), 
-                     cv::Scalar(39, 129, 113), cv::FILLED);
-        int text_x = margin_x;
-        int text_y = img.rows - margin_y;
-        cv::putText(img, text, cv::Point(text_x, text_y), 
-                   cv::FONT_HERSHEY_SIMPLEX, font_scale, 
-                   cv::Scalar(255, 255, 255), 2);
-    }
+void draw_clip(cv::Mat &img, const OsdObjectStyle &style, const OsdBand &band) {
+    // Text and font size were fitted to the frame when the style was prepared.
+    const dxs::TextSprite *sprite = style.caption;
+    if (!sprite)
+        return;
+    auto margin_x = int(img.cols * 0.05);
+    auto margin_y = int(img.rows * 0.02);
+    int row0, row1;
+    band_rows(band, img.rows, 1, row0, row1);
+    int box_y_start = img.rows - sprite->height - margin_y * 2;
+    int box_width = sprite->width + margin_x * 2;
+    banded_rectangle(img, row0, row1, cv::Point(0, box_y_start),
+                     cv::Point(box_width, img.rows), cv::Scalar(39, 129, 113), cv::FILLED);
+    int text_x = margin_x;
+    int text_y = img.rows - margin_y;
+    banded_blit(img, row0, row1, *sprite, text_x, text_y);
 }
 
-void draw_object_meta(cv::Mat &img, const DXObjectMeta *meta, float scale_x, float scale_y, bool v3_clip_text) {
-    draw_instance_segmentation(img, meta, scale_x, scale_y);
-    draw_keypoints(img, meta, scale_x, scale_y);
-    draw_obb(img, meta, scale_x, scale_y);
-    draw_face(img, meta, scale_x, scale_y);
-    draw_label_or_id(img, meta, scale_x, scale_y);
-    draw_clip(img, meta, v3_clip_text);
+void draw_object_meta(cv::Mat &img, const DXObjectMeta *meta, const OsdObjectStyle &style,
+                      float scale_x, float scale_y, const OsdBand &band) {
+    draw_instance_segmentation(img, meta, scale_x, scale_y, band);
+    draw_keypoints(img, meta, scale_x, scale_y, band);
+    draw_obb(img, meta, style, scale_x, scale_y, band);
+    draw_face(img, meta, scale_x, scale_y, band);
+    draw_label_or_id(img, meta, style, scale_x, scale_y, band);
+    draw_clip(img, style, band);
 }
 
 const std::vector<cv::Scalar> COLORS = {
@@ -398,9 +556,11 @@ YUVColor bgr_to_yuv_bt601(uint8_t b, uint8_t g, uint8_t r) {
     return YUVColor{static_cast<uint8_t>(y), static_cast<uint8_t>(u), static_cast<uint8_t>(v)};
 }
 
+
 void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                          int stride_y, int stride_uv, int width, int height,
-                         int x1, int y1, int x2, int y2, YUVColor color, int thickness) {
+                         int x1, int y1, int x2, int y2, YUVColor color, int thickness,
+                         const OsdBand &band) {
     // Clamp coordinates
     x1 = std::max(0, std::min(x1, width - 1));
     y1 = std::max(0, std::min(y1, height - 1));
@@ -408,17 +568,20 @@ void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
     y2 = std::max(0, std::min(y2, height - 1));
     
     if (x1 >= x2 || y1 >= y2) return;
+
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     
     // Draw horizontal lines on Y plane
     for (int t = 0; t < thickness; t++) {
         // Top line
-        if (y1 + t < height) {
+        if (y1 + t < height && y1 + t >= row0 && y1 + t < row1) {
             for (int x = x1; x <= x2; x++) {
                 y_plane[(y1 + t) * stride_y + x] = color.y;
             }
         }
         // Bottom line
-        if (y2 - t >= 0) {
+        if (y2 - t >= 0 && y2 - t >= row0 && y2 - t < row1) {
             for (int x = x1; x <= x2; x++) {
                 y_plane[(y2 - t) * stride_y + x] = color.y;
             }
@@ -426,16 +589,17 @@ void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
     }
     
     // Draw vertical lines on Y plane
+    int vy1 = std::max(y1, row0), vy2 = std::min(y2, row1 - 1);
     for (int t = 0; t < thickness; t++) {
         // Left line
         if (x1 + t < width) {
-            for (int y = y1; y <= y2; y++) {
+            for (int y = vy1; y <= vy2; y++) {
                 y_plane[y * stride_y + (x1 + t)] = color.y;
             }
         }
         // Right line
         if (x2 - t >= 0) {
-            for (int y = y1; y <= y2; y++) {
+            for (int y = vy1; y <= vy2; y++) {
                 y_plane[y * stride_y + (x2 - t)] = color.y;
             }
         }
@@ -449,16 +613,19 @@ void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
     int uv_thickness = std::max(1, thickness / 2);
     int uv_width = width / 2;
     int uv_height = height / 2;
+    int uv_row0, uv_row1;
+    band_rows(band, uv_height, 2, uv_row0, uv_row1);
     
     // Horizontal UV lines
     for (int t = 0; t < uv_thickness; t++) {
-        if (uv_y1 + t < uv_height) {
+        if (uv_y1 + t < uv_height && uv_y1 + t >= uv_row0 && uv_y1 + t < uv_row1) {
             for (int x = uv_x1; x <= uv_x2; x++) {
                 u_plane[(uv_y1 + t) * stride_uv + x] = color.u;
                 v_plane[(uv_y1 + t) * stride_uv + x] = color.v;
             }
         }
-        if (uv_y2 - t >= 0 && uv_y2 - t < uv_height) {
+        if (uv_y2 - t >= 0 && uv_y2 - t < uv_height && uv_y2 - t >= uv_row0 &&
+            uv_y2 - t < uv_row1) {
             for (int x = uv_x1; x <= uv_x2; x++) {
                 u_plane[(uv_y2 - t) * stride_uv + x] = color.u;
                 v_plane[(uv_y2 - t) * stride_uv + x] = color.v;
@@ -467,15 +634,16 @@ void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
     }
     
     // Vertical UV lines
+    int uv_vy1 = std::max(uv_y1, uv_row0), uv_vy2 = std::min(uv_y2, uv_row1 - 1);
     for (int t = 0; t < uv_thickness; t++) {
         if (uv_x1 + t < uv_width) {
-            for (int y = uv_y1; y <= uv_y2; y++) {
+            for (int y = uv_vy1; y <= uv_vy2; y++) {
                 u_plane[y * stride_uv + (uv_x1 + t)] = color.u;
                 v_plane[y * stride_uv + (uv_x1 + t)] = color.v;
             }
         }
         if (uv_x2 - t >= 0 && uv_x2 - t < uv_width) {
-            for (int y = uv_y1; y <= uv_y2; y++) {
+            for (int y = uv_vy1; y <= uv_vy2; y++) {
                 u_plane[y * stride_uv + (uv_x2 - t)] = color.u;
                 v_plane[y * stride_uv + (uv_x2 - t)] = color.v;
             }
@@ -485,21 +653,25 @@ void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
 
 void draw_filled_rect_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                            int stride_y, int stride_uv, int width, int height,
-                           int x1, int y1, int x2, int y2, YUVColor color) {
+                           int x1, int y1, int x2, int y2, YUVColor color,
+                           const OsdBand &band) {
     x1 = std::max(0, std::min(x1, width - 1));
     y1 = std::max(0, std::min(y1, height - 1));
     x2 = std::max(0, std::min(x2, width));
     y2 = std::max(0, std::min(y2, height));
     if (x1 >= x2 || y1 >= y2) return;
 
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     int fill_w = x2 - x1;
-    for (int row = y1; row < y2; row++)
+    for (int row = std::max(y1, row0); row < std::min(y2, row1); row++)
         memset(y_plane + row * stride_y + x1, color.y, fill_w);
 
     int uv_x1 = x1 / 2, uv_y1 = y1 / 2;
     int uv_x2 = x2 / 2, uv_y2 = y2 / 2;
     int uv_fill_w = uv_x2 - uv_x1;
-    for (int row = uv_y1; row < uv_y2; row++) {
+    band_rows(band, height / 2, 2, row0, row1);
+    for (int row = std::max(uv_y1, row0); row < std::min(uv_y2, row1); row++) {
         memset(u_plane + row * stride_uv + uv_x1, color.u, uv_fill_w);
         memset(v_plane + row * stride_uv + uv_x1, color.v, uv_fill_w);
     }
@@ -507,7 +679,8 @@ void draw_filled_rect_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
 
 void draw_rectangle_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                          int stride_y, int stride_uv, int width, int height,
-                         int x1, int y1, int x2, int y2, YUVColor color, int thickness) {
+                         int x1, int y1, int x2, int y2, YUVColor color, int thickness,
+                         const OsdBand &band) {
     // Clamp coordinates
     x1 = std::max(0, std::min(x1, width - 1));
     y1 = std::max(0, std::min(y1, height - 1));
@@ -515,29 +688,33 @@ void draw_rectangle_nv12(uint8_t *y_plane, uint8_t *uv_plane,
     y2 = std::max(0, std::min(y2, height - 1));
     
     if (x1 >= x2 || y1 >= y2) return;
+
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     
     // Draw Y plane (same as I420)
     for (int t = 0; t < thickness; t++) {
-        if (y1 + t < height) {
+        if (y1 + t < height && y1 + t >= row0 && y1 + t < row1) {
             for (int x = x1; x <= x2; x++) {
                 y_plane[(y1 + t) * stride_y + x] = color.y;
             }
         }
-        if (y2 - t >= 0) {
+        if (y2 - t >= 0 && y2 - t >= row0 && y2 - t < row1) {
             for (int x = x1; x <= x2; x++) {
                 y_plane[(y2 - t) * stride_y + x] = color.y;
             }
         }
     }
     
+    int vy1 = std::max(y1, row0), vy2 = std::min(y2, row1 - 1);
     for (int t = 0; t < thickness; t++) {
         if (x1 + t < width) {
-            for (int y = y1; y <= y2; y++) {
+            for (int y = vy1; y <= vy2; y++) {
                 y_plane[y * stride_y + (x1 + t)] = color.y;
             }
         }
         if (x2 - t >= 0) {
-            for (int y = y1; y <= y2; y++) {
+            for (int y = vy1; y <= vy2; y++) {
                 y_plane[y * stride_y + (x2 - t)] = color.y;
             }
         }
@@ -551,17 +728,20 @@ void draw_rectangle_nv12(uint8_t *y_plane, uint8_t *uv_plane,
     int uv_thickness = std::max(1, thickness / 2);
     int uv_width = width / 2;
     int uv_height = height / 2;
+    int uv_row0, uv_row1;
+    band_rows(band, uv_height, 2, uv_row0, uv_row1);
     
     // Horizontal UV lines
     for (int t = 0; t < uv_thickness; t++) {
-        if (uv_y1 + t < uv_height) {
+        if (uv_y1 + t < uv_height && uv_y1 + t >= uv_row0 && uv_y1 + t < uv_row1) {
             for (int x = uv_x1; x <= uv_x2; x++) {
                 int offset = (uv_y1 + t) * stride_uv + x * 2;
                 uv_plane[offset] = color.u;
                 uv_plane[offset + 1] = color.v;
             }
         }
-        if (uv_y2 - t >= 0 && uv_y2 - t < uv_height) {
+        if (uv_y2 - t >= 0 && uv_y2 - t < uv_height && uv_y2 - t >= uv_row0 &&
+            uv_y2 - t < uv_row1) {
             for (int x = uv_x1; x <= uv_x2; x++) {
                 int offset = (uv_y2 - t) * stride_uv + x * 2;
                 uv_plane[offset] = color.u;
@@ -571,16 +751,17 @@ void draw_rectangle_nv12(uint8_t *y_plane, uint8_t *uv_plane,
     }
     
     // Vertical UV lines
+    int uv_vy1 = std::max(uv_y1, uv_row0), uv_vy2 = std::min(uv_y2, uv_row1 - 1);
     for (int t = 0; t < uv_thickness; t++) {
         if (uv_x1 + t < uv_width) {
-            for (int y = uv_y1; y <= uv_y2; y++) {
+            for (int y = uv_vy1; y <= uv_vy2; y++) {
                 int offset = y * stride_uv + (uv_x1 + t) * 2;
                 uv_plane[offset] = color.u;
                 uv_plane[offset + 1] = color.v;
             }
         }
         if (uv_x2 - t >= 0 && uv_x2 - t < uv_width) {
-            for (int y = uv_y1; y <= uv_y2; y++) {
+            for (int y = uv_vy1; y <= uv_vy2; y++) {
                 int offset = y * stride_uv + (uv_x2 - t) * 2;
                 uv_plane[offset] = color.u;
                 uv_plane[offset + 1] = color.v;
@@ -591,21 +772,25 @@ void draw_rectangle_nv12(uint8_t *y_plane, uint8_t *uv_plane,
 
 void draw_filled_rect_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                            int stride_y, int stride_uv, int width, int height,
-                           int x1, int y1, int x2, int y2, YUVColor color) {
+                           int x1, int y1, int x2, int y2, YUVColor color,
+                           const OsdBand &band) {
     x1 = std::max(0, std::min(x1, width - 1));
     y1 = std::max(0, std::min(y1, height - 1));
     x2 = std::max(0, std::min(x2, width));
     y2 = std::max(0, std::min(y2, height));
     if (x1 >= x2 || y1 >= y2) return;
 
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     int fill_w = x2 - x1;
-    for (int row = y1; row < y2; row++)
+    for (int row = std::max(y1, row0); row < std::min(y2, row1); row++)
         memset(y_plane + row * stride_y + x1, color.y, fill_w);
 
     int uv_x1 = x1 / 2, uv_y1 = y1 / 2;
     int uv_x2 = x2 / 2, uv_y2 = y2 / 2;
     uint16_t uv_val = (static_cast<uint16_t>(color.v) << 8) | color.u;
-    for (int row = uv_y1; row < uv_y2; row++) {
+    band_rows(band, height / 2, 2, row0, row1);
+    for (int row = std::max(uv_y1, row0); row < std::min(uv_y2, row1); row++) {
         auto *uv_row = reinterpret_cast<uint16_t *>(uv_plane + row * stride_uv) + uv_x1;
         for (int col = uv_x1; col < uv_x2; col++)
             *uv_row++ = uv_val;
@@ -613,41 +798,46 @@ void draw_filled_rect_nv12(uint8_t *y_plane, uint8_t *uv_plane,
 }
 
 void draw_text_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                       const char *text, int x, int y, double scale) {
-    // Create temporary Y-only cv::Mat (grayscale)
-    cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride);
-    
-    // Draw white text (255) on Y plane only
-    cv::putText(y_mat, text, cv::Point(x, y), 
-                cv::FONT_HERSHEY_SIMPLEX, scale, 
-                cv::Scalar(255), 1, cv::LINE_8);
+                       const dxs::TextSprite &text, int x, int y, const OsdBand &band) {
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
+    if (row0 >= row1)
+        return;
+    // White (255) on the Y plane only
+    dxs::blit_text_plane(y_plane + static_cast<size_t>(row0) * stride, stride, width,
+                         row1 - row0, text, x, y - row0, 255);
 }
 
 void draw_keypoints_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                            const DXObjectMeta *meta, float sx, float sy) {
+                            const DXObjectMeta *meta, float sx, float sy, const OsdBand &band) {
     if (meta->_keypoints.empty()) return;
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride);
-    std::vector<cv::Point> pts;
+    cv::Point pts[17];
     for (int i = 0; i < 17; ++i) {
         float kx = meta->_keypoints[i * 3] / sx;
         float ky = meta->_keypoints[i * 3 + 1] / sy;
         float ks = meta->_keypoints[i * 3 + 2];
-        pts.emplace_back((ks > 0.5f) ? cv::Point(int(kx), int(ky)) : cv::Point(-1, -1));
+        pts[i] = (ks > 0.5f) ? cv::Point(int(kx), int(ky)) : cv::Point(-1, -1);
     }
     for (size_t i = 0; i < skeleton.size(); ++i) {
         auto &p = skeleton[i];
         if (pts[p[0]].x >= 0 && pts[p[1]].x >= 0)
-            cv::line(y_mat, pts[p[0]], pts[p[1]], cv::Scalar(200), 2, cv::LINE_AA);
+            banded_line(y_mat, row0, row1, pts[p[0]], pts[p[1]], cv::Scalar(200), 2, cv::LINE_AA);
     }
     for (auto &pt : pts) {
         if (pt.x >= 0)
-            cv::circle(y_mat, pt, 3, cv::Scalar(235), -1, cv::LINE_AA);
+            banded_circle(y_mat, row0, row1, pt, 3, cv::Scalar(235));
     }
 }
 
 void draw_obb_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                      const DXObjectMeta *meta, float sx, float sy) {
+                      const DXObjectMeta *meta, const OsdObjectStyle &style, float sx, float sy,
+                      const OsdBand &band) {
     if (meta->_obb.size() != 5) return;
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     float cx = meta->_obb[0] / sx;
     float cy = meta->_obb[1] / sy;
     float w = meta->_obb[2] / sx;
@@ -665,33 +855,28 @@ void draw_obb_y_plane(uint8_t *y_plane, int stride, int width, int height,
         static_cast<uint8_t>(bgr_color[1]),
         static_cast<uint8_t>(bgr_color[2]));
     for (int i = 0; i < 4; i++)
-        cv::line(y_mat, pts[i], pts[(i + 1) % 4], cv::Scalar(yuv_color.y), 2, cv::LINE_AA);
+        banded_line(y_mat, row0, row1, pts[i], pts[(i + 1) % 4], cv::Scalar(yuv_color.y), 2,
+                    cv::LINE_AA);
 
     // Draw label text
-    std::string text;
-    int id = meta->_track_id;
-    if (id != -1) {
-        text = std::to_string(id);
-    } else if (label != -1) {
-        text = cv::format("%s %.2f", meta->_label_name.c_str(), meta->_confidence);
-    }
-    if (!text.empty()) {
+    const dxs::TextSprite *text = style.label;
+    if (text) {
         float min_y = pts[0].y;
         int min_idx = 0;
         for (int i = 1; i < 4; i++) {
             if (pts[i].y < min_y) { min_y = pts[i].y; min_idx = i; }
         }
-        double font_scale = 0.00075 * std::min(width, height);
-        draw_text_y_plane(y_plane, stride, width, height,
-                          text.c_str(), static_cast<int>(pts[min_idx].x),
-                          static_cast<int>(pts[min_idx].y) - 2, font_scale);
+        draw_text_y_plane(y_plane, stride, width, height, *text,
+                          static_cast<int>(pts[min_idx].x),
+                          static_cast<int>(pts[min_idx].y) - 2, band);
     }
 }
 
 
 void draw_obb_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                    int stride_y, int stride_uv, int width, int height,
-                   const DXObjectMeta *meta, float sx, float sy) {
+                   const DXObjectMeta *meta, const OsdObjectStyle &style, float sx, float sy,
+                   const OsdBand &band) {
     if (meta->_obb.size() != 5) return;
     float cx = meta->_obb[0] / sx;
     float cy = meta->_obb[1] / sy;
@@ -703,22 +888,19 @@ void draw_obb_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                           angle_rad * 180.0f / static_cast<float>(CV_PI));
     cv::Point2f pts[4];
     rrect.points(pts);
-
-    int id = meta->_track_id;
-    int label = meta->_label;
-    int color_idx = (id != -1) ? id : (label >= 0 ? label : 0);
-    cv::Scalar bgr_color = COLORS[color_idx % COLORS.size()];
-    YUVColor yuv_color = bgr_to_yuv_bt601(
-        static_cast<uint8_t>(bgr_color[0]),
-        static_cast<uint8_t>(bgr_color[1]),
-        static_cast<uint8_t>(bgr_color[2]));
+    YUVColor yuv_color = style.yuv;
 
     // Draw on Y plane
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride_y);
     for (int i = 0; i < 4; i++)
-        cv::line(y_mat, pts[i], pts[(i + 1) % 4], cv::Scalar(yuv_color.y), 2, cv::LINE_AA);
+        banded_line(y_mat, row0, row1, pts[i], pts[(i + 1) % 4], cv::Scalar(yuv_color.y), 2,
+                    cv::LINE_AA);
 
     // Draw on U and V planes (half resolution)
+    int uv_row0, uv_row1;
+    band_rows(band, height / 2, 2, uv_row0, uv_row1);
     cv::Mat u_mat(height / 2, width / 2, CV_8UC1, u_plane, stride_uv);
     cv::Mat v_mat(height / 2, width / 2, CV_8UC1, v_plane, stride_uv);
     cv::Point2f uv_pts[4];
@@ -727,18 +909,15 @@ void draw_obb_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
         uv_pts[i].y = pts[i].y / 2.0f;
     }
     for (int i = 0; i < 4; i++) {
-        cv::line(u_mat, uv_pts[i], uv_pts[(i + 1) % 4], cv::Scalar(yuv_color.u), 1, cv::LINE_AA);
-        cv::line(v_mat, uv_pts[i], uv_pts[(i + 1) % 4], cv::Scalar(yuv_color.v), 1, cv::LINE_AA);
+        banded_line(u_mat, uv_row0, uv_row1, uv_pts[i], uv_pts[(i + 1) % 4],
+                    cv::Scalar(yuv_color.u), 1, cv::LINE_AA);
+        banded_line(v_mat, uv_row0, uv_row1, uv_pts[i], uv_pts[(i + 1) % 4],
+                    cv::Scalar(yuv_color.v), 1, cv::LINE_AA);
     }
 
     // Draw label text
-    std::string text;
-    if (id != -1) {
-        text = std::to_string(id);
-    } else if (label != -1) {
-        text = cv::format("%s %.2f", meta->_label_name.c_str(), meta->_confidence);
-    }
-    if (!text.empty()) {
+    const dxs::TextSprite *text = style.label;
+    if (text) {
         float min_y = pts[0].y;
         int min_idx = 0;
         for (int i = 1; i < 4; i++) {
@@ -746,21 +925,18 @@ void draw_obb_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
         }
         int tx = static_cast<int>(pts[min_idx].x);
         int ty = static_cast<int>(pts[min_idx].y) - 2;
-        double font_scale = 0.00075 * std::min(width, height);
-        int baseline = 0;
-        auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 1, &baseline);
-        int bg_x2 = std::min(width, tx + text_size.width);
-        int bg_y1 = std::max(0, ty - text_size.height);
+        int bg_x2 = std::min(width, tx + text->width);
+        int bg_y1 = std::max(0, ty - text->height);
         draw_filled_rect_i420(y_plane, u_plane, v_plane, stride_y, stride_uv,
-                              width, height, tx, bg_y1, bg_x2, ty + 2, yuv_color);
-        draw_text_y_plane(y_plane, stride_y, width, height,
-                         text.c_str(), tx, ty, font_scale);
+                              width, height, tx, bg_y1, bg_x2, ty + 2, yuv_color, band);
+        draw_text_y_plane(y_plane, stride_y, width, height, *text, tx, ty, band);
     }
 }
 
 void draw_obb_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                    int stride_y, int stride_uv, int width, int height,
-                   const DXObjectMeta *meta, float sx, float sy) {
+                   const DXObjectMeta *meta, const OsdObjectStyle &style, float sx, float sy,
+                   const OsdBand &band) {
     if (meta->_obb.size() != 5) return;
     float cx = meta->_obb[0] / sx;
     float cy = meta->_obb[1] / sy;
@@ -772,22 +948,19 @@ void draw_obb_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                           angle_rad * 180.0f / static_cast<float>(CV_PI));
     cv::Point2f pts[4];
     rrect.points(pts);
-
-    int id = meta->_track_id;
-    int label = meta->_label;
-    int color_idx = (id != -1) ? id : (label >= 0 ? label : 0);
-    cv::Scalar bgr_color = COLORS[color_idx % COLORS.size()];
-    YUVColor yuv_color = bgr_to_yuv_bt601(
-        static_cast<uint8_t>(bgr_color[0]),
-        static_cast<uint8_t>(bgr_color[1]),
-        static_cast<uint8_t>(bgr_color[2]));
+    YUVColor yuv_color = style.yuv;
 
     // Draw on Y plane
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride_y);
     for (int i = 0; i < 4; i++)
-        cv::line(y_mat, pts[i], pts[(i + 1) % 4], cv::Scalar(yuv_color.y), 2, cv::LINE_AA);
+        banded_line(y_mat, row0, row1, pts[i], pts[(i + 1) % 4], cv::Scalar(yuv_color.y), 2,
+                    cv::LINE_AA);
 
     // Draw on interleaved UV plane (CV_8UC2)
+    int uv_row0, uv_row1;
+    band_rows(band, height / 2, 2, uv_row0, uv_row1);
     cv::Mat uv_mat(height / 2, width / 2, CV_8UC2, uv_plane, stride_uv);
     cv::Point2f uv_pts[4];
     for (int i = 0; i < 4; i++) {
@@ -795,16 +968,12 @@ void draw_obb_nv12(uint8_t *y_plane, uint8_t *uv_plane,
         uv_pts[i].y = pts[i].y / 2.0f;
     }
     for (int i = 0; i < 4; i++)
-        cv::line(uv_mat, uv_pts[i], uv_pts[(i + 1) % 4], cv::Scalar(yuv_color.u, yuv_color.v), 1, cv::LINE_AA);
+        banded_line(uv_mat, uv_row0, uv_row1, uv_pts[i], uv_pts[(i + 1) % 4],
+                    cv::Scalar(yuv_color.u, yuv_color.v), 1, cv::LINE_AA);
 
     // Draw label text
-    std::string text;
-    if (id != -1) {
-        text = std::to_string(id);
-    } else if (label != -1) {
-        text = cv::format("%s %.2f", meta->_label_name.c_str(), meta->_confidence);
-    }
-    if (!text.empty()) {
+    const dxs::TextSprite *text = style.label;
+    if (text) {
         float min_y = pts[0].y;
         int min_idx = 0;
         for (int i = 1; i < 4; i++) {
@@ -812,37 +981,38 @@ void draw_obb_nv12(uint8_t *y_plane, uint8_t *uv_plane,
         }
         int tx = static_cast<int>(pts[min_idx].x);
         int ty = static_cast<int>(pts[min_idx].y) - 2;
-        double font_scale = 0.00075 * std::min(width, height);
-        int baseline = 0;
-        auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 1, &baseline);
-        int bg_x2 = std::min(width, tx + text_size.width);
-        int bg_y1 = std::max(0, ty - text_size.height);
+        int bg_x2 = std::min(width, tx + text->width);
+        int bg_y1 = std::max(0, ty - text->height);
         draw_filled_rect_nv12(y_plane, uv_plane, stride_y, stride_uv,
-                              width, height, tx, bg_y1, bg_x2, ty + 2, yuv_color);
-        draw_text_y_plane(y_plane, stride_y, width, height,
-                         text.c_str(), tx, ty, font_scale);
+                              width, height, tx, bg_y1, bg_x2, ty + 2, yuv_color, band);
+        draw_text_y_plane(y_plane, stride_y, width, height, *text, tx, ty, band);
     }
 }
 
 void draw_face_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                       const DXObjectMeta *meta, float sx, float sy) {
+                       const DXObjectMeta *meta, float sx, float sy, const OsdBand &band) {
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
     cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride);
     for (size_t i = 0; i + 2 < meta->_face_landmarks.size(); i += 3) {
         float fx = meta->_face_landmarks[i];
         float fy = meta->_face_landmarks[i + 1];
-        cv::circle(y_mat, cv::Point(int(fx / sx), int(fy / sy)), 3, cv::Scalar(235), -1, cv::LINE_AA);
+        banded_circle(y_mat, row0, row1, cv::Point(int(fx / sx), int(fy / sy)), 3, cv::Scalar(235));
     }
     if (meta->_face_box[2] > meta->_face_box[0] && meta->_face_box[3] > meta->_face_box[1]) {
-        cv::rectangle(y_mat,
-            cv::Rect(cv::Point(int(meta->_face_box[0] / sx), int(meta->_face_box[1] / sy)),
-                     cv::Point(int(meta->_face_box[2] / sx), int(meta->_face_box[3] / sy))),
-            cv::Scalar(235), 2);
+        banded_rectangle(y_mat, row0, row1,
+                         cv::Point(int(meta->_face_box[0] / sx), int(meta->_face_box[1] / sy)),
+                         cv::Point(int(meta->_face_box[2] / sx), int(meta->_face_box[3] / sy)),
+                         cv::Scalar(235), 2);
     }
 }
 
-void draw_instance_segmentation_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
-                            int stride_y, int stride_uv, int width, int height,
-                            const DXObjectMeta *meta, float sx, float sy) {
+// Y (plane 0) and the 4:2:0 chroma of an instance mask; `chroma` is one
+// interleaved UV plane (NV12) or the U and V planes (I420).
+static void blend_instance_yuv(uint8_t *y_plane, int stride_y, uint8_t *const *chroma,
+                               int chroma_planes, int stride_uv, int width, int height,
+                               const DXObjectMeta *meta, float sx, float sy,
+                               const OsdBand &band) {
     cv::Rect roi;
     if (!get_instance_mask_roi(meta, width, height, sx, sy, roi))
         return;
@@ -853,199 +1023,83 @@ void draw_instance_segmentation_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t
         static_cast<uint8_t>(color[1]),
         static_cast<uint8_t>(color[2]));
 
-    cv::Mat mask = resize_instance_mask(meta, roi.size());
-
-    cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride_y);
-    cv::Mat y_roi = y_mat(roi);
-    cv::Mat seg_y(roi.height, roi.width, CV_8UC1, cv::Scalar(yuv.y));
-    cv::Mat blend_y;
-    cv::addWeighted(y_roi, 0.6, seg_y, 0.4, 0.0, blend_y);
-    blend_y.copyTo(y_roi, mask);
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
+    blend_mask_plane(y_plane, stride_y, 1, roi, row0, row1, meta, &yuv.y);
 
     cv::Rect uv_roi = get_uv_roi(roi, width, height);
     if (uv_roi.width <= 0 || uv_roi.height <= 0)
         return;
-
-    cv::Mat mask_uv;
-    cv::resize(mask, mask_uv, uv_roi.size(), 0, 0, cv::INTER_NEAREST);
-
-    cv::Mat u_mat(height / 2, width / 2, CV_8UC1, u_plane, stride_uv);
-    cv::Mat v_mat(height / 2, width / 2, CV_8UC1, v_plane, stride_uv);
-    cv::Mat u_roi = u_mat(uv_roi);
-    cv::Mat v_roi = v_mat(uv_roi);
-    cv::Mat seg_u(uv_roi.height, uv_roi.width, CV_8UC1, cv::Scalar(yuv.u));
-    cv::Mat seg_v(uv_roi.height, uv_roi.width, CV_8UC1, cv::Scalar(yuv.v));
-    cv::Mat blend_u, blend_v;
-    cv::addWeighted(u_roi, 0.6, seg_u, 0.4, 0.0, blend_u);
-    cv::addWeighted(v_roi, 0.6, seg_v, 0.4, 0.0, blend_v);
-    blend_u.copyTo(u_roi, mask_uv);
-    blend_v.copyTo(v_roi, mask_uv);
+    band_rows(band, height / 2, 2, row0, row1);
+    if (chroma_planes == 1) {
+        const uint8_t uv[2] = {yuv.u, yuv.v};
+        blend_mask_plane(chroma[0], stride_uv, 2, uv_roi, row0, row1, meta, uv);
+    } else {
+        blend_mask_plane(chroma[0], stride_uv, 1, uv_roi, row0, row1, meta, &yuv.u);
+        blend_mask_plane(chroma[1], stride_uv, 1, uv_roi, row0, row1, meta, &yuv.v);
+    }
 }
 
-void draw_instance_segmentation_nv12(uint8_t *y_plane, uint8_t *uv_plane,
+void draw_instance_segmentation_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                             int stride_y, int stride_uv, int width, int height,
-                            const DXObjectMeta *meta, float sx, float sy) {
-    cv::Rect roi;
-    if (!get_instance_mask_roi(meta, width, height, sx, sy, roi))
-        return;
-
-    cv::Scalar color = get_instance_color_bgr(meta);
-    YUVColor yuv = bgr_to_yuv_bt601(
-        static_cast<uint8_t>(color[0]),
-        static_cast<uint8_t>(color[1]),
-        static_cast<uint8_t>(color[2]));
-
-    cv::Mat mask = resize_instance_mask(meta, roi.size());
-
-    cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride_y);
-    cv::Mat y_roi = y_mat(roi);
-    cv::Mat seg_y(roi.height, roi.width, CV_8UC1, cv::Scalar(yuv.y));
-    cv::Mat blend_y;
-    cv::addWeighted(y_roi, 0.6, seg_y, 0.4, 0.0, blend_y);
-    blend_y.copyTo(y_roi, mask);
-
-    cv::Rect uv_roi = get_uv_roi(roi, width, height);
-    if (uv_roi.width <= 0 || uv_roi.height <= 0)
-        return;
-
-    cv::Mat mask_uv;
-    cv::resize(mask, mask_uv, uv_roi.size(), 0, 0, cv::INTER_NEAREST);
-
-    cv::Mat uv_mat(height / 2, width / 2, CV_8UC2, uv_plane, stride_uv);
-    cv::Mat uv_roi_view = uv_mat(uv_roi);
-    cv::Mat seg_uv(uv_roi.height, uv_roi.width, CV_8UC2, cv::Scalar(yuv.u, yuv.v));
-    cv::Mat blend_uv;
-    cv::addWeighted(uv_roi_view, 0.6, seg_uv, 0.4, 0.0, blend_uv);
-    blend_uv.copyTo(uv_roi_view, mask_uv);
+                            const DXObjectMeta *meta, float sx, float sy,
+                            const OsdBand &band) {
+    uint8_t *chroma[2] = {u_plane, v_plane};
+    blend_instance_yuv(y_plane, stride_y, chroma, 2, stride_uv, width, height, meta, sx, sy,
+                       band);
 }
 
-// Internal helper: draw YUV I420 segmentation from raw data
-// Resize class-index map with INTER_NEAREST, then colorize at target resolution
-static void draw_seg_i420_impl(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
-                               int stride_y, int stride_uv, int width, int height,
-                               const unsigned char* data, int seg_w, int seg_h, bool skip_bg) {
-    size_t color_count = COLORS.size();
-
-    cv::Mat seg_map(seg_h, seg_w, CV_8UC1, const_cast<unsigned char*>(data));
-    cv::Mat resized_map;
-    cv::resize(seg_map, resized_map, cv::Size(width, height), 0, 0, cv::INTER_NEAREST);
-
-    cv::Mat seg_y(height, width, CV_8UC1, cv::Scalar(0));
-    cv::Mat seg_mask(height, width, CV_8UC1, cv::Scalar(0));
-    for (int i = 0; i < height * width; ++i) {
-        int cls = resized_map.data[i];
-        if (skip_bg && cls == 255) continue;
-        const cv::Scalar &c = COLORS[cls % color_count];
-        YUVColor yuv = bgr_to_yuv_bt601(
-            static_cast<uint8_t>(c[0]), static_cast<uint8_t>(c[1]), static_cast<uint8_t>(c[2]));
-        seg_y.data[i] = yuv.y;
-        seg_mask.data[i] = 255;
-    }
-
-    cv::Mat resized_map_uv;
-    cv::resize(resized_map, resized_map_uv, cv::Size(width / 2, height / 2), 0, 0, cv::INTER_NEAREST);
-    cv::Mat seg_u(height / 2, width / 2, CV_8UC1, cv::Scalar(128));
-    cv::Mat seg_v(height / 2, width / 2, CV_8UC1, cv::Scalar(128));
-    cv::Mat mask_uv(height / 2, width / 2, CV_8UC1, cv::Scalar(0));
-    for (int i = 0; i < (height / 2) * (width / 2); ++i) {
-        int cls = resized_map_uv.data[i];
-        if (skip_bg && cls == 255) continue;
-        const cv::Scalar &c = COLORS[cls % color_count];
-        YUVColor yuv = bgr_to_yuv_bt601(
-            static_cast<uint8_t>(c[0]), static_cast<uint8_t>(c[1]), static_cast<uint8_t>(c[2]));
-        seg_u.data[i] = yuv.u;
-        seg_v.data[i] = yuv.v;
-        mask_uv.data[i] = 255;
-    }
-
-    cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride_y);
-    cv::Mat blend_y;
-    cv::addWeighted(y_mat, 0.6, seg_y, 0.4, 0.0, blend_y);
-    blend_y.copyTo(y_mat, seg_mask);
-
-    cv::Mat u_mat(height / 2, width / 2, CV_8UC1, u_plane, stride_uv);
-    cv::Mat v_mat(height / 2, width / 2, CV_8UC1, v_plane, stride_uv);
-    cv::Mat blend_u, blend_v;
-    cv::addWeighted(u_mat, 0.6, seg_u, 0.4, 0.0, blend_u);
-    cv::addWeighted(v_mat, 0.6, seg_v, 0.4, 0.0, blend_v);
-    blend_u.copyTo(u_mat, mask_uv);
-    blend_v.copyTo(v_mat, mask_uv);
-}
-
-// Internal helper: draw YUV NV12 segmentation from raw data
-static void draw_seg_nv12_impl(uint8_t *y_plane, uint8_t *uv_plane,
-                               int stride_y, int stride_uv, int width, int height,
-                               const unsigned char* data, int seg_w, int seg_h, bool skip_bg) {
-    size_t color_count = COLORS.size();
-
-    cv::Mat seg_map(seg_h, seg_w, CV_8UC1, const_cast<unsigned char*>(data));
-    cv::Mat resized_map;
-    cv::resize(seg_map, resized_map, cv::Size(width, height), 0, 0, cv::INTER_NEAREST);
-
-    cv::Mat seg_y(height, width, CV_8UC1, cv::Scalar(0));
-    cv::Mat seg_mask(height, width, CV_8UC1, cv::Scalar(0));
-    for (int i = 0; i < height * width; ++i) {
-        int cls = resized_map.data[i];
-        if (skip_bg && cls == 255) continue;
-        const cv::Scalar &c = COLORS[cls % color_count];
-        YUVColor yuv = bgr_to_yuv_bt601(
-            static_cast<uint8_t>(c[0]), static_cast<uint8_t>(c[1]), static_cast<uint8_t>(c[2]));
-        seg_y.data[i] = yuv.y;
-        seg_mask.data[i] = 255;
-    }
-
-    cv::Mat resized_map_uv;
-    cv::resize(resized_map, resized_map_uv, cv::Size(width / 2, height / 2), 0, 0, cv::INTER_NEAREST);
-    cv::Mat seg_uv(height / 2, width / 2, CV_8UC2, cv::Scalar(128, 128));
-    cv::Mat mask_uv(height / 2, width / 2, CV_8UC1, cv::Scalar(0));
-    for (int row = 0; row < height / 2; ++row) {
-        for (int col = 0; col < width / 2; ++col) {
-            int cls = resized_map_uv.at<uint8_t>(row, col);
-            if (skip_bg && cls == 255) continue;
-            const cv::Scalar &c = COLORS[cls % color_count];
-            YUVColor yuv = bgr_to_yuv_bt601(
-                static_cast<uint8_t>(c[0]), static_cast<uint8_t>(c[1]), static_cast<uint8_t>(c[2]));
-            seg_uv.at<cv::Vec2b>(row, col) = cv::Vec2b(yuv.u, yuv.v);
-            mask_uv.at<uint8_t>(row, col) = 255;
-        }
-    }
-
-    cv::Mat y_mat(height, width, CV_8UC1, y_plane, stride_y);
-    cv::Mat blend_y;
-    cv::addWeighted(y_mat, 0.6, seg_y, 0.4, 0.0, blend_y);
-    blend_y.copyTo(y_mat, seg_mask);
-
-    cv::Mat uv_mat(height / 2, width / 2, CV_8UC2, uv_plane, stride_uv);
-    cv::Mat blend_uv;
-    cv::addWeighted(uv_mat, 0.6, seg_uv, 0.4, 0.0, blend_uv);
-    blend_uv.copyTo(uv_mat, mask_uv);
+void draw_instance_segmentation_nv12(uint8_t *y_plane, uint8_t *uv_plane,
+                            int stride_y, int stride_uv, int width, int height,
+                            const DXObjectMeta *meta, float sx, float sy,
+                            const OsdBand &band) {
+    blend_instance_yuv(y_plane, stride_y, &uv_plane, 1, stride_uv, width, height, meta, sx, sy,
+                       band);
 }
 
 void draw_semantic_segmentation_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                                   int stride_y, int stride_uv, int width, int height,
-                                  const DXFrameMeta *meta) {
-    if (meta->_seg_data.empty()) return;
-    draw_seg_i420_impl(y_plane, u_plane, v_plane, stride_y, stride_uv,
-                       width, height, meta->_seg_data.data(), meta->_seg_width, meta->_seg_height, false);
+                                  const DXFrameMeta *meta, const OsdBand &band) {
+    if (!has_seg_map(meta)) return;
+    const unsigned char *seg = meta->_seg_data.data();
+    int seg_w = meta->_seg_width, seg_h = meta->_seg_height;
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
+    blend_seg_plane(y_plane, stride_y, width, row0, row1, 1, width, height,
+                    seg, seg_w, seg_h, SegPlane::Y);
+    band_rows(band, height / 2, 2, row0, row1);
+    blend_seg_plane(u_plane, stride_uv, width / 2, row0, row1, 2, width, height,
+                    seg, seg_w, seg_h, SegPlane::U);
+    blend_seg_plane(v_plane, stride_uv, width / 2, row0, row1, 2, width, height,
+                    seg, seg_w, seg_h, SegPlane::V);
 }
 
 void draw_semantic_segmentation_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                                   int stride_y, int stride_uv, int width, int height,
-                                  const DXFrameMeta *meta) {
-    if (meta->_seg_data.empty()) return;
-    draw_seg_nv12_impl(y_plane, uv_plane, stride_y, stride_uv,
-                       width, height, meta->_seg_data.data(), meta->_seg_width, meta->_seg_height, false);
+                                  const DXFrameMeta *meta, const OsdBand &band) {
+    if (!has_seg_map(meta)) return;
+    const unsigned char *seg = meta->_seg_data.data();
+    int seg_w = meta->_seg_width, seg_h = meta->_seg_height;
+    int row0, row1;
+    band_rows(band, height, 1, row0, row1);
+    blend_seg_plane(y_plane, stride_y, width, row0, row1, 1, width, height,
+                    seg, seg_w, seg_h, SegPlane::Y);
+    band_rows(band, height / 2, 2, row0, row1);
+    blend_seg_plane(uv_plane, stride_uv, width / 2, row0, row1, 2, width, height,
+                    seg, seg_w, seg_h, SegPlane::UV);
 }
 
 void draw_object_meta_yuv_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                                int stride_y, int stride_uv, int width, int height,
-                               const DXObjectMeta *meta, float scale_x, float scale_y) {
+                               const DXObjectMeta *meta, const OsdObjectStyle &style,
+                               float scale_x, float scale_y, const OsdBand &band) {
     // Draw segmentation, pose keypoints, OBB and face landmarks first — they don't need _box
     draw_instance_segmentation_i420(y_plane, u_plane, v_plane, stride_y, stride_uv,
-                                    width, height, meta, scale_x, scale_y);
-    draw_keypoints_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y);
-    draw_obb_i420(y_plane, u_plane, v_plane, stride_y, stride_uv, width, height, meta, scale_x, scale_y);
-    draw_face_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y);
+                                    width, height, meta, scale_x, scale_y, band);
+    draw_keypoints_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y, band);
+    draw_obb_i420(y_plane, u_plane, v_plane, stride_y, stride_uv, width, height, meta, style,
+                  scale_x, scale_y, band);
+    draw_face_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y, band);
 
     // OBB objects have their own drawing — skip AABB for them
     if (meta->_obb.size() == 5) return;
@@ -1060,53 +1114,34 @@ void draw_object_meta_yuv_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_pl
     auto x2 = static_cast<int>(meta->_box[2] / scale_x);
     auto y2 = static_cast<int>(meta->_box[3] / scale_y);
 
-    // Choose color based on track_id or label
-    int id = meta->_track_id;
-    int label = meta->_label;
-    int color_idx = (id != -1) ? id : label;
-    if (color_idx < 0) color_idx = 0;
-
-    cv::Scalar bgr_color = COLORS[color_idx % COLORS.size()];
-    YUVColor yuv_color = bgr_to_yuv_bt601(
-        static_cast<uint8_t>(bgr_color[0]),
-        static_cast<uint8_t>(bgr_color[1]),
-        static_cast<uint8_t>(bgr_color[2])
-    );
+    YUVColor yuv_color = style.yuv;
 
     // Draw colored bounding box
     draw_rectangle_i420(y_plane, u_plane, v_plane, stride_y, stride_uv,
-                        width, height, x1, y1, x2, y2, yuv_color, 2);
+                        width, height, x1, y1, x2, y2, yuv_color, 2, band);
 
     // Draw white text label
-    std::string text;
-    if (id != -1) {
-        text = std::to_string(id);
-    } else if (label != -1) {
-        text = cv::format("%s %.2f", meta->_label_name.c_str(), meta->_confidence);
-    }
-
-    if (!text.empty()) {
-        double font_scale = 0.00075 * std::min(width, height);
-        int baseline = 0;
-        auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 1, &baseline);
-        int bg_x2 = std::min(width, x1 + text_size.width);
-        int bg_y1 = std::max(0, y1 - text_size.height - 2);
+    const dxs::TextSprite *text = style.label;
+    if (text) {
+        int bg_x2 = std::min(width, x1 + text->width);
+        int bg_y1 = std::max(0, y1 - text->height - 2);
         draw_filled_rect_i420(y_plane, u_plane, v_plane, stride_y, stride_uv,
-                              width, height, x1, bg_y1, bg_x2, y1, yuv_color);
-        draw_text_y_plane(y_plane, stride_y, width, height,
-                         text.c_str(), x1, y1 - 2, font_scale);
+                              width, height, x1, bg_y1, bg_x2, y1, yuv_color, band);
+        draw_text_y_plane(y_plane, stride_y, width, height, *text, x1, y1 - 2, band);
     }
 }
 
 void draw_object_meta_yuv_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                                int stride_y, int stride_uv, int width, int height,
-                               const DXObjectMeta *meta, float scale_x, float scale_y) {
+                               const DXObjectMeta *meta, const OsdObjectStyle &style,
+                               float scale_x, float scale_y, const OsdBand &band) {
     // Draw segmentation, pose keypoints, OBB and face landmarks first — they don't need _box
     draw_instance_segmentation_nv12(y_plane, uv_plane, stride_y, stride_uv,
-                                    width, height, meta, scale_x, scale_y);
-    draw_keypoints_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y);
-    draw_obb_nv12(y_plane, uv_plane, stride_y, stride_uv, width, height, meta, scale_x, scale_y);
-    draw_face_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y);
+                                    width, height, meta, scale_x, scale_y, band);
+    draw_keypoints_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y, band);
+    draw_obb_nv12(y_plane, uv_plane, stride_y, stride_uv, width, height, meta, style, scale_x,
+                  scale_y, band);
+    draw_face_y_plane(y_plane, stride_y, width, height, meta, scale_x, scale_y, band);
 
     // OBB objects have their own drawing — skip AABB for them
     if (meta->_obb.size() == 5) return;
@@ -1121,40 +1156,56 @@ void draw_object_meta_yuv_nv12(uint8_t *y_plane, uint8_t *uv_plane,
     auto x2 = static_cast<int>(meta->_box[2] / scale_x);
     auto y2 = static_cast<int>(meta->_box[3] / scale_y);
 
-    // Choose color
-    int id = meta->_track_id;
-    int label = meta->_label;
-    int color_idx = (id != -1) ? id : label;
-    if (color_idx < 0) color_idx = 0;
-
-    cv::Scalar bgr_color = COLORS[color_idx % COLORS.size()];
-    YUVColor yuv_color = bgr_to_yuv_bt601(
-        static_cast<uint8_t>(bgr_color[0]),
-        static_cast<uint8_t>(bgr_color[1]),
-        static_cast<uint8_t>(bgr_color[2])
-    );
+    YUVColor yuv_color = style.yuv;
 
     // Draw colored bounding box
     draw_rectangle_nv12(y_plane, uv_plane, stride_y, stride_uv,
-                        width, height, x1, y1, x2, y2, yuv_color, 2);
+                        width, height, x1, y1, x2, y2, yuv_color, 2, band);
 
     // Draw white text label
-    std::string text;
-    if (id != -1) {
-        text = std::to_string(id);
-    } else if (label != -1) {
-        text = cv::format("%s %.2f", meta->_label_name.c_str(), meta->_confidence);
+    const dxs::TextSprite *text = style.label;
+    if (text) {
+        int bg_x2 = std::min(width, x1 + text->width);
+        int bg_y1 = std::max(0, y1 - text->height - 2);
+        draw_filled_rect_nv12(y_plane, uv_plane, stride_y, stride_uv,
+                              width, height, x1, bg_y1, bg_x2, y1, yuv_color, band);
+        draw_text_y_plane(y_plane, stride_y, width, height, *text, x1, y1 - 2, band);
     }
+}
 
-    if (!text.empty()) {
-        double font_scale = 0.00075 * std::min(width, height);
-        int baseline = 0;
-        auto text_size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, font_scale, 1, &baseline);
-        int bg_x2 = std::min(width, x1 + text_size.width);
-        int bg_y1 = std::max(0, y1 - text_size.height - 2);
-        draw_filled_rect_nv12(y_plane, uv_plane, stride_y, stride_uv,
-                              width, height, x1, bg_y1, bg_x2, y1, yuv_color);
-        draw_text_y_plane(y_plane, stride_y, width, height,
-                         text.c_str(), x1, y1 - 2, font_scale);
+// ==================== Frame ====================
+
+void draw_frame_meta(const OsdFrame &frame, const DXFrameMeta *meta, const OsdFrameStyle &style,
+                     const OsdBand &band) {
+    const int width = frame.width;
+    const int height = frame.height;
+    float scale_x = static_cast<float>(meta->_width) / width;
+    float scale_y = static_cast<float>(meta->_height) / height;
+    uint8_t *const *p = frame.planes;
+    const int *s = frame.strides;
+
+    switch (frame.format) {
+    case OsdFrame::Format::PACKED: {
+        cv::Mat surface(height, width, CV_8UC3, p[0], s[0]);
+        draw_semantic_segmentation(surface, meta, band);
+        for (size_t i = 0; i < meta->_object_meta_list.size(); i++)
+            draw_object_meta(surface, meta->_object_meta_list[i], style.objects[i], scale_x,
+                             scale_y, band);
+        break;
+    }
+    case OsdFrame::Format::NV12:
+        draw_semantic_segmentation_nv12(p[0], p[1], s[0], s[1], width, height, meta, band);
+        for (size_t i = 0; i < meta->_object_meta_list.size(); i++)
+            draw_object_meta_yuv_nv12(p[0], p[1], s[0], s[1], width, height,
+                                      meta->_object_meta_list[i], style.objects[i], scale_x,
+                                      scale_y, band);
+        break;
+    case OsdFrame::Format::I420:
+        draw_semantic_segmentation_i420(p[0], p[1], p[2], s[0], s[1], width, height, meta, band);
+        for (size_t i = 0; i < meta->_object_meta_list.size(); i++)
+            draw_object_meta_yuv_i420(p[0], p[1], p[2], s[0], s[1], width, height,
+                                      meta->_object_meta_list[i], style.objects[i], scale_x,
+                                      scale_y, band);
+        break;
     }
 }
@@ -1,14 +1,52 @@
 #pragma once
+#include <limits>
 #include <vector>
 #include <opencv2/opencv.hpp>
 #include "./../metadata/gst-dxframemeta.hpp"
 #include "./../metadata/gst-dxobjectmeta.hpp"
+#include "dxosd_text.hpp"
 
 // YUV color structure
 struct YUVColor {
     uint8_t y, u, v;
 };
 
+// Frame rows [begin, end) a draw call may modify. Band-parallel rendering
+// gives every worker one band of the frame; each primitive is clipped to it
+// so that the bands together are pixel-identical to drawing the whole frame
+// at once (the default). Band edges are even, for 4:2:0 chroma rows.
+struct OsdBand {
+    int begin = 0;
+    int end = std::numeric_limits<int>::max();
+};
+
+// A mapped frame: packed 3-channel (RGB / BGR) in plane 0, or NV12 / I420.
+struct OsdFrame {
+    enum class Format { PACKED, NV12, I420 };
+    Format format = Format::PACKED;
+    uint8_t *planes[3] = {nullptr, nullptr, nullptr};
+    int strides[3] = {0, 0, 0};
+    int width = 0;
+    int height = 0;
+};
+
+// How one object is drawn, resolved once per frame by dxs::OsdRenderCache
+// (dxosd_cache.hpp) and only read while drawing, by every band.
+struct OsdObjectStyle {
+    const dxs::TextSprite *label = nullptr;    // track id or name + confidence
+    const dxs::TextSprite *caption = nullptr;  // CLIP caption
+    cv::Scalar color;                          // BGR, by track_id, else label
+    YUVColor yuv = {0, 0, 0};                  // BT.601 of color
+};
+
+// A CLIP result: its caption rides on an object with no box and no label.
+bool is_clip(const DXObjectMeta *meta);
+
+// Styles of a frame's objects, in _object_meta_list order.
+struct OsdFrameStyle {
+    std::vector<OsdObjectStyle> objects;
+};
+
 // Shared skeleton and color definitions for pose/OSD
 extern const std::vector<std::vector<int>> skeleton;
 extern const std::vector<cv::Scalar> pose_limb_color;
@@ -16,14 +54,21 @@ extern const std::vector<cv::Scalar> pose_kpt_color;
 extern const std::vector<cv::Scalar> COLORS;
 
 // BGR drawing functions
-void draw_semantic_segmentation(cv::Mat &img, const DXFrameMeta *meta);
-void draw_instance_segmentation(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy);
-void draw_keypoints(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy);
-void draw_obb(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy);
-void draw_face(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy);
-void draw_label_or_id(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy);
-void draw_clip(cv::Mat &img, const DXObjectMeta *meta, bool v3_clip_text = false);
-void draw_object_meta(cv::Mat &img, const DXObjectMeta *meta, float scale_x, float scale_y, bool v3_clip_text = false);
+void draw_semantic_segmentation(cv::Mat &img, const DXFrameMeta *meta,
+                                const OsdBand &band = OsdBand());
+void draw_instance_segmentation(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy,
+                                const OsdBand &band = OsdBand());
+void draw_keypoints(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy,
+                    const OsdBand &band = OsdBand());
+void draw_obb(cv::Mat &img, const DXObjectMeta *meta, const OsdObjectStyle &style,
+              float sx, float sy, const OsdBand &band = OsdBand());
+void draw_face(cv::Mat &img, const DXObjectMeta *meta, float sx, float sy,
+               const OsdBand &band = OsdBand());
+void draw_label_or_id(cv::Mat &img, const DXObjectMeta *meta, const OsdObjectStyle &style,
+                      float sx, float sy, const OsdBand &band = OsdBand());
+void draw_clip(cv::Mat &img, const OsdObjectStyle &style, const OsdBand &band = OsdBand());
+void draw_object_meta(cv::Mat &img, const DXObjectMeta *meta, const OsdObjectStyle &style,
+                      float scale_x, float scale_y, const OsdBand &band = OsdBand());
 
 // YUV utility functions
 YUVColor bgr_to_yuv_bt601(uint8_t b, uint8_t g, uint8_t r);
@@ -31,52 +76,75 @@ YUVColor bgr_to_yuv_bt601(uint8_t b, uint8_t g, uint8_t r);
 // YUV drawing functions for I420
 void draw_rectangle_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                          int stride_y, int stride_uv, int width, int height,
-                         int x1, int y1, int x2, int y2, YUVColor color, int thickness);
+                         int x1, int y1, int x2, int y2, YUVColor color, int thickness,
+                         const OsdBand &band = OsdBand());
 void draw_filled_rect_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                            int stride_y, int stride_uv, int width, int height,
-                           int x1, int y1, int x2, int y2, YUVColor color);
+                           int x1, int y1, int x2, int y2, YUVColor color,
+                           const OsdBand &band = OsdBand());
 
 // YUV drawing functions for NV12
 void draw_rectangle_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                          int stride_y, int stride_uv, int width, int height,
-                         int x1, int y1, int x2, int y2, YUVColor color, int thickness);
+                         int x1, int y1, int x2, int y2, YUVColor color, int thickness,
+                         const OsdBand &band = OsdBand());
 void draw_filled_rect_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                            int stride_y, int stride_uv, int width, int height,
-                           int x1, int y1, int x2, int y2, YUVColor color);
+                           int x1, int y1, int x2, int y2, YUVColor color,
+                           const OsdBand &band = OsdBand());
 
 // White text on Y plane only (for both I420 and NV12)
 void draw_text_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                       const char *text, int x, int y, double scale);
+                       const dxs::TextSprite &text, int x, int y,
+                       const OsdBand &band = OsdBand());
 void draw_keypoints_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                            const DXObjectMeta *meta, float sx, float sy);
+                            const DXObjectMeta *meta, float sx, float sy,
+                            const OsdBand &band = OsdBand());
 void draw_obb_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                      const DXObjectMeta *meta, float sx, float sy);
+                      const DXObjectMeta *meta, const OsdObjectStyle &style, float sx, float sy,
+                      const OsdBand &band = OsdBand());
 void draw_obb_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                    int stride_y, int stride_uv, int width, int height,
-                   const DXObjectMeta *meta, float sx, float sy);
+                   const DXObjectMeta *meta, const OsdObjectStyle &style, float sx, float sy,
+                   const OsdBand &band = OsdBand());
 void draw_obb_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                    int stride_y, int stride_uv, int width, int height,
-                   const DXObjectMeta *meta, float sx, float sy);
+                   const DXObjectMeta *meta, const OsdObjectStyle &style, float sx, float sy,
+                   const OsdBand &band = OsdBand());
 void draw_face_y_plane(uint8_t *y_plane, int stride, int width, int height,
-                       const DXObjectMeta *meta, float sx, float sy);
+                       const DXObjectMeta *meta, float sx, float sy,
+                       const OsdBand &band = OsdBand());
 void draw_instance_segmentation_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                             int stride_y, int stride_uv, int width, int height,
-                            const DXObjectMeta *meta, float sx, float sy);
+                            const DXObjectMeta *meta, float sx, float sy,
+                            const OsdBand &band = OsdBand());
 void draw_instance_segmentation_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                             int stride_y, int stride_uv, int width, int height,
-                            const DXObjectMeta *meta, float sx, float sy);
+                            const DXObjectMeta *meta, float sx, float sy,
+                            const OsdBand &band = OsdBand());
 void draw_semantic_segmentation_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                                   int stride_y, int stride_uv, int width, int height,
-                                  const DXFrameMeta *meta);
+                                  const DXFrameMeta *meta,
+                                  const OsdBand &band = OsdBand());
 void draw_semantic_segmentation_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                                   int stride_y, int stride_uv, int width, int height,
-                                  const DXFrameMeta *meta);
+                                  const DXFrameMeta *meta,
+                                  const OsdBand &band = OsdBand());
 
 // High-level YUV drawing functions
 void draw_object_meta_yuv_i420(uint8_t *y_plane, uint8_t *u_plane, uint8_t *v_plane,
                                int stride_y, int stride_uv, int width, int height,
-                               const DXObjectMeta *meta, float scale_x, float scale_y);
+                               const DXObjectMeta *meta, const OsdObjectStyle &style,
+                               float scale_x, float scale_y,
+                               const OsdBand &band = OsdBand());
 
 void draw_object_meta_yuv_nv12(uint8_t *y_plane, uint8_t *uv_plane,
                                int stride_y, int stride_uv, int width, int height,
-                               const DXObjectMeta *meta, float scale_x, float scale_y);
\ No newline at end of file
+                               const DXObjectMeta *meta, const OsdObjectStyle &style,
+                               float scale_x, float scale_y,
+                               const OsdBand &band = OsdBand());
+
+// Everything dxosd draws for `meta` on `frame`: semantic segmentation, then
+// each object in list order, with the styles prepared for this frame.
+void draw_frame_meta(const OsdFrame &frame, const DXFrameMeta *meta, const OsdFrameStyle &style,
+                     const OsdBand &band = OsdBand());
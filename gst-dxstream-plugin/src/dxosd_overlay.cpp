@@ -0,0 +1,202 @@
+#include "dxosd_overlay.hpp"
+#include "dxosd_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
+namespace dxs {
+
+// Box outline thickness, as drawn into the frame.
+static constexpr int BOX_THICKNESS = 2;
+static constexpr int SOLID_SIZE = 4;
+
+// Native-endian 0xAARRGGBB, i.e. GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB.
+static uint32_t argb(uint8_t a, uint8_t r, uint8_t g, uint8_t b) {
+    return (static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(r) << 16) |
+           (static_cast<uint32_t>(g) << 8) | b;
+}
+
+static GstBuffer *new_argb_buffer(int width, int height, GstMapInfo &map) {
+    GstBuffer *buf = gst_buffer_new_allocate(nullptr, static_cast<gsize>(width) * height * 4,
+                                             nullptr);
+    gst_buffer_add_video_meta(buf, GST_VIDEO_FRAME_FLAG_NONE,
+                              GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, width, height);
+    gst_buffer_map(buf, &map, GST_MAP_WRITE);
+    return buf;
+}
+
+static int color_index(const DXObjectMeta *obj) {
+    int idx = obj->_track_id != -1 ? obj->_track_id : obj->_label;
+    return std::max(idx, 0) % static_cast<int>(COLORS.size());
+}
+
+bool OverlayCache::LabelKey::operator<(const LabelKey &o) const {
+    return std::tie(track_id, label, bucket, scale) <
+           std::tie(o.track_id, o.label, o.bucket, o.scale);
+}
+
+OverlayCache::~OverlayCache() {
+    clear();
+}
+
+void OverlayCache::clear() {
+    for (auto &entry : solids_)
+        gst_buffer_unref(entry.second);
+    for (auto &entry : labels_)
+        gst_buffer_unref(entry.second.pixels);
+    solids_.clear();
+    labels_.clear();
+}
+
+bool OverlayCache::can_compose(const DXFrameMeta *meta) {
+    if (!meta->_seg_data.empty())
+        return false;
+    for (const DXObjectMeta *obj : meta->_object_meta_list) {
+        bool face_box = obj->_face_box[2] > obj->_face_box[0] &&
+                        obj->_face_box[3] > obj->_face_box[1];
+        if (!obj->_seg_data.empty() || !obj->_keypoints.empty() || obj->_obb.size() == 5 ||
+            !obj->_face_landmarks.empty() || face_box || is_clip(obj))
+            return false;
+    }
+    return true;
+}
+
+GstBuffer *OverlayCache::solid(int color) {
+    GstBuffer *&buf = solids_[color];
+    if (!buf) {
+        const cv::Scalar &c = COLORS[color];
+        uint32_t px = argb(255, static_cast<uint8_t>(c[2]), static_cast<uint8_t>(c[1]),
+                           static_cast<uint8_t>(c[0]));
+        GstMapInfo map;
+        buf = new_argb_buffer(SOLID_SIZE, SOLID_SIZE, map);
+        std::fill_n(reinterpret_cast<uint32_t *>(map.data), SOLID_SIZE * SOLID_SIZE, px);
+        gst_buffer_unmap(buf, &map);
+    }
+    return buf;
+}
+
+// The label as drawn into the frame: the text sprite in white over a
+// background of the box colour filling the text box (edges included, as
+// cv::rectangle(FILLED) does), with the sprite's
+// anti-aliased margin transparent around it.
+const OverlayCache::Label *OverlayCache::label(const DXObjectMeta *obj, int color,
+                                               char sep, double font_scale) {
+    bool tracked = obj->_track_id != -1;
+    if (!tracked && obj->_label == -1)
+        return nullptr;
+    LabelKey key = {obj->_track_id, -1, 0, static_cast<int>(std::lround(font_scale * 1000.0))};
+    if (!tracked) {
+        key.label = obj->_label;
+        key.bucket = static_cast<int>(std::lround(obj->_confidence * 100.0f));
+    }
+    auto it = labels_.find(key);
+    if (it != labels_.end() && it->second.color == color && it->second.sep == sep &&
+        (tracked || it->second.name == obj->_label_name)) {
+        it->second.frame = frame_;
+        return &it->second;
+    }
+
+    const TextSprite *sprite = label_sprite_cache().get(obj->_track_id, obj->_label,
+                                                        obj->_label_name, obj->_confidence,
+                                                        sep, font_scale, 1);
+    if (!sprite || sprite->cols <= 0 || sprite->rows <= 0)
+        return nullptr;
+
+    const cv::Scalar &c = COLORS[color];
+    const int bg[3] = {static_cast<int>(c[2]), static_cast<int>(c[1]), static_cast<int>(c[0])};
+    GstMapInfo map;
+    GstBuffer *buf = new_argb_buffer(sprite->cols, sprite->rows, map);
+    auto *dst = reinterpret_cast<uint32_t *>(map.data);
+    for (int r = 0; r < sprite->rows; r++) {
+        bool bg_row = r >= sprite->pad && r <= sprite->pad + sprite->height;
+        for (int i = 0; i < sprite->cols; i++) {
+            int a = sprite->alpha[static_cast<size_t>(r) * sprite->cols + i];
+            bool on_bg = bg_row && i >= sprite->pad && i <= sprite->pad + sprite->width;
+            if (on_bg)
+                *dst++ = argb(255, blend(bg[0], 255, a), blend(bg[1], 255, a),
+                              blend(bg[2], 255, a));
+            else
+                *dst++ = argb(static_cast<uint8_t>(a), 255, 255, 255);
+        }
+    }
+    gst_buffer_unmap(buf, &map);
+
+    Label &entry = labels_[key];
+    if (entry.pixels)
+        gst_buffer_unref(entry.pixels);
+    entry.pixels = buf;
+    entry.x = -sprite->pad;
+    entry.y = -sprite->height - sprite->pad;
+    entry.width = sprite->cols;
+    entry.height = sprite->rows;
+    entry.color = color;
+    entry.sep = sep;
+    entry.name = tracked ? std::string() : obj->_label_name;
+    entry.frame = frame_;
+    return &entry;
+}
+
+GstVideoOverlayComposition *OverlayCache::compose(const DXFrameMeta *meta, int width,
+                                                  int height, GstVideoFormat format) {
+    frame_++;
+    // Same label text as OsdRenderCache::prepare() draws into the frame.
+    char sep = (format == GST_VIDEO_FORMAT_NV12 || format == GST_VIDEO_FORMAT_I420) ? ' ' : '=';
+    float sx = static_cast<float>(meta->_width) / width;
+    float sy = static_cast<float>(meta->_height) / height;
+    double font_scale = 0.00075 * std::min(width, height);
+
+    GstVideoOverlayComposition *comp = nullptr;
+    auto add = [&comp](GstBuffer *pixels, int x, int y, int w, int h) {
+        if (w <= 0 || h <= 0)
+            return;
+        GstVideoOverlayRectangle *rect = gst_video_overlay_rectangle_new_raw(
+            pixels, x, y, static_cast<guint>(w), static_cast<guint>(h),
+            GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+        if (!comp)
+            comp = gst_video_overlay_composition_new(rect);
+        else
+            gst_video_overlay_composition_add_rectangle(comp, rect);
+        gst_video_overlay_rectangle_unref(rect);
+    };
+
+    for (const DXObjectMeta *obj : meta->_object_meta_list) {
+        if (obj->_obb.size() == 5 || obj->_box[2] - obj->_box[0] <= 0 ||
+            obj->_box[3] - obj->_box[1] <= 0)
+            continue;
+        auto x1 = static_cast<int>(obj->_box[0] / sx);
+        auto y1 = static_cast<int>(obj->_box[1] / sy);
+        auto x2 = static_cast<int>(obj->_box[2] / sx);
+        auto y2 = static_cast<int>(obj->_box[3] / sy);
+        int color = color_index(obj);
+        // Like draw_box(), objects without a label are not drawn.
+        const Label *text = label(obj, color, sep, font_scale);
+        if (!text)
+            continue;
+
+        // Outline centred on the box edges, like cv::rectangle().
+        GstBuffer *edge = solid(color);
+        int t = BOX_THICKNESS;
+        int w = x2 - x1 + t;
+        int h = y2 - y1 + t;
+        add(edge, x1 - t / 2, y1 - t / 2, w, t);
+        add(edge, x1 - t / 2, y2 - t / 2, w, t);
+        add(edge, x1 - t / 2, y1 - t / 2, t, h);
+        add(edge, x2 - t / 2, y1 - t / 2, t, h);
+        add(text->pixels, x1 + text->x, y1 + text->y, text->width, text->height);
+    }
+
+    // Tracks (and untracked labels) missing from this frame are gone.
+    for (auto it = labels_.begin(); it != labels_.end();) {
+        if (it->second.frame == frame_) {
+            ++it;
+            continue;
+        }
+        gst_buffer_unref(it->second.pixels);
+        it = labels_.erase(it);
+    }
+    return comp;
+}
+
+} // namespace dxs
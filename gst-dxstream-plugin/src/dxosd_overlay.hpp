@@ -0,0 +1,79 @@
+#ifndef DXOSD_OVERLAY_HPP
+#define DXOSD_OVERLAY_HPP
+
+#include "./../metadata/gst-dxframemeta.hpp"
+#include "./../metadata/gst-dxobjectmeta.hpp"
+#include <gst/video/video.h>
+
+#include <map>
+#include <string>
+
+// ---------------------------------------------------------------------------
+// Overlay-composition output for dxosd (output-mode=composition)
+// ---------------------------------------------------------------------------
+// Instead of drawing into the frame, boxes and labels become ARGB
+// GstVideoOverlayRectangles for a GstVideoOverlayCompositionMeta, which a
+// compositor or sink blends (or dxosd itself, with
+// gst_video_overlay_composition_blend(), when downstream cannot). The
+// pixel buffers behind the rectangles are cached:
+//   box edges  one small solid-colour buffer per palette colour, stretched
+//              by the rectangle's render size
+//   labels     one sprite per track (or label and confidence), reused until
+//              its text or colour changes and dropped when the object is
+//              gone from a frame
+// so a stable tracked scene builds new rectangles but no new pixels.
+
+namespace dxs {
+
+class OverlayCache {
+  public:
+    OverlayCache() = default;
+    ~OverlayCache();
+
+    OverlayCache(const OverlayCache &) = delete;
+    OverlayCache &operator=(const OverlayCache &) = delete;
+
+    /** True if everything dxosd draws for `meta` is boxes and labels;
+     *  masks, poses, OBBs, faces and CLIP captions need the frame. */
+    static bool can_compose(const DXFrameMeta *meta);
+
+    /** Rectangles for the objects of `meta` on a width x height frame of
+     *  `format`; nullptr if there is nothing to draw. Labels not used by
+     *  this frame are evicted. */
+    GstVideoOverlayComposition *compose(const DXFrameMeta *meta, int width, int height,
+                                        GstVideoFormat format);
+
+    size_t labels() const { return labels_.size(); }
+    void clear();
+
+  private:
+    struct LabelKey {
+        int track_id;
+        int label;
+        int bucket;                /**< confidence * 100, untracked only */
+        int scale;                 /**< font scale * 1000 */
+        bool operator<(const LabelKey &o) const;
+    };
+    struct Label {
+        GstBuffer *pixels = nullptr;
+        int x = 0;                 /**< offset of the sprite from the text origin */
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        int color = -1;
+        char sep = 0;              /**< label text separator */
+        std::string name;          /**< untracked labels only */
+        guint64 frame = 0;         /**< last compose() that used it */
+    };
+
+    GstBuffer *solid(int color);
+    const Label *label(const DXObjectMeta *obj, int color, char sep, double font_scale);
+
+    std::map<int, GstBuffer *> solids_;
+    std::map<LabelKey, Label> labels_;
+    guint64 frame_ = 0;
+};
+
+} // namespace dxs
+
+#endif // DXOSD_OVERLAY_HPP
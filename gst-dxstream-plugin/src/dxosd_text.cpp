@@ -0,0 +1,246 @@
+#include "dxosd_text.hpp"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace dxs {
+
+namespace {
+
+// FONT_HERSHEY_SIMPLEX metrics at scale 1: with thickness 0 getTextSize()
+// returns the unrounded glyph advances and cap + base line.
+struct HersheyMetrics {
+    int advance[95];
+    int cap_base;
+    int base;
+
+    HersheyMetrics() {
+        int baseline = 0;
+        for (int c = 32; c < 127; c++) {
+            advance[c - 32] = cv::getTextSize(std::string(1, static_cast<char>(c)),
+                                              cv::FONT_HERSHEY_SIMPLEX, 1.0, 0, &baseline)
+                                  .width;
+        }
+        cap_base = cv::getTextSize(" ", cv::FONT_HERSHEY_SIMPLEX, 1.0, 0, &baseline).height;
+        base = baseline;
+    }
+};
+
+const HersheyMetrics &metrics() {
+    static const HersheyMetrics m;
+    return m;
+}
+
+inline int glyph_index(char ch) {
+    auto c = static_cast<unsigned char>(ch);
+    return (c < 32 || c > 126) ? '?' - 32 : c - 32;
+}
+
+inline int scale_key(double scale) {
+    return static_cast<int>(std::lround(scale * 1000.0));
+}
+
+} // namespace
+
+cv::Size text_size(const char *text, double scale, int thickness, int *baseline) {
+    const HersheyMetrics &m = metrics();
+    int units = 0;
+    for (const char *p = text; *p; p++)
+        units += m.advance[glyph_index(*p)];
+    if (baseline)
+        *baseline = cvRound(m.base * scale + thickness * 0.5);
+    return cv::Size(cvRound(units * scale + thickness),
+                    cvRound(m.cap_base * scale + (thickness + 1) / 2));
+}
+
+const GlyphAtlas &GlyphAtlas::get(double scale, int thickness) {
+    static std::mutex lock;
+    static std::map<std::pair<int, int>, std::unique_ptr<GlyphAtlas>> atlases;
+
+    int key = std::max(scale_key(scale), 1);
+    std::lock_guard<std::mutex> lk(lock);
+    std::unique_ptr<GlyphAtlas> &atlas = atlases[std::make_pair(key, thickness)];
+    if (!atlas)
+        atlas.reset(new GlyphAtlas(key / 1000.0, thickness));
+    return *atlas;
+}
+
+GlyphAtlas::GlyphAtlas(double scale, int thickness)
+    : scale_(scale), thickness_(thickness), pad_(thickness + 1) {
+    height_ = text_size("", scale, thickness, &baseline_).height;
+    rows_ = height_ + baseline_ + 2 * pad_;
+
+    const HersheyMetrics &m = metrics();
+    int total = 0;
+    for (int i = 0; i < 95; i++) {
+        Glyph &g = glyphs_[i];
+        g.advance = m.advance[i] * scale;
+        g.x = total;
+        g.cols = static_cast<int>(std::ceil(g.advance)) + thickness + 2 * pad_;
+        total += g.cols;
+    }
+
+    atlas_ = cv::Mat::zeros(rows_, total, CV_8UC1);
+    for (int i = 0; i < 95; i++) {
+        const Glyph &g = glyphs_[i];
+        cv::Mat cell = atlas_(cv::Rect(g.x, 0, g.cols, rows_));
+        cv::putText(cell, std::string(1, static_cast<char>(i + 32)), cv::Point(pad_, pad_ + height_),
+                    cv::FONT_HERSHEY_SIMPLEX, scale, cv::Scalar(255), thickness, cv::LINE_AA);
+    }
+}
+
+void GlyphAtlas::render(const char *text, TextSprite &out) const {
+    double units = 0.0;
+    int cols = 2 * pad_;
+    for (const char *p = text; *p; p++) {
+        const Glyph &g = glyphs_[glyph_index(*p)];
+        cols = std::max(cols, static_cast<int>(std::lround(units)) + g.cols);
+        units += g.advance;
+    }
+
+    out.width = cvRound(units + thickness_);
+    out.height = height_;
+    out.baseline = baseline_;
+    out.pad = pad_;
+    out.cols = cols;
+    out.rows = rows_;
+    out.alpha.assign(static_cast<size_t>(cols) * rows_, 0);
+
+    // Neighbouring cells overlap by their padding: keep the stronger coverage.
+    double pen = 0.0;
+    for (const char *p = text; *p; p++) {
+        const Glyph &g = glyphs_[glyph_index(*p)];
+        int x0 = static_cast<int>(std::lround(pen));
+        for (int r = 0; r < rows_; r++) {
+            const uint8_t *src = atlas_.ptr<uint8_t>(r) + g.x;
+            uint8_t *dst = out.alpha.data() + static_cast<size_t>(r) * cols + x0;
+            for (int i = 0; i < g.cols; i++)
+                dst[i] = std::max(dst[i], src[i]);
+        }
+        pen += g.advance;
+    }
+}
+
+void render_text(const char *text, double scale, int thickness, TextSprite &out) {
+    GlyphAtlas::get(scale, thickness).render(text, out);
+}
+
+// Visible part of the sprite placed with its text origin at (x, y).
+static bool clip_sprite(const TextSprite &sprite, int x, int y, int width, int height,
+                        int &left, int &top, int &c0, int &c1, int &r0, int &r1) {
+    left = x - sprite.pad;
+    top = y - sprite.height - sprite.pad;
+    c0 = std::max(0, -left);
+    r0 = std::max(0, -top);
+    c1 = std::min(sprite.cols, width - left);
+    r1 = std::min(sprite.rows, height - top);
+    return c0 < c1 && r0 < r1;
+}
+
+void blit_text(cv::Mat &img, const TextSprite &sprite, int x, int y, const cv::Scalar &color) {
+    int left, top, c0, c1, r0, r1;
+    if (!clip_sprite(sprite, x, y, img.cols, img.rows, left, top, c0, c1, r0, r1))
+        return;
+    const int c[3] = {static_cast<int>(color[0]), static_cast<int>(color[1]),
+                      static_cast<int>(color[2])};
+    for (int r = r0; r < r1; r++) {
+        const uint8_t *a = sprite.alpha.data() + static_cast<size_t>(r) * sprite.cols;
+        uint8_t *dst = img.ptr<uint8_t>(top + r) + static_cast<size_t>(left) * 3;
+        for (int i = c0; i < c1; i++) {
+            int alpha = a[i];
+            if (alpha == 0)
+                continue;
+            uint8_t *px = dst + i * 3;
+            px[0] = blend(px[0], c[0], alpha);
+            px[1] = blend(px[1], c[1], alpha);
+            px[2] = blend(px[2], c[2], alpha);
+        }
+    }
+}
+
+void blit_text_plane(uint8_t *plane, int stride, int width, int height,
+                     const TextSprite &sprite, int x, int y, uint8_t value) {
+    int left, top, c0, c1, r0, r1;
+    if (!clip_sprite(sprite, x, y, width, height, left, top, c0, c1, r0, r1))
+        return;
+    for (int r = r0; r < r1; r++) {
+        const uint8_t *a = sprite.alpha.data() + static_cast<size_t>(r) * sprite.cols;
+        uint8_t *dst = plane + static_cast<size_t>(top + r) * stride + left;
+        for (int i = c0; i < c1; i++) {
+            if (a[i])
+                dst[i] = blend(dst[i], value, a[i]);
+        }
+    }
+}
+
+int confidence_bucket(float confidence) {
+    return static_cast<int>(std::lround(confidence * 100.0f));
+}
+
+void format_label(int track_id, const std::string &name, int bucket, char sep, std::string &out) {
+    char number[32];
+    if (track_id != -1) {
+        std::snprintf(number, sizeof(number), "%d", track_id);
+        out.assign(number);
+    } else {
+        std::snprintf(number, sizeof(number), "%c%.2f", sep, bucket / 100.0);
+        out.assign(name);
+        out.append(number);
+    }
+}
+
+size_t label_key_hash(int track_id, int label, int bucket) {
+    size_t h = static_cast<size_t>(track_id) * 0x9E3779B1u;
+    h ^= static_cast<size_t>(label) * 0x85EBCA77u + (h << 6) + (h >> 2);
+    h ^= static_cast<size_t>(bucket) * 0xC2B2AE3Du + (h << 6) + (h >> 2);
+    return h;
+}
+
+size_t LabelSpriteCache::KeyHash::operator()(const Key &k) const {
+    size_t h = label_key_hash(k.track_id, k.label, k.bucket);
+    h ^= static_cast<size_t>(k.scale) + (static_cast<size_t>(k.thickness) << 16) +
+         (static_cast<size_t>(static_cast<unsigned char>(k.sep)) << 24) + (h << 6) + (h >> 2);
+    return h;
+}
+
+const TextSprite *LabelSpriteCache::get(int track_id, int label, const std::string &name,
+                                        float confidence, char sep, double scale,
+                                        int thickness) {
+    bool tracked = track_id != -1;
+    if (!tracked && label == -1)
+        return nullptr;
+
+    Key key = {scale_key(scale), thickness, track_id, -1, 0, 0};
+    if (!tracked) {
+        key.label = label;
+        key.bucket = confidence_bucket(confidence);
+        key.sep = sep;
+    }
+    auto it = entries_.find(key);
+    if (it != entries_.end() && (tracked || it->second.name == name))
+        return &it->second.sprite;
+    if (it == entries_.end() && entries_.size() >= max_entries_)
+        entries_.clear();
+
+    Entry &entry = entries_[key];
+    std::string text;
+    format_label(track_id, name, key.bucket, sep, text);
+    if (!tracked)
+        entry.name = name;
+    render_text(text.c_str(), scale, thickness, entry.sprite);
+    return &entry.sprite;
+}
+
+LabelSpriteCache &label_sprite_cache() {
+    static thread_local LabelSpriteCache cache;
+    return cache;
+}
+
+} // namespace dxs
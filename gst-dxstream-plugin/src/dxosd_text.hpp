@@ -0,0 +1,151 @@
+#ifndef DXOSD_TEXT_HPP
+#define DXOSD_TEXT_HPP
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Text rendering for dxosd
+// ---------------------------------------------------------------------------
+// Hershey text (cv::putText) rasterizes vector strokes on every call. Here
+// the printable ASCII glyphs are rasterized once per font scale and
+// thickness into a GlyphAtlas; a string is composed from the atlas into an
+// alpha-only TextSprite, and label sprites are cached per (label, confidence
+// bucket, track_id). Drawing a label is then a rectangle fill plus one alpha
+// blit. Metrics follow cv::getTextSize() for FONT_HERSHEY_SIMPLEX, so the
+// layout of the boxes drawn around text does not change.
+
+namespace dxs {
+
+/** cv::getTextSize() for FONT_HERSHEY_SIMPLEX without touching a glyph. */
+cv::Size text_size(const char *text, double scale, int thickness, int *baseline);
+
+/** Alpha mask of a rendered string. Like cv::putText(), the text origin is
+ *  the bottom-left corner of the text at (x, y); the mask extends `pad`
+ *  pixels beyond the getTextSize() box on every side. */
+struct TextSprite {
+    int width = 0;                 /**< getTextSize() width */
+    int height = 0;                /**< getTextSize() height */
+    int baseline = 0;
+    int pad = 0;
+    int cols = 0;                  /**< mask size */
+    int rows = 0;
+    std::vector<uint8_t> alpha;
+};
+
+/** Printable ASCII (32..126) rasterized once, anti-aliased, white on black. */
+class GlyphAtlas {
+  public:
+    /** Shared atlas for `scale` (rounded to 1/1000) and `thickness`; built on
+     *  first use and kept for the lifetime of the process. */
+    static const GlyphAtlas &get(double scale, int thickness);
+
+    GlyphAtlas(double scale, int thickness);
+
+    /** Composes `text` into `out`; characters outside 32..126 render as '?'. */
+    void render(const char *text, TextSprite &out) const;
+
+    double scale() const { return scale_; }
+    int thickness() const { return thickness_; }
+
+  private:
+    struct Glyph {
+        int x;                     /**< cell offset in the atlas */
+        int cols;
+        double advance;
+    };
+
+    double scale_;
+    int thickness_;
+    int height_;                   /**< getTextSize() height */
+    int baseline_;
+    int pad_;
+    int rows_;
+    Glyph glyphs_[95];
+    cv::Mat atlas_;
+};
+
+/** Renders `text` through the atlas of (scale, thickness). */
+void render_text(const char *text, double scale, int thickness, TextSprite &out);
+
+/** Blends `sprite` in `color` into a packed 3-channel image, text origin at
+ *  (x, y). Pixels outside `img` are skipped. */
+void blit_text(cv::Mat &img, const TextSprite &sprite, int x, int y,
+               const cv::Scalar &color = cv::Scalar(255, 255, 255));
+
+/** Same for one 8-bit plane (luma of I420 / NV12). */
+void blit_text_plane(uint8_t *plane, int stride, int width, int height,
+                     const TextSprite &sprite, int x, int y, uint8_t value);
+
+/** `dst` blended towards `src` by alpha `a` (0..255), rounded. */
+inline uint8_t blend(int dst, int src, int a) {
+    int v = dst * (255 - a) + src * a + 128;
+    return static_cast<uint8_t>((v + (v >> 8)) >> 8);
+}
+
+/** Confidence rounded to the two decimals printed in a label. */
+int confidence_bucket(float confidence);
+
+/** Label text of an object: std::to_string(track_id) when tracked
+ *  (track_id != -1), "<name><sep><bucket / 100, %.2f>" otherwise. `out` is
+ *  overwritten and keeps its capacity. */
+void format_label(int track_id, const std::string &name, int bucket, char sep, std::string &out);
+
+/** Hash of an object's label identity (track id, label, confidence bucket),
+ *  shared by the label caches. */
+size_t label_key_hash(int track_id, int label, int bucket);
+
+/**
+ * Rendered object labels: std::to_string(track_id) for tracked objects,
+ * "<name><sep><confidence %.2f>" otherwise. The confidence is bucketed to
+ * the two printed decimals, so an untracked object whose score moves a
+ * little reuses its sprite. The cache is cleared once it reaches
+ * `max_entries`.
+ */
+class LabelSpriteCache {
+  public:
+    explicit LabelSpriteCache(size_t max_entries = 4096) : max_entries_(max_entries) {}
+
+    /** nullptr if the object has neither a track id nor a label. The
+     *  sprite stays valid until the next get() on this cache. */
+    const TextSprite *get(int track_id, int label, const std::string &name, float confidence,
+                          char sep, double scale, int thickness);
+
+    size_t size() const { return entries_.size(); }
+    void clear() { entries_.clear(); }
+
+  private:
+    struct Key {
+        int scale;                 /**< scale * 1000 */
+        int thickness;
+        int track_id;
+        int label;
+        int bucket;                /**< confidence * 100 */
+        char sep;
+        bool operator==(const Key &o) const {
+            return scale == o.scale && thickness == o.thickness && track_id == o.track_id &&
+                   label == o.label && bucket == o.bucket && sep == o.sep;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key &k) const;
+    };
+    struct Entry {
+        std::string name;          /**< label name the sprite was made from */
+        TextSprite sprite;
+    };
+
+    size_t max_entries_;
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+};
+
+/** Per-thread label cache, used by the overlay-composition output. */
+LabelSpriteCache &label_sprite_cache();
+
+} // namespace dxs
+
+#endif // DXOSD_TEXT_HPP
@@ -0,0 +1,348 @@
+#include "dxtensor_io.hpp"
+
+#include <fcntl.h>
+#include <glib/gstdio.h>
+#include <json-glib/json-glib.h>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace dxs {
+
+namespace {
+
+struct TypeEntry {
+    const char *name;
+    DataType type;
+    uint32_t size;
+};
+
+const TypeEntry kTypes[] = {
+    {"FLOAT", FLOAT, 4},   {"UINT8", UINT8, 1},   {"INT8", INT8, 1},
+    {"UINT16", UINT16, 2}, {"INT16", INT16, 2},   {"INT32", INT32, 4},
+    {"INT64", INT64, 8},   {"UINT32", UINT32, 4}, {"UINT64", UINT64, 8},
+    {"BBOX", BBOX, sizeof(DeviceBoundingBox_t)},
+    {"FACE", FACE, sizeof(DeviceFace_t)},
+    {"POSE", POSE, sizeof(DevicePose_t)},
+};
+
+// json-glib < 1.6 has no *_with_default getters.
+gint64 get_int(JsonObject *obj, const char *member, gint64 def) {
+    return json_object_has_member(obj, member) ? json_object_get_int_member(obj, member)
+                                               : def;
+}
+
+const gchar *get_string(JsonObject *obj, const char *member, const gchar *def) {
+    return json_object_has_member(obj, member) ? json_object_get_string_member(obj, member)
+                                               : def;
+}
+
+} // namespace
+
+const char *data_type_name(DataType type) {
+    for (const auto &t : kTypes) {
+        if (t.type == type)
+            return t.name;
+    }
+    return "NONE";
+}
+
+DataType data_type_from_name(const char *name, uint32_t *elem_size) {
+    for (const auto &t : kTypes) {
+        if (!g_strcmp0(name, t.name)) {
+            if (elem_size)
+                *elem_size = t.size;
+            return t.type;
+        }
+    }
+    if (elem_size)
+        *elem_size = 0;
+    return NONE_TYPE;
+}
+
+bool load_tensor_manifest(const std::string &dir, TensorManifest &out,
+                          std::string &error) {
+    std::string manifest = dir + "/manifest.json";
+    JsonParser *parser = json_parser_new();
+    GError *err = nullptr;
+    if (!json_parser_load_from_file(parser, manifest.c_str(), &err)) {
+        error = manifest + ": " + err->message;
+        g_error_free(err);
+        g_object_unref(parser);
+        return false;
+    }
+
+    JsonNode *root_node = json_parser_get_root(parser);
+    JsonObject *root = root_node && JSON_NODE_HOLDS_OBJECT(root_node)
+                           ? json_node_get_object(root_node)
+                           : nullptr;
+    if (!root || !json_object_has_member(root, "tensors")) {
+        error = manifest + ": missing \"tensors\"";
+        g_object_unref(parser);
+        return false;
+    }
+
+    out.width = static_cast<int>(get_int(root, "width", 0));
+    out.height = static_cast<int>(get_int(root, "height", 0));
+    const gchar *library = get_string(root, "library", nullptr);
+    if (library)
+        out.library = g_path_is_absolute(library) ? library : dir + "/" + library;
+    out.function = get_string(root, "function", "PostProcess");
+
+    // Read every file first so all tensors can share one allocation.
+    JsonArray *tensors = json_object_get_array_member(root, "tensors");
+    std::vector<std::pair<gchar *, gsize>> contents;
+    std::vector<DXTensor> descs;
+    size_t total = 0;
+    bool ok = true;
+    for (guint i = 0; ok && i < json_array_get_length(tensors); i++) {
+        JsonObject *t = json_array_get_object_element(tensors, i);
+        DXTensor tensor;
+        tensor._name = get_string(t, "name", "");
+        tensor._type = data_type_from_name(get_string(t, "type", "FLOAT"),
+                                           &tensor._elemSize);
+        size_t count = 1;
+        JsonArray *shape = json_object_has_member(t, "shape")
+                               ? json_object_get_array_member(t, "shape")
+                               : nullptr;
+        for (guint d = 0; shape && d < json_array_get_length(shape); d++) {
+            tensor._shape.push_back(json_array_get_int_element(shape, d));
+            count *= static_cast<size_t>(tensor._shape.back());
+        }
+
+        std::string file = dir + "/" + get_string(t, "file", "");
+        gchar *data = nullptr;
+        gsize length = 0;
+        if (!g_file_get_contents(file.c_str(), &data, &length, &err)) {
+            error = err->message;
+            g_clear_error(&err);
+            ok = false;
+        } else if (tensor._type == NONE_TYPE || length < count * tensor._elemSize) {
+            error = file + ": type or size does not match the manifest";
+            g_free(data);
+            ok = false;
+        } else {
+            contents.emplace_back(data, length);
+            descs.push_back(tensor);
+            total += length;
+        }
+    }
+    g_object_unref(parser);
+
+    if (ok) {
+        out.tensors.allocate(total);
+        out.tensors._tensors.clear();
+        auto *dst = static_cast<uint8_t *>(out.tensors.data_ptr());
+        for (size_t i = 0; i < descs.size(); i++) {
+            memcpy(dst, contents[i].first, contents[i].second);
+            descs[i]._data = dst;
+            dst += contents[i].second;
+            out.tensors._tensors.push_back(descs[i]);
+        }
+    }
+    for (auto &c : contents)
+        g_free(c.first);
+    return ok;
+}
+
+static size_t align_up(size_t v) {
+    return (v + DX_TENSOR_RECORD_ALIGN - 1) & ~static_cast<size_t>(DX_TENSOR_RECORD_ALIGN - 1);
+}
+
+static size_t tensor_data_size(const DXTensor &tensor) {
+    size_t count = 1;
+    for (int64_t d : tensor._shape)
+        count *= static_cast<size_t>(MAX(d, 0));
+    return count * tensor._elemSize;
+}
+
+bool TensorRecordWriter::open(const std::string &path, std::string &error) {
+    close();
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) {
+        error = path + ": " + g_strerror(errno);
+        return false;
+    }
+    TensorRecordFileHeader header = {};
+    memcpy(header.magic, DX_TENSOR_RECORD_MAGIC, sizeof(header.magic));
+    header.version = DX_TENSOR_RECORD_VERSION;
+    header.header_size = sizeof(header);
+    if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+        error = path + ": " + g_strerror(errno);
+        close();
+        return false;
+    }
+    frames_ = 0;
+    return true;
+}
+
+bool TensorRecordWriter::write(const TensorRecordFrame &frame,
+                               const DXTensors &tensors, std::string &error) {
+    if (!file_) {
+        error = "recording is not open";
+        return false;
+    }
+
+    std::vector<const DXTensor *> kept;
+    for (const auto &t : tensors._tensors) {
+        if (t._data && t._shape.size() <= DX_TENSOR_RECORD_MAX_DIMS)
+            kept.push_back(&t);
+    }
+
+    // Header and descriptors are staged in record_; tensor data is written
+    // straight from the frame's buffers.
+    size_t descs_end = sizeof(TensorRecordHeader) + kept.size() * sizeof(TensorRecordDesc);
+    size_t offset = align_up(descs_end);
+    record_.assign(descs_end, 0);
+    auto *header = reinterpret_cast<TensorRecordHeader *>(record_.data());
+    auto *descs = reinterpret_cast<TensorRecordDesc *>(header + 1);
+    for (size_t i = 0; i < kept.size(); i++) {
+        const DXTensor &t = *kept[i];
+        TensorRecordDesc &d = descs[i];
+        g_strlcpy(d.name, t._name.c_str(), sizeof(d.name));
+        d.type = static_cast<uint32_t>(t._type);
+        d.elem_size = t._elemSize;
+        d.ndim = static_cast<uint32_t>(t._shape.size());
+        for (size_t k = 0; k < t._shape.size(); k++)
+            d.shape[k] = t._shape[k];
+        d.data_offset = offset;
+        d.data_size = tensor_data_size(t);
+        offset = align_up(offset + d.data_size);
+    }
+    if (offset > G_MAXUINT32) {
+        error = "record exceeds 4 GiB";
+        return false;
+    }
+    header->record_size = static_cast<uint32_t>(offset);
+    header->num_tensors = static_cast<uint32_t>(kept.size());
+    header->pts = frame.pts;
+    header->stream_id = frame.stream_id;
+    header->infer_id = frame.infer_id;
+    header->width = frame.width;
+    header->height = frame.height;
+    memcpy(header->roi, frame.roi, sizeof(header->roi));
+    header->frame_rate = frame.frame_rate;
+
+    static const uint8_t zeros[DX_TENSOR_RECORD_ALIGN] = {};
+    size_t written = descs_end;
+    bool ok = fwrite(record_.data(), 1, descs_end, file_) == descs_end;
+    for (size_t i = 0; ok && i < kept.size(); i++) {
+        const TensorRecordDesc &d = descs[i];
+        ok = fwrite(zeros, 1, d.data_offset - written, file_) == d.data_offset - written &&
+             fwrite(kept[i]->_data, 1, d.data_size, file_) == d.data_size;
+        written = d.data_offset + d.data_size;
+    }
+    if (ok)
+        ok = fwrite(zeros, 1, offset - written, file_) == offset - written;
+    if (!ok) {
+        error = g_strerror(errno);
+        return false;
+    }
+    frames_++;
+    return true;
+}
+
+void TensorRecordWriter::close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+TensorRecordReader::~TensorRecordReader() {
+    if (file_)
+        g_mapped_file_unref(file_);
+}
+
+bool TensorRecordReader::open(const std::string &path, std::string &error) {
+    int fd = g_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error = path + ": " + g_strerror(errno);
+        return false;
+    }
+    // Private writable mapping of a read-only file: downstream may edit the
+    // replayed tensors in place; touched pages are copied, never written back.
+    GError *err = nullptr;
+    GMappedFile *file = g_mapped_file_new_from_fd(fd, TRUE, &err);
+    g_close(fd, nullptr);
+    if (!file) {
+        error = err->message;
+        g_error_free(err);
+        return false;
+    }
+
+    const char *base = g_mapped_file_get_contents(file);
+    size_t length = g_mapped_file_get_length(file);
+    const auto *header = reinterpret_cast<const TensorRecordFileHeader *>(base);
+    if (length < sizeof(*header) ||
+        memcmp(header->magic, DX_TENSOR_RECORD_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != DX_TENSOR_RECORD_VERSION ||
+        header->header_size < sizeof(*header)) {
+        error = path + ": not a version " G_STRINGIFY(DX_TENSOR_RECORD_VERSION)
+                " tensor recording";
+        g_mapped_file_unref(file);
+        return false;
+    }
+
+    if (file_)
+        g_mapped_file_unref(file_);
+    file_ = file;
+    offsets_.clear();
+    // A capture that was cut short leaves a partial last record; stop there.
+    size_t offset = header->header_size;
+    while (offset + sizeof(TensorRecordHeader) <= length) {
+        const auto *rec = reinterpret_cast<const TensorRecordHeader *>(base + offset);
+        if (rec->record_size < sizeof(TensorRecordHeader) ||
+            rec->record_size > length - offset)
+            break;
+        offsets_.push_back(offset);
+        offset += rec->record_size;
+    }
+    return true;
+}
+
+bool TensorRecordReader::read(size_t index, TensorRecordFrame &frame,
+                              DXTensors &tensors) const {
+    if (index >= offsets_.size())
+        return false;
+    char *record = g_mapped_file_get_contents(file_) + offsets_[index];
+    const auto *header = reinterpret_cast<const TensorRecordHeader *>(record);
+    if (sizeof(TensorRecordHeader) + header->num_tensors * sizeof(TensorRecordDesc) >
+        header->record_size)
+        return false;
+
+    frame.pts = header->pts;
+    frame.stream_id = header->stream_id;
+    frame.infer_id = header->infer_id;
+    frame.width = header->width;
+    frame.height = header->height;
+    memcpy(frame.roi, header->roi, sizeof(frame.roi));
+    frame.frame_rate = header->frame_rate;
+
+    tensors._tensors.clear();
+    const auto *descs = reinterpret_cast<const TensorRecordDesc *>(header + 1);
+    for (uint32_t i = 0; i < header->num_tensors; i++) {
+        const TensorRecordDesc &d = descs[i];
+        if (d.ndim > DX_TENSOR_RECORD_MAX_DIMS ||
+            d.data_offset + d.data_size > header->record_size)
+            return false;
+        DXTensor t;
+        t._name.assign(d.name, strnlen(d.name, sizeof(d.name)));
+        t._type = static_cast<DataType>(d.type);
+        t._elemSize = d.elem_size;
+        t._shape.assign(d.shape, d.shape + d.ndim);
+        t._data = record + d.data_offset;
+        tensors._tensors.push_back(t);
+    }
+
+    // The tensors alias the mapping; their owner keeps it mapped even after
+    // the reader is gone.
+    GMappedFile *file = g_mapped_file_ref(file_);
+    tensors._mem_size = header->record_size;
+    tensors._data = std::shared_ptr<void>(record,
+                                          [file](void *) { g_mapped_file_unref(file); });
+    return true;
+}
+
+} // namespace dxs
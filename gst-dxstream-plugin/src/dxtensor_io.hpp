@@ -0,0 +1,149 @@
+#ifndef DXTENSOR_IO_HPP
+#define DXTENSOR_IO_HPP
+
+#include "dxcommon.hpp"
+#include <glib.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Recorded output tensors
+// ---------------------------------------------------------------------------
+// A recorded tensor set is a directory holding a manifest.json and one raw
+// file (native endianness) per tensor:
+//   {
+//     "library":  "libpostprocess_yolov5s_6.so",   (optional)
+//     "function": "PostProcess",                   (optional)
+//     "width": 1920, "height": 1080,               (original frame size)
+//     "tensors": [
+//       { "name": "output0", "type": "FLOAT", "shape": [1, 25200, 85],
+//         "file": "output0.bin" }
+//     ]
+//   }
+// Used by dxtestsrc (tensor-dir) and the postprocess benchmark to run
+// postprocess libraries without an NPU. Many frames of live output are
+// better captured as a recording, see below.
+
+namespace dxs {
+
+struct TensorManifest {
+    std::string library;  /**< absolute, or resolved against the directory */
+    std::string function = "PostProcess";
+    int width = 0;
+    int height = 0;
+    DXTensors tensors;    /**< all tensors in one allocation */
+};
+
+const char *data_type_name(DataType type);
+DataType data_type_from_name(const char *name, uint32_t *elem_size);
+
+/** Loads <dir>/manifest.json and the tensor files it lists. On failure
+ *  returns false and describes the problem in `error`. */
+bool load_tensor_manifest(const std::string &dir, TensorManifest &out,
+                          std::string &error);
+
+// ---------------------------------------------------------------------------
+// Tensor recordings (.dxtrec)
+// ---------------------------------------------------------------------------
+// Output tensors of many frames captured from a live pipeline (dxtensorcapture)
+// and replayed by dxtestsrc (tensor-file). The file is a 64-byte header
+// followed by self-contained records, all in native endianness:
+//
+//   TensorRecordFileHeader
+//   record 0: TensorRecordHeader | TensorRecordDesc x num_tensors | data ...
+//   record 1: ...
+//
+// Records and tensor data are 64-byte aligned, so a reader maps the file
+// once (private, copy-on-write) and hands out writable tensors pointing
+// straight into the mapping.
+
+#define DX_TENSOR_RECORD_MAGIC "DXTREC\0\0"
+#define DX_TENSOR_RECORD_VERSION 1
+#define DX_TENSOR_RECORD_ALIGN 64
+#define DX_TENSOR_RECORD_MAX_DIMS 8
+#define DX_TENSOR_RECORD_NAME_LEN 64
+
+struct TensorRecordFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint8_t reserved[48];
+};
+
+struct TensorRecordHeader {
+    uint32_t record_size;   /**< bytes to the next record */
+    uint32_t num_tensors;
+    uint64_t pts;           /**< GST_CLOCK_TIME_NONE when unset */
+    int32_t stream_id;
+    int32_t infer_id;
+    int32_t width;          /**< original frame size (DXFrameMeta) */
+    int32_t height;
+    int32_t roi[4];
+    float frame_rate;
+    uint8_t reserved[12];
+};
+
+struct TensorRecordDesc {
+    char name[DX_TENSOR_RECORD_NAME_LEN]; /**< truncated, NUL terminated */
+    uint32_t type;                        /**< DataType */
+    uint32_t elem_size;
+    uint32_t ndim;
+    uint32_t reserved;
+    int64_t shape[DX_TENSOR_RECORD_MAX_DIMS];
+    uint64_t data_offset;                 /**< from the record start */
+    uint64_t data_size;
+};
+
+/** Frame metadata stored with each record. */
+struct TensorRecordFrame {
+    uint64_t pts = G_MAXUINT64;
+    int stream_id = 0;
+    int infer_id = 0;
+    int width = 0;
+    int height = 0;
+    int roi[4] = {-1, -1, -1, -1};
+    float frame_rate = 0.0f;
+};
+
+class TensorRecordWriter {
+  public:
+    ~TensorRecordWriter() { close(); }
+
+    bool open(const std::string &path, std::string &error);
+    /** Appends one record; tensors without data are skipped. */
+    bool write(const TensorRecordFrame &frame, const DXTensors &tensors,
+               std::string &error);
+    void close();
+
+    uint64_t frames() const { return frames_; }
+
+  private:
+    FILE *file_ = nullptr;
+    uint64_t frames_ = 0;
+    std::vector<uint8_t> record_;
+};
+
+class TensorRecordReader {
+  public:
+    TensorRecordReader() = default;
+    TensorRecordReader(const TensorRecordReader &) = delete;
+    TensorRecordReader &operator=(const TensorRecordReader &) = delete;
+    ~TensorRecordReader();
+
+    /** Maps the file and indexes its records. Reopening gives a fresh
+     *  mapping; tensors read before keep the old one alive. */
+    bool open(const std::string &path, std::string &error);
+
+    size_t size() const { return offsets_.size(); }
+    /** Tensors point into the mapping, which `tensors` keeps alive. */
+    bool read(size_t index, TensorRecordFrame &frame, DXTensors &tensors) const;
+
+  private:
+    GMappedFile *file_ = nullptr;
+    std::vector<size_t> offsets_;
+};
+
+} // namespace dxs
+
+#endif // DXTENSOR_IO_HPP
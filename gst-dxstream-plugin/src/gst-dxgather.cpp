@@ -2,12 +2,41 @@
 #include "./../metadata/gst-dxframemeta.hpp"
 #include "./../metadata/gst-dxobjectmeta.hpp"
 #include "./../metadata/gst-dxusermeta.hpp"
+#include "utils.hpp"
 #include <array>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 GST_DEBUG_CATEGORY_STATIC(gst_dxgather_debug_category);
 #define GST_CAT_DEFAULT gst_dxgather_debug_category
 
+#define DEFAULT_JOIN_MODE GstDxGatherJoinMode::DROP
+#define DEFAULT_PTS_TOLERANCE 0
+#define DEFAULT_PAD_TIMEOUT 100
+
+enum class PropertyID {
+    PROP_0,
+    PROP_JOIN_MODE,
+    PROP_PTS_TOLERANCE,
+    PROP_PAD_TIMEOUT
+};
+
+#define GST_TYPE_DXGATHER_JOIN_MODE (gst_dxgather_join_mode_get_type())
+static GType gst_dxgather_join_mode_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {static_cast<int>(GstDxGatherJoinMode::DROP), "drop", "drop"},
+            {static_cast<int>(GstDxGatherJoinMode::PARTIAL), "partial", "partial"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxGatherJoinMode", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
     "sink_%u", GST_PAD_SINK, GST_PAD_REQUEST, GST_STATIC_CAPS("video/x-raw"));
 
@@ -15,6 +44,11 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
     "src", GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS("video/x-raw"));
 
 static GstFlowReturn gst_dxgather_aggregate(GstAggregator *agg, gboolean timeout);
+static GstClockTime gst_dxgather_get_next_time(GstAggregator *agg);
+static gboolean gst_dxgather_start(GstAggregator *agg);
+static gboolean gst_dxgather_sink_event(GstAggregator *agg,
+                                        GstAggregatorPad *pad,
+                                        GstEvent *event);
 static GstFlowReturn gst_dxgather_update_src_caps(GstAggregator *agg,
                                                   GstCaps *downstream_caps,
                                                   GstCaps **ret);
@@ -36,23 +70,31 @@ static void copy_container(Container &dst, const Container &src) {
     dst = src;
 }
 
-static void copy_input_tensors(DXObjectMeta *dst, const DXObjectMeta *src) {
-    for (const auto &input_tensors : src->_input_tensors) {
+static void copy_input_tensors(DXObjectMeta *dst, DXObjectMeta *src,
+                               bool move = false) {
+    for (auto &input_tensors : src->_input_tensors) {
         const auto &key = input_tensors.first;
         if (dst->_input_tensors.find(key) != dst->_input_tensors.end())
             continue;
-        dst->_input_tensors[key] = input_tensors.second;
+        if (move)
+            dst->_input_tensors.emplace(key, std::move(input_tensors.second));
+        else
+            dst->_input_tensors[key] = input_tensors.second;
     }
 }
 
-static void copy_output_tensors(DXObjectMeta *dst, const DXObjectMeta *src) {
-    for (const auto &output_tensors : src->_output_tensors) {
+static void copy_output_tensors(DXObjectMeta *dst, DXObjectMeta *src,
+                                bool move = false) {
+    for (auto &output_tensors : src->_output_tensors) {
         const auto &key = output_tensors.first;
         if (dst->_output_tensors.find(key) != dst->_output_tensors.end()) {
             GST_WARNING("Output tensor key '%d' already exists, skipping duplicate", key);
             continue;
         }
-        dst->_output_tensors[key] = output_tensors.second;
+        if (move)
+            dst->_output_tensors.emplace(key, std::move(output_tensors.second));
+        else
+            dst->_output_tensors[key] = output_tensors.second;
     }
 }
 
@@ -78,14 +120,20 @@ static void merge_box_if_empty(std::array<float, 4> &dst, const std::array<float
     }
 }
 
+// `move` is set when src belongs to a buffer that is discarded right after
+// the merge, so its heap-backed fields can be taken instead of copied.
 template <typename Container>
-static void merge_container_if_empty(Container &dst, const Container &src) {
+static void merge_container_if_empty(Container &dst, Container &src,
+                                     bool move) {
     if (dst.empty() && !src.empty()) {
-        dst = src;
+        if (move)
+            dst = std::move(src);
+        else
+            dst = src;
     }
 }
 
-void copy_object_meta(DXObjectMeta *dst, const DXObjectMeta *src) {
+void copy_object_meta(DXObjectMeta *dst, DXObjectMeta *src) {
     if (!dst || !src)
         return;
 
@@ -114,40 +162,57 @@ void copy_object_meta(DXObjectMeta *dst, const DXObjectMeta *src) {
     copy_output_tensors(dst, src);
 }
 
-void merge_object_meta(DXObjectMeta *dst, const DXObjectMeta *src) {
+void merge_object_meta(DXObjectMeta *dst, DXObjectMeta *src,
+                       bool move = false) {
     if (!dst || !src)
         return;
 
     merge_if_empty_int(dst->_track_id, src->_track_id);
     merge_if_empty_int(dst->_label, src->_label);
-    if (dst->_label_name.empty() && !src->_label_name.empty()) {
-        dst->_label_name = src->_label_name;
-    }
+    merge_container_if_empty(dst->_label_name, src->_label_name, move);
     merge_if_empty_float(dst->_confidence, src->_confidence);
 
     merge_box_if_empty(dst->_box, src->_box);
-    merge_container_if_empty(dst->_keypoints, src->_keypoints);
-    merge_container_if_empty(dst->_body_feature, src->_body_feature);
+    merge_container_if_empty(dst->_keypoints, src->_keypoints, move);
+    merge_container_if_empty(dst->_body_feature, src->_body_feature, move);
 
     merge_box_if_empty(dst->_face_box, src->_face_box);
     merge_if_empty_float(dst->_face_confidence, src->_face_confidence);
-    merge_container_if_empty(dst->_face_landmarks, src->_face_landmarks);
-    merge_container_if_empty(dst->_face_feature, src->_face_feature);
+    merge_container_if_empty(dst->_face_landmarks, src->_face_landmarks, move);
+    merge_container_if_empty(dst->_face_feature, src->_face_feature, move);
 
     if (dst->_seg_data.empty() &&
         !src->_seg_data.empty()) {
-        dst->_seg_data = src->_seg_data;
+        merge_container_if_empty(dst->_seg_data, src->_seg_data, move);
         dst->_seg_width = src->_seg_width;
         dst->_seg_height = src->_seg_height;
     }
 
-    copy_input_tensors(dst, src);
-    copy_output_tensors(dst, src);
+    copy_input_tensors(dst, src, move);
+    copy_output_tensors(dst, src, move);
+}
+
+// meta_id -> object of the merged frame. Built once per aggregate() for the
+// frame being merged into and extended as branches append objects, so each
+// branch merge is O(n + m) instead of O(n * m).
+struct GatherObjectIndex {
+    const DXFrameMeta *frame = nullptr;
+    std::unordered_map<int, DXObjectMeta *> objects;
+};
+
+static void build_object_index(GatherObjectIndex &index,
+                               const DXFrameMeta *frame_meta) {
+    index.frame = frame_meta;
+    index.objects.clear();
+    index.objects.reserve(frame_meta->_object_meta_list.size() * 2);
+    for (auto *obj_meta : frame_meta->_object_meta_list)
+        index.objects.emplace(obj_meta->_meta_id, obj_meta);  // first one wins
 }
 
-void frame_meta_merge(GstBuffer **buf0, GstBuffer *buf1) {
+void frame_meta_merge(GstBuffer **buf0, GstBuffer *buf1,
+                      GatherObjectIndex &index) {
     auto *frame_meta0 = dx_get_frame_meta(*buf0);
-    const auto *frame_meta1 = dx_get_frame_meta(buf1);
+    auto *frame_meta1 = dx_get_frame_meta(buf1);
 
     if (!frame_meta1) {
         return;
@@ -157,24 +222,34 @@ void frame_meta_merge(GstBuffer **buf0, GstBuffer *buf1) {
         *buf0 = gst_buffer_ref(buf1);
         return;
     }
-
-    for (const auto *obj_meta1 : frame_meta1->_object_meta_list) {
-        gboolean found = FALSE;
-
-        for (auto *obj_meta0 : frame_meta0->_object_meta_list) {
-            if (obj_meta0->_meta_id == obj_meta1->_meta_id) {
-                merge_object_meta(obj_meta0, obj_meta1);
-                found = TRUE;
-                break;
-            }
+    if (index.frame != frame_meta0)
+        build_object_index(index, frame_meta0);
+
+    // buf1 is unref'd by the caller right after the merge. If nobody else
+    // holds it (e.g. a tee sharing the buffer across branches), its objects
+    // and fields can be taken over instead of copied.
+    bool steal = *buf0 != buf1 && gst_buffer_is_writable(buf1);
+
+    auto &objects1 = frame_meta1->_object_meta_list;
+    size_t kept = 0;
+    for (auto *obj_meta1 : objects1) {
+        auto it = index.objects.find(obj_meta1->_meta_id);
+        if (it != index.objects.end()) {
+            merge_object_meta(it->second, obj_meta1, steal);
+            objects1[kept++] = obj_meta1;
+            continue;
         }
 
-        if (!found) {
-            DXObjectMeta *obj_meta0 = dx_acquire_obj_meta_from_pool();
+        DXObjectMeta *obj_meta0 = obj_meta1;
+        if (!steal) {
+            obj_meta0 = dx_acquire_obj_meta_from_pool();
             copy_object_meta(obj_meta0, obj_meta1);
-            dx_add_obj_meta_to_frame(frame_meta0, obj_meta0);
+            objects1[kept++] = obj_meta1;
         }
+        dx_add_obj_meta_to_frame(frame_meta0, obj_meta0);
+        index.objects.emplace(obj_meta0->_meta_id, obj_meta0);
     }
+    objects1.resize(kept);
 }
 
 gboolean check_same_source(GstBuffer *buf0, GstBuffer *buf1) {
@@ -193,12 +268,179 @@ gboolean check_same_source(GstBuffer *buf0, GstBuffer *buf1) {
     return FALSE;
 }
 
+// Merges one popped branch buffer into *merged (taking ownership of buf).
+static void gather_merge_branch(GstDxGather *self, GstBuffer **merged,
+                                GstBuffer *buf, GstAggregatorPad *pad,
+                                GatherObjectIndex &index) {
+    if (!*merged) {
+        *merged = buf;
+    } else if (check_same_source(*merged, buf)) {
+        frame_meta_merge(merged, buf, index);
+        gst_buffer_unref(buf);
+    } else {
+        GST_WARNING_OBJECT(self,
+            "dxgather requires all sink pads fed from the same source; "
+            "dropping buffer at pts=%" GST_TIME_FORMAT
+            " from pad %s (different source than merged buffer)",
+            GST_TIME_ARGS(GST_BUFFER_PTS(buf)),
+            GST_PAD_NAME(pad));
+        gst_buffer_unref(buf);
+    }
+}
+
+static guint64 branch_bit(GstAggregatorPad *pad) {
+    gint index = get_sink_pad_index(GST_PAD(pad));
+    return (index >= 0 && index < 64) ? (G_GUINT64_CONSTANT(1) << index) : 0;
+}
+
+// Partial join: the target is the oldest head running time. Heads within
+// pts-tolerance of it are merged; branches whose head is later, or which
+// have nothing queued once the live deadline (target + pad-timeout) passed,
+// are recorded in DXFrameMeta::_skipped_branches and keep their buffers for
+// the next frame. Running times keep heads comparable across branch
+// segments and stay monotonic over non-flushing segment updates.
+static GstFlowReturn gst_dxgather_aggregate_partial(GstDxGather *self,
+                                                    gboolean timeout) {
+    GstAggregator *agg = GST_AGGREGATOR(self);
+    GstClockTime tolerance = (GstClockTime)self->_pts_tolerance * GST_MSECOND;
+
+    struct Branch {
+        GstAggregatorPad *pad;
+        GstClockTime pts;
+        GstClockTime rt;
+        guint64 bit;
+    };
+    std::vector<Branch> heads;
+    std::vector<GstAggregatorPad *> stale;
+    guint64 skipped = 0;
+    gboolean all_eos = TRUE;
+    gboolean waiting = FALSE;
+    GstClockTime target = GST_CLOCK_TIME_NONE;
+
+    GST_OBJECT_LOCK(agg);
+    for (GList *l = GST_ELEMENT(agg)->sinkpads; l; l = l->next) {
+        GstAggregatorPad *pad = GST_AGGREGATOR_PAD(l->data);
+        guint64 bit = branch_bit(pad);
+        if (gst_aggregator_pad_is_eos(pad)) {
+            skipped |= bit;
+            continue;
+        }
+        all_eos = FALSE;
+        GstBuffer *buf = gst_aggregator_pad_peek_buffer(pad);
+        if (!buf) {
+            waiting = TRUE;
+            skipped |= bit;
+            continue;
+        }
+        GstClockTime pts = GST_BUFFER_PTS(buf);
+        gst_buffer_unref(buf);
+        GstClockTime rt = gst_segment_to_running_time(
+            &pad->segment, GST_FORMAT_TIME, pts);
+        // A branch that was skipped for an earlier frame and caught up late.
+        // Only heads at or before the emitted frame are stale: pts-tolerance
+        // may exceed the frame duration, so anything later is a new frame.
+        if (GST_CLOCK_TIME_IS_VALID(rt) &&
+            GST_CLOCK_TIME_IS_VALID(self->_last_running_time) &&
+            rt <= self->_last_running_time) {
+            stale.push_back(GST_AGGREGATOR_PAD(gst_object_ref(pad)));
+            continue;
+        }
+        if (GST_CLOCK_TIME_IS_VALID(rt) &&
+            (!GST_CLOCK_TIME_IS_VALID(target) || rt < target))
+            target = rt;
+        heads.push_back({GST_AGGREGATOR_PAD(gst_object_ref(pad)), pts, rt, bit});
+    }
+    GST_OBJECT_UNLOCK(agg);
+
+    auto release_heads = [&heads]() {
+        for (auto &h : heads) gst_object_unref(h.pad);
+    };
+
+    if (!stale.empty()) {
+        for (GstAggregatorPad *pad : stale) {
+            GstBuffer *buf = gst_aggregator_pad_pop_buffer(pad);
+            if (buf) {
+                GST_DEBUG_OBJECT(self,
+                    "Late buffer on pad %s: pts=%" GST_TIME_FORMAT
+                    " already emitted without it — dropping",
+                    GST_PAD_NAME(pad), GST_TIME_ARGS(GST_BUFFER_PTS(buf)));
+                gst_buffer_unref(buf);
+            }
+            gst_object_unref(pad);
+        }
+        release_heads();
+        return GST_AGGREGATOR_FLOW_NEED_DATA;
+    }
+
+    if (all_eos) {
+        GST_DEBUG_OBJECT(self, "All sinkpads EOS, returning GST_FLOW_EOS");
+        return GST_FLOW_EOS;
+    }
+    // Empty branches are only given up on once the live deadline passed.
+    if (heads.empty() || (waiting && !timeout)) {
+        release_heads();
+        return GST_AGGREGATOR_FLOW_NEED_DATA;
+    }
+
+    GstBuffer *merged = nullptr;
+    GatherObjectIndex index;
+    for (auto &h : heads) {
+        if (GST_CLOCK_TIME_IS_VALID(h.rt) && GST_CLOCK_TIME_IS_VALID(target) &&
+            h.rt > target + tolerance) {
+            GST_LOG_OBJECT(self,
+                "Pad %s has no frame for running time %" GST_TIME_FORMAT
+                " (head pts=%" GST_TIME_FORMAT ") — skipped",
+                GST_PAD_NAME(h.pad), GST_TIME_ARGS(target),
+                GST_TIME_ARGS(h.pts));
+            skipped |= h.bit;
+            continue;
+        }
+        GstBuffer *buf = gst_aggregator_pad_pop_buffer(h.pad);
+        if (buf)
+            gather_merge_branch(self, &merged, buf, h.pad, index);
+    }
+    release_heads();
+
+    if (!merged)
+        return GST_AGGREGATOR_FLOW_NEED_DATA;
+    if (GST_CLOCK_TIME_IS_VALID(target)) {
+        GST_OBJECT_LOCK(agg);
+        self->_last_running_time = target;
+        GST_OBJECT_UNLOCK(agg);
+    }
+
+    DXFrameMeta *frame_meta = dx_get_frame_meta(merged);
+    if (skipped && !frame_meta) {
+        merged = dx_create_frame_meta(merged);
+        frame_meta = dx_get_frame_meta(merged);
+    }
+    if (frame_meta && frame_meta->_skipped_branches != skipped) {
+        if (!gst_buffer_is_writable(merged)) {
+            merged = gst_buffer_make_writable(merged);
+            frame_meta = dx_get_frame_meta(merged);
+        }
+        frame_meta->_skipped_branches = skipped;
+    }
+    if (skipped) {
+        GST_DEBUG_OBJECT(self,
+            "Partial merge: pts=%" GST_TIME_FORMAT " skipped=0x%" G_GINT64_MODIFIER "x",
+            GST_TIME_ARGS(GST_BUFFER_PTS(merged)), skipped);
+    }
+
+    GST_LOG_OBJECT(self, "Pushing merged buffer: pts=%" GST_TIME_FORMAT,
+                     GST_TIME_ARGS(GST_BUFFER_PTS(merged)));
+    return gst_aggregator_finish_buffer(agg, merged);
+}
+
 static GstFlowReturn
-gst_dxgather_aggregate(GstAggregator *agg, gboolean /*timeout*/) {
+gst_dxgather_aggregate(GstAggregator *agg, gboolean timeout) {
     GstDxGather *self = GST_DXGATHER(agg);
 
     GST_LOG_OBJECT(self, "aggregate called");
 
+    if (self->_join_mode == GstDxGatherJoinMode::PARTIAL)
+        return gst_dxgather_aggregate_partial(self, timeout);
+
     GstClockTime latest_pts = GST_CLOCK_TIME_NONE;
     std::vector<std::pair<GstAggregatorPad *, GstBuffer *>> peeked;
     gboolean all_eos = TRUE;
@@ -230,6 +472,7 @@ gst_dxgather_aggregate(GstAggregator *agg, gboolean /*timeout*/) {
     }
 
     GstBuffer *merged = nullptr;
+    GatherObjectIndex index;
     for (auto &p : peeked) {
         GstAggregatorPad *pad = p.first;
         GstBuffer *peek_buf = p.second;
@@ -252,20 +495,7 @@ gst_dxgather_aggregate(GstAggregator *agg, gboolean /*timeout*/) {
         if (!buf) {
             continue;
         }
-        if (!merged) {
-            merged = buf;
-        } else if (check_same_source(merged, buf)) {
-            frame_meta_merge(&merged, buf);
-            gst_buffer_unref(buf);
-        } else {
-            GST_WARNING_OBJECT(self,
-                "dxgather requires all sink pads fed from the same source; "
-                "dropping buffer at pts=%" GST_TIME_FORMAT
-                " from pad %s (different source than merged buffer)",
-                GST_TIME_ARGS(GST_BUFFER_PTS(buf)),
-                GST_PAD_NAME(pad));
-            gst_buffer_unref(buf);
-        }
+        gather_merge_branch(self, &merged, buf, pad, index);
     }
 
     if (!merged) {
@@ -277,6 +507,92 @@ gst_dxgather_aggregate(GstAggregator *agg, gboolean /*timeout*/) {
     return gst_aggregator_finish_buffer(agg, merged);
 }
 
+// Partial join in live pipelines: wait at most pad-timeout past the oldest
+// head for the remaining branches. GstAggregator adds its own latency and
+// calls aggregate(timeout=TRUE) once the deadline passes.
+static GstClockTime gst_dxgather_get_next_time(GstAggregator *agg) {
+    GstDxGather *self = GST_DXGATHER(agg);
+    if (self->_join_mode != GstDxGatherJoinMode::PARTIAL)
+        return GST_CLOCK_TIME_NONE;
+
+    GstClockTime next = GST_CLOCK_TIME_NONE;
+    GST_OBJECT_LOCK(agg);
+    for (GList *l = GST_ELEMENT(agg)->sinkpads; l; l = l->next) {
+        GstAggregatorPad *pad = GST_AGGREGATOR_PAD(l->data);
+        GstBuffer *buf = gst_aggregator_pad_peek_buffer(pad);
+        if (!buf)
+            continue;
+        GstClockTime rt = gst_segment_to_running_time(
+            &pad->segment, GST_FORMAT_TIME, GST_BUFFER_PTS(buf));
+        gst_buffer_unref(buf);
+        if (GST_CLOCK_TIME_IS_VALID(rt) &&
+            (!GST_CLOCK_TIME_IS_VALID(next) || rt < next))
+            next = rt;
+    }
+    GST_OBJECT_UNLOCK(agg);
+
+    if (GST_CLOCK_TIME_IS_VALID(next))
+        next += (GstClockTime)self->_pad_timeout * GST_MSECOND;
+    return next;
+}
+
+static gboolean gst_dxgather_start(GstAggregator *agg) {
+    GST_DXGATHER(agg)->_last_running_time = GST_CLOCK_TIME_NONE;
+    return TRUE;
+}
+
+// A flush (e.g. a backwards flushing seek) restarts running time, so the
+// last emitted frame no longer marks later heads as stale.
+static gboolean gst_dxgather_sink_event(GstAggregator *agg,
+                                        GstAggregatorPad *pad,
+                                        GstEvent *event) {
+    if (GST_EVENT_TYPE(event) == GST_EVENT_FLUSH_STOP) {
+        GST_OBJECT_LOCK(agg);
+        GST_DXGATHER(agg)->_last_running_time = GST_CLOCK_TIME_NONE;
+        GST_OBJECT_UNLOCK(agg);
+    }
+    return GST_AGGREGATOR_CLASS(parent_class)->sink_event(agg, pad, event);
+}
+
+static void gst_dxgather_set_property(GObject *object, guint prop_id,
+                                      const GValue *value, GParamSpec *pspec) {
+    auto *self = GST_DXGATHER(object);
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_JOIN_MODE:
+        self->_join_mode =
+            static_cast<GstDxGatherJoinMode>(g_value_get_enum(value));
+        break;
+    case PropertyID::PROP_PTS_TOLERANCE:
+        self->_pts_tolerance = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_PAD_TIMEOUT:
+        self->_pad_timeout = g_value_get_uint(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxgather_get_property(GObject *object, guint prop_id,
+                                      GValue *value, GParamSpec *pspec) {
+    const auto *self = GST_DXGATHER(object);
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_JOIN_MODE:
+        g_value_set_enum(value, static_cast<gint>(self->_join_mode));
+        break;
+    case PropertyID::PROP_PTS_TOLERANCE:
+        g_value_set_uint(value, self->_pts_tolerance);
+        break;
+    case PropertyID::PROP_PAD_TIMEOUT:
+        g_value_set_uint(value, self->_pad_timeout);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
 static GstFlowReturn
 gst_dxgather_update_src_caps(GstAggregator *agg,
                              GstCaps *downstream_caps, GstCaps **ret) {
@@ -305,9 +621,44 @@ static void gst_dxgather_class_init(GstDxGatherClass *klass) {
     GST_DEBUG_CATEGORY_INIT(gst_dxgather_debug_category, "dxgather", 0,
                             "DXGather plugin");
 
+    auto *gobject_class = G_OBJECT_CLASS(klass);
     auto *element_class = GST_ELEMENT_CLASS(klass);
     auto *agg_class = GST_AGGREGATOR_CLASS(klass);
 
+    gobject_class->set_property = gst_dxgather_set_property;
+    gobject_class->get_property = gst_dxgather_get_property;
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_JOIN_MODE),
+        g_param_spec_enum(
+            "join-mode", "Join Mode",
+            "How branches with different head PTS are joined: drop (merge at "
+            "the latest PTS and drop older buffers) or partial (merge at the "
+            "oldest PTS and mark branches without a matching frame as skipped)",
+            GST_TYPE_DXGATHER_JOIN_MODE, static_cast<gint>(DEFAULT_JOIN_MODE),
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_READY)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_PTS_TOLERANCE),
+        g_param_spec_uint(
+            "pts-tolerance", "PTS Tolerance",
+            "Partial join: maximum PTS distance (ms) between branch buffers "
+            "merged into the same frame",
+            0, G_MAXUINT, DEFAULT_PTS_TOLERANCE,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_PAD_TIMEOUT),
+        g_param_spec_uint(
+            "pad-timeout", "Pad Timeout",
+            "Partial join with live sources: time (ms) to wait for an empty "
+            "branch, on top of the aggregator latency, before merging without it",
+            0, G_MAXUINT, DEFAULT_PAD_TIMEOUT,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_READY)));
+
     gst_element_class_set_static_metadata(
         element_class, "DxGather", "Generic",
         "Gather Multiple Streams (from the Same Source)",
@@ -319,6 +670,9 @@ static void gst_dxgather_class_init(GstDxGatherClass *klass) {
 
     parent_class = GST_AGGREGATOR_CLASS(g_type_class_peek_parent(klass));
     agg_class->aggregate = GST_DEBUG_FUNCPTR(gst_dxgather_aggregate);
+    agg_class->get_next_time = GST_DEBUG_FUNCPTR(gst_dxgather_get_next_time);
+    agg_class->start = GST_DEBUG_FUNCPTR(gst_dxgather_start);
+    agg_class->sink_event = GST_DEBUG_FUNCPTR(gst_dxgather_sink_event);
     agg_class->update_src_caps = gst_dxgather_update_src_caps;
     agg_class->src_query = GST_DEBUG_FUNCPTR(gst_dxgather_src_query);
     agg_class->sink_query = GST_DEBUG_FUNCPTR(gst_dxgather_sink_query);
@@ -350,6 +704,10 @@ static gboolean gst_dxgather_src_query(GstAggregator *agg, GstQuery *query) {
             gst_caps_unref(caps);
         }
         GST_OBJECT_UNLOCK(agg);
+        // Partial join may additionally hold a frame for pad-timeout.
+        GstDxGather *self = GST_DXGATHER(agg);
+        if (live && self->_join_mode == GstDxGatherJoinMode::PARTIAL)
+            worst_frame += (GstClockTime)self->_pad_timeout * GST_MSECOND;
         if (worst_frame > 0) {
             min_lat += worst_frame;
             if (GST_CLOCK_TIME_IS_VALID(max_lat)) max_lat += worst_frame;
@@ -393,6 +751,10 @@ static gboolean gst_dxgather_sink_query(GstAggregator *agg,
     }
 }
 
-static void gst_dxgather_init(GstDxGather * /*self*/) {
+static void gst_dxgather_init(GstDxGather *self) {
     /* Aggregator handles all pad management */
+    self->_join_mode = DEFAULT_JOIN_MODE;
+    self->_pts_tolerance = DEFAULT_PTS_TOLERANCE;
+    self->_pad_timeout = DEFAULT_PAD_TIMEOUT;
+    self->_last_running_time = GST_CLOCK_TIME_NONE;
 }
@@ -9,8 +9,18 @@ G_BEGIN_DECLS
 #define GST_TYPE_DXGATHER (gst_dxgather_get_type())
 G_DECLARE_FINAL_TYPE(GstDxGather, gst_dxgather, GST, DXGATHER, GstAggregator)
 
+enum class GstDxGatherJoinMode {
+    DROP = 0,    // merge at the latest head PTS, drop older heads
+    PARTIAL = 1  // merge at the oldest head PTS, mark missing branches skipped
+};
+
 struct _GstDxGather {
     GstAggregator parent_instance;
+
+    GstDxGatherJoinMode _join_mode;
+    guint _pts_tolerance;     // ms, partial join: max head distance to target
+    guint _pad_timeout;       // ms, partial join (live): wait for late branches
+    GstClockTime _last_running_time;  // partial join: target of the last output
 };
 
 G_END_DECLS
@@ -1,6 +1,8 @@
 #include "gst-dxinfer.hpp"
 #include "utils.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <new>
 #include "dx_dlfcn.h"
 #include <json-glib/json-glib.h>
@@ -15,9 +17,25 @@ enum class PropertyID {
     PROP_CONFIG_PATH,
     PROP_USE_ORT,
     PROP_BACKEND,
+    PROP_SCHEDULING,
+    PROP_STREAM_PRIORITIES,
+    PROP_STREAM_WEIGHTS,
+    PROP_SCHEDULER_DEADLINE,
+    PROP_SCHEDULER_QUEUE_SIZE,
+    PROP_OUT_OF_ORDER,
+    PROP_PUSH_THREADS,
+    PROP_BATCH_SIZE,
+    PROP_BATCH_TIMEOUT,
     N_PROPERTIES
 };
 
+#define DEFAULT_SCHEDULER_QUEUE_SIZE 4
+#define DEFAULT_PUSH_THREADS 1
+#define MAX_PUSH_THREADS 16
+#define DEFAULT_BATCH_SIZE 1
+#define MAX_BATCH_SIZE 64
+#define DEFAULT_BATCH_TIMEOUT_US 2000
+
 #define GST_TYPE_DXINFER_BACKEND (gst_dxinfer_backend_get_type())
 static GType gst_dxinfer_backend_get_type() {
     static GType type = 0;
@@ -34,6 +52,22 @@ static GType gst_dxinfer_backend_get_type() {
     return type;
 }
 
+#define GST_TYPE_DXINFER_SCHEDULING (gst_dxinfer_scheduling_get_type())
+static GType gst_dxinfer_scheduling_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {static_cast<int>(GstDxInferSchedPolicy::FIFO), "fifo", "fifo"},
+            {static_cast<int>(GstDxInferSchedPolicy::PRIORITY), "priority", "priority"},
+            {static_cast<int>(GstDxInferSchedPolicy::WFQ), "wfq", "wfq"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxInferScheduling", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
 GST_DEBUG_CATEGORY_STATIC(gst_dxinfer_debug_category);
 #define GST_CAT_DEFAULT gst_dxinfer_debug_category
 
@@ -54,7 +88,17 @@ static gboolean gst_dxinfer_src_query(GstPad *pad, GstObject *parent,
                                       GstQuery *query);
 
 static gpointer push_thread_func(GstDxInfer *self);
+static gpointer completion_thread_func(GstDxInfer *self);
+static void start_push_threads(GstDxInfer *self);
 static void drain_push_thread(GstDxInfer *self);
+static void start_submit_thread(GstDxInfer *self);
+static void stop_submit_thread(GstDxInfer *self);
+static void start_batch_thread(GstDxInfer *self);
+static void stop_batch_thread(GstDxInfer *self);
+static void flush_batch(GstDxInfer *self);
+static void request_model_swap(GstDxInfer *self, const gchar *model_path);
+static void stop_model_loader(GstDxInfer *self);
+static gboolean handle_model_swap_event(GstDxInfer *self, GstEvent *event);
 
 G_DEFINE_TYPE(GstDxInfer, gst_dxinfer, GST_TYPE_ELEMENT);
 
@@ -64,6 +108,58 @@ static gboolean string_is_empty(const gchar *value) {
     return value == nullptr || value[0] == '\0';
 }
 
+// Parses "stream_id:value[,stream_id:value...]" (e.g. "0:2,3:1") into `out`.
+// Malformed entries are skipped with a warning.
+guint gst_dxinfer_parse_stream_map(const gchar *spec, std::map<int, guint> &out) {
+    out.clear();
+    if (string_is_empty(spec)) {
+        return 0;
+    }
+    guint skipped = 0;
+    gchar **items = g_strsplit(spec, ",", -1);
+    for (gchar **it = items; *it != nullptr; ++it) {
+        gchar **kv = g_strsplit(g_strstrip(*it), ":", 2);
+        if (kv[0] == nullptr || kv[1] == nullptr) {
+            if (**it != '\0')
+                skipped++;
+            g_strfreev(kv);
+            continue;
+        }
+        gchar *end_id = nullptr;
+        gchar *end_val = nullptr;
+        gint64 id = g_ascii_strtoll(kv[0], &end_id, 10);
+        guint64 val = g_ascii_strtoull(kv[1], &end_val, 10);
+        if (end_id == kv[0] || end_val == kv[1] || id < 0 || id > G_MAXINT) {
+            skipped++;
+        } else {
+            out[static_cast<int>(id)] = static_cast<guint>(MIN(val, G_MAXUINT));
+        }
+        g_strfreev(kv);
+    }
+    g_strfreev(items);
+    return skipped;
+}
+
+GstDxInferStreamSlot &gst_dxinfer_stream_slot(GstDxInferEosContext &ctx,
+                                              int stream_id) {
+    if (stream_id >= 0 && stream_id < DX_MAX_STREAMS) {
+        return ctx.streams[stream_id];
+    }
+    std::lock_guard<std::mutex> lock(ctx.overflow_lock);
+    auto &slot = ctx.overflow[stream_id];
+    if (!slot) {
+        slot.reset(new GstDxInferStreamSlot());
+    }
+    return *slot;
+}
+
+static void parse_stream_map(GstDxInfer *self, const gchar *spec,
+                             std::map<int, guint> &out) {
+    guint skipped = gst_dxinfer_parse_stream_map(spec, out);
+    if (skipped > 0)
+        GST_WARNING_OBJECT(self, "Ignored %u malformed stream entries in '%s'", skipped, spec);
+}
+
 static void parse_config(GstDxInfer *self) {
     if (string_is_empty(self->_config_path)) {
         return;
@@ -127,6 +223,41 @@ static void parse_config(GstDxInfer *self) {
             self->_backend_type = BackendType::AUTO;
     }
 
+    if (json_object_has_member(object, "scheduling")) {
+        const gchar *policy_str = json_object_get_string_member(object, "scheduling");
+        if (g_strcmp0(policy_str, "priority") == 0)
+            self->_sched_ctx.policy = GstDxInferSchedPolicy::PRIORITY;
+        else if (g_strcmp0(policy_str, "wfq") == 0)
+            self->_sched_ctx.policy = GstDxInferSchedPolicy::WFQ;
+        else
+            self->_sched_ctx.policy = GstDxInferSchedPolicy::FIFO;
+    }
+
+    if (json_object_has_member(object, "stream_priorities")) {
+        g_object_set(self, "stream-priorities",
+                     json_object_get_string_member(object, "stream_priorities"), nullptr);
+    }
+
+    if (json_object_has_member(object, "stream_weights")) {
+        g_object_set(self, "stream-weights",
+                     json_object_get_string_member(object, "stream_weights"), nullptr);
+    }
+
+    if (json_object_has_member(object, "out_of_order")) {
+        self->_out_of_order = json_object_get_boolean_member(object, "out_of_order");
+    }
+    assign_uint_member("push_threads", self->_push_thread_count);
+    self->_push_thread_count = CLAMP(self->_push_thread_count, 1, MAX_PUSH_THREADS);
+
+    assign_uint_member("batch_size", self->_batch_ctx.batch_size);
+    self->_batch_ctx.batch_size = CLAMP(self->_batch_ctx.batch_size, 1, MAX_BATCH_SIZE);
+    assign_uint_member("batch_timeout_us", self->_batch_ctx.timeout_us);
+
+    assign_uint_member("scheduler_deadline_ms", self->_sched_ctx.deadline_ms);
+    assign_uint_member("scheduler_queue_size", self->_sched_ctx.queue_size);
+    if (self->_sched_ctx.queue_size == 0)
+        self->_sched_ctx.queue_size = 1;
+
     GST_INFO_OBJECT(self, "Config loaded: model=%s, preproc_id=%u, infer_id=%u, secondary_mode=%d, use_ort=%d",
                     model_path, self->_preproc_id, self->_infer_id, self->_secondary_mode, self->_use_ort);
     g_object_unref(parser);
@@ -142,6 +273,13 @@ static void gst_dxinfer_set_property(GObject *object, guint property_id,
         if (nullptr != self->_model_path)
             g_free(self->_model_path);
         self->_model_path = g_strdup(g_value_get_string(value));
+
+        GST_OBJECT_LOCK(self);
+        gboolean active = GST_STATE(self) >= GST_STATE_READY;
+        GST_OBJECT_UNLOCK(self);
+        if (active && !string_is_empty(self->_model_path)) {
+            request_model_swap(self, self->_model_path);
+        }
         break;
     }
     case PropertyID::PROP_CONFIG_PATH: {
@@ -171,6 +309,55 @@ static void gst_dxinfer_set_property(GObject *object, guint property_id,
         self->_backend_type = static_cast<BackendType>(g_value_get_enum(value));
         break;
     }
+    case PropertyID::PROP_SCHEDULING: {
+        self->_sched_ctx.policy =
+            static_cast<GstDxInferSchedPolicy>(g_value_get_enum(value));
+        break;
+    }
+    case PropertyID::PROP_STREAM_PRIORITIES: {
+        std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+        g_free(self->_sched_ctx.priorities_str);
+        self->_sched_ctx.priorities_str = g_value_dup_string(value);
+        parse_stream_map(self, self->_sched_ctx.priorities_str,
+                         self->_sched_ctx.priorities);
+        break;
+    }
+    case PropertyID::PROP_STREAM_WEIGHTS: {
+        std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+        g_free(self->_sched_ctx.weights_str);
+        self->_sched_ctx.weights_str = g_value_dup_string(value);
+        parse_stream_map(self, self->_sched_ctx.weights_str,
+                         self->_sched_ctx.weights);
+        break;
+    }
+    case PropertyID::PROP_SCHEDULER_DEADLINE: {
+        self->_sched_ctx.deadline_ms = g_value_get_uint(value);
+        break;
+    }
+    case PropertyID::PROP_SCHEDULER_QUEUE_SIZE: {
+        std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+        self->_sched_ctx.queue_size = g_value_get_uint(value);
+        self->_sched_ctx.cv.notify_all();
+        break;
+    }
+    case PropertyID::PROP_OUT_OF_ORDER: {
+        self->_out_of_order = g_value_get_boolean(value);
+        break;
+    }
+    case PropertyID::PROP_PUSH_THREADS: {
+        self->_push_thread_count = g_value_get_uint(value);
+        break;
+    }
+    case PropertyID::PROP_BATCH_SIZE: {
+        self->_batch_ctx.batch_size = g_value_get_uint(value);
+        break;
+    }
+    case PropertyID::PROP_BATCH_TIMEOUT: {
+        std::lock_guard<std::mutex> lock(self->_batch_ctx.batch_lock);
+        self->_batch_ctx.timeout_us = g_value_get_uint(value);
+        self->_batch_ctx.cv.notify_all();
+        break;
+    }
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -202,6 +389,37 @@ static void gst_dxinfer_get_property(GObject *object, guint property_id,
     case PropertyID::PROP_BACKEND:
         g_value_set_enum(value, static_cast<int>(self->_backend_type));
         break;
+    case PropertyID::PROP_SCHEDULING:
+        g_value_set_enum(value, static_cast<int>(self->_sched_ctx.policy));
+        break;
+    case PropertyID::PROP_STREAM_PRIORITIES: {
+        std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+        g_value_set_string(value, self->_sched_ctx.priorities_str);
+        break;
+    }
+    case PropertyID::PROP_STREAM_WEIGHTS: {
+        std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+        g_value_set_string(value, self->_sched_ctx.weights_str);
+        break;
+    }
+    case PropertyID::PROP_SCHEDULER_DEADLINE:
+        g_value_set_uint(value, self->_sched_ctx.deadline_ms);
+        break;
+    case PropertyID::PROP_SCHEDULER_QUEUE_SIZE:
+        g_value_set_uint(value, self->_sched_ctx.queue_size);
+        break;
+    case PropertyID::PROP_OUT_OF_ORDER:
+        g_value_set_boolean(value, self->_out_of_order);
+        break;
+    case PropertyID::PROP_PUSH_THREADS:
+        g_value_set_uint(value, self->_push_thread_count);
+        break;
+    case PropertyID::PROP_BATCH_SIZE:
+        g_value_set_uint(value, self->_batch_ctx.batch_size);
+        break;
+    case PropertyID::PROP_BATCH_TIMEOUT:
+        g_value_set_uint(value, self->_batch_ctx.timeout_us);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -218,6 +436,8 @@ static void dxinfer_dispose(GObject *object) {
         g_free(self->_model_path);
         self->_model_path = nullptr;
     }
+    g_clear_pointer(&self->_sched_ctx.priorities_str, g_free);
+    g_clear_pointer(&self->_sched_ctx.weights_str, g_free);
 
     G_OBJECT_CLASS(parent_class)->dispose(object);
 }
@@ -228,6 +448,9 @@ static void dxinfer_finalize(GObject *object) {
     // Drain push thread before destroying synchronization primitives.
     // Normal shutdown (PAUSED→READY) already drains, but abnormal paths
     // (e.g. FLUSH_STOP creating a thread in NULL state) may leave it alive.
+    stop_model_loader(self);
+    stop_submit_thread(self);
+    stop_batch_thread(self);
     {
         std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
         self->_push_ctx.push_running = FALSE;
@@ -241,16 +464,67 @@ static void dxinfer_finalize(GObject *object) {
     }
 
     self->_backend.~unique_ptr();
+    self->_push_ctx.push_threads.~vector();
+    self->_push_ctx.reorder.~map();
     self->_push_ctx.push_queue.~queue();
     self->_push_ctx.push_lock.~mutex();
     self->_push_ctx.cv.~condition_variable();
-    self->_eos_ctx.eos_lock.~mutex();
-    self->_eos_ctx.stream_eos_arrived.~set();
-    self->_eos_ctx.stream_pending_buffers.~map();
+    self->_eos_ctx.streams.~array();
+    self->_eos_ctx.overflow.~map();
+    self->_eos_ctx.overflow_lock.~mutex();
+    self->_sched_ctx.priorities.~map();
+    self->_sched_ctx.weights.~map();
+    self->_sched_ctx.streams.~map();
+    self->_sched_ctx.sched_lock.~mutex();
+    self->_sched_ctx.cv.~condition_variable();
+    self->_batch_ctx.pending.~vector();
+    self->_batch_ctx.batch_lock.~mutex();
+    self->_batch_ctx.cv.~condition_variable();
+    self->_swap_ctx.staged.~unique_ptr();
+    self->_swap_ctx.swap_lock.~mutex();
 
     G_OBJECT_CLASS(parent_class)->finalize(object);
 }
 
+static InferBackendOptions make_backend_options(GstDxInfer *self, const gchar *model_path) {
+    InferBackendOptions opts;
+    opts.model_path = model_path;
+    opts.use_ort = static_cast<bool>(self->_use_ort);
+    opts.completion_order = self->_out_of_order && !self->_secondary_mode;
+    return opts;
+}
+
+// Derives per-backend runtime settings (output size, collection mode,
+// batching) from the installed backend.
+static void apply_backend_config(GstDxInfer *self) {
+    bool completion_order = self->_out_of_order && !self->_secondary_mode;
+    self->_output_tensor_size = self->_backend->GetOutputBufferSize();
+    self->_push_ctx.unordered = self->_backend->CompletionOrderEnabled();
+    if (completion_order && !self->_push_ctx.unordered) {
+        GST_WARNING_OBJECT(self, "%s backend has no completion-order mode, "
+                           "collecting results in submit order",
+                           self->_backend->GetName());
+    }
+
+    self->_batch_ctx.frame_input_size = 0;
+    guint batch_size = self->_batch_ctx.batch_size;
+    if (batch_size > 1 && !self->_secondary_mode) {
+        size_t input_size = self->_backend->GetInputBufferSize();
+        size_t model_batch = self->_backend->GetModelBatchSize();
+        if (self->_push_ctx.unordered) {
+            GST_WARNING_OBJECT(self, "batch-size is ignored when out-of-order is enabled");
+        } else if (model_batch != batch_size || input_size == 0) {
+            GST_WARNING_OBJECT(self, "Model input takes %zu frame(s), not batch-size=%u; "
+                               "batching disabled", model_batch, batch_size);
+        } else {
+            self->_batch_ctx.frame_input_size = input_size / batch_size;
+        }
+    }
+    GST_INFO_OBJECT(self, "Backend '%s' initialized (out-of-order=%d, batch=%u)",
+                    self->_backend->GetName(), self->_push_ctx.unordered,
+                    self->_batch_ctx.frame_input_size > 0 ? batch_size : 1);
+}
+
 static gboolean handle_null_to_ready(GstDxInfer *self) {
     if (string_is_empty(self->_model_path)) {
         GST_ELEMENT_ERROR(self, RESOURCE, SETTINGS,
@@ -279,10 +553,7 @@ static gboolean handle_null_to_ready(GstDxInfer *self) {
         return FALSE;
     }
 
-    InferBackendOptions opts;
-    opts.model_path = self->_model_path;
-    opts.use_ort = static_cast<bool>(self->_use_ort);
-
+    InferBackendOptions opts = make_backend_options(self, self->_model_path);
     if (!self->_backend->Init(opts)) {
         GST_ELEMENT_ERROR(self, RESOURCE, FAILED,
                           ("[dxinfer] Failed to initialize %s backend",
@@ -292,11 +563,19 @@ static gboolean handle_null_to_ready(GstDxInfer *self) {
         return FALSE;
     }
 
-    self->_output_tensor_size = self->_backend->GetOutputBufferSize();
-    GST_INFO_OBJECT(self, "Backend '%s' initialized", self->_backend->GetName());
+    apply_backend_config(self);
     return TRUE;
 }
 
+static void reset_stream_slots(GstDxInfer *self) {
+    for (auto &slot : self->_eos_ctx.streams) {
+        slot.pending_buffers = 0;
+        slot.eos_arrived = false;
+    }
+    std::lock_guard<std::mutex> lock(self->_eos_ctx.overflow_lock);
+    self->_eos_ctx.overflow.clear();
+}
+
 static void handle_ready_to_paused(GstDxInfer *self) {
     GST_DEBUG_OBJECT(self, "Initializing runtime state");
 
@@ -304,18 +583,18 @@ static void handle_ready_to_paused(GstDxInfer *self) {
         self->_backend->Reset();
     }
 
-    self->_eos_ctx.stream_eos_arrived.clear();
-    self->_eos_ctx.stream_pending_buffers.clear();
+    reset_stream_slots(self);
 
     self->_timing_ctx.avg_latency = 0;
     self->_timing_ctx.throughput_count = 0;
     self->_timing_ctx.throughput_start = std::chrono::steady_clock::now();
 
     if (!self->_secondary_mode) {
-        self->_push_ctx.push_running = TRUE;
-        GST_INFO_OBJECT(self, "Starting push thread");
-        self->_push_ctx.push_thread =
-            g_thread_new("push-thread", (GThreadFunc)push_thread_func, self);
+        start_push_threads(self);
+        start_batch_thread(self);
+        start_submit_thread(self);
+    } else if (self->_sched_ctx.policy != GstDxInferSchedPolicy::FIFO) {
+        GST_WARNING_OBJECT(self, "scheduling is ignored in secondary mode");
     }
 }
 
@@ -347,6 +626,13 @@ static GstStateChangeReturn dxinfer_change_state(GstElement *element,
         break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
         GST_DEBUG_OBJECT(self, "Unblocking threads for shutdown");
+        {
+            std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+            self->_sched_ctx.submit_running = FALSE;
+            self->_sched_ctx.cv.notify_all();
+        }
+        self->_batch_ctx.batch_running = FALSE;
+        self->_batch_ctx.cv.notify_all();
         {
             std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
             self->_push_ctx.push_running = FALSE;
@@ -369,6 +655,8 @@ static GstStateChangeReturn dxinfer_change_state(GstElement *element,
         break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
         if (!self->_secondary_mode) {
+            stop_submit_thread(self);
+            stop_batch_thread(self);
             drain_push_thread(self);
         } else if (self->_backend) {
             self->_backend->Reset();
@@ -376,6 +664,7 @@ static GstStateChangeReturn dxinfer_change_state(GstElement *element,
         break;
     case GST_STATE_CHANGE_READY_TO_NULL:
         GST_DEBUG_OBJECT(self, "Releasing inference engine resources");
+        stop_model_loader(self);
         self->_backend.reset();
         break;
     default:
@@ -402,7 +691,9 @@ static void gst_dxinfer_class_init(GstDxInferClass *klass) {
 
     obj_properties[static_cast<int>(PropertyID::PROP_MODEL_PATH)] =
         g_param_spec_string("model-path", "model file path",
-                            "Path to the .dxnn model file used for inference.",
+                            "Path to the .dxnn model file used for inference. Changing it in "
+                            "READY or above loads the new model in the background and swaps it in "
+                            "between requests (result posted as a dxinfer-model-swap message).",
                             nullptr, G_PARAM_READWRITE);
     obj_properties[static_cast<int>(PropertyID::PROP_CONFIG_PATH)] = g_param_spec_string(
         "config-file-path", "config path",
@@ -432,6 +723,54 @@ static void gst_dxinfer_class_init(GstDxInferClass *klass) {
         GST_TYPE_DXINFER_BACKEND, static_cast<int>(BackendType::AUTO),
         G_PARAM_READWRITE);
 
+    obj_properties[static_cast<int>(PropertyID::PROP_OUT_OF_ORDER)] = g_param_spec_boolean(
+        "out-of-order", "out of order",
+        "Collect results in backend completion order instead of submit order. "
+        "Output order is kept per stream only (requires backend support, primary mode).",
+        FALSE, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_PUSH_THREADS)] = g_param_spec_uint(
+        "push-threads", "push threads",
+        "Number of threads collecting results and pushing downstream when out-of-order "
+        "is enabled (in-order collection always uses one).",
+        1, MAX_PUSH_THREADS, DEFAULT_PUSH_THREADS, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_BATCH_SIZE)] = g_param_spec_uint(
+        "batch-size", "batch size",
+        "Number of frames (from any stream) collected into one backend request for "
+        "batch-compiled models. The model input must hold exactly this many frames "
+        "(1 disables batching).",
+        1, MAX_BATCH_SIZE, DEFAULT_BATCH_SIZE, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_BATCH_TIMEOUT)] = g_param_spec_uint(
+        "batch-timeout", "batch timeout",
+        "Maximum time in microseconds the oldest frame waits for a batch to fill "
+        "before a partial batch is submitted.",
+        0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT_US, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_SCHEDULING)] = g_param_spec_enum(
+        "scheduling", "Cross-stream scheduling",
+        "Order in which frames from different streams are submitted to the backend "
+        "(fifo: arrival order, priority: strict stream-priorities classes with "
+        "stream-weights sharing inside a class, wfq: weighted fair queuing by stream-weights).",
+        GST_TYPE_DXINFER_SCHEDULING, static_cast<int>(GstDxInferSchedPolicy::FIFO),
+        G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_STREAM_PRIORITIES)] = g_param_spec_string(
+        "stream-priorities", "stream priorities",
+        "Per-stream priority classes as \"stream_id:class,...\" (higher class is served "
+        "first, unlisted streams use class 0).",
+        nullptr, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_STREAM_WEIGHTS)] = g_param_spec_string(
+        "stream-weights", "stream weights",
+        "Per-stream weights as \"stream_id:weight,...\" (unlisted streams use weight 1).",
+        nullptr, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_SCHEDULER_DEADLINE)] = g_param_spec_uint(
+        "scheduler-deadline", "scheduler deadline",
+        "Drop frames that waited longer than this many milliseconds in the scheduler "
+        "queue (0 = never drop). Only used when scheduling is not fifo.",
+        0, G_MAXUINT, 0, G_PARAM_READWRITE);
+    obj_properties[static_cast<int>(PropertyID::PROP_SCHEDULER_QUEUE_SIZE)] = g_param_spec_uint(
+        "scheduler-queue-size", "scheduler queue size",
+        "Maximum frames queued per stream before the chain function blocks. "
+        "Only used when scheduling is not fifo.",
+        1, 1024, DEFAULT_SCHEDULER_QUEUE_SIZE, G_PARAM_READWRITE);
+
     g_object_class_install_properties(gobject_class, static_cast<int>(PropertyID::N_PROPERTIES),
                                       obj_properties.data());
 
@@ -449,10 +788,35 @@ static void gst_dxinfer_class_init(GstDxInferClass *klass) {
     element_class->change_state = dxinfer_change_state;
 }
 
+// Blocks until every frame accepted so far has been pushed downstream:
+// scheduler queues, the pending batch, push_queue and reorder queues.
+static void wait_inflight_drained(GstDxInfer *self) {
+    {
+        // Frames still parked in the scheduler have not reached
+        // push_queue yet; let them through first.
+        std::unique_lock<std::mutex> sched_lk(self->_sched_ctx.sched_lock);
+        self->_sched_ctx.cv.wait(sched_lk, [self] {
+            return self->_sched_ctx.queued == 0 ||
+                   !self->_sched_ctx.submit_running;
+        });
+    }
+    flush_batch(self);
+    std::unique_lock<std::mutex> lock(self->_push_ctx.push_lock);
+    GST_DEBUG_OBJECT(self, "Waiting for %zu queued buffers to drain",
+                     self->_push_ctx.push_queue.size());
+    self->_push_ctx.cv.wait(lock, [self] {
+        return (self->_push_ctx.push_queue.empty() &&
+                self->_push_ctx.reorder_pending == 0) ||
+               !self->_push_ctx.push_running;
+    });
+}
+
 gboolean handle_custom_downstream_event(GstDxInfer *self, GstEvent *event) {
     gboolean res = TRUE;
     const GstStructure *s_check = gst_event_get_structure(event);
-    if (gst_structure_has_name(s_check, "application/x-dx-wrapped-event")) {
+    if (gst_structure_has_name(s_check, "dx-model-swap")) {
+        res = handle_model_swap_event(self, event);
+    } else if (gst_structure_has_name(s_check, "application/x-dx-wrapped-event")) {
         int stream_id = -1;
         GstEvent *original_event = nullptr;
         gst_structure_get_int(s_check, "stream-id", &stream_id);
@@ -463,18 +827,15 @@ gboolean handle_custom_downstream_event(GstDxInfer *self, GstEvent *event) {
             gst_event_unref(original_event);
         }
         if (is_eos) {
-            {
-                std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-                self->_eos_ctx.stream_eos_arrived.insert(stream_id);
-            }
+            auto &slot = gst_dxinfer_stream_slot(self->_eos_ctx, stream_id);
+            slot.eos_arrived = true;
             GST_DEBUG_OBJECT(self, "EOS Arrived From Stream [%d]", stream_id);
 
             if (!self->_secondary_mode) {
+                flush_batch(self);
                 std::unique_lock<std::mutex> lock(self->_push_ctx.push_lock);
-                self->_push_ctx.cv.wait(lock, [self, stream_id] {
-                    std::lock_guard<std::mutex> eos_lk(self->_eos_ctx.eos_lock);
-                    return self->_eos_ctx.stream_pending_buffers[stream_id] <= 0 ||
-                           !self->_push_ctx.push_running;
+                self->_push_ctx.cv.wait(lock, [self, &slot] {
+                    return slot.pending_buffers <= 0 || !self->_push_ctx.push_running;
                 });
             }
 
@@ -502,13 +863,7 @@ static gboolean gst_dxinfer_sink_event(GstPad *pad, GstObject *parent,
     case GST_EVENT_EOS: {
         GST_DEBUG_OBJECT(self, "Received EOS event");
         if (!self->_secondary_mode) {
-            std::unique_lock<std::mutex> lock(self->_push_ctx.push_lock);
-            GST_DEBUG_OBJECT(self, "EOS: waiting for %zu queued buffers to drain",
-                            self->_push_ctx.push_queue.size());
-            self->_push_ctx.cv.wait(lock, [self] {
-                return self->_push_ctx.push_queue.empty() ||
-                       !self->_push_ctx.push_running;
-            });
+            wait_inflight_drained(self);
         }
         if (self->_push_ctx.push_running || self->_secondary_mode) {
             GST_DEBUG_OBJECT(self, "EOS: queue drained, forwarding downstream");
@@ -519,6 +874,13 @@ static gboolean gst_dxinfer_sink_event(GstPad *pad, GstObject *parent,
     } break;
     case GST_EVENT_FLUSH_START:
         if (!self->_secondary_mode) {
+            {
+                std::lock_guard<std::mutex> lock(self->_sched_ctx.sched_lock);
+                self->_sched_ctx.submit_running = FALSE;
+                self->_sched_ctx.cv.notify_all();
+            }
+            self->_batch_ctx.batch_running = FALSE;
+            self->_batch_ctx.cv.notify_all();
             std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
             self->_push_ctx.push_running = FALSE;
         }
@@ -530,17 +892,17 @@ static gboolean gst_dxinfer_sink_event(GstPad *pad, GstObject *parent,
         break;
     case GST_EVENT_FLUSH_STOP:
         if (!self->_secondary_mode) {
+            stop_submit_thread(self);
+            stop_batch_thread(self);
             drain_push_thread(self);
-            self->_push_ctx.push_running = TRUE;
-            self->_push_ctx.push_thread =
-                g_thread_new("push-thread", (GThreadFunc)push_thread_func, self);
+            start_push_threads(self);
+            start_batch_thread(self);
+            start_submit_thread(self);
         } else if (self->_backend) {
             self->_backend->Reset();
         }
         {
-            std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-            self->_eos_ctx.stream_eos_arrived.clear();
-            self->_eos_ctx.stream_pending_buffers.clear();
+            reset_stream_slots(self);
         }
         res = gst_pad_event_default(pad, parent, event);
         break;
@@ -633,6 +995,11 @@ static gboolean gst_dxinfer_src_event(GstPad *pad, GstObject *parent,
     }
     GstEvent *qos_event = (is_wrapped && inner) ? inner : event;
 
+    if (GST_EVENT_TYPE(event) == GST_EVENT_CUSTOM_UPSTREAM &&
+        gst_event_has_name(event, "dx-model-swap")) {
+        return handle_model_swap_event(self, event);
+    }
+
     if (GST_EVENT_TYPE(qos_event) == GST_EVENT_QOS) {
         GstQOSType type;
         GstClockTime timestamp;
@@ -685,6 +1052,8 @@ static void gst_dxinfer_init(GstDxInfer *self) {
     self->_config_path = nullptr;
     self->_secondary_mode = FALSE;
     self->_use_ort = TRUE;
+    self->_out_of_order = FALSE;
+    self->_push_thread_count = DEFAULT_PUSH_THREADS;
     self->_backend_type = BackendType::AUTO;
     new (&self->_backend) std::unique_ptr<IInferBackend>();
     self->_output_tensor_size = 0;
@@ -692,8 +1061,11 @@ static void gst_dxinfer_init(GstDxInfer *self) {
     new (&self->_push_ctx.push_queue) std::queue<GstDxInferPushEntry>();
     new (&self->_push_ctx.push_lock) std::mutex();
     new (&self->_push_ctx.cv) std::condition_variable();
-    self->_push_ctx.push_thread = nullptr;
+    new (&self->_push_ctx.push_threads) std::vector<GThread *>();
     self->_push_ctx.push_running = FALSE;
+    self->_push_ctx.unordered = FALSE;
+    new (&self->_push_ctx.reorder) std::map<int, GstDxInferReorderStream>();
+    self->_push_ctx.reorder_pending = 0;
 
     self->_timing_ctx.avg_latency = 0;
     self->_timing_ctx.recent_latencies = g_queue_new();
@@ -705,9 +1077,43 @@ static void gst_dxinfer_init(GstDxInfer *self) {
     self->_timing_ctx.throughput_count = 0;
     self->_timing_ctx.throughput_start = std::chrono::steady_clock::now();
 
-    new (&self->_eos_ctx.eos_lock) std::mutex();
-    new (&self->_eos_ctx.stream_eos_arrived) std::set<int>();
-    new (&self->_eos_ctx.stream_pending_buffers) std::map<int, int>();
+    new (&self->_eos_ctx.streams) std::array<GstDxInferStreamSlot, DX_MAX_STREAMS>();
+    new (&self->_eos_ctx.overflow) std::map<int, std::unique_ptr<GstDxInferStreamSlot>>();
+    new (&self->_eos_ctx.overflow_lock) std::mutex();
+
+    self->_sched_ctx.policy = GstDxInferSchedPolicy::FIFO;
+    self->_sched_ctx.deadline_ms = 0;
+    self->_sched_ctx.queue_size = DEFAULT_SCHEDULER_QUEUE_SIZE;
+    self->_sched_ctx.priorities_str = nullptr;
+    self->_sched_ctx.weights_str = nullptr;
+    new (&self->_sched_ctx.priorities) std::map<int, guint>();
+    new (&self->_sched_ctx.weights) std::map<int, guint>();
+    self->_sched_ctx.submit_thread = nullptr;
+    self->_sched_ctx.submit_running = FALSE;
+    new (&self->_sched_ctx.streams) std::map<int, GstDxInferSchedStream>();
+    self->_sched_ctx.queued = 0;
+    self->_sched_ctx.virtual_time = 0.0;
+    new (&self->_sched_ctx.sched_lock) std::mutex();
+    new (&self->_sched_ctx.cv) std::condition_variable();
+
+    self->_batch_ctx.batch_size = DEFAULT_BATCH_SIZE;
+    self->_batch_ctx.timeout_us = DEFAULT_BATCH_TIMEOUT_US;
+    self->_batch_ctx.frame_input_size = 0;
+    self->_batch_ctx.size_warned = FALSE;
+    self->_batch_ctx.batch_thread = nullptr;
+    self->_batch_ctx.batch_running = FALSE;
+    new (&self->_batch_ctx.pending) std::vector<GstBuffer *>();
+    new (&self->_batch_ctx.batch_lock) std::mutex();
+    new (&self->_batch_ctx.cv) std::condition_variable();
+
+    self->_swap_ctx.load_thread = nullptr;
+    self->_swap_ctx.loading = FALSE;
+    self->_swap_ctx.requested_path = nullptr;
+    new (&self->_swap_ctx.staged) std::unique_ptr<IInferBackend>();
+    self->_swap_ctx.staged_path = nullptr;
+    self->_swap_ctx.staged_load_ms = 0;
+    self->_swap_ctx.staged_ready = FALSE;
+    new (&self->_swap_ctx.swap_lock) std::mutex();
 }
 
 gint64 calculate_average(GQueue *queue) {
@@ -752,10 +1158,50 @@ static void update_metrics(GstDxInfer *self, gint64 latency_ms) {
     }
 }
 
+// Drops one pending-buffer reference for `stream_id` and wakes any per-stream
+// EOS waiter blocked on push_ctx.cv.
+static void release_pending_buffer(GstDxInfer *self, int stream_id) {
+    gst_dxinfer_stream_slot(self->_eos_ctx, stream_id).pending_buffers--;
+    std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
+    self->_push_ctx.cv.notify_all();
+}
+
+static size_t tensor_bytes(const dxs::DXTensor &tensor) {
+    size_t count = 1;
+    for (int64_t dim : tensor._shape)
+        count *= static_cast<size_t>(dim);
+    return count * tensor._elemSize;
+}
+
+void gst_dxinfer_batch_split_output(GstDxInferBatch &batch, guint batch_size,
+                                    guint infer_id) {
+    for (size_t i = 0; i < batch.frames.size(); i++) {
+        dxs::DXTensors view;
+        view._data = batch.output._data;
+        view._mem_size = batch.output._mem_size;
+        for (const auto &tensor : batch.output._tensors) {
+            dxs::DXTensor slice = tensor;
+            if (!tensor._shape.empty() && tensor._data &&
+                tensor._shape[0] == static_cast<int64_t>(batch_size)) {
+                size_t stride = tensor_bytes(tensor) / batch_size;
+                slice._shape[0] = 1;
+                slice._data = static_cast<uint8_t *>(tensor._data) + i * stride;
+                if (tensor._phyAddr)
+                    slice._phyAddr = tensor._phyAddr + i * stride;
+            }
+            view._tensors.push_back(slice);
+        }
+        auto *frame_meta = dx_get_frame_meta(batch.frames[i]);
+        frame_meta->_output_tensors[infer_id] = std::move(view);
+    }
+}
+
 static gpointer push_thread_func(GstDxInfer *self) {
     while (self->_push_ctx.push_running) {
         GstBuffer *push_buf = nullptr;
         bool needs_get = false;
+        std::shared_ptr<GstDxInferBatch> batch;
+        guint batch_index = 0;
         {
             std::unique_lock<std::mutex> lock(self->_push_ctx.push_lock);
             self->_push_ctx.cv.wait(lock, [self] {
@@ -768,6 +1214,8 @@ static gpointer push_thread_func(GstDxInfer *self) {
             auto &entry = self->_push_ctx.push_queue.front();
             needs_get = entry.submitted;
             push_buf = entry.buffer;
+            batch = entry.batch;
+            batch_index = entry.batch_index;
         }
 
         if (!GST_IS_BUFFER(push_buf)) {
@@ -790,13 +1238,20 @@ static gpointer push_thread_func(GstDxInfer *self) {
             continue;
         }
 
-        if (needs_get) {
+        // A batch is one request: its first frame collects the result for
+        // all of them (batch frames are queued back to back).
+        if (needs_get && batch_index == 0) {
             auto get_start = std::chrono::steady_clock::now();
-            bool ok = self->_backend->Get(frame_meta->_output_tensors[self->_infer_id]);
+            bool ok = self->_backend->Get(
+                batch ? batch->output : frame_meta->_output_tensors[self->_infer_id]);
             if (!ok) {
                 GST_DEBUG_OBJECT(self, "Backend Get() returned false, exiting push loop");
                 break;
             }
+            if (batch) {
+                gst_dxinfer_batch_split_output(*batch, self->_batch_ctx.batch_size,
+                                               self->_infer_id);
+            }
             auto latency_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::steady_clock::now() - get_start).count();
             update_metrics(self, latency_ms);
@@ -806,10 +1261,7 @@ static gpointer push_thread_func(GstDxInfer *self) {
         GstFlowReturn ret = gst_pad_push(self->_srcpad, push_buf);
         // gst_pad_push takes buffer ownership regardless of return value
 
-        {
-            std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-            self->_eos_ctx.stream_pending_buffers[stream_id] -= 1;
-        }
+        gst_dxinfer_stream_slot(self->_eos_ctx, stream_id).pending_buffers--;
 
         {
             std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
@@ -831,16 +1283,111 @@ static gpointer push_thread_func(GstDxInfer *self) {
     return nullptr;
 }
 
+// Pushes every completed entry at the head of `stream_id`'s reorder queue.
+// Called with push_lock held via `lock`; the lock is dropped around
+// gst_pad_push(). Only one thread drains a given stream at a time, so
+// per-stream order is preserved while other streams push in parallel.
+static void push_ready_entries(GstDxInfer *self, int stream_id,
+                               std::unique_lock<std::mutex> &lock) {
+    auto &rs = self->_push_ctx.reorder[stream_id];
+    if (rs.pushing)
+        return;  // the owning thread re-checks the head after each push
+    rs.pushing = true;
+
+    while (self->_push_ctx.push_running && !rs.entries.empty() &&
+           rs.entries.front()->completed) {
+        GstDxInferReorderEntry *entry = rs.entries.front();
+        rs.entries.pop_front();
+        lock.unlock();
+
+        GstFlowReturn ret = gst_pad_push(self->_srcpad, entry->buffer);
+        delete entry;
+        gst_dxinfer_stream_slot(self->_eos_ctx, stream_id).pending_buffers--;
+
+        lock.lock();
+        self->_push_ctx.reorder_pending--;
+        self->_push_ctx.cv.notify_all();
+
+        if (ret != GST_FLOW_OK) {
+            if (ret != GST_FLOW_FLUSHING) {
+                GST_WARNING_OBJECT(self, "Push returned %s", gst_flow_get_name(ret));
+            }
+            self->_push_ctx.push_running = FALSE;
+            if (self->_backend)
+                self->_backend->Flush();
+            break;
+        }
+    }
+    rs.pushing = false;
+}
+
+static gpointer completion_thread_func(GstDxInfer *self) {
+    while (self->_push_ctx.push_running) {
+        dxs::DXTensors output;
+        void *tag = nullptr;
+        if (!self->_backend->GetCompleted(output, &tag)) {
+            GST_DEBUG_OBJECT(self, "Backend GetCompleted() returned false, exiting push loop");
+            break;
+        }
+
+        auto *entry = static_cast<GstDxInferReorderEntry *>(tag);
+        auto *frame_meta = dx_get_frame_meta(entry->buffer);
+        auto &tensors = frame_meta->_output_tensors[self->_infer_id]._tensors;
+        tensors.insert(tensors.end(), output._tensors.begin(), output._tensors.end());
+
+        std::unique_lock<std::mutex> lock(self->_push_ctx.push_lock);
+        entry->completed = true;
+        update_metrics(self, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - entry->put_time).count());
+        push_ready_entries(self, entry->stream_id, lock);
+    }
+
+    GST_INFO_OBJECT(self, "Push thread exiting");
+    return nullptr;
+}
+
+static void start_push_threads(GstDxInfer *self) {
+    guint count = self->_push_ctx.unordered ? MAX(self->_push_thread_count, 1u) : 1;
+    self->_push_ctx.push_running = TRUE;
+    GST_INFO_OBJECT(self, "Starting %u push thread(s)", count);
+    for (guint i = 0; i < count; i++) {
+        GThreadFunc func = self->_push_ctx.unordered
+            ? (GThreadFunc)completion_thread_func
+            : (GThreadFunc)push_thread_func;
+        self->_push_ctx.push_threads.push_back(g_thread_new("push-thread", func, self));
+    }
+}
+
 static void drain_push_thread(GstDxInfer *self) {
-    if (self->_push_ctx.push_thread) {
-        g_thread_join(self->_push_ctx.push_thread);
-        self->_push_ctx.push_thread = nullptr;
+    if (self->_push_ctx.unordered && self->_backend) {
+        // Completion threads block inside GetCompleted(); unblock them.
+        self->_backend->Flush();
     }
+    for (GThread *thread : self->_push_ctx.push_threads) {
+        g_thread_join(thread);
+    }
+    self->_push_ctx.push_threads.clear();
 
     if (self->_backend) {
         self->_backend->Reset();
     }
 
+    // Reset() waited for device-side completion, so no tag is referenced
+    // by the backend any more.
+    std::map<int, GstDxInferReorderStream> reorder;
+    {
+        std::lock_guard<std::mutex> push_lk(self->_push_ctx.push_lock);
+        std::swap(reorder, self->_push_ctx.reorder);
+        self->_push_ctx.reorder_pending = 0;
+    }
+    for (auto &kv : reorder) {
+        for (auto *entry : kv.second.entries) {
+            gst_buffer_unref(entry->buffer);
+            gst_dxinfer_stream_slot(self->_eos_ctx, entry->stream_id).pending_buffers--;
+            delete entry;
+        }
+    }
+
     {
         std::lock_guard<std::mutex> push_lk(self->_push_ctx.push_lock);
         while (!self->_push_ctx.push_queue.empty()) {
@@ -848,8 +1395,7 @@ static void drain_push_thread(GstDxInfer *self) {
             if (GST_IS_BUFFER(entry.buffer)) {
                 auto *fm = dx_get_frame_meta(entry.buffer);
                 if (fm) {
-                    std::lock_guard<std::mutex> eos_lk(self->_eos_ctx.eos_lock);
-                    self->_eos_ctx.stream_pending_buffers[fm->_stream_id] -= 1;
+                    gst_dxinfer_stream_slot(self->_eos_ctx, fm->_stream_id).pending_buffers--;
                 }
                 gst_buffer_unref(entry.buffer);
             }
@@ -924,10 +1470,7 @@ GstFlowReturn secondary_mode_infer(GstDxInfer *self, GstBuffer *buf, const DXFra
                 if (self->_backend->IsFlushed()) {
                     GST_DEBUG_OBJECT(self, "Backend Put() flushed during secondary inference");
                     gst_buffer_unref(buf);
-                    {
-                        std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-                        self->_eos_ctx.stream_pending_buffers[frame_meta->_stream_id] -= 1;
-                    }
+                    gst_dxinfer_stream_slot(self->_eos_ctx, frame_meta->_stream_id).pending_buffers--;
                     return GST_FLOW_FLUSHING;
                 }
                 GST_WARNING_OBJECT(self, "Backend Put() failed for object, skipping inference");
@@ -939,10 +1482,7 @@ GstFlowReturn secondary_mode_infer(GstDxInfer *self, GstBuffer *buf, const DXFra
                     GST_DEBUG_OBJECT(self, "Backend Get() flushed during secondary inference");
                     self->_backend->Reset();
                     gst_buffer_unref(buf);
-                    {
-                        std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-                        self->_eos_ctx.stream_pending_buffers[frame_meta->_stream_id] -= 1;
-                    }
+                    gst_dxinfer_stream_slot(self->_eos_ctx, frame_meta->_stream_id).pending_buffers--;
                     return GST_FLOW_FLUSHING;
                 }
                 GST_WARNING_OBJECT(self, "Backend Get() failed for object, skipping");
@@ -956,15 +1496,230 @@ GstFlowReturn secondary_mode_infer(GstDxInfer *self, GstBuffer *buf, const DXFra
         GST_WARNING_OBJECT(self, "Failed to push buffer: %s", gst_flow_get_name(ret));
     }
 
+    gst_dxinfer_stream_slot(self->_eos_ctx, stream_id).pending_buffers--;
+
+    return ret;
+}
+
+// Out-of-order variant of primary_mode_infer(): the frame joins its stream's
+// reorder queue before submission (the completion may fire before PutTagged
+// returns) and is pushed by whichever thread collects its result.
+static GstFlowReturn primary_mode_infer_unordered(GstDxInfer *self, GstBuffer *buf,
+                                                  DXFrameMeta *frame_meta) {
+    int stream_id = frame_meta->_stream_id;
+    auto *entry = new GstDxInferReorderEntry{buf, stream_id, false,
+                                             std::chrono::steady_clock::now()};
     {
-        std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-        self->_eos_ctx.stream_pending_buffers[stream_id] -= 1;
+        std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
+        self->_push_ctx.reorder[stream_id].entries.push_back(entry);
+        self->_push_ctx.reorder_pending++;
     }
 
-    return ret;
+    bool submitted = false;
+    auto iter = frame_meta->_input_tensors.find(self->_preproc_id);
+    if (iter != frame_meta->_input_tensors.end()) {
+        frame_meta->_output_tensors[self->_infer_id] = dxs::DXTensors();
+        frame_meta->_output_tensors[self->_infer_id].allocate(self->_output_tensor_size);
+
+        // `entry` may be pushed and freed by a completion thread as soon as
+        // PutTagged() succeeds; do not touch it afterwards.
+        submitted = self->_backend->PutTagged(
+            iter->second.data_ptr(),
+            frame_meta->_output_tensors[self->_infer_id].data_ptr(), entry);
+
+        if (!submitted && self->_backend->IsFlushed()) {
+            {
+                std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
+                auto &entries = self->_push_ctx.reorder[stream_id].entries;
+                entries.erase(std::find(entries.begin(), entries.end(), entry));
+                self->_push_ctx.reorder_pending--;
+                self->_push_ctx.cv.notify_all();
+            }
+            delete entry;
+            gst_buffer_unref(buf);
+            release_pending_buffer(self, stream_id);
+            return GST_FLOW_FLUSHING;
+        }
+        if (!submitted) {
+            GST_WARNING_OBJECT(self, "Backend PutTagged() failed, passing through without inference");
+        }
+    }
+
+    if (!submitted) {
+        std::unique_lock<std::mutex> lock(self->_push_ctx.push_lock);
+        entry->completed = true;
+        push_ready_entries(self, stream_id, lock);
+    }
+    return GST_FLOW_OK;
+}
+
+void gst_dxinfer_batch_pack_input(GstDxInferBatch &batch, size_t slot_size,
+                                  guint batch_size, guint preproc_id) {
+    const size_t count = batch.frames.size();
+    batch.input.allocate(slot_size * batch_size);
+    auto *dst = static_cast<uint8_t *>(batch.input.data_ptr());
+    for (size_t i = 0; i < count; i++) {
+        auto *frame_meta = dx_get_frame_meta(batch.frames[i]);
+        memcpy(dst + i * slot_size, frame_meta->_input_tensors[preproc_id].data_ptr(),
+               slot_size);
+    }
+    if (count < batch_size)
+        memset(dst + count * slot_size, 0, (batch_size - count) * slot_size);
+}
+
+bool gst_dxinfer_batch_timed_out(const GstDxInferBatchContext &ctx,
+                                 std::chrono::steady_clock::time_point now) {
+    return !ctx.pending.empty() &&
+           now >= ctx.first_arrival + std::chrono::microseconds(ctx.timeout_us);
+}
+
+// Submits the collected frames as one backend request (batch_lock held).
+// Unused slots of a partial batch are zeroed and their outputs ignored.
+static GstFlowReturn batch_submit_locked(GstDxInfer *self) {
+    auto &ctx = self->_batch_ctx;
+    if (ctx.pending.empty())
+        return GST_FLOW_OK;
+
+    auto batch = std::make_shared<GstDxInferBatch>();
+    std::swap(batch->frames, ctx.pending);
+    const size_t count = batch->frames.size();
+    gst_dxinfer_batch_pack_input(*batch, ctx.frame_input_size, ctx.batch_size,
+                                 self->_preproc_id);
+    batch->output.allocate(self->_output_tensor_size);
+
+    bool submitted = self->_backend->Put(batch->input.data_ptr(), batch->output.data_ptr());
+    if (!submitted) {
+        if (self->_backend->IsFlushed()) {
+            for (GstBuffer *frame : batch->frames) {
+                int stream_id = dx_get_frame_meta(frame)->_stream_id;
+                gst_buffer_unref(frame);
+                release_pending_buffer(self, stream_id);
+            }
+            return GST_FLOW_FLUSHING;
+        }
+        GST_WARNING_OBJECT(self, "Backend Put() failed, passing batch through without inference");
+    }
+    GST_LOG_OBJECT(self, "Submitted batch of %zu/%u frames", count, ctx.batch_size);
+
+    std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
+    for (size_t i = 0; i < count; i++) {
+        self->_push_ctx.push_queue.push({submitted, batch->frames[i],
+                                         submitted ? batch : nullptr,
+                                         static_cast<guint>(i)});
+    }
+    self->_push_ctx.cv.notify_all();
+    return GST_FLOW_OK;
+}
+
+// Batching variant of primary_mode_infer(). Frames without a matching input
+// tensor cannot share a batch; they flush the pending batch (to keep arrival
+// order) and pass through without inference.
+static GstFlowReturn batch_enqueue(GstDxInfer *self, GstBuffer *buf, DXFrameMeta *frame_meta) {
+    auto &ctx = self->_batch_ctx;
+    int stream_id = frame_meta->_stream_id;
+    std::lock_guard<std::mutex> lock(ctx.batch_lock);
+    if (!ctx.batch_running) {
+        gst_buffer_unref(buf);
+        release_pending_buffer(self, stream_id);
+        return GST_FLOW_FLUSHING;
+    }
+
+    auto iter = frame_meta->_input_tensors.find(self->_preproc_id);
+    if (iter == frame_meta->_input_tensors.end() ||
+        iter->second._mem_size != ctx.frame_input_size) {
+        if (iter != frame_meta->_input_tensors.end() && !ctx.size_warned) {
+            GST_WARNING_OBJECT(self, "Input tensor size %u does not match batch slot size %zu, "
+                               "passing frame through without inference",
+                               iter->second._mem_size, ctx.frame_input_size);
+            ctx.size_warned = TRUE;
+        }
+        if (batch_submit_locked(self) == GST_FLOW_FLUSHING) {
+            gst_buffer_unref(buf);
+            release_pending_buffer(self, stream_id);
+            return GST_FLOW_FLUSHING;
+        }
+        std::lock_guard<std::mutex> push_lk(self->_push_ctx.push_lock);
+        self->_push_ctx.push_queue.push({false, buf});
+        self->_push_ctx.cv.notify_all();
+        return GST_FLOW_OK;
+    }
+
+    if (ctx.pending.empty())
+        ctx.first_arrival = std::chrono::steady_clock::now();
+    ctx.pending.push_back(buf);
+    if (ctx.pending.size() >= ctx.batch_size)
+        return batch_submit_locked(self);
+    ctx.cv.notify_all();  // arm the timeout on the first frame of a batch
+    return GST_FLOW_OK;
+}
+
+// Submits a partial batch once its oldest frame has waited timeout_us.
+static gpointer batch_thread_func(GstDxInfer *self) {
+    auto &ctx = self->_batch_ctx;
+    std::unique_lock<std::mutex> lock(ctx.batch_lock);
+    while (ctx.batch_running) {
+        if (ctx.pending.empty()) {
+            ctx.cv.wait(lock);
+            continue;
+        }
+        if (!gst_dxinfer_batch_timed_out(ctx, std::chrono::steady_clock::now())) {
+            ctx.cv.wait_until(lock, ctx.first_arrival +
+                                        std::chrono::microseconds(ctx.timeout_us));
+            continue;
+        }
+        batch_submit_locked(self);
+    }
+    GST_INFO_OBJECT(self, "Batch thread exiting");
+    return nullptr;
+}
+
+static void start_batch_thread(GstDxInfer *self) {
+    if (self->_batch_ctx.frame_input_size == 0)
+        return;
+    self->_batch_ctx.batch_running = TRUE;
+    self->_batch_ctx.batch_thread =
+        g_thread_new("batch-thread", (GThreadFunc)batch_thread_func, self);
+}
+
+static void stop_batch_thread(GstDxInfer *self) {
+    auto &ctx = self->_batch_ctx;
+    {
+        std::lock_guard<std::mutex> lock(ctx.batch_lock);
+        ctx.batch_running = FALSE;
+        ctx.cv.notify_all();
+    }
+    if (ctx.batch_thread) {
+        g_thread_join(ctx.batch_thread);
+        ctx.batch_thread = nullptr;
+    }
+
+    std::vector<GstBuffer *> pending;
+    {
+        std::lock_guard<std::mutex> lock(ctx.batch_lock);
+        std::swap(pending, ctx.pending);
+    }
+    for (GstBuffer *frame : pending) {
+        int stream_id = dx_get_frame_meta(frame)->_stream_id;
+        gst_buffer_unref(frame);
+        release_pending_buffer(self, stream_id);
+    }
+}
+
+// Submits a partial batch right away (EOS must not wait for the timeout).
+static void flush_batch(GstDxInfer *self) {
+    std::lock_guard<std::mutex> lock(self->_batch_ctx.batch_lock);
+    if (self->_batch_ctx.batch_running)
+        batch_submit_locked(self);
 }
 
 GstFlowReturn primary_mode_infer(GstDxInfer *self, GstBuffer *buf, DXFrameMeta *frame_meta) {
+    if (self->_push_ctx.unordered) {
+        return primary_mode_infer_unordered(self, buf, frame_meta);
+    }
+    if (self->_batch_ctx.frame_input_size > 0) {
+        return batch_enqueue(self, buf, frame_meta);
+    }
+
     bool submitted = false;
     auto iter = frame_meta->_input_tensors.find(self->_preproc_id);
     if (iter != frame_meta->_input_tensors.end()) {
@@ -978,8 +1733,7 @@ GstFlowReturn primary_mode_infer(GstDxInfer *self, GstBuffer *buf, DXFrameMeta *
         if (!submitted) {
             if (self->_backend->IsFlushed()) {
                 gst_buffer_unref(buf);
-                std::lock_guard<std::mutex> lock(self->_eos_ctx.eos_lock);
-                self->_eos_ctx.stream_pending_buffers[frame_meta->_stream_id] -= 1;
+                gst_dxinfer_stream_slot(self->_eos_ctx, frame_meta->_stream_id).pending_buffers--;
                 return GST_FLOW_FLUSHING;
             }
             GST_WARNING_OBJECT(self, "Backend Put() failed, passing through without inference");
@@ -994,6 +1748,406 @@ GstFlowReturn primary_mode_infer(GstDxInfer *self, GstBuffer *buf, DXFrameMeta *
     return GST_FLOW_OK;
 }
 
+// PRIORITY serves the highest non-empty class first; inside a class, and
+// for WFQ overall, the stream with the smallest virtual finish tag wins
+// (self-clocked fair queuing). A head's tag is stamped against the virtual
+// time when it first competes and then kept: re-stamping a waiting stream
+// on every step would push it behind a heavier stream indefinitely.
+int gst_dxinfer_sched_dequeue(GstDxInferSchedContext &ctx,
+                              std::chrono::steady_clock::time_point now,
+                              GstDxInferSchedEntry &entry, bool &late) {
+    int best = -1;
+    guint best_class = 0;
+    double best_tag = 0.0;
+    double best_cost = 0.0;
+
+    for (auto &kv : ctx.streams) {
+        if (kv.second.queue.empty())
+            continue;
+        guint cls = 0;
+        if (ctx.policy == GstDxInferSchedPolicy::PRIORITY) {
+            auto it = ctx.priorities.find(kv.first);
+            cls = (it != ctx.priorities.end()) ? it->second : 0;
+        }
+        auto wit = ctx.weights.find(kv.first);
+        guint weight = (wit != ctx.weights.end() && wit->second > 0) ? wit->second : 1;
+        double cost = 1.0 / weight;
+        if (kv.second.head_tag < 0.0)
+            kv.second.head_tag = MAX(ctx.virtual_time, kv.second.finish_tag) + cost;
+        double tag = kv.second.head_tag;
+
+        if (best < 0 || cls > best_class || (cls == best_class && tag < best_tag)) {
+            best = kv.first;
+            best_class = cls;
+            best_tag = tag;
+            best_cost = cost;
+        }
+    }
+    late = false;
+    if (best < 0)
+        return -1;
+
+    auto &st = ctx.streams[best];
+    entry = st.queue.front();
+    st.queue.pop_front();
+    st.finish_tag = best_tag;
+    st.head_tag = -1.0;
+    ctx.virtual_time = best_tag - best_cost;
+
+    if (ctx.deadline_ms > 0) {
+        auto waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - entry.arrival).count();
+        late = waited_ms > static_cast<gint64>(ctx.deadline_ms);
+        if (late)
+            st.dropped++;
+    }
+    return best;
+}
+
+static gpointer submit_thread_func(GstDxInfer *self) {
+    auto &ctx = self->_sched_ctx;
+    while (ctx.submit_running) {
+        GstBuffer *buf = nullptr;
+        int stream_id = -1;
+        bool late = false;
+        {
+            std::unique_lock<std::mutex> lock(ctx.sched_lock);
+            ctx.cv.wait(lock, [&ctx] {
+                return !ctx.submit_running || ctx.queued > 0;
+            });
+            if (!ctx.submit_running)
+                break;
+
+            GstDxInferSchedEntry entry{};
+            stream_id = gst_dxinfer_sched_dequeue(ctx, std::chrono::steady_clock::now(),
+                                                  entry, late);
+            if (stream_id < 0)
+                continue;
+            buf = entry.buffer;
+            // Space freed in this stream's queue; wake a blocked chain.
+            ctx.cv.notify_all();
+        }
+
+        GstFlowReturn ret = GST_FLOW_OK;
+        if (late) {
+            GST_LOG_OBJECT(self, "Dropping late frame from stream [%d] (pts=%" GST_TIME_FORMAT ")",
+                           stream_id, GST_TIME_ARGS(GST_BUFFER_PTS(buf)));
+            gst_buffer_unref(buf);
+            release_pending_buffer(self, stream_id);
+        } else {
+            ret = primary_mode_infer(self, buf, dx_get_frame_meta(buf));
+        }
+
+        {
+            // queued still counted this entry until it reached push_queue, so
+            // an EOS waiting for queued == 0 cannot overtake it.
+            std::lock_guard<std::mutex> lock(ctx.sched_lock);
+            ctx.queued--;
+            ctx.cv.notify_all();
+        }
+
+        if (ret == GST_FLOW_FLUSHING)
+            break;
+    }
+
+    GST_INFO_OBJECT(self, "Submit thread exiting");
+    return nullptr;
+}
+
+static void start_submit_thread(GstDxInfer *self) {
+    auto &ctx = self->_sched_ctx;
+    if (ctx.policy == GstDxInferSchedPolicy::FIFO || ctx.submit_thread)
+        return;
+
+    ctx.virtual_time = 0.0;
+    ctx.queued = 0;
+    ctx.submit_running = TRUE;
+    GST_INFO_OBJECT(self, "Starting submit thread (scheduling=%s)",
+                    ctx.policy == GstDxInferSchedPolicy::PRIORITY ? "priority" : "wfq");
+    ctx.submit_thread =
+        g_thread_new("submit-thread", (GThreadFunc)submit_thread_func, self);
+}
+
+static void stop_submit_thread(GstDxInfer *self) {
+    auto &ctx = self->_sched_ctx;
+    GThread *thread = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(ctx.sched_lock);
+        ctx.submit_running = FALSE;
+        ctx.cv.notify_all();
+        thread = ctx.submit_thread;
+    }
+    if (thread)
+        g_thread_join(thread);
+
+    std::map<int, GstDxInferSchedStream> leftover;
+    {
+        std::lock_guard<std::mutex> lock(ctx.sched_lock);
+        ctx.submit_thread = nullptr;
+        std::swap(leftover, ctx.streams);
+        ctx.queued = 0;
+        ctx.cv.notify_all();
+    }
+    for (auto &kv : leftover) {
+        if (kv.second.dropped > 0) {
+            GST_INFO_OBJECT(self, "Stream [%d]: %" G_GUINT64_FORMAT " late frames dropped",
+                            kv.first, kv.second.dropped);
+        }
+        for (auto &entry : kv.second.queue) {
+            gst_buffer_unref(entry.buffer);
+            release_pending_buffer(self, kv.first);
+        }
+    }
+}
+
+// Parks `buf` in its stream's scheduler queue, blocking while the queue is
+// full. Returns GST_FLOW_FLUSHING if the scheduler stopped meanwhile.
+static GstFlowReturn scheduler_enqueue(GstDxInfer *self, GstBuffer *buf, int stream_id) {
+    auto &ctx = self->_sched_ctx;
+    {
+        std::unique_lock<std::mutex> lock(ctx.sched_lock);
+        ctx.cv.wait(lock, [&ctx, stream_id] {
+            return !ctx.submit_running ||
+                   ctx.streams[stream_id].queue.size() < ctx.queue_size;
+        });
+        if (ctx.submit_running) {
+            ctx.streams[stream_id].queue.push_back(
+                {buf, std::chrono::steady_clock::now()});
+            ctx.queued++;
+            ctx.cv.notify_all();
+            return GST_FLOW_OK;
+        }
+    }
+    gst_buffer_unref(buf);
+    release_pending_buffer(self, stream_id);
+    return GST_FLOW_FLUSHING;
+}
+
+static void post_model_swap_message(GstDxInfer *self, const gchar *model_path,
+                                    gboolean success, const gchar *error,
+                                    guint64 load_ms, guint64 stall_ms) {
+    GstStructure *s = gst_structure_new(
+        "dxinfer-model-swap", "model-path", G_TYPE_STRING, model_path,
+        "success", G_TYPE_BOOLEAN, success, "load-time-ms", G_TYPE_UINT64, load_ms,
+        nullptr);
+    if (success) {
+        gst_structure_set(s, "stall-time-ms", G_TYPE_UINT64, stall_ms, nullptr);
+    } else {
+        gst_structure_set(s, "error", G_TYPE_STRING, error, nullptr);
+    }
+    gst_element_post_message(GST_ELEMENT(self),
+                             gst_message_new_element(GST_OBJECT(self), s));
+}
+
+// Creates, initializes and warms up a backend for `model_path` without
+// touching the running one. Returns nullptr and sets `error` on failure.
+static std::unique_ptr<IInferBackend> load_backend(GstDxInfer *self, const gchar *model_path,
+                                                   std::string &error) {
+    if (!g_file_test(model_path, G_FILE_TEST_IS_REGULAR)) {
+        error = "model file does not exist or is not a regular file";
+        return nullptr;
+    }
+    auto backend = InferBackendFactory::Create(self->_backend_type);
+    if (!backend) {
+        error = "failed to create inference backend";
+        return nullptr;
+    }
+    if (!backend->Init(make_backend_options(self, model_path))) {
+        error = std::string("failed to initialize ") + backend->GetName() + " backend";
+        return nullptr;
+    }
+
+    // One dummy request so the first live frame does not pay for lazy
+    // device/runtime setup of the new model.
+    size_t input_size = backend->GetInputBufferSize();
+    if (input_size > 0) {
+        dxs::DXTensors input;
+        dxs::DXTensors output;
+        input.allocate(input_size);
+        memset(input.data_ptr(), 0, input_size);
+        output.allocate(backend->GetOutputBufferSize());
+        bool ok;
+        if (backend->CompletionOrderEnabled()) {
+            void *tag = nullptr;
+            ok = backend->PutTagged(input.data_ptr(), output.data_ptr(), nullptr) &&
+                 backend->GetCompleted(output, &tag);
+        } else {
+            ok = backend->Put(input.data_ptr(), output.data_ptr()) && backend->Get(output);
+        }
+        if (!ok) {
+            error = "warm-up inference failed";
+            return nullptr;
+        }
+        backend->Reset();
+    }
+    return backend;
+}
+
+static gpointer model_load_thread_func(GstDxInfer *self) {
+    auto &ctx = self->_swap_ctx;
+    for (;;) {
+        gchar *model_path = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(ctx.swap_lock);
+            if (!ctx.requested_path) {
+                ctx.loading = FALSE;
+                break;
+            }
+            model_path = ctx.requested_path;
+            ctx.requested_path = nullptr;
+        }
+
+        GST_INFO_OBJECT(self, "Loading replacement model: %s", model_path);
+        auto load_start = std::chrono::steady_clock::now();
+        std::string error;
+        std::unique_ptr<IInferBackend> backend = load_backend(self, model_path, error);
+        guint64 load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - load_start).count();
+
+        if (!backend) {
+            GST_WARNING_OBJECT(self, "Model swap to %s failed: %s", model_path, error.c_str());
+            post_model_swap_message(self, model_path, FALSE, error.c_str(), load_ms, 0);
+            g_free(model_path);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(ctx.swap_lock);
+            // A staged backend that was never installed is superseded and
+            // released below, outside the lock.
+            std::swap(ctx.staged, backend);
+            g_free(ctx.staged_path);
+            ctx.staged_path = model_path;
+            ctx.staged_load_ms = load_ms;
+            ctx.staged_ready = TRUE;
+        }
+        GST_INFO_OBJECT(self, "Replacement model ready after %" G_GUINT64_FORMAT " ms", load_ms);
+    }
+    return nullptr;
+}
+
+// Queues an asynchronous load of `model_path`; the swap itself happens on
+// the streaming thread at the next buffer.
+static void request_model_swap(GstDxInfer *self, const gchar *model_path) {
+    auto &ctx = self->_swap_ctx;
+    std::lock_guard<std::mutex> lock(ctx.swap_lock);
+    g_free(ctx.requested_path);
+    ctx.requested_path = g_strdup(model_path);
+    if (ctx.loading)
+        return;  // the running loader picks up the latest request
+    if (ctx.load_thread)
+        g_thread_join(ctx.load_thread);  // already finished its last load
+    ctx.loading = TRUE;
+    ctx.load_thread = g_thread_new("model-load", (GThreadFunc)model_load_thread_func, self);
+}
+
+static void stop_model_loader(GstDxInfer *self) {
+    auto &ctx = self->_swap_ctx;
+    GThread *thread = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(ctx.swap_lock);
+        g_clear_pointer(&ctx.requested_path, g_free);
+        thread = ctx.load_thread;
+        ctx.load_thread = nullptr;
+    }
+    if (thread)
+        g_thread_join(thread);
+
+    std::lock_guard<std::mutex> lock(ctx.swap_lock);
+    ctx.staged.reset();
+    g_clear_pointer(&ctx.staged_path, g_free);
+    ctx.staged_ready = FALSE;
+}
+
+static gpointer release_backend_func(gpointer data) {
+    delete static_cast<IInferBackend *>(data);
+    return nullptr;
+}
+
+// Installs a staged backend between requests. In primary mode every frame
+// already submitted to the current backend is pushed first, then the
+// streaming threads are restarted on the new backend. The old engine is
+// released off the streaming thread.
+static void apply_model_swap(GstDxInfer *self) {
+    auto &ctx = self->_swap_ctx;
+    if (!ctx.staged_ready)
+        return;
+
+    std::unique_ptr<IInferBackend> backend;
+    gchar *model_path = nullptr;
+    guint64 load_ms = 0;
+    {
+        std::lock_guard<std::mutex> lock(ctx.swap_lock);
+        std::swap(backend, ctx.staged);
+        model_path = ctx.staged_path;
+        ctx.staged_path = nullptr;
+        load_ms = ctx.staged_load_ms;
+        ctx.staged_ready = FALSE;
+    }
+    if (!backend) {
+        g_free(model_path);
+        return;
+    }
+
+    auto swap_start = std::chrono::steady_clock::now();
+    if (!self->_secondary_mode) {
+        wait_inflight_drained(self);
+        if (!self->_push_ctx.push_running || GST_PAD_IS_FLUSHING(self->_sinkpad)) {
+            // Flushing or shutting down: keep the new backend staged.
+            std::lock_guard<std::mutex> lock(ctx.swap_lock);
+            if (!ctx.staged) {
+                ctx.staged = std::move(backend);
+                ctx.staged_path = model_path;
+                ctx.staged_load_ms = load_ms;
+                ctx.staged_ready = TRUE;
+            } else {
+                g_free(model_path);
+            }
+            return;
+        }
+        stop_submit_thread(self);
+        stop_batch_thread(self);
+        {
+            std::lock_guard<std::mutex> lock(self->_push_ctx.push_lock);
+            self->_push_ctx.push_running = FALSE;
+        }
+        self->_backend->Flush();
+        self->_push_ctx.cv.notify_all();
+        drain_push_thread(self);
+    }
+
+    std::swap(self->_backend, backend);
+    apply_backend_config(self);
+    if (!self->_secondary_mode) {
+        start_push_threads(self);
+        start_batch_thread(self);
+        start_submit_thread(self);
+    }
+    g_thread_unref(g_thread_new("model-release", release_backend_func, backend.release()));
+
+    guint64 stall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - swap_start).count();
+    GST_INFO_OBJECT(self, "Swapped to model %s (load %" G_GUINT64_FORMAT " ms, stall %"
+                    G_GUINT64_FORMAT " ms)", model_path, load_ms, stall_ms);
+    post_model_swap_message(self, model_path, TRUE, nullptr, load_ms, stall_ms);
+    g_free(model_path);
+}
+
+// "dx-model-swap" custom event (upstream or downstream) carrying a
+// "model-path" string: same effect as setting the model-path property.
+static gboolean handle_model_swap_event(GstDxInfer *self, GstEvent *event) {
+    const gchar *model_path =
+        gst_structure_get_string(gst_event_get_structure(event), "model-path");
+    gboolean res = !string_is_empty(model_path);
+    if (res) {
+        g_object_set(self, "model-path", model_path, nullptr);
+    } else {
+        GST_WARNING_OBJECT(self, "dx-model-swap event without model-path");
+    }
+    gst_event_unref(event);
+    return res;
+}
+
 static GstFlowReturn gst_dxinfer_chain(GstPad *pad, GstObject *parent,
                                        GstBuffer *buf) {
 
@@ -1013,6 +2167,8 @@ static GstFlowReturn gst_dxinfer_chain(GstPad *pad, GstObject *parent,
         return GST_FLOW_OK;
     }
 
+    apply_model_swap(self);
+
     auto *frame_meta = dx_get_frame_meta(buf);
 
     if (!frame_meta) {
@@ -1021,18 +2177,20 @@ static GstFlowReturn gst_dxinfer_chain(GstPad *pad, GstObject *parent,
         return GST_FLOW_OK;
     }
 
-    { // NOSONAR - scope for lock
-        std::unique_lock<std::mutex> lock(self->_eos_ctx.eos_lock);
-        if (self->_eos_ctx.stream_eos_arrived.count(frame_meta->_stream_id) > 0) {
-            GST_INFO_OBJECT(self, "EOS Already Arrived [%d] ", frame_meta->_stream_id);
-            gst_buffer_unref(buf);
-            return GST_FLOW_OK;
-        }
-        self->_eos_ctx.stream_pending_buffers[frame_meta->_stream_id]++;
+    // Wrapped EOS is serialized with buffers on this thread, so the flag
+    // cannot change between the check and the increment.
+    auto &slot = gst_dxinfer_stream_slot(self->_eos_ctx, frame_meta->_stream_id);
+    if (slot.eos_arrived) {
+        GST_INFO_OBJECT(self, "EOS Already Arrived [%d] ", frame_meta->_stream_id);
+        gst_buffer_unref(buf);
+        return GST_FLOW_OK;
     }
+    slot.pending_buffers++;
 
     if (self->_secondary_mode) {
         return secondary_mode_infer(self, buf, frame_meta);
+    } else if (self->_sched_ctx.submit_running) {
+        return scheduler_enqueue(self, buf, frame_meta->_stream_id);
     } else {
         return primary_mode_infer(self, buf, frame_meta);
     }
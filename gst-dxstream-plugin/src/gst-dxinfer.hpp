@@ -4,41 +4,154 @@
 #include "./../metadata/gst-dxframemeta.hpp"
 #include "./../metadata/gst-dxobjectmeta.hpp"
 #include "infer_backend/infer_backend_factory.hpp"
+#include "utils.hpp"
+#include <array>
 #include <chrono>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <gst/gst.h>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
-#include <set>
+#include <vector>
 
 G_BEGIN_DECLS
 
 #define GST_TYPE_DXINFER (gst_dxinfer_get_type())
 G_DECLARE_FINAL_TYPE(GstDxInfer, gst_dxinfer, GST, DXINFER, GstElement)
 
+// One backend request carrying several frames (dynamic batching). Output
+// tensors are split into per-frame views that keep `output` alive.
+struct GstDxInferBatch {
+    std::vector<GstBuffer *> frames;
+    dxs::DXTensors input;
+    dxs::DXTensors output;
+};
+
 struct GstDxInferPushEntry {
     bool submitted;
     GstBuffer *buffer;
+    std::shared_ptr<GstDxInferBatch> batch;  // set when submitted as a batch
+    guint batch_index = 0;
+};
+
+// Out-of-order mode: one entry per frame, handed to the backend as the
+// completion tag. Entries stay in their stream's reorder queue until every
+// older entry of the same stream has been pushed.
+struct GstDxInferReorderEntry {
+    GstBuffer *buffer;
+    int stream_id;
+    bool completed;
+    std::chrono::steady_clock::time_point put_time;
 };
 
-// Lock ordering rule: push_lock may hold eos_lock (via cv predicate), but
-// eos_lock must NEVER be held when acquiring push_lock.  Push thread acquires
-// them sequentially (never nested), so no deadlock occurs.
+struct GstDxInferReorderStream {
+    std::deque<GstDxInferReorderEntry *> entries;
+    bool pushing = false;  // a push thread currently owns this stream's head
+};
+
+// Waiters on cv (EOS, drain) evaluate their predicates under push_lock;
+// anyone who changes a predicate input (push_queue, reorder_pending, a
+// stream's pending count) notifies under push_lock afterwards.
 struct GstDxInferPushContext {
-    GThread *push_thread;
+    std::vector<GThread *> push_threads;
     std::atomic<gboolean> push_running;
     std::queue<GstDxInferPushEntry> push_queue;
     std::mutex push_lock;
     std::condition_variable cv;
+
+    // Out-of-order collection (backend completion order, per-stream reorder).
+    gboolean unordered;
+    std::map<int, GstDxInferReorderStream> reorder;
+    size_t reorder_pending;
+};
+
+// Per-stream EOS/pending state. Ids 0..DX_MAX_STREAMS-1 index a dense
+// table; any other id gets a slot in `overflow`, created on first use under
+// overflow_lock and never moved, so references stay valid until the next
+// READY->PAUSED reset. Counters are atomics so the per-buffer hot path takes
+// no lock for low ids; EOS waiters re-check them under push_lock after each
+// push_ctx.cv notification.
+struct GstDxInferStreamSlot {
+    std::atomic<int> pending_buffers{0};
+    std::atomic<bool> eos_arrived{false};
 };
 
 struct GstDxInferEosContext {
-    std::mutex eos_lock;
-    std::set<int> stream_eos_arrived;
-    std::map<int, int> stream_pending_buffers;
+    std::array<GstDxInferStreamSlot, DX_MAX_STREAMS> streams;
+    std::map<int, std::unique_ptr<GstDxInferStreamSlot>> overflow;
+    std::mutex overflow_lock;
+};
+
+// Cross-stream submission policy applied in front of backend Put().
+// FIFO submits straight from the chain function (arrival order); the other
+// policies park frames in per-stream queues drained by a submit thread.
+enum class GstDxInferSchedPolicy { FIFO = 0, PRIORITY = 1, WFQ = 2 };
+
+struct GstDxInferSchedEntry {
+    GstBuffer *buffer;
+    std::chrono::steady_clock::time_point arrival;
+};
+
+struct GstDxInferSchedStream {
+    std::deque<GstDxInferSchedEntry> queue;
+    double finish_tag = 0.0;  // WFQ virtual finish time of the last dequeue
+    double head_tag = -1.0;   // finish tag of the queue head, fixed once stamped (< 0: not yet)
+    guint64 dropped = 0;      // frames dropped by the deadline check
+};
+
+// Lock ordering rule: sched_lock is never held while acquiring push_lock.
+// The submit thread releases it before calling Put().
+struct GstDxInferSchedContext {
+    GstDxInferSchedPolicy policy;
+    guint deadline_ms;   // 0 = never drop late frames
+    guint queue_size;    // per-stream bound before the chain blocks
+    gchar *priorities_str;
+    gchar *weights_str;
+    std::map<int, guint> priorities;  // stream_id -> class (higher first)
+    std::map<int, guint> weights;     // stream_id -> WFQ weight
+
+    GThread *submit_thread;
+    std::atomic<gboolean> submit_running;
+    std::map<int, GstDxInferSchedStream> streams;
+    size_t queued;
+    double virtual_time;
+    std::mutex sched_lock;
+    std::condition_variable cv;
+};
+
+// Dynamic batching: frames with a matching input tensor are collected into
+// a batch of up to batch_size and submitted once. A partial batch is sent
+// when the oldest frame has waited timeout_us. Lock ordering: batch_lock may
+// hold push_lock, never the reverse.
+struct GstDxInferBatchContext {
+    guint batch_size;          // frames per request (1 = batching off)
+    guint timeout_us;          // max wait for a partial batch
+    size_t frame_input_size;   // bytes per frame slot, 0 = batching inactive
+    gboolean size_warned;
+
+    GThread *batch_thread;
+    std::atomic<gboolean> batch_running;
+    std::vector<GstBuffer *> pending;
+    std::chrono::steady_clock::time_point first_arrival;
+    std::mutex batch_lock;
+    std::condition_variable cv;
+};
+
+// Hot model swap: a replacement backend is loaded and warmed up on
+// load_thread, then installed by the streaming thread between requests.
+// Requests arriving while a load runs replace requested_path (latest wins).
+struct GstDxInferSwapContext {
+    GThread *load_thread;
+    gboolean loading;
+    gchar *requested_path;
+    std::unique_ptr<IInferBackend> staged;
+    gchar *staged_path;
+    guint64 staged_load_ms;
+    std::atomic<gboolean> staged_ready;
+    std::mutex swap_lock;
 };
 
 struct GstDxInferTimingContext {
@@ -63,6 +176,8 @@ struct _GstDxInfer {
 
     gboolean _secondary_mode;
     gboolean _use_ort;
+    gboolean _out_of_order;
+    guint _push_thread_count;
     gchar *_model_path;
     gchar *_config_path;
     BackendType _backend_type;
@@ -72,6 +187,9 @@ struct _GstDxInfer {
 
     GstDxInferPushContext _push_ctx;
     GstDxInferEosContext _eos_ctx;
+    GstDxInferSchedContext _sched_ctx;
+    GstDxInferBatchContext _batch_ctx;
+    GstDxInferSwapContext _swap_ctx;
     GstDxInferTimingContext _timing_ctx;
 };
 
@@ -79,4 +197,46 @@ using GstDxInfer = struct _GstDxInfer;
 
 G_END_DECLS
 
+// Scheduler steps that only touch their arguments (no element, no locking).
+
+// Parses "stream_id:value,..." into `out`. Entries with a bad id (negative
+// or above G_MAXINT) or value are skipped; returns how many were skipped.
+guint gst_dxinfer_parse_stream_map(const gchar *spec, std::map<int, guint> &out);
+
+// Returns the EOS/pending slot of `stream_id`: the dense table entry for
+// ids below DX_MAX_STREAMS, otherwise the overflow slot (created if absent).
+GstDxInferStreamSlot &gst_dxinfer_stream_slot(GstDxInferEosContext &ctx,
+                                              int stream_id);
+
+// One submit step, called with sched_lock held: picks the next stream by
+// ctx.policy, pops its oldest frame into `entry` and advances the WFQ clock.
+// `late` is set when the frame waited longer than ctx.deadline_ms at `now`
+// (that stream's dropped counter is bumped). Returns the stream id, or -1
+// when every queue is empty.
+int gst_dxinfer_sched_dequeue(GstDxInferSchedContext &ctx,
+                              std::chrono::steady_clock::time_point now,
+                              GstDxInferSchedEntry &entry, bool &late);
+
+// Dynamic batching steps, likewise free of the backend and of locking.
+
+// Copies the input tensor `preproc_id` of every frame of `batch` into
+// batch.input, batch_size slots of slot_size bytes. Unused slots of a
+// partial batch are zeroed.
+void gst_dxinfer_batch_pack_input(GstDxInferBatch &batch, size_t slot_size,
+                                  guint batch_size, guint preproc_id);
+
+// Gives every frame of `batch` a view of its slice of the batched output,
+// stored as its output tensors `infer_id`. Only the per-tensor _data
+// pointers are per frame. The view's _data and _mem_size still describe the
+// whole batch output buffer: a frame's slices of several tensors are not
+// one contiguous region, so _data is there to keep the buffer alive.
+// Tensors whose leading dimension is not batch_size are shared unsplit.
+void gst_dxinfer_batch_split_output(GstDxInferBatch &batch, guint batch_size,
+                                    guint infer_id);
+
+// True when ctx.pending holds frames whose oldest has waited
+// ctx.timeout_us at `now`, so the partial batch is due.
+bool gst_dxinfer_batch_timed_out(const GstDxInferBatchContext &ctx,
+                                 std::chrono::steady_clock::time_point now);
+
 #endif // GST_DXINFER_H
@@ -9,7 +9,49 @@
 GST_DEBUG_CATEGORY_STATIC(gst_dxinputselector_debug_category);
 #define GST_CAT_DEFAULT gst_dxinputselector_debug_category
 
-enum class PropertyID { PROP_0, PROP_MAX_QUEUE_SIZE };
+#define DEFAULT_LIVE_MODE FALSE
+#define DEFAULT_LATENCY_BUDGET 0
+#define DEFAULT_PAD_LATENCY_BUDGET -1
+#define DEFAULT_SCHEDULING GstDxInputSelectorPolicy::MIN_PTS
+#define DEFAULT_FAIRNESS_WINDOW 1000
+#define DEFAULT_PAD_WEIGHT 1
+
+enum class PropertyID {
+    PROP_0,
+    PROP_MAX_QUEUE_SIZE,
+    PROP_LIVE_MODE,
+    PROP_LATENCY_BUDGET,
+    PROP_SCHEDULING,
+    PROP_FAIRNESS_WINDOW
+};
+
+enum class PadPropertyID {
+    PROP_0,
+    PROP_LATENCY_BUDGET,
+    PROP_WEIGHT,
+    PROP_FORWARDED,
+    PROP_SKIPPED
+};
+
+#define GST_TYPE_DXINPUTSELECTOR_SCHEDULING                                    \
+    (gst_dxinputselector_scheduling_get_type())
+static GType gst_dxinputselector_scheduling_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {static_cast<int>(GstDxInputSelectorPolicy::MIN_PTS), "min-pts", "min-pts"},
+            {static_cast<int>(GstDxInputSelectorPolicy::ROUND_ROBIN), "round-robin",
+             "round-robin"},
+            {static_cast<int>(GstDxInputSelectorPolicy::WEIGHTED_RR), "weighted-rr",
+             "weighted-rr"},
+            {static_cast<int>(GstDxInputSelectorPolicy::DEFICIT), "deficit", "deficit"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxInputSelectorScheduling", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
 
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
     "sink_%u", GST_PAD_SINK, GST_PAD_REQUEST, GST_STATIC_CAPS("video/x-raw"));
@@ -19,6 +61,7 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
 
 static GstFlowReturn gst_dxinputselector_aggregate(GstAggregator *agg,
                                                     gboolean timeout);
+static GstClockTime gst_dxinputselector_get_next_time(GstAggregator *agg);
 static gboolean gst_dxinputselector_sink_event(GstAggregator *agg,
                                                 GstAggregatorPad *pad,
                                                 GstEvent *event);
@@ -34,6 +77,119 @@ static gboolean gst_dxinputselector_sink_query(GstAggregator *agg,
                                                 GstQuery *query);
 static void gst_dxinputselector_finalize(GObject *object);
 
+G_DEFINE_TYPE(GstDxInputSelectorPad, gst_dxinputselector_pad,
+              GST_TYPE_AGGREGATOR_PAD);
+
+static void gst_dxinputselector_pad_set_property(GObject *object,
+                                                 guint prop_id,
+                                                 const GValue *value,
+                                                 GParamSpec *pspec) {
+    auto *pad = GST_DXINPUTSELECTOR_PAD(object);
+    switch (static_cast<PadPropertyID>(prop_id)) {
+    case PadPropertyID::PROP_LATENCY_BUDGET:
+        pad->_latency_budget = g_value_get_int(value);
+        break;
+    case PadPropertyID::PROP_WEIGHT:
+        pad->_weight = g_value_get_uint(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxinputselector_pad_get_property(GObject *object,
+                                                 guint prop_id, GValue *value,
+                                                 GParamSpec *pspec) {
+    const auto *pad = GST_DXINPUTSELECTOR_PAD(object);
+    switch (static_cast<PadPropertyID>(prop_id)) {
+    case PadPropertyID::PROP_LATENCY_BUDGET:
+        g_value_set_int(value, pad->_latency_budget);
+        break;
+    case PadPropertyID::PROP_WEIGHT:
+        g_value_set_uint(value, pad->_weight);
+        break;
+    case PadPropertyID::PROP_FORWARDED:
+    case PadPropertyID::PROP_SKIPPED: {
+        // Counters are updated by aggregate() under the element lock. A
+        // queued head has been passed over by every output since it was
+        // queued; that part is settled lazily when the pad is served.
+        GstElement *parent = gst_pad_get_parent_element(GST_PAD(object));
+        if (parent)
+            GST_OBJECT_LOCK(parent);
+        guint64 v = pad->_forwarded;
+        if (static_cast<PadPropertyID>(prop_id) == PadPropertyID::PROP_SKIPPED) {
+            v = pad->_skipped;
+            if (parent && pad->_queued)
+                v += GST_DXINPUTSELECTOR(parent)->_outputs - pad->_queued_at;
+        }
+        if (parent) {
+            GST_OBJECT_UNLOCK(parent);
+            gst_object_unref(parent);
+        }
+        g_value_set_uint64(value, v);
+        break;
+    }
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxinputselector_pad_class_init(GstDxInputSelectorPadClass *klass) {
+    auto *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->set_property = gst_dxinputselector_pad_set_property;
+    gobject_class->get_property = gst_dxinputselector_pad_get_property;
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PadPropertyID::PROP_LATENCY_BUDGET),
+        g_param_spec_int(
+            "latency-budget", "Latency Budget",
+            "Live mode: how long (ms) output may wait for this pad past the "
+            "oldest pending frame before the pad is skipped. "
+            "-1 uses the element's latency-budget",
+            -1, G_MAXINT, DEFAULT_PAD_LATENCY_BUDGET,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PadPropertyID::PROP_WEIGHT),
+        g_param_spec_uint(
+            "weight", "Weight",
+            "Share of the output for weighted-rr (frames per turn) and "
+            "deficit scheduling",
+            1, 1000, DEFAULT_PAD_WEIGHT,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PadPropertyID::PROP_FORWARDED),
+        g_param_spec_uint64(
+            "forwarded", "Forwarded", "Frames forwarded from this pad", 0,
+            G_MAXUINT64, 0,
+            (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PadPropertyID::PROP_SKIPPED),
+        g_param_spec_uint64(
+            "skipped", "Skipped",
+            "Outputs of other pads while this pad had a frame waiting, plus "
+            "live-mode timeouts that skipped it as late",
+            0, G_MAXUINT64, 0,
+            (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+}
+
+static void gst_dxinputselector_pad_init(GstDxInputSelectorPad *pad) {
+    pad->_latency_budget = DEFAULT_PAD_LATENCY_BUDGET;
+    pad->_weight = DEFAULT_PAD_WEIGHT;
+    pad->_forwarded = 0;
+    pad->_skipped = 0;
+    pad->_window_forwarded = 0;
+    pad->_queued_at = 0;
+    pad->_queued = FALSE;
+    pad->_stream_id = -1;
+}
+
 G_DEFINE_TYPE(GstDxInputSelector, gst_dxinputselector, GST_TYPE_AGGREGATOR);
 
 static GstAggregatorClass *parent_class = nullptr;  // NOSONAR
@@ -42,10 +198,26 @@ static void gst_dxinputselector_set_property(GObject *object, guint prop_id,
                                              const GValue *value,
                                              GParamSpec *pspec) {
     auto *self = GST_DXINPUTSELECTOR(object);
-    if (static_cast<PropertyID>(prop_id) == PropertyID::PROP_MAX_QUEUE_SIZE) {
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_MAX_QUEUE_SIZE:
         self->_max_queue_size = g_value_get_uint(value);
-    } else {
+        break;
+    case PropertyID::PROP_LIVE_MODE:
+        self->_live_mode = g_value_get_boolean(value);
+        break;
+    case PropertyID::PROP_LATENCY_BUDGET:
+        self->_latency_budget = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_SCHEDULING:
+        self->_scheduling =
+            static_cast<GstDxInputSelectorPolicy>(g_value_get_enum(value));
+        break;
+    case PropertyID::PROP_FAIRNESS_WINDOW:
+        self->_fairness_window = g_value_get_uint(value);
+        break;
+    default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
     }
 }
 
@@ -53,10 +225,25 @@ static void gst_dxinputselector_get_property(GObject *object, guint prop_id,
                                              GValue *value,
                                              GParamSpec *pspec) {
     const auto *self = GST_DXINPUTSELECTOR(object);
-    if (static_cast<PropertyID>(prop_id) == PropertyID::PROP_MAX_QUEUE_SIZE) {
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_MAX_QUEUE_SIZE:
         g_value_set_uint(value, self->_max_queue_size);
-    } else {
+        break;
+    case PropertyID::PROP_LIVE_MODE:
+        g_value_set_boolean(value, self->_live_mode);
+        break;
+    case PropertyID::PROP_LATENCY_BUDGET:
+        g_value_set_uint(value, self->_latency_budget);
+        break;
+    case PropertyID::PROP_SCHEDULING:
+        g_value_set_enum(value, static_cast<gint>(self->_scheduling));
+        break;
+    case PropertyID::PROP_FAIRNESS_WINDOW:
+        g_value_set_uint(value, self->_fairness_window);
+        break;
+    default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
     }
 }
 
@@ -125,10 +312,19 @@ gst_dxinputselector_sink_event(GstAggregator *agg, GstAggregatorPad *pad,
         return TRUE;
 
     case GST_EVENT_FLUSH_START:
-    case GST_EVENT_FLUSH_STOP:
         // L1B: aggregator default handles upstream/downstream broadcast
         return GST_AGGREGATOR_CLASS(parent_class)->sink_event(agg, pad, event);
 
+    case GST_EVENT_FLUSH_STOP: {
+        gboolean ret =
+            GST_AGGREGATOR_CLASS(parent_class)->sink_event(agg, pad, event);
+        // The pad queue was dropped; cached heads are no longer valid.
+        GST_OBJECT_LOCK(agg);
+        GST_DXINPUTSELECTOR(agg)->_heads_dirty = TRUE;
+        GST_OBJECT_UNLOCK(agg);
+        return ret;
+    }
+
     default:
         // TAG / GAP / unknown → wrap per-stream so outputselector can route
         gst_pad_push_event(GST_AGGREGATOR_SRC_PAD(agg),
@@ -138,68 +334,284 @@ gst_dxinputselector_sink_event(GstAggregator *agg, GstAggregatorPad *pad,
     }
 }
 
-static GstFlowReturn
-gst_dxinputselector_aggregate(GstAggregator *agg, gboolean /*timeout*/) {
-    GstDxInputSelector *self = GST_DXINPUTSELECTOR(agg);
+// Heap order: smallest PTS on top, ties broken by stream id so the choice
+// does not depend on sink pad list order.
+static bool head_later(const GstDxInputSelectorHead &a,
+                       const GstDxInputSelectorHead &b) {
+    if (a.pts != b.pts)
+        return a.pts > b.pts;
+    return a.stream_id > b.stream_id;
+}
 
-    GstClockTime min_pts = GST_CLOCK_TIME_NONE;
-    GstAggregatorPad *min_pad = nullptr;
-    std::vector<std::pair<GstAggregatorPad *, GstBuffer *>> peeked;
-    gboolean all_done = TRUE;
-    std::vector<gint> new_eos_streams;
+// Forget every cached head and mark all sink pads idle. Needed whenever pads
+// were added/removed or a flush dropped queued buffers.
+static void reset_heads_locked(GstDxInputSelector *self) {
+    self->_heads.clear();
+    self->_idle_pads.clear();
+    self->_rr_order.clear();
+    for (GList *l = GST_ELEMENT(self)->sinkpads; l; l = l->next) {
+        auto *pad = GST_DXINPUTSELECTOR_PAD(l->data);
+        pad->_stream_id = get_sink_pad_index(GST_PAD(pad));
+        // Settle the outputs the dropped head had waited through.
+        if (pad->_queued) {
+            pad->_skipped += self->_outputs - pad->_queued_at;
+            pad->_queued = FALSE;
+        }
+        self->_idle_pads.push_back(GST_AGGREGATOR_PAD(pad));
+        self->_rr_order.push_back(GST_AGGREGATOR_PAD(pad));
+    }
+    std::sort(self->_rr_order.begin(), self->_rr_order.end(),
+              [](GstAggregatorPad *a, GstAggregatorPad *b) {
+                  return GST_DXINPUTSELECTOR_PAD(a)->_stream_id <
+                         GST_DXINPUTSELECTOR_PAD(b)->_stream_id;
+              });
+    self->_pads_cookie = GST_ELEMENT(self)->pads_cookie;
+    self->_heads_dirty = FALSE;
+}
 
-    GST_OBJECT_LOCK(agg);
-    for (GList *l = GST_ELEMENT(agg)->sinkpads; l; l = l->next) {
-        GstAggregatorPad *pad = GST_AGGREGATOR_PAD(l->data);
-        gint stream_id = get_sink_pad_index(GST_PAD(pad));
+// Peek only the idle pads; those that now hold a buffer move into the heap.
+// Pads already in the heap keep their head until it is popped.
+static void refill_heads_locked(GstDxInputSelector *self) {
+    if (self->_heads_dirty ||
+        self->_pads_cookie != GST_ELEMENT(self)->pads_cookie)
+        reset_heads_locked(self);
 
-        if (gst_aggregator_pad_is_eos(pad)) {
-            GstBuffer *buf = gst_aggregator_pad_peek_buffer(pad);
-            if (buf) {
-                peeked.emplace_back(pad, buf);
-                all_done = FALSE;
-            } else if (self->_stream_eos_sent.count(stream_id) == 0) {
-                self->_stream_eos_sent.insert(stream_id);
-                new_eos_streams.push_back(stream_id);
-            }
+    size_t kept = 0;
+    for (GstAggregatorPad *pad : self->_idle_pads) {
+        GstBuffer *buf = gst_aggregator_pad_peek_buffer(pad);
+        if (!buf) {
+            self->_idle_pads[kept++] = pad;
             continue;
         }
+        auto *dxpad = GST_DXINPUTSELECTOR_PAD(pad);
+        self->_heads.push_back({GST_BUFFER_PTS(buf), dxpad->_stream_id, pad});
+        std::push_heap(self->_heads.begin(), self->_heads.end(), head_later);
+        dxpad->_queued = TRUE;
+        dxpad->_queued_at = self->_outputs;
+        gst_buffer_unref(buf);
+    }
+    self->_idle_pads.resize(kept);
+}
 
-        all_done = FALSE;
-        GstBuffer *buf = gst_aggregator_pad_peek_buffer(pad);
-        if (!buf) {
-            GST_OBJECT_UNLOCK(agg);
-            for (auto &p : peeked) gst_buffer_unref(p.second);
-            return GST_AGGREGATOR_FLOW_NEED_DATA;
+static GstClockTime pad_latency_budget(const GstDxInputSelector *self,
+                                       GstAggregatorPad *pad) {
+    gint ms = GST_DXINPUTSELECTOR_PAD(pad)->_latency_budget;
+    guint budget = ms >= 0 ? (guint)ms : self->_latency_budget;
+    return (GstClockTime)budget * GST_MSECOND;
+}
+
+static GstClockTime head_running_time(const GstDxInputSelectorHead &head) {
+    return gst_segment_to_running_time(&head.pad->segment, GST_FORMAT_TIME,
+                                       head.pts);
+}
+
+static GstClockTime current_running_time(GstElement *element) {
+    GstClock *clock = gst_element_get_clock(element);
+    if (!clock)
+        return GST_CLOCK_TIME_NONE;
+    GstClockTime now = gst_clock_get_time(clock);
+    GstClockTime base = gst_element_get_base_time(element);
+    gst_object_unref(clock);
+    return now > base ? now - base : 0;
+}
+
+// Live mode deadline: the oldest pending head plus the largest budget among
+// the pads it is still waiting for. GstAggregator adds its own latency and
+// calls aggregate(timeout=TRUE) once the deadline passes.
+static GstClockTime gst_dxinputselector_get_next_time(GstAggregator *agg) {
+    GstDxInputSelector *self = GST_DXINPUTSELECTOR(agg);
+    if (!self->_live_mode)
+        return GST_CLOCK_TIME_NONE;
+
+    GstClockTime next = GST_CLOCK_TIME_NONE;
+    GST_OBJECT_LOCK(agg);
+    refill_heads_locked(self);
+    if (!self->_heads.empty()) {
+        GstClockTime budget = 0;
+        for (GstAggregatorPad *pad : self->_idle_pads) {
+            if (!gst_aggregator_pad_is_eos(pad))
+                budget = MAX(budget, pad_latency_budget(self, pad));
         }
-        peeked.emplace_back(pad, buf);
+        GstClockTime rt = head_running_time(self->_heads.front());
+        if (GST_CLOCK_TIME_IS_VALID(rt))
+            next = rt + budget;
     }
     GST_OBJECT_UNLOCK(agg);
+    return next;
+}
 
-    for (gint sid : new_eos_streams) {
-        send_wrapped_eos(agg, sid);
+// Round-robin over stream ids, skipping streams without a queued frame.
+// Weighted-rr keeps serving the same stream until it has forwarded `weight`
+// frames in a row or runs dry.
+static GstAggregatorPad *select_round_robin_locked(GstDxInputSelector *self) {
+    const auto &order = self->_rr_order;
+    gboolean weighted =
+        self->_scheduling == GstDxInputSelectorPolicy::WEIGHTED_RR;
+
+    size_t start = 0;
+    while (start < order.size() &&
+           GST_DXINPUTSELECTOR_PAD(order[start])->_stream_id <= self->_rr_last)
+        start++;
+
+    if (weighted && self->_rr_credit > 0 && start > 0) {
+        auto *cur = GST_DXINPUTSELECTOR_PAD(order[start - 1]);
+        if (cur->_stream_id == self->_rr_last && cur->_queued) {
+            self->_rr_credit--;
+            return order[start - 1];
+        }
     }
 
-    if (all_done && peeked.empty()) {
-        GST_DEBUG_OBJECT(self, "All streams EOS, returning GST_FLOW_EOS");
-        return GST_FLOW_EOS;
+    for (size_t k = 0; k < order.size(); k++) {
+        GstAggregatorPad *pad = order[(start + k) % order.size()];
+        auto *dxpad = GST_DXINPUTSELECTOR_PAD(pad);
+        if (!dxpad->_queued)
+            continue;
+        self->_rr_last = dxpad->_stream_id;
+        self->_rr_credit = weighted ? dxpad->_weight - 1 : 0;
+        return pad;
+    }
+    return nullptr;
+}
+
+// Deficit fairness: forward the queued stream that got the least output
+// relative to its weight in the current window (oldest head wins ties). The
+// window restarts every fairness-window ms of stream running time.
+static GstAggregatorPad *select_deficit_locked(GstDxInputSelector *self) {
+    GstClockTime rt = head_running_time(self->_heads.front());
+    GstClockTime window = (GstClockTime)self->_fairness_window * GST_MSECOND;
+    if (GST_CLOCK_TIME_IS_VALID(rt) &&
+        (!GST_CLOCK_TIME_IS_VALID(self->_window_start) ||
+         rt < self->_window_start || rt - self->_window_start >= window)) {
+        for (GstAggregatorPad *pad : self->_rr_order)
+            GST_DXINPUTSELECTOR_PAD(pad)->_window_forwarded = 0;
+        self->_window_start = rt;
     }
 
-    for (auto &p : peeked) {
-        GstClockTime pts = GST_BUFFER_PTS(p.second);
-        if (min_pts == GST_CLOCK_TIME_NONE ||
-            (GST_CLOCK_TIME_IS_VALID(pts) && pts < min_pts)) {
-            min_pts = pts;
-            min_pad = p.first;
+    const GstDxInputSelectorHead *best = nullptr;
+    for (const auto &head : self->_heads) {
+        if (!best) {
+            best = &head;
+            continue;
         }
+        const auto *a = GST_DXINPUTSELECTOR_PAD(head.pad);
+        const auto *b = GST_DXINPUTSELECTOR_PAD(best->pad);
+        // a.forwarded / a.weight vs b.forwarded / b.weight, without division
+        guint64 lhs = a->_window_forwarded * b->_weight;
+        guint64 rhs = b->_window_forwarded * a->_weight;
+        if (lhs < rhs || (lhs == rhs && head_later(*best, head)))
+            best = &head;
     }
+    return best ? best->pad : nullptr;
+}
+
+// Remove the head the scheduling policy forwards next and account for it.
+// min-pts pops the heap top; the other policies pick an arbitrary entry and
+// re-heapify, which is linear like their scan.
+static GstAggregatorPad *take_next_head_locked(GstDxInputSelector *self) {
+    GstAggregatorPad *pad = nullptr;
+    switch (self->_scheduling) {
+    case GstDxInputSelectorPolicy::ROUND_ROBIN:
+    case GstDxInputSelectorPolicy::WEIGHTED_RR:
+        pad = select_round_robin_locked(self);
+        break;
+    case GstDxInputSelectorPolicy::DEFICIT:
+        pad = select_deficit_locked(self);
+        break;
+    default:
+        break;
+    }
+
+    auto it = self->_heads.end();
+    if (pad)
+        it = std::find_if(self->_heads.begin(), self->_heads.end(),
+                          [pad](const GstDxInputSelectorHead &h) {
+                              return h.pad == pad;
+                          });
+    if (it == self->_heads.end()) {
+        std::pop_heap(self->_heads.begin(), self->_heads.end(), head_later);
+        pad = self->_heads.back().pad;
+        self->_heads.pop_back();
+    } else {
+        self->_heads.erase(it);
+        std::make_heap(self->_heads.begin(), self->_heads.end(), head_later);
+    }
+
+    auto *dxpad = GST_DXINPUTSELECTOR_PAD(pad);
+    dxpad->_skipped += self->_outputs - dxpad->_queued_at;
+    dxpad->_queued = FALSE;
+    dxpad->_forwarded++;
+    dxpad->_window_forwarded++;
+    self->_outputs++;
+    return pad;
+}
 
-    for (auto &p : peeked) gst_buffer_unref(p.second);
+static GstFlowReturn
+gst_dxinputselector_aggregate(GstAggregator *agg, gboolean timeout) {
+    GstDxInputSelector *self = GST_DXINPUTSELECTOR(agg);
+    std::vector<gint> new_eos_streams;
+    std::vector<GstAggregatorPad *> empty_pads;
+    GstAggregatorPad *min_pad = nullptr;
+
+    // Taken before the object lock: gst_element_get_clock() locks it too.
+    gboolean live_timeout = self->_live_mode && timeout;
+    GstClockTime now =
+        live_timeout ? current_running_time(GST_ELEMENT(agg)) : GST_CLOCK_TIME_NONE;
+
+    GST_OBJECT_LOCK(agg);
+    refill_heads_locked(self);
+
+    for (GstAggregatorPad *pad : self->_idle_pads) {
+        if (!gst_aggregator_pad_is_eos(pad)) {
+            empty_pads.push_back(pad);
+            continue;
+        }
+        gint stream_id = get_sink_pad_index(GST_PAD(pad));
+        if (self->_stream_eos_sent.count(stream_id) == 0) {
+            self->_stream_eos_sent.insert(stream_id);
+            new_eos_streams.push_back(stream_id);
+        }
+    }
+
+    gboolean ready = !self->_heads.empty();
+    if (ready && !empty_pads.empty()) {
+        // Non-live: wait for every stream as before. Live: on timeout, skip
+        // pads whose budget past the oldest pending frame has run out.
+        ready = live_timeout;
+        GstClockTime top_rt = head_running_time(self->_heads.front());
+        for (GstAggregatorPad *pad : empty_pads) {
+            if (!ready)
+                break;
+            if (GST_CLOCK_TIME_IS_VALID(now) && GST_CLOCK_TIME_IS_VALID(top_rt) &&
+                now < top_rt + pad_latency_budget(self, pad))
+                ready = FALSE;
+        }
+        if (ready)
+            GST_DEBUG_OBJECT(self, "Timeout: skipping %zu late stream(s)",
+                             empty_pads.size());
+    }
 
-    if (!min_pad)
+    if (ready) {
+        for (GstAggregatorPad *pad : empty_pads)
+            GST_DXINPUTSELECTOR_PAD(pad)->_skipped++;
+        min_pad = GST_AGGREGATOR_PAD(gst_object_ref(take_next_head_locked(self)));
+        self->_idle_pads.push_back(min_pad);
+    }
+    GST_OBJECT_UNLOCK(agg);
+
+    for (gint sid : new_eos_streams) {
+        send_wrapped_eos(agg, sid);
+    }
+
+    if (!min_pad) {
+        if (empty_pads.empty()) {
+            GST_DEBUG_OBJECT(self, "All streams EOS, returning GST_FLOW_EOS");
+            return GST_FLOW_EOS;
+        }
         return GST_AGGREGATOR_FLOW_NEED_DATA;
+    }
 
     GstBuffer *buf = gst_aggregator_pad_pop_buffer(min_pad);
+    gst_object_unref(min_pad);
     if (!buf)
         return GST_AGGREGATOR_FLOW_NEED_DATA;
 
@@ -211,12 +623,32 @@ gst_dxinputselector_aggregate(GstAggregator *agg, gboolean /*timeout*/) {
 static gboolean gst_dxinputselector_start(GstAggregator *agg) {
     GstDxInputSelector *self = GST_DXINPUTSELECTOR(agg);
     self->_stream_eos_sent.clear();
+    GST_OBJECT_LOCK(self);
+    self->_heads_dirty = TRUE;
+    self->_rr_last = -1;
+    self->_rr_credit = 0;
+    self->_window_start = GST_CLOCK_TIME_NONE;
+    self->_outputs = 0;
+    for (GList *l = GST_ELEMENT(self)->sinkpads; l; l = l->next) {
+        auto *pad = GST_DXINPUTSELECTOR_PAD(l->data);
+        pad->_forwarded = 0;
+        pad->_skipped = 0;
+        pad->_window_forwarded = 0;
+        pad->_queued = FALSE;
+    }
+    GST_OBJECT_UNLOCK(self);
     return TRUE;
 }
 
 static gboolean gst_dxinputselector_stop(GstAggregator *agg) {
     GstDxInputSelector *self = GST_DXINPUTSELECTOR(agg);
     self->_stream_eos_sent.clear();
+    GST_OBJECT_LOCK(self);
+    self->_heads.clear();
+    self->_idle_pads.clear();
+    self->_rr_order.clear();
+    self->_heads_dirty = TRUE;
+    GST_OBJECT_UNLOCK(self);
     return TRUE;
 }
 
@@ -249,18 +681,63 @@ static void gst_dxinputselector_class_init(GstDxInputSelectorClass *klass) {
             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
                           GST_PARAM_MUTABLE_READY)));
 
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_LIVE_MODE),
+        g_param_spec_boolean(
+            "live-mode", "Live Mode",
+            "With live sources, do not let an empty stream block the others: "
+            "once the oldest pending frame has waited the latency budget of "
+            "every empty pad, output it and skip the late pads",
+            DEFAULT_LIVE_MODE,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_READY)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_LATENCY_BUDGET),
+        g_param_spec_uint(
+            "latency-budget", "Latency Budget",
+            "Live mode: default time (ms) to wait for an empty pad, on top of "
+            "the aggregator latency. Overridden per pad by the sink pad's "
+            "latency-budget property",
+            0, G_MAXUINT, DEFAULT_LATENCY_BUDGET,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_READY)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SCHEDULING),
+        g_param_spec_enum(
+            "scheduling", "Scheduling",
+            "Which pending frame is forwarded next: min-pts (smallest PTS), "
+            "round-robin, weighted-rr (pad weight frames per turn) or "
+            "deficit (least served relative to pad weight per window)",
+            GST_TYPE_DXINPUTSELECTOR_SCHEDULING,
+            static_cast<gint>(DEFAULT_SCHEDULING),
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_FAIRNESS_WINDOW),
+        g_param_spec_uint(
+            "fairness-window", "Fairness Window",
+            "Deficit scheduling: accounting window in ms of stream time",
+            1, G_MAXUINT, DEFAULT_FAIRNESS_WINDOW,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+
     gst_element_class_set_static_metadata(
         element_class, "DXInputSelector", "Generic",
         "Input Selection from Multi Channel Streams (N:1)",
         "Sangil Jo <sijo@deepx.ai>");
 
     gst_element_class_add_static_pad_template_with_gtype(
-        element_class, &sink_template, GST_TYPE_AGGREGATOR_PAD);
+        element_class, &sink_template, GST_TYPE_DXINPUTSELECTOR_PAD);
     gst_element_class_add_static_pad_template(element_class, &src_template);
 
     parent_class = GST_AGGREGATOR_CLASS(g_type_class_peek_parent(klass));
     element_class->release_pad = GST_DEBUG_FUNCPTR(gst_dxinputselector_release_pad);
     agg_class->aggregate = GST_DEBUG_FUNCPTR(gst_dxinputselector_aggregate);
+    agg_class->get_next_time =
+        GST_DEBUG_FUNCPTR(gst_dxinputselector_get_next_time);
     agg_class->sink_event = GST_DEBUG_FUNCPTR(gst_dxinputselector_sink_event);
     agg_class->src_event = GST_DEBUG_FUNCPTR(gst_dxinputselector_src_event);
     agg_class->clip = GST_DEBUG_FUNCPTR(gst_dxinputselector_clip);
@@ -276,12 +753,28 @@ static void gst_dxinputselector_init(GstDxInputSelector *self) {
     // Skipping this crashes on MSVC (null tree sentinel) the first time the
     // set is touched (e.g. _stream_eos_sent.clear() in start()).
     new (&self->_stream_eos_sent) std::set<int>();
+    new (&self->_heads) std::vector<GstDxInputSelectorHead>();
+    new (&self->_idle_pads) std::vector<GstAggregatorPad *>();
     self->_max_queue_size = 2;
+    self->_live_mode = DEFAULT_LIVE_MODE;
+    self->_latency_budget = DEFAULT_LATENCY_BUDGET;
+    self->_pads_cookie = 0;
+    self->_heads_dirty = TRUE;
+    self->_scheduling = DEFAULT_SCHEDULING;
+    self->_fairness_window = DEFAULT_FAIRNESS_WINDOW;
+    new (&self->_rr_order) std::vector<GstAggregatorPad *>();
+    self->_rr_last = -1;
+    self->_rr_credit = 0;
+    self->_window_start = GST_CLOCK_TIME_NONE;
+    self->_outputs = 0;
 }
 
 static void gst_dxinputselector_finalize(GObject *object) {
     GstDxInputSelector *self = GST_DXINPUTSELECTOR(object);
     self->_stream_eos_sent.~set();
+    self->_heads.~vector();
+    self->_idle_pads.~vector();
+    self->_rr_order.~vector();
     G_OBJECT_CLASS(parent_class)->finalize(object);
 }
 
@@ -394,6 +887,18 @@ static gboolean gst_dxinputselector_src_query(GstAggregator *agg,
             if (GST_CLOCK_TIME_IS_VALID(max_lat))
                 max_lat += self_buf;
         }
+        if (self->_live_mode) {
+            // Worst case we hold the oldest frame for the largest pad budget.
+            GstClockTime budget = 0;
+            GST_OBJECT_LOCK(agg);
+            for (GList *l = GST_ELEMENT(agg)->sinkpads; l; l = l->next)
+                budget = MAX(budget, pad_latency_budget(
+                                         self, GST_AGGREGATOR_PAD(l->data)));
+            GST_OBJECT_UNLOCK(agg);
+            min_lat += budget;
+            if (GST_CLOCK_TIME_IS_VALID(max_lat))
+                max_lat += budget;
+        }
         gst_query_set_latency(query, live, min_lat, max_lat);
         return TRUE;
     }
@@ -4,17 +4,79 @@
 #include <gst/base/gstaggregator.h>
 #include <gst/gst.h>
 #include <set>
+#include <vector>
 
 G_BEGIN_DECLS
 
+/** Which pending head is forwarded next. */
+enum class GstDxInputSelectorPolicy {
+    MIN_PTS = 0,     /**< globally smallest PTS (default) */
+    ROUND_ROBIN = 1, /**< one frame per stream in stream-id order */
+    WEIGHTED_RR = 2, /**< `weight` consecutive frames per stream turn */
+    DEFICIT = 3      /**< least served relative to weight within a window */
+};
+
+#define GST_TYPE_DXINPUTSELECTOR_PAD (gst_dxinputselector_pad_get_type())
+G_DECLARE_FINAL_TYPE(GstDxInputSelectorPad, gst_dxinputselector_pad, GST,
+                     DXINPUTSELECTOR_PAD, GstAggregatorPad)
+
+struct _GstDxInputSelectorPad {
+    GstAggregatorPad parent_instance;
+
+    /** Live-mode wait budget in ms for this pad; -1 uses the element's
+     *  latency-budget. */
+    gint _latency_budget;
+
+    /** Share of the output for weighted-rr / deficit scheduling */
+    guint _weight;
+
+    /** Statistics and scheduler state, guarded by the element object lock */
+    gint _stream_id;           /**< sink_%u index, cached on heap rebuild */
+    guint64 _forwarded;        /**< frames forwarded downstream */
+    guint64 _skipped;          /**< outputs passed over while waiting */
+    guint64 _window_forwarded; /**< forwarded in the current deficit window */
+    guint64 _queued_at;        /**< element output count when head was queued */
+    gboolean _queued;          /**< head is in the element's heap */
+};
+
 #define GST_TYPE_DXINPUTSELECTOR (gst_dxinputselector_get_type())
 G_DECLARE_FINAL_TYPE(GstDxInputSelector, gst_dxinputselector, GST,
                      DXINPUTSELECTOR, GstAggregator)
 
+/** Pending head buffer of one sink pad, keyed by PTS in the min-heap. */
+struct GstDxInputSelectorHead {
+    GstClockTime pts;
+    gint stream_id;
+    GstAggregatorPad *pad; /**< not ref'd; the heap is rebuilt on pad changes */
+};
+
 struct _GstDxInputSelector {
     GstAggregator parent_instance;
     std::set<int> _stream_eos_sent;
     guint _max_queue_size;
+
+    /** Live mode: on aggregator timeout, skip pads whose budget expired */
+    gboolean _live_mode;
+    guint _latency_budget; /**< default per-pad wait budget (ms) */
+
+    GstDxInputSelectorPolicy _scheduling;
+    guint _fairness_window; /**< deficit accounting window (ms) */
+
+    /** Min-heap (by PTS, then stream id) of pads with a queued head buffer,
+     *  plus the pads that currently have none. Guarded by the object lock.
+     *  Only the popped pad and idle pads are re-peeked per aggregate(). */
+    std::vector<GstDxInputSelectorHead> _heads;
+    std::vector<GstAggregatorPad *> _idle_pads;
+    guint32 _pads_cookie;
+    gboolean _heads_dirty; /**< set on flush/start/stop to force a rebuild */
+
+    /** Round-robin state: sink pads sorted by stream id, the stream id
+     *  forwarded last and the frames left in its weighted turn. */
+    std::vector<GstAggregatorPad *> _rr_order;
+    gint _rr_last;
+    guint _rr_credit;
+    GstClockTime _window_start; /**< running time the deficit window began */
+    guint64 _outputs;           /**< total frames forwarded */
 };
 
 G_END_DECLS
@@ -0,0 +1,268 @@
+#include "gst-dxlatencytracer.hpp"
+#include "./../metadata/gst-dxframemeta.hpp"
+#include <algorithm>
+#include <new>
+#include <tuple>
+
+GST_DEBUG_CATEGORY_STATIC(gst_dxlatencytracer_debug_category);
+#define GST_CAT_DEFAULT gst_dxlatencytracer_debug_category
+
+// Entries of buffers an element dropped are discarded once a later buffer
+// of the same stream leaves it; this only bounds elements that never push.
+#define DX_LATENCY_MAX_PENDING 256
+
+G_DEFINE_TYPE(GstDxLatencyTracer, gst_dxlatencytracer, GST_TYPE_TRACER);
+
+static gboolean is_dx_element(GstObject *object) {
+    return object && GST_IS_ELEMENT(object) &&
+           g_str_has_prefix(G_OBJECT_TYPE_NAME(object), "GstDx");
+}
+
+static int buffer_stream_id(GstBuffer *buffer) {
+    const DXFrameMeta *frame_meta = dx_get_frame_meta(buffer);
+    return frame_meta ? frame_meta->_stream_id : -1;
+}
+
+static void histogram_add(GstDxLatencyHistogram &hist, guint64 us) {
+    hist.count++;
+    hist.sum_us += us;
+    hist.min_us = MIN(hist.min_us, us);
+    hist.max_us = MAX(hist.max_us, us);
+    guint bucket = us ? g_bit_storage(us) - 1 : 0;
+    hist.buckets[MIN(bucket, DX_LATENCY_HIST_BUCKETS - 1)]++;
+}
+
+// Upper bound of the bucket holding the given fraction of samples.
+static guint64 histogram_percentile(const GstDxLatencyHistogram &hist,
+                                    double fraction) {
+    guint64 target = (guint64)(fraction * hist.count);
+    guint64 seen = 0;
+    for (guint i = 0; i < DX_LATENCY_HIST_BUCKETS; i++) {
+        seen += hist.buckets[i];
+        if (seen > target)
+            return MIN(G_GUINT64_CONSTANT(2) << i, hist.max_us);
+    }
+    return hist.max_us;
+}
+
+static void write_trace_event_locked(GstDxLatencyTracer *self,
+                                     const std::string &name, int stream_id,
+                                     GstClockTime pts, GstClockTime entry,
+                                     GstClockTime duration) {
+    if (!self->_trace_file)
+        return;
+    fprintf(self->_trace_file,
+            "%s{\"name\":\"%s\",\"cat\":\"dx\",\"ph\":\"X\",\"ts\":%.3f,"
+            "\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"pts\":%" G_GINT64_FORMAT
+            "}}",
+            self->_trace_first ? "" : ",\n", name.c_str(), entry / 1000.0,
+            duration / 1000.0, stream_id,
+            GST_CLOCK_TIME_IS_VALID(pts) ? (gint64)pts : (gint64)-1);
+    self->_trace_first = FALSE;
+}
+
+static void record_entry_locked(GstDxLatencyTracer *self,
+                                const std::string &name, int stream_id,
+                                GstClockTime pts, GstClockTime ts) {
+    auto &pending = self->_elements[name].pending[stream_id];
+    if (pending.size() >= DX_LATENCY_MAX_PENDING)
+        pending.pop_front();
+    pending.emplace_back(pts, ts);
+}
+
+static void record_exit_locked(GstDxLatencyTracer *self,
+                               const std::string &name, int stream_id,
+                               GstClockTime pts, GstClockTime ts) {
+    auto it = self->_elements.find(name);
+    if (it == self->_elements.end())
+        return;
+    auto pit = it->second.pending.find(stream_id);
+    if (pit == it->second.pending.end())
+        return;
+
+    // Buffers leave in arrival order per stream; anything queued before the
+    // match was dropped inside the element.
+    auto &pending = pit->second;
+    auto match = std::find_if(pending.begin(), pending.end(),
+                              [pts](const std::pair<GstClockTime, GstClockTime> &e) {
+                                  return e.first == pts;
+                              });
+    if (match == pending.end())
+        return;
+    GstClockTime entry = match->second;
+    pending.erase(pending.begin(), match + 1);
+
+    GstClockTime duration = ts > entry ? ts - entry : 0;
+    histogram_add(it->second.streams[stream_id], duration / GST_USECOND);
+    write_trace_event_locked(self, name, stream_id, pts, entry, duration);
+}
+
+static void dump_stats_locked(GstDxLatencyTracer *self) {
+    FILE *stats = nullptr;
+    if (self->_stats_path) {
+        stats = fopen(self->_stats_path, "w");
+        if (!stats)
+            GST_WARNING_OBJECT(self, "Cannot open stats file %s", self->_stats_path);
+    }
+    if (stats)
+        fputs("{\"elements\":[", stats);
+
+    gboolean first = TRUE;
+    for (const auto &el : self->_elements) {
+        for (const auto &kv : el.second.streams) {
+            const GstDxLatencyHistogram &hist = kv.second;
+            if (!hist.count)
+                continue;
+            guint64 mean = hist.sum_us / hist.count;
+            guint64 p50 = histogram_percentile(hist, 0.50);
+            guint64 p99 = histogram_percentile(hist, 0.99);
+            GST_INFO_OBJECT(self,
+                "%s stream %d: n=%" G_GUINT64_FORMAT " mean=%" G_GUINT64_FORMAT
+                "us min=%" G_GUINT64_FORMAT "us max=%" G_GUINT64_FORMAT
+                "us p50<=%" G_GUINT64_FORMAT "us p99<=%" G_GUINT64_FORMAT "us",
+                el.first.c_str(), kv.first, hist.count, mean, hist.min_us,
+                hist.max_us, p50, p99);
+            if (!stats)
+                continue;
+            fprintf(stats,
+                    "%s\n{\"name\":\"%s\",\"stream_id\":%d,\"count\":%" G_GUINT64_FORMAT
+                    ",\"mean_us\":%" G_GUINT64_FORMAT ",\"min_us\":%" G_GUINT64_FORMAT
+                    ",\"max_us\":%" G_GUINT64_FORMAT ",\"p50_us\":%" G_GUINT64_FORMAT
+                    ",\"p99_us\":%" G_GUINT64_FORMAT ",\"buckets\":[",
+                    first ? "" : ",", el.first.c_str(), kv.first, hist.count,
+                    mean, hist.min_us, hist.max_us, p50, p99);
+            for (guint i = 0; i < DX_LATENCY_HIST_BUCKETS; i++)
+                fprintf(stats, "%s%" G_GUINT64_FORMAT, i ? "," : "", hist.buckets[i]);
+            fputs("]}", stats);
+            first = FALSE;
+        }
+    }
+
+    if (stats) {
+        fputs("\n]}\n", stats);
+        fclose(stats);
+    }
+    if (self->_trace_file)
+        fflush(self->_trace_file);
+}
+
+// pad-push-pre: the buffer leaves the pad's element and enters its peer's.
+static void do_push_buffer_pre(GstDxLatencyTracer *self, GstClockTime ts,
+                               GstPad *pad, GstBuffer *buffer) {
+    GstObject *parent = GST_OBJECT_PARENT(pad);
+    GstPad *peer = gst_pad_get_peer(pad);
+    GstElement *next = peer ? gst_pad_get_parent_element(peer) : nullptr;
+    gboolean leaving = is_dx_element(parent);
+    gboolean entering = is_dx_element(GST_OBJECT_CAST(next));
+
+    if (leaving || entering) {
+        int stream_id = buffer_stream_id(buffer);
+        GstClockTime pts = GST_BUFFER_PTS(buffer);
+        std::lock_guard<std::mutex> lock(self->_lock);
+        if (leaving)
+            record_exit_locked(self, GST_OBJECT_NAME(parent), stream_id, pts, ts);
+        if (entering)
+            record_entry_locked(self, GST_OBJECT_NAME(next), stream_id, pts, ts);
+    }
+
+    if (next)
+        gst_object_unref(next);
+    if (peer)
+        gst_object_unref(peer);
+}
+
+static void do_push_buffer_list_pre(GstDxLatencyTracer *self, GstClockTime ts,
+                                    GstPad *pad, GstBufferList *list) {
+    guint n = gst_buffer_list_length(list);
+    for (guint i = 0; i < n; i++)
+        do_push_buffer_pre(self, ts, pad, gst_buffer_list_get(list, i));
+}
+
+static void do_element_change_state_post(GstDxLatencyTracer *self,
+                                         GstClockTime ts, GstElement *element,
+                                         GstStateChange transition,
+                                         GstStateChangeReturn result) {
+    std::ignore = ts;
+    std::ignore = result;
+    if (transition != GST_STATE_CHANGE_PAUSED_TO_READY)
+        return;
+
+    std::lock_guard<std::mutex> lock(self->_lock);
+    if (is_dx_element(GST_OBJECT_CAST(element))) {
+        auto it = self->_elements.find(GST_OBJECT_NAME(element));
+        if (it != self->_elements.end())
+            it->second.pending.clear();
+    } else if (GST_IS_PIPELINE(element)) {
+        dump_stats_locked(self);
+    }
+}
+
+static void gst_dxlatencytracer_constructed(GObject *object) {
+    auto *self = GST_DXLATENCYTRACER(object);
+    G_OBJECT_CLASS(gst_dxlatencytracer_parent_class)->constructed(object);
+
+    gchar *params = nullptr;
+    g_object_get(self, "params", &params, nullptr);
+    if (params) {
+        gchar *desc = g_strdup_printf("dxlatency,%s", params);
+        GstStructure *s = gst_structure_from_string(desc, nullptr);
+        if (s) {
+            const gchar *file = gst_structure_get_string(s, "file");
+            if (file) {
+                self->_trace_file = fopen(file, "w");
+                if (self->_trace_file) {
+                    fputs("[\n", self->_trace_file);
+                    fflush(self->_trace_file);
+                } else
+                    GST_WARNING_OBJECT(self, "Cannot open trace file %s", file);
+            }
+            self->_stats_path = g_strdup(gst_structure_get_string(s, "stats"));
+            gst_structure_free(s);
+        } else {
+            GST_WARNING_OBJECT(self, "Invalid params '%s'", params);
+        }
+        g_free(desc);
+        g_free(params);
+    }
+
+    GstTracer *tracer = GST_TRACER(self);
+    gst_tracing_register_hook(tracer, "pad-push-pre",
+                              G_CALLBACK(do_push_buffer_pre));
+    gst_tracing_register_hook(tracer, "pad-push-list-pre",
+                              G_CALLBACK(do_push_buffer_list_pre));
+    gst_tracing_register_hook(tracer, "element-change-state-post",
+                              G_CALLBACK(do_element_change_state_post));
+}
+
+static void gst_dxlatencytracer_finalize(GObject *object) {
+    auto *self = GST_DXLATENCYTRACER(object);
+    dump_stats_locked(self);
+    if (self->_trace_file) {
+        fputs("\n]\n", self->_trace_file);
+        fclose(self->_trace_file);
+        self->_trace_file = nullptr;
+    }
+    g_free(self->_stats_path);
+
+    // NOSONAR - members were constructed with placement new in _init
+    self->_elements.~map(); // NOSONAR
+    self->_lock.~mutex(); // NOSONAR
+    G_OBJECT_CLASS(gst_dxlatencytracer_parent_class)->finalize(object);
+}
+
+static void gst_dxlatencytracer_class_init(GstDxLatencyTracerClass *klass) {
+    GST_DEBUG_CATEGORY_INIT(gst_dxlatencytracer_debug_category, "dxlatency", 0,
+                            "DX per-element latency tracer");
+
+    auto *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->constructed = gst_dxlatencytracer_constructed;
+    gobject_class->finalize = gst_dxlatencytracer_finalize;
+}
+
+static void gst_dxlatencytracer_init(GstDxLatencyTracer *self) {
+    new (&self->_lock) std::mutex();
+    new (&self->_elements) std::map<std::string, GstDxLatencyElement>();
+    self->_trace_file = nullptr;
+    self->_trace_first = TRUE;
+    self->_stats_path = nullptr;
+}
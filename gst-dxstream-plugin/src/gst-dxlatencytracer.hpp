@@ -0,0 +1,52 @@
+#ifndef GST_DXLATENCYTRACER_H
+#define GST_DXLATENCYTRACER_H
+
+#include <gst/gst.h>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_DXLATENCYTRACER (gst_dxlatencytracer_get_type())
+G_DECLARE_FINAL_TYPE(GstDxLatencyTracer, gst_dxlatencytracer, GST,
+                     DXLATENCYTRACER, GstTracer)
+
+/** log2 buckets over microseconds: bucket i holds [2^i, 2^(i+1)) us,
+ *  bucket 0 also everything below 1 us, the last one everything above. */
+#define DX_LATENCY_HIST_BUCKETS 24
+
+struct GstDxLatencyHistogram {
+    guint64 count = 0;
+    guint64 sum_us = 0;
+    guint64 min_us = G_MAXUINT64;
+    guint64 max_us = 0;
+    guint64 buckets[DX_LATENCY_HIST_BUCKETS] = {};
+};
+
+/** Timing state of one DX element, keyed by element name. */
+struct GstDxLatencyElement {
+    /** stream_id -> (pts, entry timestamp) of buffers still inside the
+     *  element, in arrival order */
+    std::map<int, std::deque<std::pair<GstClockTime, GstClockTime>>> pending;
+    /** stream_id -> time from sink pad entry to src pad exit */
+    std::map<int, GstDxLatencyHistogram> streams;
+};
+
+struct _GstDxLatencyTracer {
+    GstTracer parent_instance;
+
+    std::mutex _lock;
+    std::map<std::string, GstDxLatencyElement> _elements;
+
+    FILE *_trace_file;     /**< Chrome-trace JSON array ("file" param) */
+    gboolean _trace_first; /**< no event written to _trace_file yet */
+    gchar *_stats_path;    /**< histogram JSON, rewritten on pipeline stop */
+};
+
+G_END_DECLS
+
+#endif /* GST_DXLATENCYTRACER_H */
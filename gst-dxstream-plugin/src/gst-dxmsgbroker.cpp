@@ -2,10 +2,43 @@
 #include "gst-dxmsgmeta.hpp"
 #include "utils.hpp"
 
+#include "dx_msgbroker_publisher.hpp"
 #include "dx_msgbrokerl_kafka.hpp"
 #include "dx_msgbrokerl_mqtt.hpp"
 
-enum class PropertyID { PROP_0, PROP_BROKER_NAME, PROP_CONN_INFO, PROP_CONFIG, PROP_TOPIC };
+#include <string>
+#include <vector>
+
+enum class PropertyID {
+    PROP_0,
+    PROP_BROKER_NAME,
+    PROP_CONN_INFO,
+    PROP_CONFIG,
+    PROP_TOPIC,
+    PROP_ASYNC,
+    PROP_MAX_QUEUE_SIZE,
+    PROP_BATCH_SIZE,
+    PROP_LINGER_MS,
+    PROP_SPILL_DIR,
+    PROP_SPILL_SEGMENT_SIZE,
+    PROP_SPILL_MAX_SIZE,
+    PROP_DRAIN_TIMEOUT,
+    PROP_QUEUE_DEPTH,
+    PROP_SPILL_DEPTH,
+    PROP_PUBLISHED,
+    PROP_DROPPED,
+    PROP_SPILLED,
+    PROP_PUBLISH_LATENCY,
+    PROP_MAX_PUBLISH_LATENCY
+};
+
+#define DEFAULT_ASYNC FALSE
+#define DEFAULT_MAX_QUEUE_SIZE 1024
+#define DEFAULT_BATCH_SIZE 32
+#define DEFAULT_LINGER_MS 5
+#define DEFAULT_SPILL_SEGMENT_SIZE (16 * 1024 * 1024)
+#define DEFAULT_SPILL_MAX_SIZE (G_GUINT64_CONSTANT(1) << 30)
+#define DEFAULT_DRAIN_TIMEOUT_MS 5000
 
 GST_DEBUG_CATEGORY_STATIC(gst_dxmsgbroker_debug_category);
 #define GST_CAT_DEFAULT gst_dxmsgbroker_debug_category
@@ -78,6 +111,106 @@ static void gst_dxmsgbroker_class_init(GstDxMsgBrokerClass *klass) {
                             "The topic name for publishing messages. Required.",
                             nullptr, G_PARAM_READWRITE));
 
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_ASYNC),
+        g_param_spec_boolean(
+            "async", "Async",
+            "Publish from a sender thread through a bounded queue instead of "
+            "in render(); a slow or unreachable broker no longer stalls the pipeline",
+            DEFAULT_ASYNC, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_MAX_QUEUE_SIZE),
+        g_param_spec_uint("max-queue-size", "Max Queue Size",
+                          "Messages held in memory in async mode; newer messages "
+                          "are dropped (or spilled) when full",
+                          1, G_MAXINT, DEFAULT_MAX_QUEUE_SIZE, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_BATCH_SIZE),
+        g_param_spec_uint("batch-size", "Batch Size",
+                          "Maximum messages published per sender wakeup in async mode",
+                          1, 65536, DEFAULT_BATCH_SIZE, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_LINGER_MS),
+        g_param_spec_uint("linger-ms", "Linger (ms)",
+                          "Time to wait for a batch to fill before publishing it "
+                          "in async mode (0: publish immediately)",
+                          0, 10000, DEFAULT_LINGER_MS, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SPILL_DIR),
+        g_param_spec_string(
+            "spill-dir", "Spill Directory",
+            "Directory where async mode stores messages while the broker is "
+            "unreachable; they are replayed in order on reconnect (optional)",
+            nullptr, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SPILL_SEGMENT_SIZE),
+        g_param_spec_uint64("spill-segment-size", "Spill Segment Size",
+                            "Size in bytes of each memory-mapped spill file",
+                            64 * 1024, G_MAXUINT32, DEFAULT_SPILL_SEGMENT_SIZE,
+                            G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SPILL_MAX_SIZE),
+        g_param_spec_uint64("spill-max-size", "Spill Max Size",
+                            "Disk space used for spilling; the oldest messages are "
+                            "dropped beyond it",
+                            64 * 1024, G_MAXUINT64, DEFAULT_SPILL_MAX_SIZE,
+                            G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_DRAIN_TIMEOUT),
+        g_param_spec_uint("drain-timeout", "Drain Timeout (ms)",
+                          "Time EOS waits for queued messages to be published in "
+                          "async mode",
+                          0, G_MAXUINT, DEFAULT_DRAIN_TIMEOUT_MS, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_QUEUE_DEPTH),
+        g_param_spec_uint("queue-depth", "Queue Depth",
+                          "Messages waiting in the async queue", 0, G_MAXUINT, 0,
+                          G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SPILL_DEPTH),
+        g_param_spec_uint64("spill-depth", "Spill Depth",
+                            "Messages waiting in the spill directory", 0,
+                            G_MAXUINT64, 0, G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_PUBLISHED),
+        g_param_spec_uint64("published", "Published",
+                            "Messages handed to the broker in async mode", 0,
+                            G_MAXUINT64, 0, G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_DROPPED),
+        g_param_spec_uint64("dropped", "Dropped",
+                            "Messages lost in async mode (queue or spill full)", 0,
+                            G_MAXUINT64, 0, G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SPILLED),
+        g_param_spec_uint64("spilled", "Spilled",
+                            "Messages written to the spill directory", 0,
+                            G_MAXUINT64, 0, G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_PUBLISH_LATENCY),
+        g_param_spec_uint64("publish-latency", "Publish Latency",
+                            "Average queue-to-broker time in ns (async mode)", 0,
+                            G_MAXUINT64, 0, G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_MAX_PUBLISH_LATENCY),
+        g_param_spec_uint64("max-publish-latency", "Max Publish Latency",
+                            "Highest queue-to-broker time in ns (async mode)", 0,
+                            G_MAXUINT64, 0, G_PARAM_READABLE));
+
     gst_element_class_add_pad_template(
         GST_ELEMENT_CLASS(klass),
         gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
@@ -111,6 +244,16 @@ static void gst_dxmsgbroker_init(GstDxMsgBroker *self) {
     self->_send_function = nullptr;
     self->_disconnect_function = nullptr;
 
+    self->_async = DEFAULT_ASYNC;
+    self->_max_queue_size = DEFAULT_MAX_QUEUE_SIZE;
+    self->_batch_size = DEFAULT_BATCH_SIZE;
+    self->_linger_ms = DEFAULT_LINGER_MS;
+    self->_spill_dir = nullptr;
+    self->_spill_segment_size = DEFAULT_SPILL_SEGMENT_SIZE;
+    self->_spill_max_size = DEFAULT_SPILL_MAX_SIZE;
+    self->_drain_timeout_ms = DEFAULT_DRAIN_TIMEOUT_MS;
+    self->_publisher = nullptr;
+
     gst_base_sink_set_sync(GST_BASE_SINK(self), FALSE);
     gst_base_sink_set_async_enabled(GST_BASE_SINK(self), FALSE);
 }
@@ -143,12 +286,49 @@ static void gst_dxmsgbroker_set_property(GObject *object, guint prop_id,
         }
         self->_topic = g_value_dup_string(value);
         break;
+    case PropertyID::PROP_ASYNC:
+        self->_async = g_value_get_boolean(value);
+        break;
+    case PropertyID::PROP_MAX_QUEUE_SIZE:
+        self->_max_queue_size = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_BATCH_SIZE:
+        self->_batch_size = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_LINGER_MS:
+        self->_linger_ms = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_SPILL_DIR:
+        g_free(self->_spill_dir);
+        self->_spill_dir = g_value_dup_string(value);
+        break;
+    case PropertyID::PROP_SPILL_SEGMENT_SIZE:
+        self->_spill_segment_size = g_value_get_uint64(value);
+        break;
+    case PropertyID::PROP_SPILL_MAX_SIZE:
+        self->_spill_max_size = g_value_get_uint64(value);
+        break;
+    case PropertyID::PROP_DRAIN_TIMEOUT:
+        self->_drain_timeout_ms = g_value_get_uint(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
     }
 }
 
+// Reads a publisher counter for the stats properties. stop() detaches the
+// publisher under the object lock, so it cannot be deleted mid-read.
+template <typename T>
+static T publisher_stat(GstDxMsgBroker *self, T (DxMsgPublisher::*stat)() const) {
+    T value = 0;
+    GST_OBJECT_LOCK(self);
+    if (self->_publisher)
+        value = (self->_publisher->*stat)();
+    GST_OBJECT_UNLOCK(self);
+    return value;
+}
+
 static void gst_dxmsgbroker_get_property(GObject *object, guint prop_id,
                                          GValue *value, GParamSpec *pspec) {
     GstDxMsgBroker *self = GST_DXMSGBROKER(object);
@@ -166,6 +346,51 @@ static void gst_dxmsgbroker_get_property(GObject *object, guint prop_id,
     case PropertyID::PROP_TOPIC:
         g_value_set_string(value, self->_topic);
         break;
+    case PropertyID::PROP_ASYNC:
+        g_value_set_boolean(value, self->_async);
+        break;
+    case PropertyID::PROP_MAX_QUEUE_SIZE:
+        g_value_set_uint(value, self->_max_queue_size);
+        break;
+    case PropertyID::PROP_BATCH_SIZE:
+        g_value_set_uint(value, self->_batch_size);
+        break;
+    case PropertyID::PROP_LINGER_MS:
+        g_value_set_uint(value, self->_linger_ms);
+        break;
+    case PropertyID::PROP_SPILL_DIR:
+        g_value_set_string(value, self->_spill_dir);
+        break;
+    case PropertyID::PROP_SPILL_SEGMENT_SIZE:
+        g_value_set_uint64(value, self->_spill_segment_size);
+        break;
+    case PropertyID::PROP_SPILL_MAX_SIZE:
+        g_value_set_uint64(value, self->_spill_max_size);
+        break;
+    case PropertyID::PROP_DRAIN_TIMEOUT:
+        g_value_set_uint(value, self->_drain_timeout_ms);
+        break;
+    case PropertyID::PROP_QUEUE_DEPTH:
+        g_value_set_uint(value, publisher_stat(self, &DxMsgPublisher::queue_depth));
+        break;
+    case PropertyID::PROP_SPILL_DEPTH:
+        g_value_set_uint64(value, publisher_stat(self, &DxMsgPublisher::spill_depth));
+        break;
+    case PropertyID::PROP_PUBLISHED:
+        g_value_set_uint64(value, publisher_stat(self, &DxMsgPublisher::published));
+        break;
+    case PropertyID::PROP_DROPPED:
+        g_value_set_uint64(value, publisher_stat(self, &DxMsgPublisher::dropped));
+        break;
+    case PropertyID::PROP_SPILLED:
+        g_value_set_uint64(value, publisher_stat(self, &DxMsgPublisher::spilled));
+        break;
+    case PropertyID::PROP_PUBLISH_LATENCY:
+        g_value_set_uint64(value, publisher_stat(self, &DxMsgPublisher::latency_ns));
+        break;
+    case PropertyID::PROP_MAX_PUBLISH_LATENCY:
+        g_value_set_uint64(value, publisher_stat(self, &DxMsgPublisher::max_latency_ns));
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -191,6 +416,10 @@ static void gst_dxmsgbroker_finalize(GObject *object) {
         g_free(self->_topic);
         self->_topic = nullptr;
     }
+    if (self->_spill_dir) {
+        g_free(self->_spill_dir);
+        self->_spill_dir = nullptr;
+    }
 }
 
 static GstStateChangeReturn
@@ -199,6 +428,45 @@ gst_dxmsgbroker_change_state(GstElement *element, GstStateChange transition) {
               ->change_state(element, transition);
 }
 
+static gboolean start_publisher(GstDxMsgBroker *self) {
+    DxMsgPublisherConfig config;
+    config.max_queue_size = self->_max_queue_size;
+    config.batch_size = self->_batch_size;
+    config.linger_ms = self->_linger_ms;
+    config.spill_dir = string_is_empty(self->_spill_dir) ? "" : self->_spill_dir;
+    config.spill_segment_size = self->_spill_segment_size;
+    config.spill_max_size = self->_spill_max_size;
+
+    // The sender reconnects with the settings captured at start.
+    std::string conn_info = self->_conn_info;
+    std::string cfg_path = self->_config ? self->_config : "";
+    DxMsg_Bal_ConnectFptr_t connect = self->_connect_function;
+    auto reconnect = [connect, conn_info, cfg_path]() mutable {
+        return connect(&conn_info[0], cfg_path.empty() ? nullptr : &cfg_path[0]);
+    };
+
+    DxMsgPublisher *publisher = new DxMsgPublisher(config, self->_topic, self->_handle,
+                                                   reconnect, self->_send_function);
+    self->_handle = nullptr; // owned by the publisher until stop()
+
+    std::string error;
+    if (!publisher->start(error)) {
+        GST_ELEMENT_ERROR(self, RESOURCE, SETTINGS,
+                          ("Cannot start async publishing: %s", error.c_str()), (NULL));
+        self->_handle = publisher->stop();
+        delete publisher;
+        return FALSE;
+    }
+    GST_OBJECT_LOCK(self);
+    self->_publisher = publisher;
+    GST_OBJECT_UNLOCK(self);
+    GST_INFO_OBJECT(self, "Async publishing: queue %u, batch %u, linger %u ms%s%s",
+                    self->_max_queue_size, self->_batch_size, self->_linger_ms,
+                    config.spill_dir.empty() ? "" : ", spill to ",
+                    config.spill_dir.c_str());
+    return TRUE;
+}
+
 static gboolean gst_dxmsgbroker_start(GstBaseSink *sink) {
     GstDxMsgBroker *self = GST_DXMSGBROKER(sink);
 
@@ -234,21 +502,47 @@ static gboolean gst_dxmsgbroker_start(GstBaseSink *sink) {
 
     GST_INFO_OBJECT(self, "Connecting to %s broker", self->_broker_name);
     self->_handle = self->_connect_function(self->_conn_info, self->_config);
-    if (self->_handle == nullptr) {
+    if (self->_handle == nullptr && !self->_async) {
         GST_ELEMENT_ERROR(self, RESOURCE, OPEN_READ_WRITE,
                           ("Failed to connect to %s broker", self->_broker_name),
                           (NULL));
         return FALSE;
     }
-    GST_INFO_OBJECT(self, "Successfully connected to broker");
+    if (self->_handle) {
+        GST_INFO_OBJECT(self, "Successfully connected to broker");
+    } else {
+        GST_WARNING_OBJECT(self, "Failed to connect to %s broker, retrying in background",
+                           self->_broker_name);
+    }
 
     self->_msgbroker_count = 0;
+    self->_consecutive_failures = 0;
+    if (self->_async && !start_publisher(self)) {
+        gst_dxmsgbroker_stop(sink);
+        return FALSE;
+    }
     return TRUE;
 }
 
 static gboolean gst_dxmsgbroker_stop(GstBaseSink *sink) {
     GstDxMsgBroker *self = GST_DXMSGBROKER(sink);
 
+    // Detach under the object lock so the stats getters never see it freed.
+    GST_OBJECT_LOCK(self);
+    DxMsgPublisher *publisher = self->_publisher;
+    self->_publisher = nullptr;
+    GST_OBJECT_UNLOCK(self);
+    if (publisher) {
+        // The sender may have reconnected; its handle is the live one.
+        self->_handle = publisher->stop();
+        GST_INFO_OBJECT(self,
+                        "Async publisher stopped: %" G_GUINT64_FORMAT " published, %"
+                        G_GUINT64_FORMAT " dropped, %" G_GUINT64_FORMAT " spilled",
+                        publisher->published(), publisher->dropped(),
+                        publisher->spilled());
+        delete publisher;
+    }
+
     if (self->_handle && self->_disconnect_function) {
         GST_INFO_OBJECT(self, "Disconnecting from broker");
         DxMsg_Bal_Error_t error = self->_disconnect_function(self->_handle);
@@ -268,9 +562,36 @@ static GstFlowReturn gst_dxmsgbroker_render(GstBaseSink *sink,
     GST_LOG_OBJECT(self, "Render: msg #%" G_GUINT64_FORMAT, self->_msgbroker_count);
     self->_msgbroker_count++;
 
+    GstDxMsgMeta *meta =
+        (GstDxMsgMeta *)gst_buffer_get_meta(buffer, GST_DXMSG_META_API_TYPE);
+    // The payload first, then follow-up messages (e.g. snapshots).
+    std::vector<GBytes *> messages;
+    if (meta && meta->_payload) {
+        const auto *payload = (DxMsgPayload *)meta->_payload;
+        messages.push_back(meta->_bytes ? g_bytes_ref(meta->_bytes)
+                                        : g_bytes_new(payload->_data, payload->_size));
+    }
+    if (meta && meta->_extra_bytes) {
+        for (guint i = 0; i < meta->_extra_bytes->len; i++)
+            messages.push_back(g_bytes_ref((GBytes *)g_ptr_array_index(meta->_extra_bytes, i)));
+    }
+    auto release_messages = [&messages]() {
+        for (GBytes *bytes : messages)
+            g_bytes_unref(bytes);
+    };
+
+    if (self->_publisher) {
+        // Queue and return; the sender thread owns broker I/O and retries.
+        for (GBytes *bytes : messages)
+            self->_publisher->push(bytes);
+        release_messages();
+        return GST_FLOW_OK;
+    }
+
     static const guint MAX_CONSECUTIVE_FAILURES = 10;
 
     if (!self->_handle) {
+        release_messages();
         self->_consecutive_failures++;
         GST_WARNING_OBJECT(self,
             "Broker not connected, dropping message (%u/%u consecutive failures)",
@@ -284,18 +605,13 @@ static GstFlowReturn gst_dxmsgbroker_render(GstBaseSink *sink,
         return GST_FLOW_OK;
     }
 
-    GstDxMsgMeta *meta =
-        (GstDxMsgMeta *)gst_buffer_get_meta(buffer, GST_DXMSG_META_API_TYPE);
-
-    if (meta) {
-        const char *topic = self->_topic;
-        const auto *payload = (DxMsgPayload *)meta->_payload;
-
-        GST_LOG_OBJECT(self, "Publishing message (%u bytes) to topic: %s",
-                         payload->_size, topic);
-        DxMsg_Bal_Error_t error = self->_send_function(self->_handle, topic,
-                                     payload->_data, payload->_size);
+    const char *topic = self->_topic;
+    for (GBytes *bytes : messages) {
+        GST_LOG_OBJECT(self, "Publishing message (%zu bytes) to topic: %s",
+                         g_bytes_get_size(bytes), topic);
+        DxMsg_Bal_Error_t error = self->_send_function(self->_handle, topic, bytes);
         if (error != DxMsg_Bal_Error::DXMSG_BAL_OK) {
+            release_messages();
             self->_consecutive_failures++;
             GST_WARNING_OBJECT(self,
                 "Failed to publish message (%u/%u consecutive failures)",
@@ -309,12 +625,20 @@ static GstFlowReturn gst_dxmsgbroker_render(GstBaseSink *sink,
             return GST_FLOW_OK;
         }
     }
+    release_messages();
 
     self->_consecutive_failures = 0;
     return GST_FLOW_OK;
 }
 
 static gboolean gst_dxmsgbroker_event(GstBaseSink *sink, GstEvent *event) {
+    GstDxMsgBroker *self = GST_DXMSGBROKER(sink);
+
+    if (GST_EVENT_TYPE(event) == GST_EVENT_EOS && self->_publisher &&
+        !self->_publisher->drain(self->_drain_timeout_ms)) {
+        GST_WARNING_OBJECT(self, "%u messages still queued at EOS",
+                           self->_publisher->queue_depth());
+    }
     return GST_BASE_SINK_CLASS(gst_dxmsgbroker_parent_class)
         ->event(sink, event);
 }
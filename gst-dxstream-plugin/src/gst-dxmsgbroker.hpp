@@ -30,13 +30,16 @@ using DxMsg_Bal_Handle_t = DxMsg_Bal_Handle*;
 /* BAL method */
 using DxMsg_Bal_ConnectFptr_t = DxMsg_Bal_Handle_t (*)(char *conn_info,
                                                         char *cfg_path);
+/* payload is borrowed; a broker that sends asynchronously keeps its own
+ * reference until delivery instead of copying the data. */
 using DxMsg_Bal_SendFptr_t = DxMsg_Bal_Error_t (*)(DxMsg_Bal_Handle_t handle,
                                                     const char *topic,
-                                                    const void *payload,
-                                                    int payload_len);
+                                                    GBytes *payload);
 using DxMsg_Bal_DisconnectFptr_t = DxMsg_Bal_Error_t (*)(
     DxMsg_Bal_Handle_t handle);
 
+class DxMsgPublisher;
+
 struct _GstDxMsgBroker {
     GstBaseSink parent;
 
@@ -55,6 +58,17 @@ struct _GstDxMsgBroker {
     guint64 _msgbroker_count;
 
     guint _consecutive_failures;
+
+    /* async publishing */
+    gboolean _async;
+    guint _max_queue_size;
+    guint _batch_size;
+    guint _linger_ms;
+    gchar *_spill_dir;
+    guint64 _spill_segment_size;
+    guint64 _spill_max_size;
+    guint _drain_timeout_ms;
+    DxMsgPublisher *_publisher;
 };
 
 G_END_DECLS
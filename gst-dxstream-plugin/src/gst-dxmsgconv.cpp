@@ -3,12 +3,10 @@
 #include "./../metadata/gst-dxmsgmeta.hpp"
 #include "gst-dxmsgmeta.hpp"
 #include "transforms/gst_frame_desc.hpp"
-#include "transforms/video_transform_factory.hpp"
 #include "utils.hpp"
 #include "dx_dlfcn.h"
 #include <json-glib/json-glib.h>
-#include <opencv2/imgcodecs.hpp>
-#include <opencv2/imgproc.hpp>
+#include <algorithm>
 #include <vector>
 
 enum class PropertyID {
@@ -16,9 +14,92 @@ enum class PropertyID {
     PROP_CONFIG_FILE_PATH,
     PROP_LIBRARY_FILE_PATH,
     PROP_MESSAGE_INTERVAL,
-    PROP_INCLUDE_FRAME
+    PROP_INCLUDE_FRAME,
+    PROP_MESSAGE_FORMAT,
+    PROP_SNAPSHOT_WIDTH,
+    PROP_SNAPSHOT_HEIGHT,
+    PROP_SNAPSHOT_QUALITY,
+    PROP_SNAPSHOT_MODE,
+    PROP_SNAPSHOT_ASYNC,
+    PROP_SNAPSHOT_WORKERS,
+    PROP_SNAPSHOT_MAX_PENDING,
+    PROP_SNAPSHOTS_DROPPED,
+    PROP_EMIT_MODE,
+    PROP_CHANGE_THRESHOLD,
+    PROP_TRACK_TIMEOUT,
+    PROP_DWELL_TIME,
+    PROP_COUNT_WINDOW
 };
 
+#define DEFAULT_SNAPSHOT_QUALITY 95
+#define DEFAULT_SNAPSHOT_WORKERS 2
+#define DEFAULT_SNAPSHOT_MAX_PENDING 4
+#define DEFAULT_CHANGE_THRESHOLD 0.1f
+#define DEFAULT_TRACK_TIMEOUT 1000
+#define DEFAULT_DWELL_TIME 0
+#define DEFAULT_COUNT_WINDOW 10000
+
+/** What include-frame attaches (snapshot-mode). */
+enum DxMsgConvSnapshotMode {
+    DXMSGCONV_SNAPSHOT_FRAME = 0,
+    DXMSGCONV_SNAPSHOT_CROPS = 1
+};
+
+#define GST_TYPE_DXMSGCONV_FORMAT (gst_dxmsgconv_format_get_type())
+static GType gst_dxmsgconv_format_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {DXMSG_FORMAT_JSON, "JSON text", "json"},
+            {DXMSG_FORMAT_BINARY, "Compact binary schema", "binary"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxMsgConvFormat", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
+#define GST_TYPE_DXMSGCONV_SNAPSHOT_MODE (gst_dxmsgconv_snapshot_mode_get_type())
+static GType gst_dxmsgconv_snapshot_mode_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {DXMSGCONV_SNAPSHOT_FRAME, "Whole frame", "frame"},
+            {DXMSGCONV_SNAPSHOT_CROPS, "One thumbnail per object", "crops"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxMsgConvSnapshotMode", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
+/** When a message is sent (emit-mode). */
+enum DxMsgConvEmitMode {
+    DXMSGCONV_EMIT_INTERVAL = 0,
+    DXMSGCONV_EMIT_ON_CHANGE = 1,
+    DXMSGCONV_EMIT_EVENTS = 2,
+    DXMSGCONV_EMIT_COUNTS = 3
+};
+
+#define GST_TYPE_DXMSGCONV_EMIT_MODE (gst_dxmsgconv_emit_mode_get_type())
+static GType gst_dxmsgconv_emit_mode_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {DXMSGCONV_EMIT_INTERVAL, "Every message-interval frames", "interval"},
+            {DXMSGCONV_EMIT_ON_CHANGE, "When tracks, labels or boxes change", "on-change"},
+            {DXMSGCONV_EMIT_EVENTS, "Track enter / exit / dwell events", "events"},
+            {DXMSGCONV_EMIT_COUNTS, "Objects per class per count-window", "counts"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxMsgConvEmitMode", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
 GST_DEBUG_CATEGORY_STATIC(gst_dxmsgconv_debug_category);
 #define GST_CAT_DEFAULT gst_dxmsgconv_debug_category
 
@@ -34,6 +115,8 @@ static gboolean gst_dxmsgconv_propose_allocation(GstBaseTransform *trans,
 static gboolean gst_dxmsgconv_query(GstBaseTransform *trans,
                                     GstPadDirection direction,
                                     GstQuery *query);
+static gboolean gst_dxmsgconv_sink_event(GstBaseTransform *trans,
+                                         GstEvent *event);
 
 G_DEFINE_TYPE(GstDxMsgConv, gst_dxmsgconv, GST_TYPE_BASE_TRANSFORM);
 
@@ -53,14 +136,31 @@ static void gst_dxmsgconv_finalize(GObject *object) {
     g_free(self->_config_file_path);
     g_free(self->_library_file_path);
 
-    self->_kernel_pool.~unique_ptr();
-    self->_rgb_buf.~vector();
-    self->_jpeg_buf.~vector();
+    self->_snapshot_encoder.~unique_ptr();
+    self->_jpeg_encoder.~unique_ptr();
+    self->_snapshot_job.~SnapshotJob();
     self->_seq_ids.~map();
+    self->_emit_states.~map();
 
     G_OBJECT_CLASS(parent_class)->finalize(object);
 }
 
+// Sets an enum property from its nick in the config file.
+static void set_enum_member(GstDxMsgConv *self, JsonObject *object,
+                            const gchar *member, const gchar *property, GType type) {
+    if (!json_object_has_member(object, member))
+        return;
+    const gchar *nick = json_object_get_string_member(object, member);
+    auto *enum_class = static_cast<GEnumClass *>(g_type_class_ref(type));
+    GEnumValue *value = g_enum_get_value_by_nick(enum_class, nick ? nick : "");
+    if (value) {
+        g_object_set(self, property, value->value, nullptr);
+    } else {
+        GST_WARNING_OBJECT(self, "Unknown %s '%s'", member, nick);
+    }
+    g_type_class_unref(enum_class);
+}
+
 static void parse_config(GstDxMsgConv *self) {
 
     if (string_is_empty(self->_config_file_path)) {
@@ -108,6 +208,50 @@ static void parse_config(GstDxMsgConv *self) {
         g_object_set(self, "include-frame", include_frame, nullptr);
     }
 
+    set_enum_member(self, object, "message_format", "message-format",
+                    GST_TYPE_DXMSGCONV_FORMAT);
+
+    static const struct {
+        const gchar *member;
+        const gchar *property;
+    } int_members[] = {
+        {"snapshot_width", "snapshot-width"},
+        {"snapshot_height", "snapshot-height"},
+        {"snapshot_quality", "snapshot-quality"},
+        {"snapshot_workers", "snapshot-workers"},
+        {"snapshot_max_pending", "snapshot-max-pending"},
+        {"track_timeout", "track-timeout"},
+        {"dwell_time", "dwell-time"},
+        {"count_window", "count-window"},
+    };
+    for (const auto &m : int_members) {
+        if (json_object_has_member(object, m.member)) {
+            gint64 v = json_object_get_int_member(object, m.member);
+            GParamSpec *pspec =
+                g_object_class_find_property(G_OBJECT_GET_CLASS(self), m.property);
+            if (G_IS_PARAM_SPEC_INT(pspec))
+                g_object_set(self, m.property, (gint)v, nullptr);
+            else
+                g_object_set(self, m.property, (guint)v, nullptr);
+        }
+    }
+
+    set_enum_member(self, object, "snapshot_mode", "snapshot-mode",
+                    GST_TYPE_DXMSGCONV_SNAPSHOT_MODE);
+
+    set_enum_member(self, object, "emit_mode", "emit-mode", GST_TYPE_DXMSGCONV_EMIT_MODE);
+
+    if (json_object_has_member(object, "change_threshold")) {
+        gdouble threshold = json_object_get_double_member(object, "change_threshold");
+        g_object_set(self, "change-threshold", (gfloat)threshold, nullptr);
+    }
+
+    if (json_object_has_member(object, "snapshot_async")) {
+        gboolean snapshot_async =
+            json_object_get_boolean_member(object, "snapshot_async");
+        g_object_set(self, "snapshot-async", snapshot_async, nullptr);
+    }
+
     g_object_unref(parser);
 }
 
@@ -131,6 +275,45 @@ static void gst_dxmsgconv_set_property(GObject *object, guint prop_id,
     case PropertyID::PROP_INCLUDE_FRAME:
         self->_include_frame = g_value_get_boolean(value);
         break;
+    case PropertyID::PROP_MESSAGE_FORMAT:
+        self->_message_format = static_cast<DxMsgFormat>(g_value_get_enum(value));
+        break;
+    case PropertyID::PROP_SNAPSHOT_WIDTH:
+        self->_snapshot_width = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_SNAPSHOT_HEIGHT:
+        self->_snapshot_height = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_SNAPSHOT_QUALITY:
+        self->_snapshot_quality = g_value_get_int(value);
+        break;
+    case PropertyID::PROP_SNAPSHOT_MODE:
+        self->_snapshot_mode = g_value_get_enum(value);
+        break;
+    case PropertyID::PROP_SNAPSHOT_ASYNC:
+        self->_snapshot_async = g_value_get_boolean(value);
+        break;
+    case PropertyID::PROP_SNAPSHOT_WORKERS:
+        self->_snapshot_workers = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_SNAPSHOT_MAX_PENDING:
+        self->_snapshot_max_pending = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_EMIT_MODE:
+        self->_emit_mode = g_value_get_enum(value);
+        break;
+    case PropertyID::PROP_CHANGE_THRESHOLD:
+        self->_change_threshold = g_value_get_float(value);
+        break;
+    case PropertyID::PROP_TRACK_TIMEOUT:
+        self->_track_timeout = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_DWELL_TIME:
+        self->_dwell_time = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_COUNT_WINDOW:
+        self->_count_window = g_value_get_uint(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -155,6 +338,49 @@ static void gst_dxmsgconv_get_property(GObject *object, guint prop_id,
     case PropertyID::PROP_INCLUDE_FRAME:
         g_value_set_boolean(value, self->_include_frame);
         break;
+    case PropertyID::PROP_MESSAGE_FORMAT:
+        g_value_set_enum(value, self->_message_format);
+        break;
+    case PropertyID::PROP_SNAPSHOT_WIDTH:
+        g_value_set_uint(value, self->_snapshot_width);
+        break;
+    case PropertyID::PROP_SNAPSHOT_HEIGHT:
+        g_value_set_uint(value, self->_snapshot_height);
+        break;
+    case PropertyID::PROP_SNAPSHOT_QUALITY:
+        g_value_set_int(value, self->_snapshot_quality);
+        break;
+    case PropertyID::PROP_SNAPSHOT_MODE:
+        g_value_set_enum(value, self->_snapshot_mode);
+        break;
+    case PropertyID::PROP_SNAPSHOT_ASYNC:
+        g_value_set_boolean(value, self->_snapshot_async);
+        break;
+    case PropertyID::PROP_SNAPSHOT_WORKERS:
+        g_value_set_uint(value, self->_snapshot_workers);
+        break;
+    case PropertyID::PROP_SNAPSHOT_MAX_PENDING:
+        g_value_set_uint(value, self->_snapshot_max_pending);
+        break;
+    case PropertyID::PROP_SNAPSHOTS_DROPPED:
+        g_value_set_uint64(value, self->_snapshot_encoder
+                                      ? self->_snapshot_encoder->dropped() : 0);
+        break;
+    case PropertyID::PROP_EMIT_MODE:
+        g_value_set_enum(value, self->_emit_mode);
+        break;
+    case PropertyID::PROP_CHANGE_THRESHOLD:
+        g_value_set_float(value, self->_change_threshold);
+        break;
+    case PropertyID::PROP_TRACK_TIMEOUT:
+        g_value_set_uint(value, self->_track_timeout);
+        break;
+    case PropertyID::PROP_DWELL_TIME:
+        g_value_set_uint(value, self->_dwell_time);
+        break;
+    case PropertyID::PROP_COUNT_WINDOW:
+        g_value_set_uint(value, self->_count_window);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -201,6 +427,117 @@ static void gst_dxmsgconv_class_init(GstDxMsgConvClass *klass) {
             "Flag whether to include frame data as base64 JPEG in the message. (optional).",
             FALSE, G_PARAM_READWRITE));
 
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_MESSAGE_FORMAT),
+        g_param_spec_enum(
+            "message-format", "Message Format",
+            "Payload encoding requested from the converter library: JSON text or "
+            "the compact binary schema. (optional).",
+            GST_TYPE_DXMSGCONV_FORMAT, DXMSG_FORMAT_JSON, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_WIDTH),
+        g_param_spec_uint(
+            "snapshot-width", "Snapshot Width",
+            "Width of include-frame snapshots; 0 follows snapshot-height (keeping "
+            "the aspect ratio) or the source width. Never upscales. (optional).",
+            0, 8192, 0, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_HEIGHT),
+        g_param_spec_uint(
+            "snapshot-height", "Snapshot Height",
+            "Height of include-frame snapshots; 0 follows snapshot-width (keeping "
+            "the aspect ratio) or the source height. Never upscales. (optional).",
+            0, 8192, 0, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_QUALITY),
+        g_param_spec_int(
+            "snapshot-quality", "Snapshot Quality",
+            "JPEG quality of include-frame snapshots. (optional).",
+            1, 100, DEFAULT_SNAPSHOT_QUALITY, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_MODE),
+        g_param_spec_enum(
+            "snapshot-mode", "Snapshot Mode",
+            "What include-frame attaches: the whole frame (frameData), or one "
+            "thumbnail per object sent as a follow-up message. (optional).",
+            GST_TYPE_DXMSGCONV_SNAPSHOT_MODE, DXMSGCONV_SNAPSHOT_FRAME,
+            G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_ASYNC),
+        g_param_spec_boolean(
+            "snapshot-async", "Snapshot Async",
+            "Encode snapshots on worker threads. The message then carries no "
+            "frameData; each snapshot follows as its own message, attached to a "
+            "later buffer. (optional).",
+            FALSE, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_WORKERS),
+        g_param_spec_uint(
+            "snapshot-workers", "Snapshot Workers",
+            "Encoder threads with snapshot-async. (optional).",
+            1, 16, DEFAULT_SNAPSHOT_WORKERS, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOT_MAX_PENDING),
+        g_param_spec_uint(
+            "snapshot-max-pending", "Snapshot Max Pending",
+            "Snapshots queued or being encoded with snapshot-async; further "
+            "snapshots are dropped. (optional).",
+            1, 256, DEFAULT_SNAPSHOT_MAX_PENDING, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_SNAPSHOTS_DROPPED),
+        g_param_spec_uint64(
+            "snapshots-dropped", "Snapshots Dropped",
+            "Snapshots dropped because snapshot-max-pending was reached.",
+            0, G_MAXUINT64, 0, G_PARAM_READABLE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_EMIT_MODE),
+        g_param_spec_enum(
+            "emit-mode", "Emit Mode",
+            "When messages are sent: every message-interval frames, only when the "
+            "objects change, as track enter/exit/dwell events, or as per-class "
+            "counts per count-window. (optional).",
+            GST_TYPE_DXMSGCONV_EMIT_MODE, DXMSGCONV_EMIT_INTERVAL, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_CHANGE_THRESHOLD),
+        g_param_spec_float(
+            "change-threshold", "Change Threshold",
+            "emit-mode=on-change: box movement, relative to the box size, that "
+            "counts as a change. (optional).",
+            0.0f, 10.0f, DEFAULT_CHANGE_THRESHOLD, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_TRACK_TIMEOUT),
+        g_param_spec_uint(
+            "track-timeout", "Track Timeout",
+            "emit-mode=events: milliseconds a track may be unseen before its exit "
+            "event. (optional).",
+            0, G_MAXUINT, DEFAULT_TRACK_TIMEOUT, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_DWELL_TIME),
+        g_param_spec_uint(
+            "dwell-time", "Dwell Time",
+            "emit-mode=events: milliseconds after which a present track gets a dwell "
+            "event; 0 disables dwell events. (optional).",
+            0, G_MAXUINT, DEFAULT_DWELL_TIME, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_COUNT_WINDOW),
+        g_param_spec_uint(
+            "count-window", "Count Window",
+            "emit-mode=counts: length of a counting window in milliseconds. (optional).",
+            1, G_MAXUINT, DEFAULT_COUNT_WINDOW, G_PARAM_READWRITE));
+
     GstCaps *video_caps = gst_caps_from_string(
         DX_VIDEORAW_CAPS_STR "; "
         "video/x-raw, format=(string){ NV12, I420, RGB, BGR }");
@@ -223,6 +560,8 @@ static void gst_dxmsgconv_class_init(GstDxMsgConvClass *klass) {
     base_transform_class->propose_allocation =
         GST_DEBUG_FUNCPTR(gst_dxmsgconv_propose_allocation);
     base_transform_class->query = GST_DEBUG_FUNCPTR(gst_dxmsgconv_query);
+    base_transform_class->sink_event =
+        GST_DEBUG_FUNCPTR(gst_dxmsgconv_sink_event);
 
     parent_class = GST_ELEMENT_CLASS(g_type_class_peek_parent(klass));
 
@@ -234,16 +573,30 @@ static void gst_dxmsgconv_class_init(GstDxMsgConvClass *klass) {
 static void gst_dxmsgconv_init(GstDxMsgConv *self) {
     GST_TRACE_OBJECT(self, "init");
 
-    new (&self->_kernel_pool) std::unique_ptr<dxt::TransformKernelPool>();
-    new (&self->_rgb_buf) std::vector<uint8_t>();
-    new (&self->_jpeg_buf) std::vector<unsigned char>();
+    new (&self->_snapshot_encoder) std::unique_ptr<dxs::SnapshotEncoder>();
+    new (&self->_jpeg_encoder) std::unique_ptr<dxs::SnapshotJpegEncoder>();
+    new (&self->_snapshot_job) dxs::SnapshotJob();
     new (&self->_seq_ids) std::map<int, guint64>();
+    new (&self->_emit_states) std::map<int, dxs::StreamEmitState>();
 
     self->_config_file_path = nullptr;
     self->_library_file_path = nullptr;
     self->_library_handle = nullptr;
     self->_message_interval = 1;
     self->_include_frame = FALSE;
+    self->_message_format = DXMSG_FORMAT_JSON;
+    self->_snapshot_width = 0;
+    self->_snapshot_height = 0;
+    self->_snapshot_quality = DEFAULT_SNAPSHOT_QUALITY;
+    self->_snapshot_mode = DXMSGCONV_SNAPSHOT_FRAME;
+    self->_snapshot_async = FALSE;
+    self->_snapshot_workers = DEFAULT_SNAPSHOT_WORKERS;
+    self->_snapshot_max_pending = DEFAULT_SNAPSHOT_MAX_PENDING;
+    self->_emit_mode = DXMSGCONV_EMIT_INTERVAL;
+    self->_change_threshold = DEFAULT_CHANGE_THRESHOLD;
+    self->_track_timeout = DEFAULT_TRACK_TIMEOUT;
+    self->_dwell_time = DEFAULT_DWELL_TIME;
+    self->_count_window = DEFAULT_COUNT_WINDOW;
     self->_cached_width = 0;
     self->_cached_height = 0;
     self->_cached_format = GST_VIDEO_FORMAT_UNKNOWN;
@@ -299,11 +652,12 @@ static gboolean gst_dxmsgconv_stop(GstBaseTransform *trans) {
     GstDxMsgConv *self = GST_DXMSGCONV(trans);
     GST_DEBUG_OBJECT(trans, "stop");
 
-    self->_kernel_pool.reset();
-    self->_rgb_buf.clear();
-    self->_rgb_buf.shrink_to_fit();
-    self->_jpeg_buf.clear();
-    self->_jpeg_buf.shrink_to_fit();
+    // Joins the workers. EOS has already pushed every snapshot; after a
+    // flush or a mid-stream stop, unfinished ones are dropped.
+    self->_snapshot_encoder.reset();
+    self->_jpeg_encoder.reset();
+    self->_snapshot_job = dxs::SnapshotJob();
+    self->_emit_states.clear();
 
     if (self->_context) {
         self->_delete_context_function(self->_context);
@@ -317,139 +671,223 @@ static gboolean gst_dxmsgconv_stop(GstBaseTransform *trans) {
     return TRUE;
 }
 
-static dxt::FrameDesc build_src_frame_desc(GstBuffer *buf,
-                                           const GstVideoInfo *vinfo) {
-    int w = GST_VIDEO_INFO_WIDTH(vinfo);
-    int h = GST_VIDEO_INFO_HEIGHT(vinfo);
-    GstVideoFormat gst_fmt = GST_VIDEO_INFO_FORMAT(vinfo);
-
-    switch (gst_fmt) {
-    case GST_VIDEO_FORMAT_NV12:
-    case GST_VIDEO_FORMAT_I420:
-    case GST_VIDEO_FORMAT_RGB:
-    case GST_VIDEO_FORMAT_BGR: {
-        dxt::VideoFormat fmt = dxt::video_format_from_gst(gst_fmt);
-        dxt::FrameDesc desc;
-        dxt::detail::build_frame_layout(desc, buf, w, h, fmt, vinfo);
-        return desc;
-    }
-    default:
-        GST_WARNING("build_src_frame_desc: unsupported format %d", gst_fmt);
-        return {};
+static void ensure_snapshot_encoder(GstDxMsgConv *self) {
+    if (self->_snapshot_async) {
+        if (self->_snapshot_encoder)
+            return;
+        self->_snapshot_encoder = std::make_unique<dxs::SnapshotEncoder>(
+            self->_snapshot_workers, self->_snapshot_max_pending, self->_snapshot_quality);
+        GST_INFO_OBJECT(self, "include-frame: %u snapshot workers started",
+                        self->_snapshot_workers);
+    } else if (!self->_jpeg_encoder) {
+        self->_jpeg_encoder = std::make_unique<dxs::SnapshotJpegEncoder>();
     }
 }
 
-static gchar *encode_frame_to_base64(GstDxMsgConv *self, GstBuffer *buf) {
-    int w = GST_VIDEO_INFO_WIDTH(&self->_input_info);
-    int h = GST_VIDEO_INFO_HEIGHT(&self->_input_info);
-    GstVideoFormat gst_fmt = GST_VIDEO_INFO_FORMAT(&self->_input_info);
-    dxt::VideoFormat src_fmt = dxt::video_format_from_gst(gst_fmt);
+// Streaming-thread part of a snapshot: copies the frame, or each object box,
+// out of `buf` at the snapshot size. Encoding is left to the caller.
+static bool capture_snapshot(GstDxMsgConv *self, const DXFrameMeta *frame_meta,
+                             GstBuffer *buf, dxs::SnapshotJob &job) {
+    dxt::GstSrcFrame src(buf, self->_input_info);
+    if (!src.ok()) {
+        GST_WARNING_OBJECT(self, "Failed to map buffer for frame snapshot");
+        return false;
+    }
+    const dxt::FrameDesc &desc = src.desc();
+    int out_w = 0;
+    int out_h = 0;
+
+    job.crops = self->_snapshot_mode == DXMSGCONV_SNAPSHOT_CROPS;
+    job.crop_list.clear();
+    if (!job.crops) {
+        dxs::snapshot_size(desc.width, desc.height, self->_snapshot_width,
+                           self->_snapshot_height, out_w, out_h);
+        return dxs::snapshot_capture(desc, dxt::CropRect(), out_w, out_h, job.frame);
+    }
 
-    // Build src FrameDesc
-    dxt::FrameDesc src_desc = build_src_frame_desc(buf, &self->_input_info);
+    for (const DXObjectMeta *obj : frame_meta->_object_meta_list) {
+        int x0 = std::max(0, static_cast<int>(obj->_box[0]));
+        int y0 = std::max(0, static_cast<int>(obj->_box[1]));
+        int x1 = std::min(desc.width, static_cast<int>(obj->_box[2]));
+        int y1 = std::min(desc.height, static_cast<int>(obj->_box[3]));
+        if (x1 - x0 < 2 || y1 - y0 < 2)
+            continue;
+        dxt::CropRect roi;
+        roi.x = x0;
+        roi.y = y0;
+        roi.w = x1 - x0;
+        roi.h = y1 - y0;
+        roi.enabled = true;
+
+        dxs::SnapshotCrop crop;
+        crop.track_id = obj->_track_id;
+        crop.label_id = obj->_label;
+        crop.box = obj->_box;
+        dxs::snapshot_size(roi.w, roi.h, self->_snapshot_width, self->_snapshot_height,
+                           out_w, out_h);
+        if (dxs::snapshot_capture(desc, roi, out_w, out_h, crop.image))
+            job.crop_list.push_back(std::move(crop));
+    }
+    return !job.crop_list.empty();
+}
 
-    // Map buffer and fill plane data pointers
-    GstMapInfo map;
-    if (!gst_buffer_map(buf, &map, GST_MAP_READ)) {
-        GST_WARNING_OBJECT(self, "Failed to map buffer for frame encoding");
+// Takes the snapshot of a converted frame. Returns the inline frameData for
+// a synchronous whole-frame snapshot; otherwise the snapshot is either queued
+// for the workers or, for synchronous crops, returned in `*follow_up`.
+static gchar *take_snapshot(GstDxMsgConv *self, const DXFrameMeta *frame_meta,
+                            GstBuffer *buf, int stream_id, guint64 seq,
+                            GBytes **follow_up) {
+    if (self->_snapshot_async) {
+        auto job = std::make_unique<dxs::SnapshotJob>();
+        job->stream_id = stream_id;
+        job->seq_id = seq;
+        if (capture_snapshot(self, frame_meta, buf, *job) &&
+            !self->_snapshot_encoder->submit(std::move(job))) {
+            GST_DEBUG_OBJECT(self, "Snapshot workers busy, dropping snapshot of seq %"
+                             G_GUINT64_FORMAT, seq);
+        }
         return nullptr;
     }
 
-    for (int i = 0; i < src_desc.num_planes; ++i) {
-        src_desc.planes[i].data = map.data + src_desc.planes[i].offset;
+    dxs::SnapshotJob &job = self->_snapshot_job;
+    job.stream_id = stream_id;
+    job.seq_id = seq;
+    if (!capture_snapshot(self, frame_meta, buf, job))
+        return nullptr;
+    if (job.crops) {
+        *follow_up = dxs::snapshot_message(job, *self->_jpeg_encoder, self->_snapshot_quality);
+        return nullptr;
     }
+    return self->_jpeg_encoder->encode_base64(job.frame, self->_snapshot_quality);
+}
 
-    // Build dst FrameDesc (RGB) — reuse member buffer
-    self->_rgb_buf.resize(w * h * 3);
-    dxt::FrameDesc dst_desc = dxt::make_output_frame_desc(
-        self->_rgb_buf.data(), w, h, dxt::VideoFormat::RGB);
-
-    // Get kernel from pool and transform to RGB
-    dxt::InputConfig input_cfg{src_fmt, w, h};
-    auto result = self->_kernel_pool->transform(input_cfg, src_desc, dst_desc);
-    gst_buffer_unmap(buf, &map);
+// Builds the full message of a frame through the converter library.
+static void convert_frame(GstDxMsgConv *self, DXFrameMeta *frame_meta, GstBuffer *buf,
+                          int stream_id, guint64 seq) {
+    GstDxMsgMetaInfo meta_info;
+    meta_info._frame_meta = frame_meta;
+    meta_info._seq_id = seq;
+    meta_info._input_info = &self->_input_info;
+    meta_info._include_frame = self->_include_frame;
+    meta_info._frame_base64 = nullptr;
+    meta_info._message_format = self->_message_format;
+
+    gchar *base64_str = nullptr;
+    GBytes *follow_up = nullptr;
+    // Domain mode (dxvideoraw) has no frame layout to snapshot.
+    if (self->_include_frame && self->_cached_format != GST_VIDEO_FORMAT_UNKNOWN) {
+        base64_str = take_snapshot(self, frame_meta, buf, stream_id, seq, &follow_up);
+        if (!base64_str && !self->_snapshot_async &&
+            self->_snapshot_mode == DXMSGCONV_SNAPSHOT_FRAME) {
+            GST_DEBUG_OBJECT(self, "Frame encoding failed, frameData will be null");
+        }
+        meta_info._frame_base64 = base64_str;
+    }
 
-    if (!result.success) {
-        GST_WARNING_OBJECT(self, "Frame color conversion failed");
-        return nullptr;
+    DxMsgPayload *payload = nullptr;
+    try {
+        payload = self->_convert_payload_function(self->_context, &meta_info);
+    } catch (const std::exception &e) {
+        GST_ERROR_OBJECT(self, "convert_payload_function threw exception: %s", e.what());
+        g_free(base64_str);
+        if (follow_up)
+            g_bytes_unref(follow_up);
+        return;
+    } catch (...) {
+        GST_ERROR_OBJECT(self, "convert_payload_function threw unknown exception");
+        g_free(base64_str);
+        if (follow_up)
+            g_bytes_unref(follow_up);
+        return;
     }
 
-    // JPEG encode — OpenCV expects BGR channel order
-    cv::Mat rgb_mat(h, w, CV_8UC3, self->_rgb_buf.data(), w * 3);
-    cv::cvtColor(rgb_mat, rgb_mat, cv::COLOR_RGB2BGR);
-    self->_jpeg_buf.clear();
-    if (!cv::imencode(".jpg", rgb_mat, self->_jpeg_buf) || self->_jpeg_buf.empty()) {
-        GST_WARNING_OBJECT(self, "JPEG encoding failed");
-        return nullptr;
+    if (!payload) {
+        GST_WARNING_OBJECT(self, "convert_payload_function returned null");
+        g_free(base64_str);
+        if (follow_up)
+            g_bytes_unref(follow_up);
+        return;
     }
 
-    return g_base64_encode(self->_jpeg_buf.data(), self->_jpeg_buf.size());
+    // The payload data moves into the meta as is; no copy on the way
+    // to the broker.
+    dx_take_payload_to_buffer(buf, payload);
+    g_free(base64_str);
+    if (follow_up) {
+        dx_add_extra_payload_bytes_to_buffer(buf, follow_up);
+        g_bytes_unref(follow_up);
+    }
 }
 
-static void ensure_kernel_pool(GstDxMsgConv *self) {
-    if (self->_kernel_pool) return;
-
-    int w = GST_VIDEO_INFO_WIDTH(&self->_input_info);
-    int h = GST_VIDEO_INFO_HEIGHT(&self->_input_info);
-
-    dxt::FrameDesc dst_template = dxt::make_output_frame_desc(
-        nullptr, w, h, dxt::VideoFormat::RGB);
-    dxt::TransformOps ops;
+static std::vector<dxs::EmitObject> emit_objects(const DXFrameMeta *frame_meta) {
+    std::vector<dxs::EmitObject> objects;
+    objects.reserve(frame_meta->_object_meta_list.size());
+    for (const DXObjectMeta *obj : frame_meta->_object_meta_list) {
+        // Same objects as the message: the library skips label -1.
+        if (obj->_label != -1)
+            objects.push_back({obj->_track_id, obj->_label, &obj->_label_name, obj->_box});
+    }
+    return objects;
+}
 
-    self->_kernel_pool = std::make_unique<dxt::TransformKernelPool>(dst_template, ops);
-    GST_INFO_OBJECT(self, "include-frame: kernel pool created for RGB conversion");
+static gint64 buffer_time_ns(GstBuffer *buf) {
+    if (GST_BUFFER_PTS_IS_VALID(buf))
+        return static_cast<gint64>(GST_BUFFER_PTS(buf));
+    return g_get_monotonic_time() * 1000;
 }
 
 void convert(GstDxMsgConv *self, DXFrameMeta *frame_meta, GstBuffer *buf) {
     int stream_id = (frame_meta && frame_meta->_stream_id >= 0)
                         ? frame_meta->_stream_id : 0;
     guint64 &seq = self->_seq_ids[stream_id];
-    if (self->_message_interval == 0 ||
-        (seq % self->_message_interval) == 0) {
-        GstDxMsgMetaInfo meta_info;
-        meta_info._frame_meta = frame_meta;
-        meta_info._seq_id = seq;
-        meta_info._input_info = &self->_input_info;
-        meta_info._include_frame = self->_include_frame;
-        meta_info._frame_base64 = nullptr;
-
-        gchar *base64_str = nullptr;
-        if (self->_include_frame && self->_kernel_pool) {
-            base64_str = encode_frame_to_base64(self, buf);
-            if (!base64_str) {
-                GST_DEBUG_OBJECT(self, "Frame encoding failed, frameData will be null");
-            }
-            meta_info._frame_base64 = base64_str;
-        }
 
-        DxMsgPayload *payload = nullptr;
-        try {
-            payload = self->_convert_payload_function(self->_context, &meta_info);
-        } catch (const std::exception &e) {
-            GST_ERROR_OBJECT(self, "convert_payload_function threw exception: %s", e.what());
-            g_free(base64_str);
-            return;
-        } catch (...) {
-            GST_ERROR_OBJECT(self, "convert_payload_function threw unknown exception");
-            g_free(base64_str);
-            return;
+    if (self->_emit_mode == DXMSGCONV_EMIT_INTERVAL) {
+        if (self->_message_interval == 0 ||
+            (seq % self->_message_interval) == 0) {
+            convert_frame(self, frame_meta, buf, stream_id, seq);
+        } else {
+            GST_DEBUG_OBJECT(self, "skip seq:%lu, _message_interval: %d",
+                             seq, self->_message_interval);
         }
+        return;
+    }
 
-        if (!payload) {
-            GST_WARNING_OBJECT(self, "convert_payload_function returned null");
-            g_free(base64_str);
-            return;
+    dxs::StreamEmitState &state = self->_emit_states[stream_id];
+    std::vector<dxs::EmitObject> objects = emit_objects(frame_meta);
+    gint64 now_ns = buffer_time_ns(buf);
+    GBytes *message = nullptr;
+
+    switch (self->_emit_mode) {
+    case DXMSGCONV_EMIT_ON_CHANGE:
+        if (state.changed(objects, self->_change_threshold)) {
+            convert_frame(self, frame_meta, buf, stream_id, seq);
+        } else {
+            GST_LOG_OBJECT(self, "stream %d seq %" G_GUINT64_FORMAT " unchanged",
+                           stream_id, seq);
         }
+        return;
+    case DXMSGCONV_EMIT_EVENTS: {
+        std::vector<dxs::TrackEvent> events;
+        state.track(objects, now_ns, self->_track_timeout * GST_MSECOND,
+                    self->_dwell_time * GST_MSECOND, events);
+        if (!events.empty())
+            message = dxs::track_events_message(stream_id, seq, events);
+        break;
+    }
+    case DXMSGCONV_EMIT_COUNTS: {
+        std::vector<dxs::ClassCount> counts;
+        gint64 start_ns = 0;
+        if (state.count(objects, now_ns, self->_count_window * GST_MSECOND, counts, start_ns))
+            message = dxs::class_counts_message(stream_id, seq, start_ns, now_ns, counts);
+        break;
+    }
+    default:
+        break;
+    }
 
-        dx_add_payload_to_buffer(buf, payload);
-
-        g_free(payload->_data);
-        g_free(payload);
-        g_free(base64_str);
-
-    } else {
-        GST_DEBUG_OBJECT(self, "skip seq:%lu, _message_interval: %d",
-                         seq, self->_message_interval);
+    if (message) {
+        dx_add_payload_bytes_to_buffer(buf, message);
+        g_bytes_unref(message);
     }
 }
 
@@ -466,7 +904,6 @@ static gboolean gst_dxmsgconv_set_caps(GstBaseTransform *trans,
         self->_cached_width = 0;
         self->_cached_height = 0;
         self->_cached_format = GST_VIDEO_FORMAT_UNKNOWN;
-        self->_kernel_pool.reset();
         return TRUE;
     }
 
@@ -478,7 +915,6 @@ static gboolean gst_dxmsgconv_set_caps(GstBaseTransform *trans,
     self->_cached_width  = GST_VIDEO_INFO_WIDTH(&self->_input_info);
     self->_cached_height = GST_VIDEO_INFO_HEIGHT(&self->_input_info);
     self->_cached_format = GST_VIDEO_INFO_FORMAT(&self->_input_info);
-    self->_kernel_pool.reset();
 
     GST_INFO_OBJECT(self, "Caps set: %dx%d format=%s",
                     self->_cached_width, self->_cached_height,
@@ -500,15 +936,23 @@ static GstFlowReturn gst_dxmsgconv_transform_ip(GstBaseTransform *trans,
                    " stream=%d seq=%" G_GUINT64_FORMAT,
                    GST_TIME_ARGS(GST_BUFFER_PTS(buf)), stream_id, seq);
 
-    if (self->_include_frame && !self->_kernel_pool) {
-        ensure_kernel_pool(self);
+    if (self->_include_frame) {
+        ensure_snapshot_encoder(self);
     }
 
-    if (!frame_meta) {
+    if (frame_meta) {
+        convert(self, frame_meta, buf);
+    } else {
         GST_LOG_OBJECT(self, "No DXFrameMeta, passing through");
-        return GST_FLOW_OK;
     }
-    convert(self, frame_meta, buf);
+
+    // Snapshots finished by the workers ride on whichever buffer comes next.
+    if (self->_snapshot_encoder) {
+        for (GBytes *snapshot : self->_snapshot_encoder->take_finished()) {
+            dx_add_extra_payload_bytes_to_buffer(buf, snapshot);
+            g_bytes_unref(snapshot);
+        }
+    }
 
     return GST_FLOW_OK;
 }
@@ -544,3 +988,58 @@ static gboolean gst_dxmsgconv_query(GstBaseTransform *trans,
     }
     return GST_BASE_TRANSFORM_CLASS(parent_class)->query(trans, direction, query);
 }
+
+// events / counts messages that only the end of the stream completes:
+// exit events for the tracks still live and the open counts window.
+static void flush_emit_states(GstDxMsgConv *self, std::vector<GBytes *> &messages) {
+    for (auto &entry : self->_emit_states) {
+        const int stream_id = entry.first;
+        const guint64 seq = self->_seq_ids[stream_id];
+        if (self->_emit_mode == DXMSGCONV_EMIT_EVENTS) {
+            std::vector<dxs::TrackEvent> events;
+            entry.second.flush_tracks(events);
+            if (!events.empty())
+                messages.push_back(dxs::track_events_message(stream_id, seq, events));
+        } else if (self->_emit_mode == DXMSGCONV_EMIT_COUNTS) {
+            std::vector<dxs::ClassCount> counts;
+            gint64 start_ns = 0;
+            gint64 end_ns = 0;
+            if (entry.second.flush_count(counts, start_ns, end_ns))
+                messages.push_back(
+                    dxs::class_counts_message(stream_id, seq, start_ns, end_ns, counts));
+        }
+    }
+}
+
+// Messages that would otherwise be lost at EOS: snapshots still being
+// encoded by the workers, and what the emit states still hold. They go
+// downstream in one last buffer that carries only a GstDxMsgMeta.
+static void push_eos_messages(GstDxMsgConv *self) {
+    std::vector<GBytes *> messages;
+    flush_emit_states(self, messages);
+    if (self->_snapshot_encoder) {
+        self->_snapshot_encoder->drain();
+        for (GBytes *snapshot : self->_snapshot_encoder->take_finished())
+            messages.push_back(snapshot);
+    }
+    if (messages.empty())
+        return;
+
+    GstBuffer *buf = gst_buffer_new();
+    for (GBytes *message : messages) {
+        dx_add_extra_payload_bytes_to_buffer(buf, message);
+        g_bytes_unref(message);
+    }
+    GST_DEBUG_OBJECT(self, "Pushing %zu messages finished at EOS", messages.size());
+    GstFlowReturn ret = gst_pad_push(GST_BASE_TRANSFORM_SRC_PAD(self), buf);
+    if (ret != GST_FLOW_OK)
+        GST_WARNING_OBJECT(self, "Final message buffer not pushed: %s",
+                           gst_flow_get_name(ret));
+}
+
+static gboolean gst_dxmsgconv_sink_event(GstBaseTransform *trans,
+                                         GstEvent *event) {
+    if (GST_EVENT_TYPE(event) == GST_EVENT_EOS)
+        push_eos_messages(GST_DXMSGCONV(trans));
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->sink_event(trans, event);
+}
@@ -5,7 +5,8 @@
 #include <gst/gst.h>
 
 #include "gst-dxmsgmeta.hpp"
-#include "transforms/transform_kernel_pool.hpp"
+#include "dx_msg_emitter.hpp"
+#include "dx_snapshot_encoder.hpp"
 
 #include <map>
 #include <memory>
@@ -26,12 +27,26 @@ struct _GstDxMsgConv {
     GstBaseTransform _parent_instance;
 
     std::map<int, guint64> _seq_ids;
+    std::map<int, dxs::StreamEmitState> _emit_states;
     guint _message_interval;
     GstVideoInfo _input_info;
     gchar *_config_file_path;
     gchar *_library_file_path;
     void *_library_handle;
     gboolean _include_frame;
+    DxMsgFormat _message_format;
+    gint _emit_mode;
+    gfloat _change_threshold;
+    guint _track_timeout;
+    guint _dwell_time;
+    guint _count_window;
+    guint _snapshot_width;
+    guint _snapshot_height;
+    gint _snapshot_quality;
+    gint _snapshot_mode;
+    gboolean _snapshot_async;
+    guint _snapshot_workers;
+    guint _snapshot_max_pending;
     int _cached_width;
     int _cached_height;
     GstVideoFormat _cached_format;
@@ -42,9 +57,9 @@ struct _GstDxMsgConv {
     DXMsg_DeleteContextFptr _delete_context_function;
     DXMsg_ConvertPayloadFptr _convert_payload_function;
 
-    std::unique_ptr<dxt::TransformKernelPool> _kernel_pool;
-    std::vector<uint8_t> _rgb_buf;
-    std::vector<unsigned char> _jpeg_buf;
+    std::unique_ptr<dxs::SnapshotEncoder> _snapshot_encoder;   /**< snapshot-async */
+    std::unique_ptr<dxs::SnapshotJpegEncoder> _jpeg_encoder;   /**< streaming thread */
+    dxs::SnapshotJob _snapshot_job;   /**< reused by synchronous snapshots */
 };
 
 G_END_DECLS
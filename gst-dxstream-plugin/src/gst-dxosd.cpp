@@ -3,6 +3,7 @@
 #include "./../metadata/gst-dxobjectmeta.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
 #include <new>
 #include <cmath>
@@ -12,7 +13,31 @@
 #include "dxosd_common.hpp"
 
 
-enum class PropertyID { PROP_0, N_PROPERTIES };
+enum class PropertyID { PROP_0, PROP_RENDER_THREADS, PROP_OUTPUT_MODE, N_PROPERTIES };
+
+#define DEFAULT_RENDER_THREADS 1
+#define MAX_RENDER_THREADS 64
+
+/** Where the OSD goes (output-mode). */
+enum DxOsdOutputMode {
+    DXOSD_OUTPUT_DRAW = 0,
+    DXOSD_OUTPUT_COMPOSITION = 1
+};
+
+#define GST_TYPE_DXOSD_OUTPUT_MODE (gst_dxosd_output_mode_get_type())
+static GType gst_dxosd_output_mode_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {DXOSD_OUTPUT_DRAW, "Draw into the frame", "draw"},
+            {DXOSD_OUTPUT_COMPOSITION, "Attach a GstVideoOverlayCompositionMeta", "composition"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxOsdOutputMode", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
 
 GST_DEBUG_CATEGORY_STATIC(gst_dxosd_debug_category);
 #define GST_CAT_DEFAULT gst_dxosd_debug_category
@@ -38,16 +63,74 @@ static GstBaseTransformClass *parent_class = nullptr;
 
 static void gst_dxosd_finalize(GObject *object) {
     auto *self = GST_DXOSD(object);
+    self->_render_cache.~map();
+    self->_overlays.~map();
+    self->_band_pool.~unique_ptr();
     self->_stream_info.~map();
     G_OBJECT_CLASS(parent_class)->finalize(object);
 }
 
+static void gst_dxosd_set_property(GObject *object, guint prop_id,
+                                   const GValue *value, GParamSpec *pspec) {
+    auto *self = GST_DXOSD(object);
+
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_RENDER_THREADS:
+        self->_render_threads = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_OUTPUT_MODE:
+        self->_output_mode = g_value_get_enum(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxosd_get_property(GObject *object, guint prop_id, GValue *value,
+                                   GParamSpec *pspec) {
+    auto *self = GST_DXOSD(object);
+
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_RENDER_THREADS:
+        g_value_set_uint(value, self->_render_threads);
+        break;
+    case PropertyID::PROP_OUTPUT_MODE:
+        g_value_set_enum(value, self->_output_mode);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
 static void gst_dxosd_class_init(GstDxOsdClass *klass) {
     GST_DEBUG_CATEGORY_INIT(gst_dxosd_debug_category, "dxosd", 0,
                             "DXOsd plugin");
 
     auto *gobject_class = G_OBJECT_CLASS(klass);
     gobject_class->finalize = gst_dxosd_finalize;
+    gobject_class->set_property = gst_dxosd_set_property;
+    gobject_class->get_property = gst_dxosd_get_property;
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_RENDER_THREADS),
+        g_param_spec_uint(
+            "render-threads", "Render Threads",
+            "Threads drawing each frame, in horizontal bands; 1 draws on the "
+            "streaming thread only, 0 uses one per CPU core. The output does not "
+            "depend on it. (optional).",
+            0, MAX_RENDER_THREADS, DEFAULT_RENDER_THREADS, G_PARAM_READWRITE));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_OUTPUT_MODE),
+        g_param_spec_enum(
+            "output-mode", "Output Mode",
+            "Draw into the frame, or attach boxes and labels as a "
+            "GstVideoOverlayCompositionMeta for downstream to blend (blended here "
+            "if downstream does not accept the meta; frames with masks, poses, "
+            "OBBs, faces or CLIP captions are drawn). (optional).",
+            GST_TYPE_DXOSD_OUTPUT_MODE, DXOSD_OUTPUT_DRAW, G_PARAM_READWRITE));
 
     auto *basetransform_class = GST_BASE_TRANSFORM_CLASS(klass);
     basetransform_class->transform_ip = GST_DEBUG_FUNCPTR(gst_dxosd_transform_ip);
@@ -93,6 +176,12 @@ static void gst_dxosd_class_init(GstDxOsdClass *klass) {
 static void gst_dxosd_init(GstDxOsd *self) {
     GST_DEBUG_OBJECT(self, "Initializing OSD element (passthrough transform)");
     new (&self->_stream_info) std::map<int, GstVideoInfo>();
+    new (&self->_band_pool) std::unique_ptr<dxs::BandPool>();
+    new (&self->_overlays) std::map<int, dxs::OverlayCache>();
+    new (&self->_render_cache) std::map<int, dxs::OsdRenderCache>();
+    self->_render_threads = DEFAULT_RENDER_THREADS;
+    self->_output_mode = DXOSD_OUTPUT_DRAW;
+    self->_composition_meta = FALSE;
     gst_base_transform_set_qos_enabled(GST_BASE_TRANSFORM(self), TRUE);
 }
 
@@ -102,6 +191,10 @@ static GstStateChangeReturn gst_dxosd_change_state(GstElement *element,
     switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
         self->_stream_info.clear();
+        self->_band_pool.reset();
+        self->_overlays.clear();
+        self->_render_cache.clear();
+        self->_composition_meta = FALSE;
         break;
     default:
         break;
@@ -162,6 +255,8 @@ static gboolean gst_dxosd_sink_event(GstBaseTransform *trans,
     } break;
     case GST_EVENT_FLUSH_STOP:
         self->_stream_info.clear();
+        self->_overlays.clear();
+        self->_render_cache.clear();
         break;
     default:
         break;
@@ -187,6 +282,65 @@ static gboolean gst_dxosd_query(GstBaseTransform *trans,
     return GST_BASE_TRANSFORM_CLASS(parent_class)->query(trans, direction, query);
 }
 
+// Pool for render-threads, rebuilt when the property changes; nullptr
+// draws on the streaming thread.
+static dxs::BandPool *ensure_band_pool(GstDxOsd *self) {
+    guint threads = self->_render_threads;
+    if (threads == 0)
+        threads = std::min(g_get_num_processors(), static_cast<guint>(MAX_RENDER_THREADS));
+    if (threads <= 1) {
+        self->_band_pool.reset();
+        return nullptr;
+    }
+    if (!self->_band_pool || self->_band_pool->threads() != threads) {
+        self->_band_pool.reset(new dxs::BandPool(threads));
+        GST_INFO_OBJECT(self, "Rendering with %u threads", threads);
+    }
+    return self->_band_pool.get();
+}
+
+// output-mode=composition: the frame is only mapped (to blend the
+// rectangles here) when downstream did not announce the meta.
+static GstFlowReturn attach_composition(GstDxOsd *self, GstBuffer *buf, GstVideoInfo *info,
+                                        const DXFrameMeta *frame_meta) {
+    GstVideoOverlayComposition *comp = self->_overlays[frame_meta->_stream_id].compose(
+        frame_meta, GST_VIDEO_INFO_WIDTH(info), GST_VIDEO_INFO_HEIGHT(info),
+        GST_VIDEO_INFO_FORMAT(info));
+    if (!comp)
+        return GST_FLOW_OK;
+
+    if (!self->_composition_meta) {
+        GstVideoFrame frame;
+        if (!gst_video_frame_map(&frame, info, buf, GST_MAP_READWRITE)) {
+            gst_video_overlay_composition_unref(comp);
+            GST_ELEMENT_ERROR(self, RESOURCE, READ,
+                ("Failed to map video frame for OSD rendering"), (NULL));
+            return GST_FLOW_ERROR;
+        }
+        gst_video_overlay_composition_blend(comp, &frame);
+        gst_video_frame_unmap(&frame);
+        gst_video_overlay_composition_unref(comp);
+        return GST_FLOW_OK;
+    }
+
+    // Keep rectangles attached upstream, below ours.
+    GstVideoOverlayCompositionMeta *upstream = gst_buffer_get_video_overlay_composition_meta(buf);
+    if (upstream) {
+        GstVideoOverlayComposition *merged =
+            gst_video_overlay_composition_copy(upstream->overlay);
+        guint n = gst_video_overlay_composition_n_rectangles(comp);
+        for (guint i = 0; i < n; i++)
+            gst_video_overlay_composition_add_rectangle(
+                merged, gst_video_overlay_composition_get_rectangle(comp, i));
+        gst_video_overlay_composition_unref(comp);
+        comp = merged;
+        gst_buffer_remove_meta(buf, reinterpret_cast<GstMeta *>(upstream));
+    }
+    gst_buffer_add_video_overlay_composition_meta(buf, comp);
+    gst_video_overlay_composition_unref(comp);
+    return GST_FLOW_OK;
+}
+
 static GstFlowReturn gst_dxosd_transform_ip(GstBaseTransform *trans,
                                              GstBuffer *buf) {
     GstDxOsd *self = GST_DXOSD(trans);
@@ -211,6 +365,10 @@ static GstFlowReturn gst_dxosd_transform_ip(GstBaseTransform *trans,
 
     GstVideoInfo *info = &it->second;
 
+    if (self->_output_mode == DXOSD_OUTPUT_COMPOSITION &&
+        dxs::OverlayCache::can_compose(frame_meta))
+        return attach_composition(self, buf, info, frame_meta);
+
     // Map buffer for read/write
     GstVideoFrame frame;
     if (!gst_video_frame_map(&frame, info, buf, GST_MAP_READWRITE)) {
@@ -219,67 +377,45 @@ static GstFlowReturn gst_dxosd_transform_ip(GstBaseTransform *trans,
         return GST_FLOW_ERROR;
     }
 
-    int width = GST_VIDEO_FRAME_WIDTH(&frame);
-    int height = GST_VIDEO_FRAME_HEIGHT(&frame);
-    GstVideoFormat format = GST_VIDEO_FRAME_FORMAT(&frame);
-
-    // Draw based on format
-    if (format == GST_VIDEO_FORMAT_RGB || format == GST_VIDEO_FORMAT_BGR) {
+    OsdFrame osd;
+    osd.width = GST_VIDEO_FRAME_WIDTH(&frame);
+    osd.height = GST_VIDEO_FRAME_HEIGHT(&frame);
+    switch (GST_VIDEO_FRAME_FORMAT(&frame)) {
+    case GST_VIDEO_FORMAT_NV12:
+        osd.format = OsdFrame::Format::NV12;
+        break;
+    case GST_VIDEO_FORMAT_I420:
+        osd.format = OsdFrame::Format::I420;
+        break;
+    case GST_VIDEO_FORMAT_RGB:
+    case GST_VIDEO_FORMAT_BGR:
         // RGB/BGR: Direct OpenCV drawing on existing buffer
-        int stride = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0);
-        auto *data = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0));
-        cv::Mat surface(height, width, CV_8UC3, data, stride);
-
-        float scale_x = static_cast<float>(frame_meta->_width) / static_cast<float>(width);
-        float scale_y = static_cast<float>(frame_meta->_height) / static_cast<float>(height);
-
-        // Frame-level segmentation (semantic seg)
-        draw_semantic_segmentation(surface, frame_meta);
-
-        for (const auto *obj_meta : frame_meta->_object_meta_list) {
-            draw_object_meta(surface, obj_meta, scale_x, scale_y);
-        }
-    } else if (format == GST_VIDEO_FORMAT_NV12) {
-        // NV12: YUV drawing with color boxes and white text
-        auto *y_plane = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0));
-        auto *uv_plane = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 1));
-        int stride_y = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0);
-        int stride_uv = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 1);
-
-        float scale_x = static_cast<float>(frame_meta->_width) / static_cast<float>(width);
-        float scale_y = static_cast<float>(frame_meta->_height) / static_cast<float>(height);
-
-        GST_DEBUG_OBJECT(self, "Drawing on NV12: %zu objects",
-                        frame_meta->_object_meta_list.size());
-
-        // Frame-level segmentation (semantic seg)
-        draw_semantic_segmentation_nv12(y_plane, uv_plane, stride_y, stride_uv, width, height, frame_meta);
+        osd.format = OsdFrame::Format::PACKED;
+        break;
+    default:
+        gst_video_frame_unmap(&frame);
+        return GST_FLOW_OK;
+    }
+    for (guint i = 0; i < GST_VIDEO_FRAME_N_PLANES(&frame) && i < 3; i++) {
+        osd.planes[i] = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, i));
+        osd.strides[i] = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, i);
+    }
 
-        for (const auto *obj_meta : frame_meta->_object_meta_list) {
-            draw_object_meta_yuv_nv12(y_plane, uv_plane, stride_y, stride_uv,
-                                     width, height, obj_meta, scale_x, scale_y);
-        }
-    } else if (format == GST_VIDEO_FORMAT_I420) {
-        // I420: YUV drawing with color boxes and white text
-        auto *y_plane = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0));
-        auto *u_plane = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 1));
-        auto *v_plane = static_cast<uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 2));
-        int stride_y = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0);
-        int stride_uv = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 1);
-
-        float scale_x = static_cast<float>(frame_meta->_width) / static_cast<float>(width);
-        float scale_y = static_cast<float>(frame_meta->_height) / static_cast<float>(height);
-
-        GST_DEBUG_OBJECT(self, "Drawing on I420: %zu objects",
-                        frame_meta->_object_meta_list.size());
-
-        // Frame-level segmentation (semantic seg)
-        draw_semantic_segmentation_i420(y_plane, u_plane, v_plane, stride_y, stride_uv, width, height, frame_meta);
-
-        for (const auto *obj_meta : frame_meta->_object_meta_list) {
-            draw_object_meta_yuv_i420(y_plane, u_plane, v_plane, stride_y, stride_uv,
-                                     width, height, obj_meta, scale_x, scale_y);
-        }
+    GST_DEBUG_OBJECT(self, "Drawing on %s: %zu objects",
+                     gst_video_format_to_string(GST_VIDEO_FRAME_FORMAT(&frame)),
+                     frame_meta->_object_meta_list.size());
+
+    // Resolved once here; the bands only read it.
+    const OsdFrameStyle &style =
+        self->_render_cache[frame_meta->_stream_id].prepare(frame_meta, osd);
+
+    dxs::BandPool *pool = ensure_band_pool(self);
+    if (pool) {
+        pool->run(osd.height, [&osd, frame_meta, &style](const OsdBand &band) {
+            draw_frame_meta(osd, frame_meta, style, band);
+        });
+    } else {
+        draw_frame_meta(osd, frame_meta, style);
     }
 
     gst_video_frame_unmap(&frame);
@@ -295,6 +431,12 @@ static gboolean gst_dxosd_propose_allocation(GstBaseTransform *trans,
     if (base_class && base_class->propose_allocation)
         ret = base_class->propose_allocation(trans, decide_query, query);
 
+    // In-place: the query was answered downstream, so this is where it
+    // says whether it blends overlay compositions itself.
+    auto *self = GST_DXOSD(trans);
+    self->_composition_meta = gst_query_find_allocation_meta(
+        query, GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE, nullptr);
+
     GstCaps *qcaps = nullptr;
     gst_query_parse_allocation(query, &qcaps, nullptr);
     if (qcaps && dx_caps_is_videoraw(qcaps))
@@ -3,10 +3,15 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <gst/gst.h>
 #include <gst/video/video.h>
 #include <gst/base/gstbasetransform.h>
 
+#include "dxosd_band.hpp"
+#include "dxosd_cache.hpp"
+#include "dxosd_overlay.hpp"
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_DXOSD (gst_dxosd_get_type())
@@ -15,6 +20,12 @@ G_DECLARE_FINAL_TYPE(GstDxOsd, gst_dxosd, GST, DXOSD, GstBaseTransform)
 struct _GstDxOsd {
     GstBaseTransform parent;
     std::map<int, GstVideoInfo> _stream_info;
+    guint _render_threads;
+    std::unique_ptr<dxs::BandPool> _band_pool;   /**< render-threads > 1 */
+    gint _output_mode;
+    gboolean _composition_meta;   /**< downstream accepts GstVideoOverlayCompositionMeta */
+    std::map<int, dxs::OverlayCache> _overlays;  /**< output-mode=composition, per stream */
+    std::map<int, dxs::OsdRenderCache> _render_cache;  /**< labels, colours, per stream */
 };
 
 G_END_DECLS
@@ -2,12 +2,45 @@
 #include "./../metadata/gst-dxframemeta.hpp"
 #include "./../metadata/gst-dxobjectmeta.hpp"
 #include "utils.hpp"
+#include <algorithm>
 #include <new>
 #include <vector>
 
 GST_DEBUG_CATEGORY_STATIC(gst_dxoutputselector_debug_category);
 #define GST_CAT_DEFAULT gst_dxoutputselector_debug_category
 
+#define DEFAULT_MAX_QUEUE_SIZE 0
+#define DEFAULT_LEAKY GstDxOutputSelectorLeaky::NO
+
+enum class PropertyID {
+    PROP_0,
+    PROP_MAX_QUEUE_SIZE,
+    PROP_LEAKY
+};
+
+enum class PadPropertyID {
+    PROP_0,
+    PROP_DROPPED
+};
+
+#define GST_TYPE_DXOUTPUTSELECTOR_LEAKY (gst_dxoutputselector_leaky_get_type())
+static GType gst_dxoutputselector_leaky_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {static_cast<int>(GstDxOutputSelectorLeaky::NO), "no", "no"},
+            {static_cast<int>(GstDxOutputSelectorLeaky::UPSTREAM), "upstream",
+             "upstream"},
+            {static_cast<int>(GstDxOutputSelectorLeaky::DOWNSTREAM), "downstream",
+             "downstream"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxOutputSelectorLeaky", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
 static GstFlowReturn gst_dxoutputselector_chain_function(GstPad *pad,
                                                          GstObject *parent,
                                                          GstBuffer *buf);
@@ -25,9 +58,101 @@ static gboolean gst_dxoutputselector_src_event(GstPad *pad, GstObject *parent,
 static gboolean gst_dxoutputselector_src_query(GstPad *pad, GstObject *parent,
                                                GstQuery *query);
 
+static void stream_stop_thread(GstDxOutputSelectorPad *spad);
+
+G_DEFINE_TYPE(GstDxOutputSelectorPad, gst_dxoutputselector_pad, GST_TYPE_PAD);
+
+static void gst_dxoutputselector_pad_get_property(GObject *object,
+                                                  guint prop_id, GValue *value,
+                                                  GParamSpec *pspec) {
+    auto *spad = GST_DXOUTPUTSELECTOR_PAD(object);
+    switch (static_cast<PadPropertyID>(prop_id)) {
+    case PadPropertyID::PROP_DROPPED: {
+        std::lock_guard<std::mutex> lock(spad->_lock);
+        g_value_set_uint64(value, spad->_dropped);
+        break;
+    }
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxoutputselector_pad_finalize(GObject *object) {
+    auto *spad = GST_DXOUTPUTSELECTOR_PAD(object);
+    stream_stop_thread(spad);
+    // NOSONAR - members were constructed with placement new in pad_init
+    spad->_queue.~deque(); // NOSONAR
+    spad->_cond.~condition_variable(); // NOSONAR
+    spad->_lock.~mutex(); // NOSONAR
+    G_OBJECT_CLASS(gst_dxoutputselector_pad_parent_class)->finalize(object);
+}
+
+static void gst_dxoutputselector_pad_class_init(GstDxOutputSelectorPadClass *klass) {
+    auto *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->get_property = gst_dxoutputselector_pad_get_property;
+    gobject_class->finalize = gst_dxoutputselector_pad_finalize;
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PadPropertyID::PROP_DROPPED),
+        g_param_spec_uint64(
+            "dropped", "Dropped",
+            "Buffers of this stream dropped by the leaky output queue",
+            0, G_MAXUINT64, 0,
+            (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+}
+
+static void gst_dxoutputselector_pad_init(GstDxOutputSelectorPad *spad) {
+    new (&spad->_lock) std::mutex();
+    new (&spad->_cond) std::condition_variable();
+    new (&spad->_queue) std::deque<GstMiniObject *>();
+    spad->_queued_buffers = 0;
+    spad->_thread = nullptr;
+    spad->_running = FALSE;
+    spad->_flushing = FALSE;
+    spad->_pushing = FALSE;
+    spad->_last_ret = GST_FLOW_OK;
+    spad->_dropped = 0;
+}
+
 G_DEFINE_TYPE(GstDxOutputSelector, gst_dxoutputselector, GST_TYPE_ELEMENT);
 static GstElementClass *parent_class = nullptr;  // NOSONAR - GStreamer standard pattern with G_DEFINE_TYPE macro
 
+static void gst_dxoutputselector_set_property(GObject *object, guint prop_id,
+                                              const GValue *value,
+                                              GParamSpec *pspec) {
+    auto *self = GST_DXOUTPUTSELECTOR(object);
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_MAX_QUEUE_SIZE:
+        self->_max_queue_size = g_value_get_uint(value);
+        break;
+    case PropertyID::PROP_LEAKY:
+        self->_leaky =
+            static_cast<GstDxOutputSelectorLeaky>(g_value_get_enum(value));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxoutputselector_get_property(GObject *object, guint prop_id,
+                                              GValue *value,
+                                              GParamSpec *pspec) {
+    const auto *self = GST_DXOUTPUTSELECTOR(object);
+    switch (static_cast<PropertyID>(prop_id)) {
+    case PropertyID::PROP_MAX_QUEUE_SIZE:
+        g_value_set_uint(value, self->_max_queue_size);
+        break;
+    case PropertyID::PROP_LEAKY:
+        g_value_set_enum(value, static_cast<gint>(self->_leaky));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
 static void dxoutputselector_dispose(GObject *object) {
     GstDxOutputSelector *self = GST_DXOUTPUTSELECTOR(object);
 
@@ -58,9 +183,32 @@ static void gst_dxoutputselector_class_init(GstDxOutputSelectorClass *klass) {
                             "dxoutputselector", 0, "DXOutputSelector plugin");
     auto *element_class = GST_ELEMENT_CLASS(klass);
     auto *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->set_property = gst_dxoutputselector_set_property;
+    gobject_class->get_property = gst_dxoutputselector_get_property;
     gobject_class->dispose = dxoutputselector_dispose;
     gobject_class->finalize = dxoutputselector_finalize;
 
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_MAX_QUEUE_SIZE),
+        g_param_spec_uint(
+            "max-queue-size", "Max Queue Size",
+            "Per-stream output queue depth in buffers. Each src pad then "
+            "pushes from its own thread so a slow stream does not block the "
+            "others. 0 pushes synchronously on the upstream thread",
+            0, G_MAXUINT, DEFAULT_MAX_QUEUE_SIZE,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_READY)));
+
+    g_object_class_install_property(
+        gobject_class, static_cast<guint>(PropertyID::PROP_LEAKY),
+        g_param_spec_enum(
+            "leaky", "Leaky",
+            "What a full stream queue does: no (block upstream), upstream "
+            "(drop the new buffer) or downstream (drop the oldest buffer)",
+            GST_TYPE_DXOUTPUTSELECTOR_LEAKY, static_cast<gint>(DEFAULT_LEAKY),
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+
     gst_element_class_set_static_metadata(
         element_class, "DXOutputSelector", "Generic",
         "Routing N output stream from Input N Logical stream (1:N)",
@@ -74,7 +222,8 @@ static void gst_dxoutputselector_class_init(GstDxOutputSelectorClass *klass) {
         "src_%u", GST_PAD_SRC, GST_PAD_REQUEST, GST_STATIC_CAPS("video/x-raw"));
 
     gst_element_class_add_static_pad_template(element_class, &sink_template);
-    gst_element_class_add_static_pad_template(element_class, &src_template);
+    gst_element_class_add_static_pad_template_with_gtype(
+        element_class, &src_template, GST_TYPE_DXOUTPUTSELECTOR_PAD);
 
     element_class->request_new_pad =
         GST_DEBUG_FUNCPTR(gst_dxoutputselector_request_pad);
@@ -95,6 +244,196 @@ static void gst_dxoutputselector_init(GstDxOutputSelector *self) {
     gst_element_add_pad(GST_ELEMENT(self), self->_sinkpad);
 
     new (&self->_srcpads) std::map<int, GstPad *>();
+    self->_max_queue_size = DEFAULT_MAX_QUEUE_SIZE;
+    self->_leaky = DEFAULT_LEAKY;
+}
+
+// ---------------------------------------------------------------------------
+// Per-stream output queues (max-queue-size > 0)
+// ---------------------------------------------------------------------------
+
+static gpointer stream_thread_func(GstDxOutputSelectorPad *spad) {
+    GstPad *pad = GST_PAD(spad);
+    std::unique_lock<std::mutex> lock(spad->_lock);
+    for (;;) {
+        spad->_cond.wait(lock, [spad] {
+            return !spad->_running || !spad->_queue.empty();
+        });
+        if (!spad->_running)
+            break;
+
+        GstMiniObject *item = spad->_queue.front();
+        spad->_queue.pop_front();
+        gboolean is_buffer = GST_IS_BUFFER(item);
+        if (is_buffer)
+            spad->_queued_buffers--;
+        spad->_pushing = TRUE;
+        spad->_cond.notify_all();
+        lock.unlock();
+
+        GstFlowReturn ret = GST_FLOW_OK;
+        if (is_buffer)
+            ret = gst_pad_push(pad, GST_BUFFER_CAST(item));
+        else
+            gst_pad_push_event(pad, GST_EVENT_CAST(item));
+        if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING) {
+            GST_WARNING_OBJECT(pad, "Push failed: %s", gst_flow_get_name(ret));
+        }
+
+        lock.lock();
+        if (is_buffer)
+            spad->_last_ret = ret;
+        spad->_pushing = FALSE;
+        spad->_cond.notify_all();
+    }
+    return nullptr;
+}
+
+// Call with spad->_lock held.
+static void stream_start_thread_locked(GstDxOutputSelectorPad *spad) {
+    if (!spad->_thread) {
+        spad->_thread = g_thread_new(GST_PAD_NAME(spad),
+                                     (GThreadFunc)stream_thread_func, spad);
+    }
+}
+
+static void stream_stop_thread(GstDxOutputSelectorPad *spad) {
+    std::deque<GstMiniObject *> pending;
+    GThread *thread = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(spad->_lock);
+        spad->_running = FALSE;
+        spad->_flushing = TRUE;
+        std::swap(pending, spad->_queue);
+        spad->_queued_buffers = 0;
+        thread = spad->_thread;
+        spad->_thread = nullptr;
+        spad->_cond.notify_all();
+    }
+    if (thread)
+        g_thread_join(thread);
+    for (GstMiniObject *item : pending)
+        gst_mini_object_unref(item);
+}
+
+static GstFlowReturn stream_enqueue_buffer(GstDxOutputSelector *self,
+                                           GstDxOutputSelectorPad *spad,
+                                           GstBuffer *buffer) {
+    std::unique_lock<std::mutex> lock(spad->_lock);
+    while (spad->_running && !spad->_flushing &&
+           spad->_last_ret == GST_FLOW_OK &&
+           spad->_queued_buffers >= self->_max_queue_size) {
+        if (self->_leaky == GstDxOutputSelectorLeaky::UPSTREAM) {
+            spad->_dropped++;
+            lock.unlock();
+            GST_LOG_OBJECT(spad, "Queue full, dropping incoming buffer");
+            gst_buffer_unref(buffer);
+            return GST_FLOW_OK;
+        }
+        if (self->_leaky == GstDxOutputSelectorLeaky::DOWNSTREAM) {
+            auto it = std::find_if(spad->_queue.begin(), spad->_queue.end(),
+                                   [](GstMiniObject *o) { return GST_IS_BUFFER(o); });
+            GstMiniObject *oldest = *it;
+            spad->_queue.erase(it);
+            spad->_queued_buffers--;
+            spad->_dropped++;
+            gst_mini_object_unref(oldest);
+            GST_LOG_OBJECT(spad, "Queue full, dropped oldest buffer");
+            continue;
+        }
+        spad->_cond.wait(lock);
+    }
+
+    GstFlowReturn ret = spad->_last_ret;
+    if (!spad->_running || spad->_flushing)
+        ret = GST_FLOW_FLUSHING;
+    if (ret != GST_FLOW_OK) {
+        lock.unlock();
+        gst_buffer_unref(buffer);
+        return ret;
+    }
+
+    spad->_queue.push_back(GST_MINI_OBJECT_CAST(buffer));
+    spad->_queued_buffers++;
+    stream_start_thread_locked(spad);
+    spad->_cond.notify_all();
+    return GST_FLOW_OK;
+}
+
+static gboolean stream_enqueue_event(GstDxOutputSelectorPad *spad,
+                                     GstEvent *event) {
+    std::unique_lock<std::mutex> lock(spad->_lock);
+    if (!spad->_running || spad->_flushing) {
+        lock.unlock();
+        gst_event_unref(event);
+        return FALSE;
+    }
+    spad->_queue.push_back(GST_MINI_OBJECT_CAST(event));
+    stream_start_thread_locked(spad);
+    spad->_cond.notify_all();
+    return TRUE;
+}
+
+static void stream_flush_start(GstDxOutputSelectorPad *spad) {
+    std::deque<GstMiniObject *> pending;
+    {
+        std::lock_guard<std::mutex> lock(spad->_lock);
+        spad->_flushing = TRUE;
+        std::swap(pending, spad->_queue);
+        spad->_queued_buffers = 0;
+        spad->_cond.notify_all();
+    }
+    for (GstMiniObject *item : pending)
+        gst_mini_object_unref(item);
+}
+
+// Waits for an in-flight push (unblocked by the FLUSH_START already sent
+// downstream) so no pre-flush item can follow FLUSH_STOP.
+static void stream_flush_stop(GstDxOutputSelectorPad *spad) {
+    std::unique_lock<std::mutex> lock(spad->_lock);
+    spad->_cond.wait(lock, [spad] { return !spad->_pushing; });
+    spad->_flushing = FALSE;
+    spad->_last_ret = GST_FLOW_OK;
+}
+
+static gboolean gst_dxoutputselector_src_activate_mode(GstPad *pad,
+                                                       GstObject *parent,
+                                                       GstPadMode mode,
+                                                       gboolean active) {
+    std::ignore = parent;
+    std::ignore = mode;
+    auto *spad = GST_DXOUTPUTSELECTOR_PAD(pad);
+    if (active) {
+        std::lock_guard<std::mutex> lock(spad->_lock);
+        spad->_running = TRUE;
+        spad->_flushing = FALSE;
+        spad->_last_ret = GST_FLOW_OK;
+    } else {
+        stream_stop_thread(spad);
+    }
+    return TRUE;
+}
+
+// Events for one stream: with output queues, serialized events travel through
+// the queue to keep their order relative to buffers; flushes act on it.
+static gboolean push_stream_event(GstDxOutputSelector *self, GstPad *pad,
+                                  GstEvent *event) {
+    if (self->_max_queue_size == 0)
+        return gst_pad_push_event(pad, event);
+
+    auto *spad = GST_DXOUTPUTSELECTOR_PAD(pad);
+    switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_FLUSH_START:
+        stream_flush_start(spad);
+        return gst_pad_push_event(pad, event);
+    case GST_EVENT_FLUSH_STOP:
+        stream_flush_stop(spad);
+        return gst_pad_push_event(pad, event);
+    default:
+        if (GST_EVENT_IS_SERIALIZED(event))
+            return stream_enqueue_event(spad, event);
+        return gst_pad_push_event(pad, event);
+    }
 }
 
 static GstPad *find_target_srcpad(GstDxOutputSelector *self, int stream_id) {
@@ -124,7 +463,7 @@ static gboolean broadcast_event(GstDxOutputSelector *self, GstEvent *event) {
 
     gboolean ret = TRUE;
     for (GstPad *p : pads) {
-        ret &= gst_pad_push_event(p, gst_event_ref(event));
+        ret &= push_stream_event(self, p, gst_event_ref(event));
         gst_object_unref(p);
     }
     gst_event_unref(event);
@@ -152,7 +491,7 @@ static gboolean gst_dxoutputselector_sink_event(GstPad *pad, GstObject *parent,
             gst_event_unref(original);
             return TRUE;
         }
-        gboolean ret = gst_pad_push_event(target, original);
+        gboolean ret = push_stream_event(self, target, original);
         gst_object_unref(target);
         return ret;
     }
@@ -175,7 +514,7 @@ static gboolean gst_dxoutputselector_sink_event(GstPad *pad, GstObject *parent,
                 gst_event_unref(original);
                 return TRUE;
             }
-            gboolean ret = gst_pad_push_event(target, original);
+            gboolean ret = push_stream_event(self, target, original);
             gst_object_unref(target);
             return ret;
         }
@@ -224,9 +563,14 @@ static GstPad *gst_dxoutputselector_request_pad(GstElement *element,
     gchar *pad_name = name ? g_strdup(name)
                            : g_strdup_printf("src_%" G_GSIZE_FORMAT, self->_srcpads.size());
 
-    GstPad *srcpad = gst_pad_new_from_template(templ, pad_name);
+    GstPad *srcpad = GST_PAD(g_object_new(GST_TYPE_DXOUTPUTSELECTOR_PAD,
+                                          "name", pad_name,
+                                          "direction", GST_PAD_SRC,
+                                          "template", templ, nullptr));
 
     gint stream_id = get_src_pad_index(srcpad);
+    gst_pad_set_activatemode_function(
+        srcpad, GST_DEBUG_FUNCPTR(gst_dxoutputselector_src_activate_mode));
     gst_pad_set_active(srcpad, TRUE);
     gst_pad_set_event_function(srcpad, GST_DEBUG_FUNCPTR(gst_dxoutputselector_src_event));
     gst_pad_set_query_function(srcpad, GST_DEBUG_FUNCPTR(gst_dxoutputselector_src_query));
@@ -287,7 +631,10 @@ static GstFlowReturn gst_dxoutputselector_chain_function(GstPad *pad,
     }
 
     GST_LOG_OBJECT(self, "Pushing buffer to stream %d", frame_meta->_stream_id);
-    GstFlowReturn res = gst_pad_push(target, buffer);
+    GstFlowReturn res =
+        self->_max_queue_size > 0
+            ? stream_enqueue_buffer(self, GST_DXOUTPUTSELECTOR_PAD(target), buffer)
+            : gst_pad_push(target, buffer);
     gst_object_unref(target);
     if (res != GST_FLOW_OK) {
         GST_WARNING_OBJECT(self, "Push failed stream [%d]: %s",
@@ -2,10 +2,42 @@
 #define GST_DXOUTPUTSELECTOR_H
 
 #include <gst/gst.h>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 
 G_BEGIN_DECLS
 
+/** What a full per-stream output queue does with the next buffer. */
+enum class GstDxOutputSelectorLeaky {
+    NO = 0,        /**< block upstream until the stream drains (default) */
+    UPSTREAM = 1,  /**< drop the incoming buffer */
+    DOWNSTREAM = 2 /**< drop the oldest queued buffer */
+};
+
+#define GST_TYPE_DXOUTPUTSELECTOR_PAD (gst_dxoutputselector_pad_get_type())
+G_DECLARE_FINAL_TYPE(GstDxOutputSelectorPad, gst_dxoutputselector_pad, GST,
+                     DXOUTPUTSELECTOR_PAD, GstPad)
+
+struct _GstDxOutputSelectorPad {
+    GstPad parent_instance;
+
+    /** Output queue (max-queue-size > 0), drained by _thread. Holds buffers
+     *  and serialized events in stream order; guarded by _lock. */
+    std::mutex _lock;
+    std::condition_variable _cond;
+    std::deque<GstMiniObject *> _queue;
+    guint _queued_buffers;    /**< buffers in _queue (events don't count) */
+    GThread *_thread;
+    gboolean _running;        /**< cleared to stop _thread */
+    gboolean _flushing;       /**< between FLUSH_START and FLUSH_STOP */
+    gboolean _pushing;        /**< _thread is pushing an item downstream */
+    GstFlowReturn _last_ret;  /**< result of the last downstream push */
+
+    guint64 _dropped;         /**< buffers dropped by the leaky policy */
+};
+
 #define GST_TYPE_DXOUTPUTSELECTOR (gst_dxoutputselector_get_type())
 G_DECLARE_FINAL_TYPE(GstDxOutputSelector, gst_dxoutputselector, GST,
                      DXOUTPUTSELECTOR, GstElement)
@@ -15,8 +47,13 @@ struct _GstDxOutputSelector {
 
     std::map<int, GstPad *> _srcpads;
     GstPad *_sinkpad;
+
+    /** Per-stream output queue depth in buffers; 0 pushes synchronously on
+     *  the upstream streaming thread */
+    guint _max_queue_size;
+    GstDxOutputSelectorLeaky _leaky;
 };
 
 G_END_DECLS
 
-#endif // GST_DXOUTPUTSELECTOR_H
\ No newline at end of file
+#endif // GST_DXOUTPUTSELECTOR_H
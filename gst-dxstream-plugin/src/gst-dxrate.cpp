@@ -13,8 +13,15 @@
     gst_util_uint64_scale(count, GST_SECOND, self->_framerate)
 
 #define DEFAULT_THROTTLE FALSE
-
-enum class PropertyID { PROP_0, PROP_THROTTLE, PROP_FRAMERATE, N_PROPERTIES };
+#define DEFAULT_ZERO_COPY TRUE
+
+enum class PropertyID {
+    PROP_0,
+    PROP_THROTTLE,
+    PROP_FRAMERATE,
+    PROP_ZERO_COPY,
+    N_PROPERTIES
+};
 
 GST_DEBUG_CATEGORY_STATIC(gst_dxrate_debug_category);
 #define GST_CAT_DEFAULT gst_dxrate_debug_category
@@ -126,6 +133,9 @@ static void dxrate_set_property(GObject *object, guint property_id,
     case static_cast<guint>(PropertyID::PROP_FRAMERATE):
         self->_framerate = g_value_get_uint(value);
         break;
+    case static_cast<guint>(PropertyID::PROP_ZERO_COPY):
+        self->_zero_copy = g_value_get_boolean(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -147,6 +157,9 @@ static void dxrate_get_property(GObject *object, guint property_id,
     case static_cast<guint>(PropertyID::PROP_FRAMERATE):
         g_value_set_uint(value, self->_framerate);
         break;
+    case static_cast<guint>(PropertyID::PROP_ZERO_COPY):
+        g_value_set_boolean(value, self->_zero_copy);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -215,6 +228,14 @@ static void gst_dxrate_class_init(GstDxRateClass *klass) {
         "Sets the target framerate (FPS). This property must be configured. ",
         0, 10000, 0, G_PARAM_READWRITE);
 
+    obj_properties[static_cast<guint>(PropertyID::PROP_ZERO_COPY)] =
+        g_param_spec_boolean("zero-copy", "Zero Copy",
+                             "Emit output buffers (including duplicates) as new "
+                             "buffer shells that share the input memory. "
+                             "Downstream writers get a private copy on write "
+                             "map. If false, every output is a deep copy. ",
+                             DEFAULT_ZERO_COPY, G_PARAM_READWRITE);
+
     g_object_class_install_properties(gobject_class, static_cast<guint>(PropertyID::N_PROPERTIES),
                                       obj_properties.data());
 
@@ -311,7 +332,13 @@ static GstFlowReturn gst_dxrate_flush_prev(GstDxRate *self, RateStreamState &st,
         return GST_FLOW_OK;
     }
 
-    GstBuffer *outbuf = gst_buffer_copy_deep(st.prevbuf);
+    // A shallow copy refs prevbuf's GstMemory instead of copying it. While
+    // shared, the memory cannot be locked exclusively, so a downstream
+    // gst_buffer_map(WRITE) transparently replaces it with a private copy;
+    // readers never pay for one. DXFrameMeta is carried over by its
+    // transform function, which copies the object list but shares tensors.
+    GstBuffer *outbuf = self->_zero_copy ? gst_buffer_copy(st.prevbuf)
+                                  : gst_buffer_copy_deep(st.prevbuf);
 
     return gst_dxrate_push_buffer(self, st, outbuf, duplicate, next_intime);
 }
@@ -348,6 +375,7 @@ static void gst_dxrate_init(GstDxRate *self) {
     self->_out = 0;
     self->_throttle = false;
     self->_framerate = 0;
+    self->_zero_copy = DEFAULT_ZERO_COPY;
 }
 
 static gboolean flush_loop(GstDxRate *self, RateStreamState &st,
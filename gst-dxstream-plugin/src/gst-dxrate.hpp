@@ -25,6 +25,7 @@ struct _GstDxRate {
 
     /** Properties */
     gboolean _throttle;
+    gboolean _zero_copy; /**< share input memory instead of deep copying */
 };
 
 G_END_DECLS
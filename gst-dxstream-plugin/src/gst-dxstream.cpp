@@ -1,12 +1,15 @@
 #include "gst-dxgather.hpp"
 #include "gst-dxinfer.hpp"
 #include "gst-dxinputselector.hpp"
+#include "gst-dxlatencytracer.hpp"
 #include "gst-dxosd.hpp"
 #include "gst-dxoutputselector.hpp"
 #include "gst-dxpostprocess.hpp"
 #include "gst-dxpreprocess.hpp"
 #include "gst-dxrate.hpp"
 #include "gst-dxscale.hpp"
+#include "gst-dxtensorcapture.hpp"
+#include "gst-dxtestsrc.hpp"
 #include "gst-dxconvert.hpp"
 #include "gst-dxtracker.hpp"
 #include <gst/gst.h>
@@ -57,6 +60,14 @@ static gboolean plugin_init(GstPlugin *plugin) {
                               GST_TYPE_DXCONVERT)) {
         return FALSE;
     }
+    if (!gst_element_register(plugin, "dxtestsrc", GST_RANK_NONE,
+                              GST_TYPE_DXTESTSRC)) {
+        return FALSE;
+    }
+    if (!gst_element_register(plugin, "dxtensorcapture", GST_RANK_NONE,
+                              GST_TYPE_DXTENSORCAPTURE)) {
+        return FALSE;
+    }
 #ifndef DEEPX_V3
     if (!gst_element_register(plugin, "dxmsgconv", GST_RANK_NONE,
                               GST_TYPE_DXMSGCONV)) {
@@ -91,6 +102,10 @@ static gboolean plugin_init(GstPlugin *plugin) {
                               GST_TYPE_DXPREPROCESS)) {
         return FALSE;
     }
+    // Tracers (enabled with GST_TRACERS=dxlatency)
+    if (!gst_tracer_register(plugin, "dxlatency", GST_TYPE_DXLATENCYTRACER)) {
+        return FALSE;
+    }
     // VNPU Hardware Codec Elements
 #ifdef HAVE_DXVNPU
     GstRank vnpu_codec_rank = GST_RANK_NONE;
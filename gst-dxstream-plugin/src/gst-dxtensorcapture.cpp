@@ -0,0 +1,206 @@
+#include "gst-dxtensorcapture.hpp"
+#include "utils.hpp"
+#include "./../metadata/gst-dxframemeta.hpp"
+#include <array>
+#include <new>
+#include <string>
+
+GST_DEBUG_CATEGORY_STATIC(gst_dxtensorcapture_debug_category);
+#define GST_CAT_DEFAULT gst_dxtensorcapture_debug_category
+
+#define DEFAULT_INFER_ID 0
+#define DEFAULT_MAX_FRAMES 0
+
+enum class PropertyID {
+    PROP_0,
+    PROP_LOCATION,
+    PROP_INFER_ID,
+    PROP_MAX_FRAMES,
+    N_PROPERTIES
+};
+
+G_DEFINE_TYPE(GstDxTensorCapture, gst_dxtensorcapture, GST_TYPE_BASE_TRANSFORM);
+
+static gboolean gst_dxtensorcapture_start(GstBaseTransform *trans) {
+    GstDxTensorCapture *self = GST_DXTENSORCAPTURE(trans);
+    if (!self->_location || !*self->_location) {
+        GST_ELEMENT_ERROR(self, RESOURCE, NOT_FOUND,
+                          ("No location set for the tensor recording"), (NULL));
+        return FALSE;
+    }
+    std::string error;
+    if (!self->_writer.open(self->_location, error)) {
+        GST_ELEMENT_ERROR(self, RESOURCE, OPEN_WRITE,
+                          ("Cannot open '%s' for writing", self->_location),
+                          ("%s", error.c_str()));
+        return FALSE;
+    }
+    GST_INFO_OBJECT(self, "Capturing infer-id %d tensors to %s", self->_infer_id,
+                    self->_location);
+    return TRUE;
+}
+
+static gboolean gst_dxtensorcapture_stop(GstBaseTransform *trans) {
+    GstDxTensorCapture *self = GST_DXTENSORCAPTURE(trans);
+    GST_INFO_OBJECT(self, "Captured %" G_GUINT64_FORMAT " frames",
+                    self->_writer.frames());
+    self->_writer.close();
+    return TRUE;
+}
+
+static GstFlowReturn gst_dxtensorcapture_transform_ip(GstBaseTransform *trans,
+                                                      GstBuffer *buf) {
+    GstDxTensorCapture *self = GST_DXTENSORCAPTURE(trans);
+    if (self->_max_frames > 0 && self->_writer.frames() >= self->_max_frames)
+        return GST_FLOW_OK;
+
+    DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+    if (!frame_meta) {
+        GST_LOG_OBJECT(self, "No DXFrameMeta, passing through");
+        return GST_FLOW_OK;
+    }
+    auto it = frame_meta->_output_tensors.find(self->_infer_id);
+    if (it == frame_meta->_output_tensors.end()) {
+        // Skipped by dxinfer (interval, ROI, ...): nothing to record.
+        GST_LOG_OBJECT(self, "stream %d: no tensors for infer-id %d",
+                       frame_meta->_stream_id, self->_infer_id);
+        return GST_FLOW_OK;
+    }
+
+    dxs::TensorRecordFrame frame;
+    frame.pts = GST_BUFFER_PTS(buf);
+    frame.stream_id = frame_meta->_stream_id;
+    frame.infer_id = self->_infer_id;
+    frame.width = frame_meta->_width;
+    frame.height = frame_meta->_height;
+    for (int i = 0; i < 4; i++)
+        frame.roi[i] = frame_meta->_roi[i];
+    frame.frame_rate = frame_meta->_frame_rate;
+
+    std::string error;
+    if (!self->_writer.write(frame, it->second, error)) {
+        GST_ELEMENT_ERROR(self, RESOURCE, WRITE,
+                          ("Cannot write tensor recording '%s'", self->_location),
+                          ("%s", error.c_str()));
+        return GST_FLOW_ERROR;
+    }
+    if (self->_max_frames > 0 && self->_writer.frames() == self->_max_frames)
+        GST_INFO_OBJECT(self, "Reached max-frames (%" G_GUINT64_FORMAT
+                        "), passing through from now on", self->_max_frames);
+    return GST_FLOW_OK;
+}
+
+static void gst_dxtensorcapture_set_property(GObject *object, guint property_id,
+                                             const GValue *value, GParamSpec *pspec) {
+    GstDxTensorCapture *self = GST_DXTENSORCAPTURE(object);
+
+    switch (property_id) {
+    case static_cast<guint>(PropertyID::PROP_LOCATION):
+        g_free(self->_location);
+        self->_location = g_value_dup_string(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_INFER_ID):
+        self->_infer_id = g_value_get_int(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_MAX_FRAMES):
+        self->_max_frames = g_value_get_uint64(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxtensorcapture_get_property(GObject *object, guint property_id,
+                                             GValue *value, GParamSpec *pspec) {
+    GstDxTensorCapture *self = GST_DXTENSORCAPTURE(object);
+
+    switch (property_id) {
+    case static_cast<guint>(PropertyID::PROP_LOCATION):
+        g_value_set_string(value, self->_location);
+        break;
+    case static_cast<guint>(PropertyID::PROP_INFER_ID):
+        g_value_set_int(value, self->_infer_id);
+        break;
+    case static_cast<guint>(PropertyID::PROP_MAX_FRAMES):
+        g_value_set_uint64(value, self->_max_frames);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxtensorcapture_finalize(GObject *object) {
+    GstDxTensorCapture *self = GST_DXTENSORCAPTURE(object);
+    g_free(self->_location);
+    self->_writer.~TensorRecordWriter(); // NOSONAR - placement new in _init
+    G_OBJECT_CLASS(gst_dxtensorcapture_parent_class)->finalize(object);
+}
+
+static void gst_dxtensorcapture_class_init(GstDxTensorCaptureClass *klass) {
+    GST_DEBUG_CATEGORY_INIT(gst_dxtensorcapture_debug_category, "dxtensorcapture",
+                            0, "DXTensorCapture plugin");
+
+    auto *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->set_property = gst_dxtensorcapture_set_property;
+    gobject_class->get_property = gst_dxtensorcapture_get_property;
+    gobject_class->finalize = gst_dxtensorcapture_finalize;
+
+    static std::array<GParamSpec *, static_cast<int>(PropertyID::N_PROPERTIES)>
+        obj_properties = {
+            nullptr,
+        };
+    auto flags = static_cast<GParamFlags>(G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_LOCATION)] = g_param_spec_string(
+        "location", "Location", "Tensor recording (.dxtrec) to write", nullptr,
+        flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_INFER_ID)] = g_param_spec_int(
+        "infer-id", "Inference ID",
+        "Capture the output tensors of the dxinfer with this inference-id",
+        0, G_MAXINT, DEFAULT_INFER_ID, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_MAX_FRAMES)] = g_param_spec_uint64(
+        "max-frames", "Max Frames",
+        "Stop capturing after this many frames (0 = unlimited); buffers keep "
+        "passing through",
+        0, G_MAXUINT64, DEFAULT_MAX_FRAMES, flags);
+
+    g_object_class_install_properties(gobject_class,
+                                      static_cast<guint>(PropertyID::N_PROPERTIES),
+                                      obj_properties.data());
+
+    auto *element_class = GST_ELEMENT_CLASS(klass);
+    gst_element_class_add_pad_template(
+        element_class,
+        gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+                             gst_caps_from_string(DX_VIDEORAW_CAPS_STR "; video/x-raw")));
+    gst_element_class_add_pad_template(
+        element_class,
+        gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+                             gst_caps_from_string(DX_VIDEORAW_CAPS_STR "; video/x-raw")));
+    gst_element_class_set_static_metadata(
+        element_class, "DXTensorCapture", "Generic",
+        "Records dxinfer output tensors and frame metadata for offline replay",
+        "Sangil Jo <sijo@deepx.ai>");
+
+    auto *base_transform_class = GST_BASE_TRANSFORM_CLASS(klass);
+    base_transform_class->passthrough_on_same_caps = TRUE;
+    base_transform_class->start = GST_DEBUG_FUNCPTR(gst_dxtensorcapture_start);
+    base_transform_class->stop = GST_DEBUG_FUNCPTR(gst_dxtensorcapture_stop);
+    base_transform_class->transform_ip =
+        GST_DEBUG_FUNCPTR(gst_dxtensorcapture_transform_ip);
+}
+
+static void gst_dxtensorcapture_init(GstDxTensorCapture *self) {
+    self->_location = nullptr;
+    self->_infer_id = DEFAULT_INFER_ID;
+    self->_max_frames = DEFAULT_MAX_FRAMES;
+    new (&self->_writer) dxs::TensorRecordWriter();
+
+    // Only reads the buffer; never make it writable.
+    gst_base_transform_set_in_place(GST_BASE_TRANSFORM(self), TRUE);
+    gst_base_transform_set_passthrough(GST_BASE_TRANSFORM(self), TRUE);
+}
@@ -0,0 +1,27 @@
+#ifndef GST_DXTENSORCAPTURE_H
+#define GST_DXTENSORCAPTURE_H
+
+#include "dxtensor_io.hpp"
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_DXTENSORCAPTURE (gst_dxtensorcapture_get_type())
+G_DECLARE_FINAL_TYPE(GstDxTensorCapture, gst_dxtensorcapture, GST,
+                     DXTENSORCAPTURE, GstBaseTransform)
+
+struct _GstDxTensorCapture {
+    GstBaseTransform _parent_instance;
+
+    /** Properties */
+    gchar *_location;     /**< .dxtrec file written between start and stop */
+    gint _infer_id;       /**< _output_tensors key to capture */
+    guint64 _max_frames;  /**< stop capturing after this many, 0 = unlimited */
+
+    dxs::TensorRecordWriter _writer;
+};
+
+G_END_DECLS
+
+#endif // GST_DXTENSORCAPTURE_H
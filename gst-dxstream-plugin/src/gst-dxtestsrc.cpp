@@ -0,0 +1,665 @@
+#include "gst-dxtestsrc.hpp"
+#include "./../metadata/gst-dxframemeta.hpp"
+#include "./../metadata/gst-dxobjectmeta.hpp"
+#include <algorithm>
+#include <array>
+#include <new>
+#include <string>
+
+GST_DEBUG_CATEGORY_STATIC(gst_dxtestsrc_debug_category);
+#define GST_CAT_DEFAULT gst_dxtestsrc_debug_category
+
+#define DXTESTSRC_MAX_STREAMS 256
+#define DXTESTSRC_MAX_OBJECTS 1024
+#define DXTESTSRC_NUM_CLASSES 80
+
+#define DEFAULT_NUM_STREAMS 1
+#define DEFAULT_FIRST_STREAM_ID 0
+#define DEFAULT_WIDTH 1920
+#define DEFAULT_HEIGHT 1080
+#define DEFAULT_FORMAT GST_VIDEO_FORMAT_I420
+#define DEFAULT_FPS_N 30
+#define DEFAULT_FPS_D 1
+#define DEFAULT_IS_LIVE FALSE
+#define DEFAULT_NUM_OBJECTS 0
+#define DEFAULT_MOTION GstDxTestSrcMotion::LINEAR
+#define DEFAULT_TRACK_IDS FALSE
+#define DEFAULT_SEED 0
+#define DEFAULT_INFER_ID 0
+#define DEFAULT_LOOP FALSE
+
+enum class PropertyID {
+    PROP_0,
+    PROP_NUM_STREAMS,
+    PROP_FIRST_STREAM_ID,
+    PROP_WIDTH,
+    PROP_HEIGHT,
+    PROP_FORMAT,
+    PROP_FRAMERATE,
+    PROP_IS_LIVE,
+    PROP_NUM_OBJECTS,
+    PROP_MOTION,
+    PROP_TRACK_IDS,
+    PROP_SEED,
+    PROP_TENSOR_DIR,
+    PROP_INFER_ID,
+    PROP_TENSOR_FILE,
+    PROP_LOOP,
+    N_PROPERTIES
+};
+
+#define GST_TYPE_DXTESTSRC_MOTION (gst_dxtestsrc_motion_get_type())
+static GType gst_dxtestsrc_motion_get_type() {
+    static GType type = 0;
+    if (g_once_init_enter(&type)) {
+        static const GEnumValue values[] = {
+            {static_cast<int>(GstDxTestSrcMotion::STATIC), "static", "static"},
+            {static_cast<int>(GstDxTestSrcMotion::LINEAR), "linear", "linear"},
+            {static_cast<int>(GstDxTestSrcMotion::RANDOM_WALK), "random-walk",
+             "random-walk"},
+            {0, NULL, NULL}
+        };
+        GType tmp = g_enum_register_static("GstDxTestSrcMotion", values);
+        g_once_init_leave(&type, tmp);
+    }
+    return type;
+}
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE("{ I420, NV12, RGB, BGR }")));
+
+G_DEFINE_TYPE(GstDxTestSrc, gst_dxtestsrc, GST_TYPE_PUSH_SRC);
+
+static gboolean is_supported_format(GstVideoFormat format) {
+    return format == GST_VIDEO_FORMAT_I420 || format == GST_VIDEO_FORMAT_NV12 ||
+           format == GST_VIDEO_FORMAT_RGB || format == GST_VIDEO_FORMAT_BGR;
+}
+
+static void init_streams(GstDxTestSrc *self) {
+    self->_streams.clear();
+    self->_streams.resize(self->_num_streams);
+    auto fw = static_cast<float>(self->_width);
+    auto fh = static_cast<float>(self->_height);
+    float speed = self->_motion == GstDxTestSrcMotion::STATIC ? 0.0f : 4.0f;
+
+    for (guint s = 0; s < self->_num_streams; s++) {
+        GstDxTestSrcStream &stream = self->_streams[s];
+        stream.rng.seed(self->_seed + self->_first_stream_id + s);
+        std::uniform_real_distribution<float> size(0.02f, 0.15f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> velocity(-speed, speed);
+        std::uniform_real_distribution<float> confidence(0.5f, 1.0f);
+
+        for (guint i = 0; i < self->_num_objects; i++) {
+            GstDxTestSrcObject o;
+            o.w = size(stream.rng) * fw;
+            o.h = size(stream.rng) * fh;
+            o.x = unit(stream.rng) * (fw - o.w);
+            o.y = unit(stream.rng) * (fh - o.h);
+            o.vx = velocity(stream.rng);
+            o.vy = velocity(stream.rng);
+            o.label = static_cast<int>(stream.rng() % DXTESTSRC_NUM_CLASSES);
+            o.confidence = confidence(stream.rng);
+            stream.objects.push_back(o);
+        }
+    }
+}
+
+static void move_objects(GstDxTestSrc *self, GstDxTestSrcStream &stream) {
+    if (self->_motion == GstDxTestSrcMotion::STATIC)
+        return;
+    auto fw = static_cast<float>(self->_width);
+    auto fh = static_cast<float>(self->_height);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+    for (auto &o : stream.objects) {
+        if (self->_motion == GstDxTestSrcMotion::RANDOM_WALK) {
+            o.vx = CLAMP(o.vx + jitter(stream.rng), -8.0f, 8.0f);
+            o.vy = CLAMP(o.vy + jitter(stream.rng), -8.0f, 8.0f);
+        }
+        o.x += o.vx;
+        o.y += o.vy;
+        if (o.x < 0 || o.x + o.w > fw) {
+            o.vx = -o.vx;
+            o.x = CLAMP(o.x, 0.0f, fw - o.w);
+        }
+        if (o.y < 0 || o.y + o.h > fh) {
+            o.vy = -o.vy;
+            o.y = CLAMP(o.y, 0.0f, fh - o.h);
+        }
+    }
+}
+
+static void attach_objects(GstDxTestSrc *self, GstDxTestSrcStream &stream,
+                           DXFrameMeta *frame_meta) {
+    for (size_t i = 0; i < stream.objects.size(); i++) {
+        const GstDxTestSrcObject &o = stream.objects[i];
+        DXObjectMeta *obj_meta = dx_acquire_obj_meta_from_pool();
+        obj_meta->_box[0] = o.x;
+        obj_meta->_box[1] = o.y;
+        obj_meta->_box[2] = o.x + o.w;
+        obj_meta->_box[3] = o.y + o.h;
+        obj_meta->_label = o.label;
+        obj_meta->_label_name = "class_" + std::to_string(o.label);
+        obj_meta->_confidence = o.confidence;
+        if (self->_track_ids)
+            obj_meta->_track_id = static_cast<int>(i);
+        dx_add_obj_meta_to_frame(frame_meta, obj_meta);
+    }
+}
+
+static GstCaps *gst_dxtestsrc_get_caps(GstBaseSrc *src, GstCaps *filter) {
+    GstDxTestSrc *self = GST_DXTESTSRC(src);
+    GstCaps *caps = gst_caps_new_simple(
+        "video/x-raw", "format", G_TYPE_STRING,
+        gst_video_format_to_string(self->_format), "width", G_TYPE_INT,
+        self->_width, "height", G_TYPE_INT, self->_height, "framerate",
+        GST_TYPE_FRACTION, self->_fps_n, self->_fps_d, nullptr);
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(caps);
+        caps = tmp;
+    }
+    return caps;
+}
+
+static gboolean gst_dxtestsrc_set_caps(GstBaseSrc *src, GstCaps *caps) {
+    GstDxTestSrc *self = GST_DXTESTSRC(src);
+    if (!gst_video_info_from_caps(&self->_info, caps)) {
+        GST_ERROR_OBJECT(self, "Invalid caps %" GST_PTR_FORMAT, caps);
+        return FALSE;
+    }
+
+    // Every output buffer shares this memory; writers downstream get their
+    // own copy on map, as with any read-only upstream buffer.
+    gst_clear_buffer(&self->_frame);
+    self->_frame = gst_buffer_new_allocate(nullptr, GST_VIDEO_INFO_SIZE(&self->_info),
+                                           nullptr);
+    gst_buffer_memset(self->_frame, 0, 0x80, GST_VIDEO_INFO_SIZE(&self->_info));
+    return TRUE;
+}
+
+static GstFlowReturn replay_record(GstDxTestSrc *self, GstBuffer **outbuf) {
+    size_t count = self->_recording->size();
+    if (count == 0 || (!self->_loop && self->_record_index >= count))
+        return GST_FLOW_EOS;
+
+    dxs::TensorRecordFrame frame;
+    dxs::DXTensors tensors;
+    guint64 loop = self->_record_index / count;
+    // Downstream may have edited replayed tensors in the private mapping;
+    // every further loop starts from a fresh one.
+    if (loop > 0 && self->_record_index % count == 0) {
+        std::string error;
+        if (!self->_recording->open(self->_tensor_file, error) ||
+            self->_recording->size() != count) {
+            GST_ELEMENT_ERROR(self, RESOURCE, READ,
+                              ("Cannot reopen tensor recording '%s'", self->_tensor_file),
+                              ("%s", error.empty() ? "record count changed" : error.c_str()));
+            return GST_FLOW_ERROR;
+        }
+    }
+    if (!self->_recording->read(self->_record_index % count, frame, tensors)) {
+        GST_ELEMENT_ERROR(self, STREAM, DECODE,
+                          ("Corrupt record %" G_GUINT64_FORMAT " in '%s'",
+                           self->_record_index % count, self->_tensor_file),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    GstBuffer *buf = gst_buffer_copy(self->_frame);
+    GstClockTime duration =
+        gst_util_uint64_scale(1, self->_fps_d * GST_SECOND, self->_fps_n);
+    // Recorded timestamps are kept, rebased to 0 and shifted on every loop.
+    if (GST_CLOCK_TIME_IS_VALID(frame.pts) && GST_CLOCK_TIME_IS_VALID(self->_record_first) &&
+        frame.pts >= self->_record_first)
+        GST_BUFFER_PTS(buf) = frame.pts - self->_record_first + loop * self->_record_span;
+    else
+        GST_BUFFER_PTS(buf) = self->_record_index * duration;
+    GST_BUFFER_DURATION(buf) = duration;
+    GST_BUFFER_OFFSET(buf) = self->_record_index;
+
+    buf = dx_create_frame_meta(buf);
+    DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+    frame_meta->_stream_id = frame.stream_id;
+    frame_meta->_name = "video/x-raw";
+    frame_meta->_format = gst_video_format_to_string(self->_format);
+    // dxpostprocess scales boxes to the recorded frame size, not to the
+    // (placeholder) pixels of this buffer.
+    frame_meta->_width = frame.width > 0 ? frame.width : self->_width;
+    frame_meta->_height = frame.height > 0 ? frame.height : self->_height;
+    for (int i = 0; i < 4; i++)
+        frame_meta->_roi[i] = frame.roi[i];
+    frame_meta->_frame_rate = frame.frame_rate > 0
+                                  ? frame.frame_rate
+                                  : static_cast<float>(self->_fps_n) / self->_fps_d;
+    frame_meta->_output_tensors[frame.infer_id] = tensors;
+    self->_record_index++;
+
+    GST_LOG_OBJECT(self, "record %" G_GUINT64_FORMAT " stream %d pts %" GST_TIME_FORMAT,
+                   GST_BUFFER_OFFSET(buf), frame_meta->_stream_id,
+                   GST_TIME_ARGS(GST_BUFFER_PTS(buf)));
+    *outbuf = buf;
+    return GST_FLOW_OK;
+}
+
+static GstFlowReturn gst_dxtestsrc_create(GstPushSrc *src, GstBuffer **outbuf) {
+    GstDxTestSrc *self = GST_DXTESTSRC(src);
+    if (!self->_frame)
+        return GST_FLOW_NOT_NEGOTIATED;
+    if (self->_recording)
+        return replay_record(self, outbuf);
+
+    guint index = self->_next_stream;
+    GstBuffer *buf = gst_buffer_copy(self->_frame);
+    GST_BUFFER_PTS(buf) = gst_util_uint64_scale(
+        self->_frame_index, self->_fps_d * GST_SECOND, self->_fps_n);
+    GST_BUFFER_DURATION(buf) =
+        gst_util_uint64_scale(1, self->_fps_d * GST_SECOND, self->_fps_n);
+    GST_BUFFER_OFFSET(buf) = self->_frame_index;
+
+    buf = dx_create_frame_meta(buf);
+    DXFrameMeta *frame_meta = dx_get_frame_meta(buf);
+    frame_meta->_stream_id = self->_first_stream_id + static_cast<int>(index);
+    frame_meta->_name = "video/x-raw";
+    frame_meta->_format = gst_video_format_to_string(self->_format);
+    frame_meta->_width = self->_width;
+    frame_meta->_height = self->_height;
+    frame_meta->_frame_rate = static_cast<float>(self->_fps_n) / self->_fps_d;
+
+    GstDxTestSrcStream &stream = self->_streams[index];
+    if (self->_frame_index > 0)
+        move_objects(self, stream);
+    attach_objects(self, stream, frame_meta);
+    if (self->_has_tensors)
+        frame_meta->_output_tensors[self->_infer_id] = self->_tensors;
+
+    // Streams are interleaved frame by frame: all streams of frame n share
+    // its PTS and go out before frame n + 1.
+    if (++self->_next_stream >= self->_num_streams) {
+        self->_next_stream = 0;
+        self->_frame_index++;
+    }
+
+    GST_LOG_OBJECT(self, "stream %d frame %" G_GUINT64_FORMAT " pts %" GST_TIME_FORMAT,
+                   frame_meta->_stream_id, GST_BUFFER_OFFSET(buf),
+                   GST_TIME_ARGS(GST_BUFFER_PTS(buf)));
+    *outbuf = buf;
+    return GST_FLOW_OK;
+}
+
+static void gst_dxtestsrc_get_times(GstBaseSrc *src, GstBuffer *buffer,
+                                    GstClockTime *start, GstClockTime *end) {
+    // Only sync against the clock in live mode; otherwise run flat out.
+    if (gst_base_src_is_live(src)) {
+        GstClockTime timestamp = GST_BUFFER_PTS(buffer);
+        if (GST_CLOCK_TIME_IS_VALID(timestamp)) {
+            *start = timestamp;
+            if (GST_BUFFER_DURATION_IS_VALID(buffer))
+                *end = timestamp + GST_BUFFER_DURATION(buffer);
+        }
+    } else {
+        *start = GST_CLOCK_TIME_NONE;
+        *end = GST_CLOCK_TIME_NONE;
+    }
+}
+
+static void init_record_times(GstDxTestSrc *self, const dxs::TensorRecordReader &reader) {
+    self->_record_first = GST_CLOCK_TIME_NONE;
+    self->_record_span = 0;
+    dxs::TensorRecordFrame first, last;
+    dxs::DXTensors tensors;
+    if (reader.size() == 0 || !reader.read(0, first, tensors) ||
+        !reader.read(reader.size() - 1, last, tensors))
+        return;
+    if (!GST_CLOCK_TIME_IS_VALID(first.pts) || !GST_CLOCK_TIME_IS_VALID(last.pts) ||
+        last.pts < first.pts)
+        return;
+    self->_record_first = first.pts;
+    self->_record_span = last.pts - first.pts +
+                         gst_util_uint64_scale(1, self->_fps_d * GST_SECOND, self->_fps_n);
+}
+
+static gboolean gst_dxtestsrc_start(GstBaseSrc *src) {
+    GstDxTestSrc *self = GST_DXTESTSRC(src);
+    self->_frame_index = 0;
+    self->_next_stream = 0;
+    init_streams(self);
+
+    self->_has_tensors = FALSE;
+    self->_tensors = dxs::DXTensors();
+    if (self->_tensor_dir && *self->_tensor_dir) {
+        dxs::TensorManifest manifest;
+        std::string error;
+        if (!dxs::load_tensor_manifest(self->_tensor_dir, manifest, error)) {
+            GST_ELEMENT_ERROR(self, RESOURCE, NOT_FOUND,
+                              ("Cannot load recorded tensors from '%s'",
+                               self->_tensor_dir),
+                              ("%s", error.c_str()));
+            return FALSE;
+        }
+        self->_tensors = manifest.tensors;
+        self->_has_tensors = TRUE;
+        GST_INFO_OBJECT(self, "Attaching %zu recorded tensors as infer-id %d",
+                        self->_tensors._tensors.size(), self->_infer_id);
+    }
+
+    self->_recording.reset();
+    self->_record_index = 0;
+    if (self->_tensor_file && *self->_tensor_file) {
+        std::unique_ptr<dxs::TensorRecordReader> reader(new dxs::TensorRecordReader());
+        std::string error;
+        if (!reader->open(self->_tensor_file, error)) {
+            GST_ELEMENT_ERROR(self, RESOURCE, NOT_FOUND,
+                              ("Cannot open tensor recording '%s'", self->_tensor_file),
+                              ("%s", error.c_str()));
+            return FALSE;
+        }
+        init_record_times(self, *reader);
+        GST_INFO_OBJECT(self, "Replaying %zu records from %s%s", reader->size(),
+                        self->_tensor_file, self->_loop ? " in a loop" : "");
+        self->_recording = std::move(reader);
+        return TRUE;
+    }
+
+    GST_INFO_OBJECT(self, "%u streams from id %d, %dx%d %s, %u objects per frame",
+                    self->_num_streams, self->_first_stream_id, self->_width,
+                    self->_height, gst_video_format_to_string(self->_format),
+                    self->_num_objects);
+    return TRUE;
+}
+
+static gboolean gst_dxtestsrc_stop(GstBaseSrc *src) {
+    GstDxTestSrc *self = GST_DXTESTSRC(src);
+    gst_clear_buffer(&self->_frame);
+    self->_streams.clear();
+    self->_tensors = dxs::DXTensors();
+    self->_has_tensors = FALSE;
+    self->_recording.reset();
+    return TRUE;
+}
+
+static void gst_dxtestsrc_set_property(GObject *object, guint property_id,
+                                       const GValue *value, GParamSpec *pspec) {
+    GstDxTestSrc *self = GST_DXTESTSRC(object);
+
+    switch (property_id) {
+    case static_cast<guint>(PropertyID::PROP_NUM_STREAMS):
+        self->_num_streams = g_value_get_uint(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_FIRST_STREAM_ID):
+        self->_first_stream_id = g_value_get_int(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_WIDTH):
+        self->_width = g_value_get_int(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_HEIGHT):
+        self->_height = g_value_get_int(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_FORMAT): {
+        auto format = static_cast<GstVideoFormat>(g_value_get_enum(value));
+        if (is_supported_format(format))
+            self->_format = format;
+        else
+            GST_WARNING_OBJECT(self, "Unsupported format %s, keeping %s",
+                               gst_video_format_to_string(format),
+                               gst_video_format_to_string(self->_format));
+        break;
+    }
+    case static_cast<guint>(PropertyID::PROP_FRAMERATE):
+        self->_fps_n = gst_value_get_fraction_numerator(value);
+        self->_fps_d = gst_value_get_fraction_denominator(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_IS_LIVE):
+        self->_is_live = g_value_get_boolean(value);
+        gst_base_src_set_live(GST_BASE_SRC(self), self->_is_live);
+        break;
+    case static_cast<guint>(PropertyID::PROP_NUM_OBJECTS):
+        self->_num_objects = g_value_get_uint(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_MOTION):
+        self->_motion = static_cast<GstDxTestSrcMotion>(g_value_get_enum(value));
+        break;
+    case static_cast<guint>(PropertyID::PROP_TRACK_IDS):
+        self->_track_ids = g_value_get_boolean(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_SEED):
+        self->_seed = g_value_get_uint(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_TENSOR_DIR):
+        g_free(self->_tensor_dir);
+        self->_tensor_dir = g_value_dup_string(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_INFER_ID):
+        self->_infer_id = g_value_get_int(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_TENSOR_FILE):
+        g_free(self->_tensor_file);
+        self->_tensor_file = g_value_dup_string(value);
+        break;
+    case static_cast<guint>(PropertyID::PROP_LOOP):
+        self->_loop = g_value_get_boolean(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxtestsrc_get_property(GObject *object, guint property_id,
+                                       GValue *value, GParamSpec *pspec) {
+    GstDxTestSrc *self = GST_DXTESTSRC(object);
+
+    switch (property_id) {
+    case static_cast<guint>(PropertyID::PROP_NUM_STREAMS):
+        g_value_set_uint(value, self->_num_streams);
+        break;
+    case static_cast<guint>(PropertyID::PROP_FIRST_STREAM_ID):
+        g_value_set_int(value, self->_first_stream_id);
+        break;
+    case static_cast<guint>(PropertyID::PROP_WIDTH):
+        g_value_set_int(value, self->_width);
+        break;
+    case static_cast<guint>(PropertyID::PROP_HEIGHT):
+        g_value_set_int(value, self->_height);
+        break;
+    case static_cast<guint>(PropertyID::PROP_FORMAT):
+        g_value_set_enum(value, self->_format);
+        break;
+    case static_cast<guint>(PropertyID::PROP_FRAMERATE):
+        gst_value_set_fraction(value, self->_fps_n, self->_fps_d);
+        break;
+    case static_cast<guint>(PropertyID::PROP_IS_LIVE):
+        g_value_set_boolean(value, self->_is_live);
+        break;
+    case static_cast<guint>(PropertyID::PROP_NUM_OBJECTS):
+        g_value_set_uint(value, self->_num_objects);
+        break;
+    case static_cast<guint>(PropertyID::PROP_MOTION):
+        g_value_set_enum(value, static_cast<gint>(self->_motion));
+        break;
+    case static_cast<guint>(PropertyID::PROP_TRACK_IDS):
+        g_value_set_boolean(value, self->_track_ids);
+        break;
+    case static_cast<guint>(PropertyID::PROP_SEED):
+        g_value_set_uint(value, self->_seed);
+        break;
+    case static_cast<guint>(PropertyID::PROP_TENSOR_DIR):
+        g_value_set_string(value, self->_tensor_dir);
+        break;
+    case static_cast<guint>(PropertyID::PROP_INFER_ID):
+        g_value_set_int(value, self->_infer_id);
+        break;
+    case static_cast<guint>(PropertyID::PROP_TENSOR_FILE):
+        g_value_set_string(value, self->_tensor_file);
+        break;
+    case static_cast<guint>(PropertyID::PROP_LOOP):
+        g_value_set_boolean(value, self->_loop);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        break;
+    }
+}
+
+static void gst_dxtestsrc_finalize(GObject *object) {
+    GstDxTestSrc *self = GST_DXTESTSRC(object);
+    gst_clear_buffer(&self->_frame);
+    g_free(self->_tensor_dir);
+    g_free(self->_tensor_file);
+
+    // NOSONAR - members were constructed with placement new in _init
+    using StreamVector = std::vector<GstDxTestSrcStream>;
+    self->_streams.~StreamVector(); // NOSONAR
+    self->_tensors.~DXTensors(); // NOSONAR
+    using RecordingPtr = std::unique_ptr<dxs::TensorRecordReader>;
+    self->_recording.~RecordingPtr(); // NOSONAR
+    G_OBJECT_CLASS(gst_dxtestsrc_parent_class)->finalize(object);
+}
+
+static void gst_dxtestsrc_class_init(GstDxTestSrcClass *klass) {
+    GST_DEBUG_CATEGORY_INIT(gst_dxtestsrc_debug_category, "dxtestsrc", 0,
+                            "DXTestSrc plugin");
+
+    auto *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->set_property = gst_dxtestsrc_set_property;
+    gobject_class->get_property = gst_dxtestsrc_get_property;
+    gobject_class->finalize = gst_dxtestsrc_finalize;
+
+    static std::array<GParamSpec *, static_cast<int>(PropertyID::N_PROPERTIES)>
+        obj_properties = {
+            nullptr,
+        };
+    auto flags = static_cast<GParamFlags>(G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_NUM_STREAMS)] = g_param_spec_uint(
+        "num-streams", "Number of Streams",
+        "Number of streams interleaved frame by frame on the src pad, each "
+        "with its own DXFrameMeta stream_id",
+        1, DXTESTSRC_MAX_STREAMS, DEFAULT_NUM_STREAMS, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_FIRST_STREAM_ID)] = g_param_spec_int(
+        "first-stream-id", "First Stream ID",
+        "stream_id of the first stream; the others follow consecutively",
+        0, G_MAXINT, DEFAULT_FIRST_STREAM_ID, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_WIDTH)] = g_param_spec_int(
+        "width", "Width", "Frame width", 16, 16384, DEFAULT_WIDTH, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_HEIGHT)] = g_param_spec_int(
+        "height", "Height", "Frame height", 16, 16384, DEFAULT_HEIGHT, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_FORMAT)] = g_param_spec_enum(
+        "format", "Format", "Pixel format (I420, NV12, RGB or BGR)",
+        GST_TYPE_VIDEO_FORMAT, DEFAULT_FORMAT, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_FRAMERATE)] = gst_param_spec_fraction(
+        "framerate", "Framerate",
+        "Frames per second of each stream (timestamps; paces output only "
+        "when is-live)",
+        1, 1, G_MAXINT, 1, DEFAULT_FPS_N, DEFAULT_FPS_D, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_IS_LIVE)] = g_param_spec_boolean(
+        "is-live", "Is Live",
+        "Act as a live source and emit frames in real time",
+        DEFAULT_IS_LIVE, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_NUM_OBJECTS)] = g_param_spec_uint(
+        "num-objects", "Number of Objects",
+        "Synthetic detections (DXObjectMeta) attached to every frame",
+        0, DXTESTSRC_MAX_OBJECTS, DEFAULT_NUM_OBJECTS, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_MOTION)] = g_param_spec_enum(
+        "motion", "Motion", "How synthetic detections move between frames",
+        GST_TYPE_DXTESTSRC_MOTION, static_cast<gint>(DEFAULT_MOTION), flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_TRACK_IDS)] = g_param_spec_boolean(
+        "track-ids", "Track IDs",
+        "Give synthetic detections stable ground-truth track ids instead of "
+        "leaving them to dxtracker",
+        DEFAULT_TRACK_IDS, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_SEED)] = g_param_spec_uint(
+        "seed", "Seed", "Seed of the detection generator (per stream: seed + stream_id)",
+        0, G_MAXUINT, DEFAULT_SEED, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_TENSOR_DIR)] = g_param_spec_string(
+        "tensor-dir", "Tensor Directory",
+        "Recorded tensor set (directory with manifest.json) attached to every "
+        "frame as output tensors, for running dxpostprocess without an NPU",
+        nullptr, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_INFER_ID)] = g_param_spec_int(
+        "infer-id", "Inference ID",
+        "Key of the recorded tensors in _output_tensors (match the "
+        "dxpostprocess inference-id)",
+        0, G_MAXINT, DEFAULT_INFER_ID, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_TENSOR_FILE)] = g_param_spec_string(
+        "tensor-file", "Tensor File",
+        "Tensor recording (.dxtrec, see dxtensorcapture) replayed one record "
+        "per buffer with its stream_id, timestamp and infer-id; replaces the "
+        "synthetic streams",
+        nullptr, flags);
+
+    obj_properties[static_cast<guint>(PropertyID::PROP_LOOP)] = g_param_spec_boolean(
+        "loop", "Loop", "Restart tensor-file at its end instead of sending EOS",
+        DEFAULT_LOOP, flags);
+
+    g_object_class_install_properties(gobject_class,
+                                      static_cast<guint>(PropertyID::N_PROPERTIES),
+                                      obj_properties.data());
+
+    auto *element_class = GST_ELEMENT_CLASS(klass);
+    gst_element_class_set_static_metadata(
+        element_class, "DXTestSrc", "Source/Video",
+        "Emits synthetic multi-stream frames carrying DXFrameMeta, optional "
+        "detections and recorded tensors",
+        "Sangil Jo <sijo@deepx.ai>");
+    gst_element_class_add_static_pad_template(element_class, &src_template);
+
+    auto *base_src_class = GST_BASE_SRC_CLASS(klass);
+    base_src_class->get_caps = GST_DEBUG_FUNCPTR(gst_dxtestsrc_get_caps);
+    base_src_class->set_caps = GST_DEBUG_FUNCPTR(gst_dxtestsrc_set_caps);
+    base_src_class->get_times = GST_DEBUG_FUNCPTR(gst_dxtestsrc_get_times);
+    base_src_class->start = GST_DEBUG_FUNCPTR(gst_dxtestsrc_start);
+    base_src_class->stop = GST_DEBUG_FUNCPTR(gst_dxtestsrc_stop);
+
+    auto *push_src_class = GST_PUSH_SRC_CLASS(klass);
+    push_src_class->create = GST_DEBUG_FUNCPTR(gst_dxtestsrc_create);
+}
+
+static void gst_dxtestsrc_init(GstDxTestSrc *self) {
+    self->_num_streams = DEFAULT_NUM_STREAMS;
+    self->_first_stream_id = DEFAULT_FIRST_STREAM_ID;
+    self->_width = DEFAULT_WIDTH;
+    self->_height = DEFAULT_HEIGHT;
+    self->_format = DEFAULT_FORMAT;
+    self->_fps_n = DEFAULT_FPS_N;
+    self->_fps_d = DEFAULT_FPS_D;
+    self->_is_live = DEFAULT_IS_LIVE;
+    self->_num_objects = DEFAULT_NUM_OBJECTS;
+    self->_motion = DEFAULT_MOTION;
+    self->_track_ids = DEFAULT_TRACK_IDS;
+    self->_seed = DEFAULT_SEED;
+    self->_tensor_dir = nullptr;
+    self->_infer_id = DEFAULT_INFER_ID;
+    self->_tensor_file = nullptr;
+    self->_loop = DEFAULT_LOOP;
+
+    gst_video_info_init(&self->_info);
+    self->_frame = nullptr;
+    self->_frame_index = 0;
+    self->_next_stream = 0;
+    new (&self->_streams) std::vector<GstDxTestSrcStream>();
+    new (&self->_tensors) dxs::DXTensors();
+    self->_has_tensors = FALSE;
+    new (&self->_recording) std::unique_ptr<dxs::TensorRecordReader>();
+    self->_record_index = 0;
+    self->_record_first = GST_CLOCK_TIME_NONE;
+    self->_record_span = 0;
+
+    gst_base_src_set_format(GST_BASE_SRC(self), GST_FORMAT_TIME);
+    gst_base_src_set_live(GST_BASE_SRC(self), DEFAULT_IS_LIVE);
+}
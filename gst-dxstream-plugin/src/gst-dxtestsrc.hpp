@@ -0,0 +1,75 @@
+#ifndef GST_DXTESTSRC_H
+#define GST_DXTESTSRC_H
+
+#include "dxcommon.hpp"
+#include "dxtensor_io.hpp"
+#include <gst/base/gstpushsrc.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+G_BEGIN_DECLS
+
+/** How synthetic detections move between frames. */
+enum class GstDxTestSrcMotion {
+    STATIC = 0,     /**< boxes never move */
+    LINEAR = 1,     /**< constant velocity, bouncing off the frame edges */
+    RANDOM_WALK = 2 /**< velocity jitters every frame, bouncing off edges */
+};
+
+struct GstDxTestSrcObject {
+    float x, y, w, h;  /**< top-left corner and size in pixels */
+    float vx, vy;      /**< pixels per frame */
+    int label;
+    float confidence;
+};
+
+/** Synthetic state of one emitted stream. */
+struct GstDxTestSrcStream {
+    std::vector<GstDxTestSrcObject> objects;
+    std::mt19937 rng;
+};
+
+#define GST_TYPE_DXTESTSRC (gst_dxtestsrc_get_type())
+G_DECLARE_FINAL_TYPE(GstDxTestSrc, gst_dxtestsrc, GST, DXTESTSRC, GstPushSrc)
+
+struct _GstDxTestSrc {
+    GstPushSrc parent_instance;
+
+    /** Properties */
+    guint _num_streams;
+    gint _first_stream_id;
+    gint _width;
+    gint _height;
+    GstVideoFormat _format;
+    gint _fps_n;
+    gint _fps_d;
+    gboolean _is_live;
+    guint _num_objects;
+    GstDxTestSrcMotion _motion;
+    gboolean _track_ids;   /**< give objects ground-truth track ids */
+    guint _seed;
+    gchar *_tensor_dir;    /**< recorded tensor set attached to every frame */
+    gint _infer_id;        /**< _output_tensors key for the recorded tensors */
+    gchar *_tensor_file;   /**< .dxtrec recording replayed record by record */
+    gboolean _loop;        /**< restart the recording instead of EOS */
+
+    /** Streaming state (set up in start) */
+    GstVideoInfo _info;
+    GstBuffer *_frame;     /**< pixel data shared by every output buffer */
+    guint64 _frame_index;  /**< frames emitted per stream so far */
+    guint _next_stream;    /**< index of the stream emitted next */
+    std::vector<GstDxTestSrcStream> _streams;
+    dxs::DXTensors _tensors;
+    gboolean _has_tensors;
+    std::unique_ptr<dxs::TensorRecordReader> _recording;
+    guint64 _record_index;      /**< records replayed so far, over all loops */
+    GstClockTime _record_first; /**< PTS of record 0 */
+    GstClockTime _record_span;  /**< PTS shift per loop */
+};
+
+G_END_DECLS
+
+#endif // GST_DXTESTSRC_H
@@ -29,6 +29,11 @@ static bool version_less_than(const std::string& v1, const std::string& v2) {
 
 DxrtBackend::~DxrtBackend() {
     Flush();
+    if (completion_order_ && ie_) {
+        // Callbacks touch members; let them finish before members go away.
+        wait_device_idle();
+    }
+    ie_.reset();
 }
 
 bool DxrtBackend::Init(const InferBackendOptions& options) {
@@ -65,11 +70,23 @@ bool DxrtBackend::Init(const InferBackendOptions& options) {
     }
 
     output_size_ = ie_->GetOutputSize();
+    input_size_ = ie_->GetInputSize();
+    auto inputs = ie_->GetInputs();
+    if (!inputs.empty() && !inputs.front().shape().empty() && inputs.front().shape()[0] > 0) {
+        batch_size_ = static_cast<size_t>(inputs.front().shape()[0]);
+    }
     size_t device_count = dxrt::DevicePool::GetInstance().GetDeviceCount();
     max_pending_ = device_count * 5;
 
-    GST_INFO("DxrtBackend: initialized (DXRT %s, %zu devices, max_pending=%zu)",
-             version.c_str(), device_count, max_pending_);
+    completion_order_ = options.completion_order;
+    if (completion_order_) {
+        ie_->RegisterCallback([this](dxrt::TensorPtrs& outputs, void* user_arg) {
+            return on_complete(outputs, user_arg);
+        });
+    }
+
+    GST_INFO("DxrtBackend: initialized (DXRT %s, %zu devices, max_pending=%zu, completion_order=%d)",
+             version.c_str(), device_count, max_pending_, completion_order_);
     return true;
 }
 
@@ -116,6 +133,63 @@ bool DxrtBackend::Get(dxs::DXTensors& output) {
     return true;
 }
 
+bool DxrtBackend::PutTagged(void* input_ptr, void* output_ptr, void* tag) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] {
+        return flushed_ || inflight_ < max_pending_;
+    });
+    if (flushed_) return false;
+
+    // Count before RunAsync: the callback may fire before it returns.
+    inflight_++;
+    device_inflight_++;
+    put_count_++;
+    int req_id = ie_->RunAsync(input_ptr, tag, output_ptr);
+    GST_TRACE("PutTagged req_id=%d (inflight=%zu, total_put=%zu)", req_id, inflight_, put_count_);
+    return true;
+}
+
+int DxrtBackend::on_complete(dxrt::TensorPtrs& outputs, void* user_arg) {
+    CompletedEntry entry;
+    entry.tag = user_arg;
+    convert_tensor(outputs, entry.output);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.push_back(std::move(entry));
+    device_inflight_--;
+    cv_.notify_all();
+    return 0;
+}
+
+bool DxrtBackend::GetCompleted(dxs::DXTensors& output, void** tag) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] {
+        return flushed_ || !completed_.empty();
+    });
+    if (flushed_) return false;
+
+    auto& front = completed_.front();
+    *tag = front.tag;
+    for (auto& t : front.output._tensors)
+        output._tensors.push_back(t);
+    completed_.pop_front();
+    inflight_--;
+    get_count_++;
+    GST_TRACE("GetCompleted (inflight=%zu, total_put=%zu, total_get=%zu)",
+              inflight_, put_count_, get_count_);
+    cv_.notify_all();
+    return true;
+}
+
+void DxrtBackend::wait_device_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cv_.wait_for(lock, std::chrono::seconds(5),
+                      [this] { return device_inflight_ == 0; })) {
+        GST_WARNING("DxrtBackend: %zu requests still running on device after 5s",
+                    device_inflight_);
+    }
+}
+
 void DxrtBackend::Flush() {
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -125,6 +199,17 @@ void DxrtBackend::Flush() {
 }
 
 void DxrtBackend::Reset() {
+    if (completion_order_) {
+        wait_device_idle();
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_.clear();
+        inflight_ = 0;
+        flushed_ = false;
+        put_count_ = 0;
+        get_count_ = 0;
+        return;
+    }
+
     std::queue<PendingEntry> to_drain;
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -146,6 +231,10 @@ size_t DxrtBackend::GetOutputBufferSize() const {
     return output_size_;
 }
 
+size_t DxrtBackend::GetInputBufferSize() const {
+    return input_size_;
+}
+
 void DxrtBackend::convert_tensor(const dxrt::TensorPtrs& src, dxs::DXTensors& output) {
     for (size_t i = 0; i < src.size(); i++) {
         dxs::DXTensor t;
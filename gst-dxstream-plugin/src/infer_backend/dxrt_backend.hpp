@@ -6,6 +6,7 @@
 #include <condition_variable>
 #include <dxrt/dxrt_api.h>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -21,11 +22,19 @@ public:
     void Flush() override;
     void Reset() override;
     size_t GetOutputBufferSize() const override;
+    size_t GetInputBufferSize() const override;
+    size_t GetModelBatchSize() const override { return batch_size_; }
     const char* GetName() const override { return "dxrt"; }
     bool IsFlushed() const override { return flushed_; }
 
+    bool CompletionOrderEnabled() const override { return completion_order_; }
+    bool PutTagged(void* input_ptr, void* output_ptr, void* tag) override;
+    bool GetCompleted(dxs::DXTensors& output, void** tag) override;
+
 private:
     static void convert_tensor(const dxrt::TensorPtrs& src, dxs::DXTensors& output);
+    int on_complete(dxrt::TensorPtrs& outputs, void* user_arg);
+    void wait_device_idle();
 
     struct PendingEntry {
         int req_id;
@@ -35,6 +44,8 @@ private:
 
     std::shared_ptr<dxrt::InferenceEngine> ie_;
     size_t output_size_ = 0;
+    size_t input_size_ = 0;
+    size_t batch_size_ = 1;
     size_t max_pending_ = 10;
 
     std::queue<PendingEntry> pending_entries_;
@@ -43,4 +54,14 @@ private:
     std::atomic<bool> flushed_{false};
     size_t put_count_ = 0;
     size_t get_count_ = 0;
+
+    // Completion-order mode: results are delivered by the DXRT callback.
+    struct CompletedEntry {
+        void* tag;
+        dxs::DXTensors output;
+    };
+    bool completion_order_ = false;
+    std::deque<CompletedEntry> completed_;
+    size_t inflight_ = 0;         // submitted, not yet collected by GetCompleted
+    size_t device_inflight_ = 0;  // submitted, callback not yet fired
 };
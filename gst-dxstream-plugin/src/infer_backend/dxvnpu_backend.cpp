@@ -216,3 +216,7 @@ void DxvnpuBackend::Reset() {
 size_t DxvnpuBackend::GetOutputBufferSize() const {
     return output_size_;
 }
+
+size_t DxvnpuBackend::GetInputBufferSize() const {
+    return input_size_;
+}
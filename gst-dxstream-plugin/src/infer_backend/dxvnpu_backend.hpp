@@ -21,6 +21,7 @@ public:
     void Flush() override;
     void Reset() override;
     size_t GetOutputBufferSize() const override;
+    size_t GetInputBufferSize() const override;
     const char* GetName() const override { return "dxvnpu"; }
     bool IsFlushed() const override { return flushed_.load(); }
 
@@ -8,6 +8,7 @@ struct InferBackendOptions {
     std::string model_path;
     bool use_ort = true;
     int device_id = -1;  // -1: use all devices, >=0: specific device
+    bool completion_order = false;  // request PutTagged/GetCompleted mode
 };
 
 class IInferBackend {
@@ -39,9 +40,36 @@ public:
     // Output buffer size in bytes (for pre-allocation before Put).
     virtual size_t GetOutputBufferSize() const = 0;
 
+    // Input buffer size in bytes expected by Put() (whole model input,
+    // including the batch dimension for batch-compiled models).
+    virtual size_t GetInputBufferSize() const = 0;
+
     // Backend name for logging ("dxrt", "dxvnpu").
     virtual const char* GetName() const = 0;
 
     // Check if backend is in flushed state.
     virtual bool IsFlushed() const = 0;
+
+    // Leading (batch) dimension of the model input. Batch-compiled models
+    // take GetModelBatchSize() frames per Put().
+    virtual size_t GetModelBatchSize() const { return 1; }
+
+    // ---- Optional completion-order mode (InferBackendOptions::completion_order) ----
+    // True if Init() enabled completion-order collection. When enabled, use
+    // PutTagged/GetCompleted instead of Put/Get.
+    virtual bool CompletionOrderEnabled() const { return false; }
+
+    // Like Put(), but `tag` is returned by GetCompleted() for this request.
+    virtual bool PutTagged(void* input_ptr, void* output_ptr, void* tag) {
+        (void)input_ptr; (void)output_ptr; (void)tag;
+        return false;
+    }
+
+    // Block until any submitted request completes (not necessarily the
+    // oldest), fill output tensor metadata and return its tag.
+    // Safe to call from several threads. Returns false if flushed.
+    virtual bool GetCompleted(dxs::DXTensors& output, void** tag) {
+        (void)output; (void)tag;
+        return false;
+    }
 };
@@ -0,0 +1,215 @@
+// dxinfer dynamic batching tests
+// Core: batch-size > 1 is only honoured when the model input holds exactly
+// batch-size frames; otherwise dxinfer falls back to one frame per request.
+// Either way every frame must reach downstream before EOS.
+//
+// Packing the batch input, splitting the batch output into per-frame views
+// and the partial-batch timeout are plain functions, tested here without an
+// NPU on hand-built batches.
+//
+// ⚠️ Implementation-coupled: BAT_fallback_on_single_frame_model inspects the
+// private _batch_ctx to tell whether batching was activated.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include "gst-dxinfer.hpp"
+#include "harness_helpers.hpp"
+#include "meta_helpers.hpp"
+#include "npu_env.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+using namespace dxtest;
+
+static std::string resolve_test_model() {
+    std::string p = resolve_model_path("yolov5-s_640x640_ppu.dxnn");
+    if (p.empty()) p = resolve_model_path("YOLOV5S_1.dxnn");
+    return p;
+}
+
+GST_START_TEST(BAT_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    fail_unless(e != nullptr);
+
+    guint batch = 0, timeout = 0;
+    g_object_get(e, "batch-size", &batch, "batch-timeout", &timeout, nullptr);
+    fail_unless_equals_int(batch, 1);
+    fail_unless_equals_int(timeout, 2000);
+
+    g_object_set(e, "batch-size", 8u, "batch-timeout", 500u, nullptr);
+    g_object_get(e, "batch-size", &batch, "batch-timeout", &timeout, nullptr);
+    fail_unless_equals_int(batch, 8);
+    fail_unless_equals_int(timeout, 500);
+
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+static const guint PREPROC_ID = 1;
+static const guint INFER_ID = 2;
+
+// A frame whose input tensor PREPROC_ID is `slot` bytes of `fill`.
+static GstBuffer *make_batch_frame(int stream_id, size_t slot, guint8 fill) {
+    GstBuffer *buf = gst_buffer_new();
+    DXFrameMeta *fm = make_frame_meta(buf, stream_id, 4, 4);
+    dxs::DXTensors &input = fm->_input_tensors[PREPROC_ID];
+    input.allocate(slot);
+    memset(input.data_ptr(), fill, slot);
+    return buf;
+}
+
+static void free_batch_frames(GstDxInferBatch &batch) {
+    for (GstBuffer *frame : batch.frames)
+        gst_buffer_unref(frame);
+    batch.frames.clear();
+}
+
+// BAT_split_output_views: with batch-size 4 and 3 frames, each frame gets
+// its own slice of a [4, 2] float tensor (leading dimension 1, physical
+// address offset alike), while a [1, 3] tensor is shared unsplit. Every view
+// keeps the whole output buffer: same _data, same _mem_size.
+GST_START_TEST(BAT_split_output_views) {
+    const guint batch_size = 4;
+    GstDxInferBatch batch;
+    for (int i = 0; i < 3; i++)
+        batch.frames.push_back(make_batch_frame(i, 16, 0));
+
+    const size_t a_bytes = batch_size * 2 * sizeof(float);
+    const size_t b_bytes = 3 * sizeof(float);
+    batch.output.allocate(a_bytes + b_bytes);
+    auto *base = static_cast<uint8_t *>(batch.output.data_ptr());
+
+    dxs::DXTensor a;
+    a._name = "a";
+    a._shape = {batch_size, 2};
+    a._elemSize = sizeof(float);
+    a._type = dxs::DataType::FLOAT;
+    a._data = base;
+    a._phyAddr = 0x1000;
+    dxs::DXTensor b = a;
+    b._name = "b";
+    b._shape = {1, 3};
+    b._data = base + a_bytes;
+    b._phyAddr = 0x1000 + a_bytes;
+    batch.output._tensors = {a, b};
+
+    gst_dxinfer_batch_split_output(batch, batch_size, INFER_ID);
+
+    const size_t stride = 2 * sizeof(float);
+    for (size_t i = 0; i < batch.frames.size(); i++) {
+        DXFrameMeta *fm = dx_get_frame_meta(batch.frames[i]);
+        fail_unless(fm->_output_tensors.count(INFER_ID) == 1);
+        const dxs::DXTensors &view = fm->_output_tensors[INFER_ID];
+        fail_unless(view.data_ptr() == base);
+        fail_unless_equals_int(view._mem_size, batch.output._mem_size);
+        fail_unless_equals_int((int)view._tensors.size(), 2);
+
+        const dxs::DXTensor &sa = view._tensors[0];
+        fail_unless_equals_int((int)sa._shape[0], 1);
+        fail_unless_equals_int((int)sa._shape[1], 2);
+        fail_unless(sa._data == base + i * stride, "frame %zu: wrong slice", i);
+        fail_unless_equals_uint64(sa._phyAddr, 0x1000 + i * stride);
+
+        const dxs::DXTensor &sb = view._tensors[1];
+        fail_unless_equals_int((int)sb._shape[0], 1);
+        fail_unless_equals_int((int)sb._shape[1], 3);
+        fail_unless(sb._data == base + a_bytes, "frame %zu: [1, 3] tensor split", i);
+        fail_unless_equals_uint64(sb._phyAddr, 0x1000 + a_bytes);
+    }
+    free_batch_frames(batch);
+}
+GST_END_TEST;
+
+// BAT_partial_batch_timeout_padding: a batch of 2 out of 4 frames is only
+// due once its first frame has waited batch-timeout; it is then packed with
+// the two frames in order and the unused slots zeroed.
+GST_START_TEST(BAT_partial_batch_timeout_padding) {
+    GstDxInferBatchContext ctx;
+    ctx.batch_size = 4;
+    ctx.timeout_us = 1000;
+    ctx.frame_input_size = 8;
+    auto t0 = std::chrono::steady_clock::now();
+    ctx.first_arrival = t0;
+    fail_if(gst_dxinfer_batch_timed_out(ctx, t0 + std::chrono::seconds(1)),
+            "an empty batch is never due");
+
+    ctx.pending.push_back(make_batch_frame(0, ctx.frame_input_size, 0x11));
+    ctx.pending.push_back(make_batch_frame(1, ctx.frame_input_size, 0x22));
+    fail_if(gst_dxinfer_batch_timed_out(ctx, t0 + std::chrono::microseconds(999)));
+    fail_unless(gst_dxinfer_batch_timed_out(ctx, t0 + std::chrono::microseconds(1000)));
+
+    GstDxInferBatch batch;
+    std::swap(batch.frames, ctx.pending);
+    gst_dxinfer_batch_pack_input(batch, ctx.frame_input_size, ctx.batch_size, PREPROC_ID);
+
+    fail_unless_equals_int(batch.input._mem_size, 4 * 8);
+    const auto *in = static_cast<const uint8_t *>(batch.input.data_ptr());
+    for (size_t i = 0; i < 4 * 8; i++) {
+        guint8 expected = i < 8 ? 0x11 : i < 16 ? 0x22 : 0;
+        fail_unless_equals_int(in[i], expected);
+    }
+    free_batch_frames(batch);
+}
+GST_END_TEST;
+
+// BAT_fallback_on_single_frame_model: the sample models are compiled with
+// batch 1, so batch-size=4 must be rejected at NULL->READY (batching stays
+// inactive) and the pipeline must still run to EOS with all frames.
+GST_START_TEST(BAT_fallback_on_single_frame_model) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    GError *err = nullptr;
+    gchar *launch = g_strdup_printf(
+        "videotestsrc num-buffers=8 "
+        "! video/x-raw,format=RGB,width=640,height=640,framerate=30/1 "
+        "! dxpreprocess resize-width=640 resize-height=640 "
+        "! dxinfer name=infer model-path=%s backend=dxrt batch-size=4 "
+        "! fakesink name=sink sync=false signal-handoffs=true",
+        model.c_str());
+    GstElement *pipe = gst_parse_launch(launch, &err);
+    g_free(launch);
+    fail_unless(err == nullptr && pipe != nullptr);
+
+    GstElement *infer = gst_bin_get_by_name(GST_BIN(pipe), "infer");
+    GstElement *sink = gst_bin_get_by_name(GST_BIN(pipe), "sink");
+    gint handoffs = 0;
+    g_signal_connect(sink, "handoff",
+                     G_CALLBACK(+[](GstElement *, GstBuffer *, GstPad *, gpointer d) {
+                         g_atomic_int_inc((gint *)d);
+                     }),
+                     &handoffs);
+
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipe));
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    GstMessage *msg = gst_bus_timed_pop_filtered(bus, 30 * GST_SECOND,
+        (GstMessageType)(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+    fail_unless(msg != nullptr, "timeout waiting for EOS");
+    fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_EOS);
+    fail_unless_equals_int(g_atomic_int_get(&handoffs), 8);
+    fail_unless_equals_int((int)((GstDxInfer *)infer)->_batch_ctx.frame_input_size, 0);
+
+    gst_message_unref(msg);
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(infer);
+    gst_object_unref(sink);
+    gst_object_unref(bus);
+    gst_object_unref(pipe);
+}
+GST_END_TEST;
+
+static Suite *dxinfer_batching_suite(void) {
+    Suite *s = suite_create("dxinfer_batching");
+    TCase *tc = tcase_create("batching");
+    tcase_set_timeout(tc, 60.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, BAT_property_defaults_and_set);
+    tcase_add_test(tc, BAT_split_output_views);
+    tcase_add_test(tc, BAT_partial_batch_timeout_padding);
+    tcase_add_test(tc, BAT_fallback_on_single_frame_model);
+    return s;
+}
+
+GST_CHECK_MAIN(dxinfer_batching);
@@ -102,9 +102,8 @@ static GstBuffer *make_infer_buffer(GstClockTime pts) {
 // CE_infer_flush_stop_resets_eos_state
 // Target: gst_dxinfer_sink_event FLUSH_STOP L485-494
 //   - backend->Reset() called
-//   - stream_eos_arrived.clear()
-//   - stream_pending_buffers.clear()
-// MUT: remove L490-493 → after flush, stream still appears as EOS'd → buffers dropped
+//   - reset_stream_slots() (per-stream eos_arrived / pending_buffers)
+// MUT: remove reset_stream_slots() → after flush, stream still appears as EOS'd → buffers dropped
 // Requires: NPU runtime
 // ---------------------------------------------------------------------------
 GST_START_TEST(CE_infer_flush_stop_resets_eos_state) {
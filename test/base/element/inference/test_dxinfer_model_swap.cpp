@@ -0,0 +1,160 @@
+// dxinfer hot model swap tests
+// Core: changing model-path (property or "dx-model-swap" event) while the
+// element is READY or above loads the new model in the background and swaps
+// it in between requests; the outcome is posted as a "dxinfer-model-swap"
+// element message. In NULL the change simply updates the property.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include "harness_helpers.hpp"
+#include "npu_env.hpp"
+
+#include <string>
+
+using namespace dxtest;
+
+static std::string resolve_test_model() {
+    std::string p = resolve_model_path("yolov5-s_640x640_ppu.dxnn");
+    if (p.empty()) p = resolve_model_path("YOLOV5S_1.dxnn");
+    return p;
+}
+
+static GstMessage *pop_swap_message(GstBus *bus, GstClockTime timeout) {
+    GstClockTime deadline = gst_util_get_timestamp() + timeout;
+    for (;;) {
+        GstClockTime now = gst_util_get_timestamp();
+        if (now >= deadline)
+            return nullptr;
+        GstMessage *msg = gst_bus_timed_pop_filtered(
+            bus, deadline - now,
+            (GstMessageType)(GST_MESSAGE_ELEMENT | GST_MESSAGE_ERROR));
+        if (!msg)
+            return nullptr;
+        if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ERROR ||
+            gst_message_has_name(msg, "dxinfer-model-swap"))
+            return msg;
+        gst_message_unref(msg);
+    }
+}
+
+GST_START_TEST(SWP_event_in_null_updates_property) {
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    fail_unless(e != nullptr);
+    GstPad *src = gst_element_get_static_pad(e, "src");
+
+    GstEvent *ev = gst_event_new_custom(
+        GST_EVENT_CUSTOM_UPSTREAM,
+        gst_structure_new("dx-model-swap", "model-path", G_TYPE_STRING, "/tmp/next.dxnn",
+                          nullptr));
+    fail_unless(gst_pad_send_event(src, ev));
+
+    gchar *path = nullptr;
+    g_object_get(e, "model-path", &path, nullptr);
+    fail_unless_equals_string(path, "/tmp/next.dxnn");
+    g_free(path);
+
+    ev = gst_event_new_custom(GST_EVENT_CUSTOM_UPSTREAM,
+                              gst_structure_new_empty("dx-model-swap"));
+    fail_if(gst_pad_send_event(src, ev), "swap event without model-path must fail");
+
+    gst_object_unref(src);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// SWP_invalid_path_reports_failure: a bad replacement path leaves the running
+// model in place and reports success=FALSE on the bus.
+GST_START_TEST(SWP_invalid_path_reports_failure) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    g_object_set(e, "model-path", model.c_str(), nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "backend", "dxrt");
+    GstBus *bus = gst_bus_new();
+    gst_element_set_bus(e, bus);
+    assert_state(e, GST_STATE_READY);
+
+    g_object_set(e, "model-path", "/nonexistent/model.dxnn", nullptr);
+    GstMessage *msg = pop_swap_message(bus, 10 * GST_SECOND);
+    fail_unless(msg != nullptr, "no dxinfer-model-swap message");
+    const GstStructure *s = gst_message_get_structure(msg);
+    gboolean success = TRUE;
+    fail_unless(gst_structure_get_boolean(s, "success", &success));
+    fail_if(success);
+    fail_unless(gst_structure_has_field(s, "error"));
+    gst_message_unref(msg);
+
+    gst_element_set_state(e, GST_STATE_NULL);
+    gst_element_set_bus(e, nullptr);
+    gst_object_unref(bus);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// SWP_swap_during_playback: swapping to a model while frames flow must not
+// lose frames and must report success.
+GST_START_TEST(SWP_swap_during_playback) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    GError *err = nullptr;
+    gchar *launch = g_strdup_printf(
+        "videotestsrc num-buffers=90 is-live=true "
+        "! video/x-raw,format=RGB,width=640,height=640,framerate=30/1 "
+        "! dxpreprocess resize-width=640 resize-height=640 "
+        "! dxinfer name=infer model-path=%s backend=dxrt "
+        "! fakesink name=sink sync=false signal-handoffs=true",
+        model.c_str());
+    GstElement *pipe = gst_parse_launch(launch, &err);
+    g_free(launch);
+    fail_unless(err == nullptr && pipe != nullptr);
+
+    GstElement *infer = gst_bin_get_by_name(GST_BIN(pipe), "infer");
+    GstElement *sink = gst_bin_get_by_name(GST_BIN(pipe), "sink");
+    gint handoffs = 0;
+    g_signal_connect(sink, "handoff",
+                     G_CALLBACK(+[](GstElement *, GstBuffer *, GstPad *, gpointer d) {
+                         g_atomic_int_inc((gint *)d);
+                     }),
+                     &handoffs);
+
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipe));
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    g_object_set(infer, "model-path", model.c_str(), nullptr);
+
+    GstMessage *msg = pop_swap_message(bus, 20 * GST_SECOND);
+    fail_unless(msg != nullptr, "no dxinfer-model-swap message");
+    fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_ELEMENT);
+    gboolean success = FALSE;
+    fail_unless(gst_structure_get_boolean(gst_message_get_structure(msg), "success", &success));
+    fail_unless(success);
+    gst_message_unref(msg);
+
+    msg = gst_bus_timed_pop_filtered(bus, 30 * GST_SECOND,
+        (GstMessageType)(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+    fail_unless(msg != nullptr, "timeout waiting for EOS");
+    fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_EOS);
+    fail_unless_equals_int(g_atomic_int_get(&handoffs), 90);
+
+    gst_message_unref(msg);
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(infer);
+    gst_object_unref(sink);
+    gst_object_unref(bus);
+    gst_object_unref(pipe);
+}
+GST_END_TEST;
+
+static Suite *dxinfer_model_swap_suite(void) {
+    Suite *s = suite_create("dxinfer_model_swap");
+    TCase *tc = tcase_create("model_swap");
+    tcase_set_timeout(tc, 90.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, SWP_event_in_null_updates_property);
+    tcase_add_test(tc, SWP_invalid_path_reports_failure);
+    tcase_add_test(tc, SWP_swap_during_playback);
+    return s;
+}
+
+GST_CHECK_MAIN(dxinfer_model_swap);
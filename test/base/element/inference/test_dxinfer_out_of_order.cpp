@@ -0,0 +1,119 @@
+// dxinfer out-of-order collection tests
+// Core: out-of-order=true collects backend results in completion order but
+// must still push each stream's frames in arrival order, and EOS must wait for
+// frames parked in the per-stream reorder queues.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include "harness_helpers.hpp"
+#include "npu_env.hpp"
+
+#include <string>
+
+using namespace dxtest;
+
+static std::string resolve_test_model() {
+    std::string p = resolve_model_path("yolov5-s_640x640_ppu.dxnn");
+    if (p.empty()) p = resolve_model_path("YOLOV5S_1.dxnn");
+    return p;
+}
+
+GST_START_TEST(OOO_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    fail_unless(e != nullptr);
+
+    gboolean ooo = TRUE;
+    guint threads = 0;
+    g_object_get(e, "out-of-order", &ooo, "push-threads", &threads, nullptr);
+    fail_unless(!ooo);
+    fail_unless_equals_int(threads, 1);
+
+    g_object_set(e, "out-of-order", TRUE, "push-threads", 4u, nullptr);
+    g_object_get(e, "out-of-order", &ooo, "push-threads", &threads, nullptr);
+    fail_unless(ooo);
+    fail_unless_equals_int(threads, 4);
+
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+struct HandoffState {
+    gint count;
+    GstClockTime last_pts;
+    gboolean reordered;
+};
+
+// OOO_run_preserves_order: every frame arrives, in PTS order, before EOS.
+GST_START_TEST(OOO_run_preserves_order) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    GError *err = nullptr;
+    gchar *launch = g_strdup_printf(
+        "videotestsrc num-buffers=16 "
+        "! video/x-raw,format=RGB,width=640,height=640,framerate=30/1 "
+        "! dxpreprocess resize-width=640 resize-height=640 "
+        "! dxinfer model-path=%s backend=dxrt out-of-order=true push-threads=3 "
+        "! fakesink name=sink sync=false signal-handoffs=true",
+        model.c_str());
+    GstElement *pipe = gst_parse_launch(launch, &err);
+    g_free(launch);
+    fail_unless(err == nullptr && pipe != nullptr);
+
+    GstElement *sink = gst_bin_get_by_name(GST_BIN(pipe), "sink");
+    HandoffState state = {0, GST_CLOCK_TIME_NONE, FALSE};
+    g_signal_connect(sink, "handoff",
+                     G_CALLBACK(+[](GstElement *, GstBuffer *buf, GstPad *, gpointer d) {
+                         auto *s = static_cast<HandoffState *>(d);
+                         GstClockTime pts = GST_BUFFER_PTS(buf);
+                         if (GST_CLOCK_TIME_IS_VALID(s->last_pts) && pts < s->last_pts)
+                             s->reordered = TRUE;
+                         s->last_pts = pts;
+                         s->count++;
+                     }),
+                     &state);
+
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipe));
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    GstMessage *msg = gst_bus_timed_pop_filtered(bus, 30 * GST_SECOND,
+        (GstMessageType)(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+    fail_unless(msg != nullptr, "timeout waiting for EOS");
+    fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_EOS);
+    fail_unless_equals_int(state.count, 16);
+    fail_unless(!state.reordered, "frames of one stream were pushed out of order");
+
+    gst_message_unref(msg);
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(sink);
+    gst_object_unref(bus);
+    gst_object_unref(pipe);
+}
+GST_END_TEST;
+
+// OOO_state_cycle: completion threads are started/joined across state cycles.
+GST_START_TEST(OOO_state_cycle) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    g_object_set(e, "model-path", model.c_str(), "out-of-order", TRUE,
+                 "push-threads", 2u, nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "backend", "dxrt");
+    full_state_cycle(e);
+    full_state_cycle(e);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+static Suite *dxinfer_out_of_order_suite(void) {
+    Suite *s = suite_create("dxinfer_out_of_order");
+    TCase *tc = tcase_create("out_of_order");
+    tcase_set_timeout(tc, 60.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, OOO_property_defaults_and_set);
+    tcase_add_test(tc, OOO_run_preserves_order);
+    tcase_add_test(tc, OOO_state_cycle);
+    return s;
+}
+
+GST_CHECK_MAIN(dxinfer_out_of_order);
@@ -0,0 +1,308 @@
+// dxinfer cross-stream scheduling tests
+// Core: scheduling=fifo keeps the original arrival-order submit path. priority/wfq
+// park frames in per-stream queues drained by a submit thread; EOS must not
+// overtake frames still parked in the scheduler.
+//
+// Queue selection (gst_dxinfer_sched_dequeue), the stream map parser and the
+// per-stream slot lookup are plain functions, tested here without an NPU on
+// hand-filled queues.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include "gst-dxinfer.hpp"
+#include "harness_helpers.hpp"
+#include "npu_env.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace dxtest;
+
+static std::string resolve_test_model() {
+    std::string p = resolve_model_path("yolov5-s_640x640_ppu.dxnn");
+    if (p.empty()) p = resolve_model_path("YOLOV5S_1.dxnn");
+    return p;
+}
+
+GST_START_TEST(SCH_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    fail_unless(e != nullptr);
+
+    gchar *prio = nullptr, *weights = nullptr;
+    guint deadline = 99, qsize = 0;
+    g_object_get(e, "stream-priorities", &prio, "stream-weights", &weights,
+                 "scheduler-deadline", &deadline, "scheduler-queue-size", &qsize,
+                 nullptr);
+    fail_unless(prio == nullptr);
+    fail_unless(weights == nullptr);
+    fail_unless_equals_int(deadline, 0);
+    fail_unless_equals_int(qsize, 4);
+
+    gint policy = -1;
+    g_object_get(e, "scheduling", &policy, nullptr);
+    fail_unless_equals_int(policy, 0);  // fifo
+    gst_util_set_object_arg(G_OBJECT(e), "scheduling", "wfq");
+    g_object_get(e, "scheduling", &policy, nullptr);
+    fail_unless_equals_int(policy, 2);
+
+    g_object_set(e, "stream-priorities", "0:2,1:0", "stream-weights", "1:3",
+                 "scheduler-deadline", 100u, "scheduler-queue-size", 8u, nullptr);
+    g_object_get(e, "stream-priorities", &prio, "stream-weights", &weights,
+                 "scheduler-deadline", &deadline, "scheduler-queue-size", &qsize,
+                 nullptr);
+    fail_unless_equals_string(prio, "0:2,1:0");
+    fail_unless_equals_string(weights, "1:3");
+    fail_unless_equals_int(deadline, 100);
+    fail_unless_equals_int(qsize, 8);
+    g_free(prio);
+    g_free(weights);
+
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+GST_START_TEST(SCH_stream_map_parsing) {
+    std::map<int, guint> map;
+    guint skipped = gst_dxinfer_parse_stream_map(
+        " 0:3 , 5:1,bogus,7:,-1:4,64:2,4294967296:1", map);
+    fail_unless_equals_int(skipped, 4);
+    fail_unless_equals_int((int)map.size(), 3);
+    fail_unless_equals_int(map[0], 3);
+    fail_unless_equals_int(map[5], 1);
+    fail_unless_equals_int(map[64], 2);
+
+    fail_unless_equals_int(gst_dxinfer_parse_stream_map("", map), 0);
+    fail_unless(map.empty());
+}
+GST_END_TEST;
+
+// Ids past the dense table (and negative ones) get overflow slots that keep
+// their address, so a reference taken in the chain stays valid for EOS.
+GST_START_TEST(SCH_stream_slot_overflow) {
+    GstDxInferEosContext ctx;
+    GstDxInferStreamSlot &low = gst_dxinfer_stream_slot(ctx, 3);
+    fail_unless(&low == &ctx.streams[3]);
+    fail_unless(ctx.overflow.empty());
+
+    GstDxInferStreamSlot &high = gst_dxinfer_stream_slot(ctx, 200);
+    high.pending_buffers++;
+    high.eos_arrived = true;
+    GstDxInferStreamSlot &edge = gst_dxinfer_stream_slot(ctx, DX_MAX_STREAMS);
+    GstDxInferStreamSlot &neg = gst_dxinfer_stream_slot(ctx, -1);
+    fail_unless_equals_int((int)ctx.overflow.size(), 3);
+    fail_unless(&edge != &high);
+    fail_unless(&neg != &high);
+
+    GstDxInferStreamSlot &again = gst_dxinfer_stream_slot(ctx, 200);
+    fail_unless(&again == &high);
+    fail_unless_equals_int(again.pending_buffers, 1);
+    fail_unless(again.eos_arrived);
+    fail_unless_equals_int(edge.pending_buffers, 0);
+    fail_if(edge.eos_arrived);
+}
+GST_END_TEST;
+
+using SchedClock = std::chrono::steady_clock;
+
+// Queues `frames` buffers on `stream`, PTS = push index within the stream.
+static void sched_push(GstDxInferSchedContext &ctx, int stream, int frames,
+                       SchedClock::time_point arrival) {
+    auto &q = ctx.streams[stream].queue;
+    for (int i = 0; i < frames; i++) {
+        GstBuffer *buf = gst_buffer_new();
+        GST_BUFFER_PTS(buf) = q.size();
+        GST_BUFFER_OFFSET(buf) = stream;
+        q.push_back({buf, arrival});
+    }
+}
+
+struct SchedPick {
+    int stream;
+    GstClockTime pts;
+    bool late;
+};
+
+// Drains ctx completely, recording which stream each step served.
+static std::vector<SchedPick> sched_drain(GstDxInferSchedContext &ctx, SchedClock::time_point now) {
+    std::vector<SchedPick> picks;
+    GstDxInferSchedEntry entry{};
+    bool late = false;
+    int stream;
+    while ((stream = gst_dxinfer_sched_dequeue(ctx, now, entry, late)) >= 0) {
+        fail_unless_equals_int((int)GST_BUFFER_OFFSET(entry.buffer), stream);
+        picks.push_back({stream, GST_BUFFER_PTS(entry.buffer), late});
+        gst_buffer_unref(entry.buffer);
+    }
+    return picks;
+}
+
+// SCH_priority_serves_high_class_first: stream 1 (class 2) is drained before
+// stream 0 (class 0) even though stream 0 has the lower id.
+// MUT: ignore priorities → streams interleave → fail
+GST_START_TEST(SCH_priority_serves_high_class_first) {
+    GstDxInferSchedContext ctx{};
+    ctx.policy = GstDxInferSchedPolicy::PRIORITY;
+    ctx.priorities = {{0, 0}, {1, 2}};
+    auto now = SchedClock::now();
+    sched_push(ctx, 0, 3, now);
+    sched_push(ctx, 1, 3, now);
+
+    std::vector<SchedPick> picks = sched_drain(ctx, now);
+    fail_unless_equals_int((int)picks.size(), 6);
+    for (int i = 0; i < 6; i++)
+        fail_unless_equals_int(picks[i].stream, i < 3 ? 1 : 0);
+}
+GST_END_TEST;
+
+// SCH_wfq_weights_order: with weights 3:1 and both streams backlogged, every
+// window of 4 submissions holds 3 frames of stream 0 and 1 of stream 1.
+// MUT: re-stamp waiting heads each step → stream 1 starves until stream 0
+//      is empty → fail
+GST_START_TEST(SCH_wfq_weights_order) {
+    GstDxInferSchedContext ctx{};
+    ctx.policy = GstDxInferSchedPolicy::WFQ;
+    ctx.weights = {{0, 3}, {1, 1}};
+    auto now = SchedClock::now();
+    sched_push(ctx, 0, 12, now);
+    sched_push(ctx, 1, 4, now);
+
+    std::vector<SchedPick> picks = sched_drain(ctx, now);
+    fail_unless_equals_int((int)picks.size(), 16);
+    for (int w = 0; w < 4; w++) {
+        int from_1 = 0;
+        for (int i = 0; i < 4; i++)
+            from_1 += picks[w * 4 + i].stream == 1;
+        fail_unless_equals_int(from_1, 1);
+    }
+}
+GST_END_TEST;
+
+// SCH_deadline_drops_late_frames: frames that waited longer than
+// scheduler-deadline are reported late (and counted); fresh ones are not.
+// MUT: compare against arrival instead of waited time → nothing late → fail
+GST_START_TEST(SCH_deadline_drops_late_frames) {
+    GstDxInferSchedContext ctx{};
+    ctx.policy = GstDxInferSchedPolicy::WFQ;
+    ctx.deadline_ms = 50;
+    auto now = SchedClock::now();
+    sched_push(ctx, 0, 2, now - std::chrono::milliseconds(100));
+    sched_push(ctx, 0, 1, now - std::chrono::milliseconds(10));
+
+    std::vector<SchedPick> picks = sched_drain(ctx, now);
+    fail_unless_equals_int((int)picks.size(), 3);
+    fail_unless(picks[0].late && picks[1].late);
+    fail_unless(!picks[2].late);
+    fail_unless_equals_int((int)ctx.streams[0].dropped, 2);
+
+    ctx.deadline_ms = 0;
+    sched_push(ctx, 0, 1, now - std::chrono::seconds(10));
+    picks = sched_drain(ctx, now);
+    fail_unless(!picks[0].late, "deadline 0 never drops");
+}
+GST_END_TEST;
+
+// SCH_per_stream_order_kept: whatever the interleaving across streams, each
+// stream's frames are submitted in push order.
+// MUT: pop from the back of a stream queue → PTS decreases → fail
+GST_START_TEST(SCH_per_stream_order_kept) {
+    const GstDxInferSchedPolicy policies[] = {GstDxInferSchedPolicy::PRIORITY,
+                                              GstDxInferSchedPolicy::WFQ};
+    for (GstDxInferSchedPolicy policy : policies) {
+        GstDxInferSchedContext ctx{};
+        ctx.policy = policy;
+        ctx.priorities = {{2, 1}};
+        ctx.weights = {{0, 2}, {1, 5}, {2, 1}};
+        auto now = SchedClock::now();
+        sched_push(ctx, 0, 7, now);
+        sched_push(ctx, 1, 9, now);
+        sched_push(ctx, 2, 4, now);
+
+        std::map<int, GstClockTime> next;
+        std::vector<SchedPick> picks = sched_drain(ctx, now);
+        fail_unless_equals_int((int)picks.size(), 20);
+        for (const SchedPick &p : picks)
+            fail_unless_equals_uint64(p.pts, next[p.stream]++);
+    }
+}
+GST_END_TEST;
+
+// SCH_scheduled_run_reaches_eos: with a submit thread in front of Put(), all
+// frames must still reach the push thread before EOS is forwarded.
+GST_START_TEST(SCH_scheduled_run_reaches_eos) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    const char *policies[] = {"priority", "wfq"};
+    for (const char *policy : policies) {
+        GError *err = nullptr;
+        gchar *launch = g_strdup_printf(
+            "videotestsrc num-buffers=8 "
+            "! video/x-raw,format=RGB,width=640,height=640,framerate=30/1 "
+            "! dxpreprocess resize-width=640 resize-height=640 "
+            "! dxinfer model-path=%s backend=dxrt scheduling=%s "
+            "stream-priorities=0:1 stream-weights=0:2 "
+            "! fakesink name=sink sync=false signal-handoffs=true",
+            model.c_str(), policy);
+        GstElement *pipe = gst_parse_launch(launch, &err);
+        g_free(launch);
+        fail_unless(err == nullptr && pipe != nullptr);
+
+        GstElement *sink = gst_bin_get_by_name(GST_BIN(pipe), "sink");
+        gint handoffs = 0;
+        g_signal_connect(sink, "handoff",
+                         G_CALLBACK(+[](GstElement *, GstBuffer *, GstPad *, gpointer d) {
+                             g_atomic_int_inc((gint *)d);
+                         }),
+                         &handoffs);
+
+        GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipe));
+        gst_element_set_state(pipe, GST_STATE_PLAYING);
+        GstMessage *msg = gst_bus_timed_pop_filtered(bus, 30 * GST_SECOND,
+            (GstMessageType)(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+        fail_unless(msg != nullptr, "timeout waiting for EOS (%s)", policy);
+        fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_EOS);
+        fail_unless_equals_int(g_atomic_int_get(&handoffs), 8);
+
+        gst_message_unref(msg);
+        gst_element_set_state(pipe, GST_STATE_NULL);
+        gst_object_unref(sink);
+        gst_object_unref(bus);
+        gst_object_unref(pipe);
+    }
+}
+GST_END_TEST;
+
+// SCH_state_cycle: submit thread is started/joined with the push thread.
+GST_START_TEST(SCH_state_cycle) {
+    std::string model = resolve_test_model();
+    DXTEST_SKIP_IF(model.empty() || !npu_available(), "model/NPU not available");
+
+    GstElement *e = gst_element_factory_make("dxinfer", nullptr);
+    g_object_set(e, "model-path", model.c_str(), nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "backend", "dxrt");
+    gst_util_set_object_arg(G_OBJECT(e), "scheduling", "priority");
+    full_state_cycle(e);
+    full_state_cycle(e);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+static Suite *dxinfer_scheduling_suite(void) {
+    Suite *s = suite_create("dxinfer_scheduling");
+    TCase *tc = tcase_create("scheduling");
+    tcase_set_timeout(tc, 60.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, SCH_property_defaults_and_set);
+    tcase_add_test(tc, SCH_stream_map_parsing);
+    tcase_add_test(tc, SCH_stream_slot_overflow);
+    tcase_add_test(tc, SCH_priority_serves_high_class_first);
+    tcase_add_test(tc, SCH_wfq_weights_order);
+    tcase_add_test(tc, SCH_deadline_drops_late_frames);
+    tcase_add_test(tc, SCH_per_stream_order_kept);
+    tcase_add_test(tc, SCH_scheduled_run_reaches_eos);
+    tcase_add_test(tc, SCH_state_cycle);
+    return s;
+}
+
+GST_CHECK_MAIN(dxinfer_scheduling);
@@ -0,0 +1,245 @@
+// dxtensorcapture / dxtestsrc tensor-file tests
+// Core: output tensors captured from a pipeline replay bit-exact, with the
+// recorded stream_id, timestamps and frame size; loop keeps replaying with
+// increasing timestamps; replayed tensors are writable copy-on-write views;
+// max-frames bounds the recording.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <glib/gstdio.h>
+#include "gstdxstream/gst-dxframemeta.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace {
+
+// Temporary tensor-dir with two tensors: FLOAT [1,2,3] = 0..5 and
+// UINT8 [4] = 10..13.
+struct TensorDir {
+    gchar *dir;
+    std::string recording;
+
+    TensorDir() {
+        dir = g_dir_make_tmp("dxtensorcapture_XXXXXX", nullptr);
+        fail_unless(dir != nullptr);
+        const char *json =
+            "{\"width\":640,\"height\":480,\"tensors\":["
+            "{\"name\":\"output0\",\"type\":\"FLOAT\",\"shape\":[1,2,3],\"file\":\"a.bin\"},"
+            "{\"name\":\"output1\",\"type\":\"UINT8\",\"shape\":[4],\"file\":\"b.bin\"}]}";
+        const float a[6] = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
+        const guint8 b[4] = {10, 11, 12, 13};
+        fail_unless(g_file_set_contents(path("manifest.json").c_str(), json, -1, nullptr));
+        fail_unless(g_file_set_contents(path("a.bin").c_str(), (const gchar *)a,
+                                        sizeof(a), nullptr));
+        fail_unless(g_file_set_contents(path("b.bin").c_str(), (const gchar *)b,
+                                        sizeof(b), nullptr));
+        recording = path("capture.dxtrec");
+    }
+    ~TensorDir() {
+        for (const char *f : {"manifest.json", "a.bin", "b.bin", "capture.dxtrec"})
+            g_remove(path(f).c_str());
+        g_rmdir(dir);
+        g_free(dir);
+    }
+    std::string path(const char *name) const { return std::string(dir) + "/" + name; }
+};
+
+void run_to_eos(const std::string &desc) {
+    GError *err = nullptr;
+    GstElement *pipe = gst_parse_launch(desc.c_str(), &err);
+    fail_unless(err == nullptr && pipe != nullptr);
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    GstBus *bus = gst_element_get_bus(pipe);
+    GstMessage *msg = gst_bus_timed_pop_filtered(
+        bus, 10 * GST_SECOND,
+        static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+    fail_unless(msg != nullptr, "timeout waiting for EOS");
+    fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_EOS);
+    gst_message_unref(msg);
+    gst_object_unref(bus);
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(pipe);
+}
+
+void capture(const TensorDir &td, int buffers, const char *extra = "") {
+    gchar *desc = g_strdup_printf(
+        "dxtestsrc num-streams=2 first-stream-id=3 width=64 height=64 "
+        "tensor-dir=%s infer-id=1 num-buffers=%d ! "
+        "dxtensorcapture location=%s infer-id=1 %s ! fakesink sync=false",
+        td.dir, buffers, td.recording.c_str(), extra);
+    run_to_eos(desc);
+    g_free(desc);
+}
+
+GstElement *replay(const TensorDir &td, const char *extra, GstElement **sink) {
+    gchar *desc = g_strdup_printf(
+        "dxtestsrc name=src width=64 height=64 tensor-file=%s %s ! "
+        "appsink name=sink sync=false",
+        td.recording.c_str(), extra);
+    GError *err = nullptr;
+    GstElement *pipe = gst_parse_launch(desc, &err);
+    g_free(desc);
+    fail_unless(err == nullptr && pipe != nullptr);
+    *sink = gst_bin_get_by_name(GST_BIN(pipe), "sink");
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    return pipe;
+}
+
+void check_tensors(DXFrameMeta *fm) {
+    auto it = fm->_output_tensors.find(1);
+    fail_unless(it != fm->_output_tensors.end());
+    fail_unless_equals_int((int)it->second._tensors.size(), 2);
+    const dxs::DXTensor &a = it->second._tensors[0];
+    const dxs::DXTensor &b = it->second._tensors[1];
+    fail_unless(a._name == "output0" && b._name == "output1");
+    fail_unless_equals_int(a._type, dxs::FLOAT);
+    fail_unless_equals_int(b._type, dxs::UINT8);
+    fail_unless_equals_int((int)a._shape.size(), 3);
+    fail_unless_equals_int((int)a._shape[2], 3);
+    fail_unless_equals_float(static_cast<const float *>(a._data)[5], 5.0f);
+    fail_unless_equals_int(static_cast<const guint8 *>(b._data)[3], 13);
+    fail_unless_equals_int((int)(reinterpret_cast<guintptr>(a._data) % 64), 0);
+}
+
+} // namespace
+
+// TCAP_round_trip: 6 buffers over 2 streams replay in order with their
+// stream ids, PTS and tensors, then EOS.
+GST_START_TEST(TCAP_round_trip) {
+    TensorDir td;
+    capture(td, 6);
+
+    GstElement *sink;
+    GstElement *pipe = replay(td, "", &sink);
+    for (int i = 0; i < 6; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 5 * GST_SECOND);
+        fail_unless(s != nullptr, "timeout waiting for a buffer");
+        GstBuffer *buf = gst_sample_get_buffer(s);
+        DXFrameMeta *fm = dx_get_frame_meta(buf);
+        fail_unless(fm != nullptr);
+        fail_unless_equals_int(fm->_stream_id, 3 + i % 2);
+        fail_unless_equals_int(fm->_width, 64);
+        fail_unless_equals_uint64(GST_BUFFER_PTS(buf), (guint64)(i / 2) * GST_SECOND / 30);
+        check_tensors(fm);
+        gst_sample_unref(s);
+    }
+    fail_unless(gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 5 * GST_SECOND) == nullptr);
+    fail_unless(gst_app_sink_is_eos(GST_APP_SINK(sink)));
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(sink);
+    gst_object_unref(pipe);
+}
+GST_END_TEST;
+
+// TCAP_loop: a 2-record recording looped for 6 buffers keeps increasing PTS.
+GST_START_TEST(TCAP_loop) {
+    TensorDir td;
+    capture(td, 2);
+
+    GstElement *sink;
+    GstElement *pipe = replay(td, "loop=true num-buffers=6", &sink);
+    GstClockTime last = GST_CLOCK_TIME_NONE;
+    for (int i = 0; i < 6; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 5 * GST_SECOND);
+        fail_unless(s != nullptr, "timeout waiting for a buffer");
+        GstBuffer *buf = gst_sample_get_buffer(s);
+        check_tensors(dx_get_frame_meta(buf));
+        if (i % 2 == 1)
+            fail_unless(GST_BUFFER_PTS(buf) == last);  // same frame, other stream
+        else if (i > 0)
+            fail_unless(GST_BUFFER_PTS(buf) > last);
+        last = GST_BUFFER_PTS(buf);
+        gst_sample_unref(s);
+    }
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(sink);
+    gst_object_unref(pipe);
+}
+GST_END_TEST;
+
+// TCAP_replay_tensors_writable: replayed tensors of a read-only recording
+// may be edited in place. The edits stay out of the file and out of the
+// next loop, which replays the recorded values again.
+GST_START_TEST(TCAP_replay_tensors_writable) {
+    TensorDir td;
+    capture(td, 2);
+    gchar *before = nullptr;
+    gsize before_len = 0;
+    fail_unless(g_file_get_contents(td.recording.c_str(), &before, &before_len, nullptr));
+    fail_unless_equals_int(g_chmod(td.recording.c_str(), 0444), 0);
+
+    GstElement *sink;
+    GstElement *pipe = replay(td, "loop=true num-buffers=4", &sink);
+    for (int i = 0; i < 4; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 5 * GST_SECOND);
+        fail_unless(s != nullptr, "timeout waiting for a buffer");
+        DXFrameMeta *fm = dx_get_frame_meta(gst_sample_get_buffer(s));
+        check_tensors(fm);
+        if (i < 2) {
+            dxs::DXTensors &t = fm->_output_tensors[1];
+            static_cast<float *>(t._tensors[0]._data)[5] = -1.0f;
+            static_cast<guint8 *>(t._tensors[1]._data)[3] = 0;
+        }
+        gst_sample_unref(s);
+    }
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(sink);
+    gst_object_unref(pipe);
+
+    gchar *after = nullptr;
+    gsize after_len = 0;
+    fail_unless(g_file_get_contents(td.recording.c_str(), &after, &after_len, nullptr));
+    fail_unless(after_len == before_len && memcmp(before, after, before_len) == 0,
+                "replay wrote to the recording");
+    g_free(before);
+    g_free(after);
+}
+GST_END_TEST;
+
+// TCAP_max_frames: only the first max-frames buffers are recorded.
+GST_START_TEST(TCAP_max_frames) {
+    TensorDir td;
+    capture(td, 10, "max-frames=3");
+
+    GstElement *sink;
+    GstElement *pipe = replay(td, "", &sink);
+    int count = 0;
+    while (GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 2 * GST_SECOND)) {
+        gst_sample_unref(s);
+        count++;
+    }
+    fail_unless_equals_int(count, 3);
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(sink);
+    gst_object_unref(pipe);
+}
+GST_END_TEST;
+
+// TCAP_bad_file_errors: a file that is not a recording fails start.
+GST_START_TEST(TCAP_bad_file_errors) {
+    TensorDir td;
+    GstElement *e = gst_element_factory_make("dxtestsrc", nullptr);
+    g_object_set(e, "tensor-file", td.path("manifest.json").c_str(), nullptr);
+    fail_unless_equals_int(gst_element_set_state(e, GST_STATE_PAUSED),
+                           GST_STATE_CHANGE_FAILURE);
+    gst_element_set_state(e, GST_STATE_NULL);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+static Suite *dxtensorcapture_suite(void) {
+    Suite *s = suite_create("dxtensorcapture");
+    TCase *tc = tcase_create("capture");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, TCAP_round_trip);
+    tcase_add_test(tc, TCAP_loop);
+    tcase_add_test(tc, TCAP_replay_tensors_writable);
+    tcase_add_test(tc, TCAP_max_frames);
+    tcase_add_test(tc, TCAP_bad_file_errors);
+    return s;
+}
+
+GST_CHECK_MAIN(dxtensorcapture);
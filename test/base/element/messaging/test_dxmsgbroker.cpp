@@ -7,8 +7,12 @@
 #include <gst/check/gstharness.h>
 #include <gst/gst.h>
 #include "harness_helpers.hpp"
+#include "gstdxstream/gst-dxmsgmeta.hpp"
+
+#include <glib/gstdio.h>
 
 #include <cstring>
+#include <string>
 
 using namespace dxtest;
 
@@ -90,6 +94,30 @@ GST_START_TEST(CA2_property_defaults_and_set) {
 }
 GST_END_TEST;
 
+GST_START_TEST(CA3_async_property_defaults) {
+    GstElement *e = gst_element_factory_make("dxmsgbroker", nullptr);
+
+    gboolean async = TRUE;
+    guint queue = 0, batch = 0, linger = 0, depth = 1;
+    gchar *spill_dir = nullptr;
+    guint64 published = 1, dropped = 1;
+    g_object_get(e, "async", &async, "max-queue-size", &queue, "batch-size", &batch,
+                 "linger-ms", &linger, "spill-dir", &spill_dir, "queue-depth", &depth,
+                 "published", &published, "dropped", &dropped, nullptr);
+
+    fail_unless(async == FALSE, "async must default to FALSE");
+    fail_unless_equals_int(queue, 1024);
+    fail_unless_equals_int(batch, 32);
+    fail_unless_equals_int(linger, 5);
+    fail_unless(spill_dir == nullptr, "spill-dir default must be null");
+    fail_unless_equals_int(depth, 0);
+    fail_unless_equals_uint64(published, 0);
+    fail_unless_equals_uint64(dropped, 0);
+
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
 // ---- Element-specific TCs ----
 
 // CE_broker_invalid_type_error: invalid broker-name → READY failure
@@ -135,6 +163,57 @@ GST_START_TEST(CE_broker_missing_topic_error) {
 }
 GST_END_TEST;
 
+static void remove_dir(const gchar *dir) {
+    GDir *d = g_dir_open(dir, 0, nullptr);
+    if (d) {
+        while (const gchar *name = g_dir_read_name(d))
+            g_remove((std::string(dir) + "/" + name).c_str());
+        g_dir_close(d);
+    }
+    g_rmdir(dir);
+}
+
+static GstHarness *async_unreachable_harness(const gchar *spill_dir) {
+    gchar *launch = g_strdup_printf(
+        "dxmsgbroker async=true broker-name=mqtt conn-info=127.0.0.1:1 "
+        "topic=test_topic spill-dir=%s",
+        spill_dir);
+    GstHarness *h = gst_harness_new_parse(launch);
+    g_free(launch);
+    gst_harness_set_src_caps_str(h, "video/x-raw,format=RGB,width=4,height=4,framerate=30/1");
+    return h;
+}
+
+// CE_async_unreachable_spills: async mode starts without a broker, keeps
+// accepting buffers and leaves the messages in spill-dir for the next run.
+// Target: gst_dxmsgbroker_start async path, DxMsgPublisher::stop, DxMsgSpillRing::open
+GST_START_TEST(CE_async_unreachable_spills) {
+    gchar *dir = g_dir_make_tmp("dxmsgbroker_XXXXXX", nullptr);
+    fail_unless(dir != nullptr);
+
+    GstHarness *h = async_unreachable_harness(dir);
+    for (int i = 0; i < 3; i++) {
+        GstBuffer *buf = gst_buffer_new_allocate(nullptr, 4 * 4 * 3, nullptr);
+        gchar *json = g_strdup_printf("{\"seq\":%d}", i);
+        GBytes *bytes = g_bytes_new_take(json, strlen(json));
+        dx_add_payload_bytes_to_buffer(buf, bytes);
+        g_bytes_unref(bytes);
+        fail_unless_equals_int(gst_harness_push(h, buf), GST_FLOW_OK);
+    }
+    gst_harness_teardown(h);
+
+    // A new run recovers what the first one could not publish.
+    h = async_unreachable_harness(dir);
+    guint64 spill_depth = 0;
+    g_object_get(h->element, "spill-depth", &spill_depth, nullptr);
+    fail_unless_equals_uint64(spill_depth, 3);
+    gst_harness_teardown(h);
+
+    remove_dir(dir);
+    g_free(dir);
+}
+GST_END_TEST;
+
 static Suite *dxmsgbroker_suite(void) {
     Suite *s = suite_create("dxmsgbroker");
     TCase *tc = tcase_create("contract");
@@ -142,10 +221,12 @@ static Suite *dxmsgbroker_suite(void) {
     suite_add_tcase(s, tc);
     tcase_add_test(tc, CA1_factory_make);
     tcase_add_test(tc, CA2_property_defaults_and_set);
+    tcase_add_test(tc, CA3_async_property_defaults);
     tcase_add_test(tc, CE_broker_invalid_type_error);
     tcase_add_test(tc, CE_broker_connect_fail_error);
     tcase_add_test(tc, CE_broker_missing_conn_info_error);
     tcase_add_test(tc, CE_broker_missing_topic_error);
+    tcase_add_test(tc, CE_async_unreachable_spills);
     return s;
 }
 
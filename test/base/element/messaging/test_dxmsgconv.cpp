@@ -11,6 +11,8 @@
 #include "npu_env.hpp"
 
 #include <cstring>
+#include <string>
+#include <vector>
 
 using namespace dxtest;
 
@@ -44,6 +46,40 @@ static GstBuffer *make_buf_with_meta(GstClockTime pts, int stream_id,
     return b;
 }
 
+static GstBuffer *make_nv12_buf_with_meta(int w, int h, int n_objects) {
+    GstBuffer *b = gst_buffer_new_allocate(nullptr, w * h * 3 / 2, nullptr);
+    gst_buffer_memset(b, 0, 0x80, w * h * 3 / 2);
+    DXFrameMeta *fm = make_frame_meta(b, 0, w, h);
+    for (int i = 0; i < n_objects; i++) {
+        add_object_to_frame(fm, i, 0.9f, 8 + 24 * i, 8, 20 + 24 * i, 40, 100 + i);
+    }
+    return b;
+}
+
+static std::string payload_string(GstBuffer *buf) {
+    GstDxMsgMeta *mm = (GstDxMsgMeta *)gst_buffer_get_meta(
+        buf, gst_dxmsg_meta_api_get_type());
+    if (!mm || !mm->_payload)
+        return std::string();
+    DxMsgPayload *pl = (DxMsgPayload *)mm->_payload;
+    return std::string((const char *)pl->_data, pl->_size);
+}
+
+static guint extra_count(GstBuffer *buf) {
+    GstDxMsgMeta *mm = (GstDxMsgMeta *)gst_buffer_get_meta(
+        buf, gst_dxmsg_meta_api_get_type());
+    return (mm && mm->_extra_bytes) ? mm->_extra_bytes->len : 0;
+}
+
+static std::string extra_string(GstBuffer *buf, guint index) {
+    GstDxMsgMeta *mm = (GstDxMsgMeta *)gst_buffer_get_meta(
+        buf, gst_dxmsg_meta_api_get_type());
+    gsize size = 0;
+    auto *data = (const char *)g_bytes_get_data(
+        (GBytes *)g_ptr_array_index(mm->_extra_bytes, index), &size);
+    return std::string(data, size);
+}
+
 static bool has_msg_meta(GstBuffer *buf) {
     GstMeta *meta = gst_buffer_get_meta(buf, gst_dxmsg_meta_api_get_type());
     return meta != nullptr;
@@ -76,6 +112,19 @@ GST_START_TEST(CA2_property_defaults_and_set) {
     fail_unless_equals_int(interval, 1);
     fail_unless(inc == FALSE, "include-frame default must be FALSE");
 
+    gint format = -1;
+    g_object_get(e, "message-format", &format, nullptr);
+    fail_unless_equals_int(format, 0); // json
+
+    guint snapshot_width = 1;
+    gint quality = 0;
+    gboolean snapshot_async = TRUE;
+    g_object_get(e, "snapshot-width", &snapshot_width, "snapshot-quality", &quality,
+                 "snapshot-async", &snapshot_async, nullptr);
+    fail_unless_equals_int(snapshot_width, 0);
+    fail_unless_equals_int(quality, 95);
+    fail_unless(snapshot_async == FALSE, "snapshot-async default must be FALSE");
+
     g_free(lib);
     g_free(cfg);
 
@@ -202,6 +251,292 @@ GST_START_TEST(CE_msgconv_payload_attached) {
 }
 GST_END_TEST;
 
+// CE_msgconv_binary_format: message-format=binary → payload in the binary schema
+// Target: dxmsg_convert_payload format dispatch, dxpayload_convert_to_binary
+GST_START_TEST(CE_msgconv_binary_format) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "message-format", "binary");
+    g_object_set(e, "library-file-path", MSGCONV_LIB, nullptr);
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(h, CAPS_STR);
+
+    gst_harness_push(h, make_buf_with_meta(0, 3, 2));
+    GstBuffer *out = gst_harness_pull(h);
+    fail_unless(out != nullptr && has_msg_meta(out));
+
+    GstDxMsgMeta *mm = (GstDxMsgMeta *)gst_buffer_get_meta(
+        out, gst_dxmsg_meta_api_get_type());
+    DxMsgPayload *pl = (DxMsgPayload *)mm->_payload;
+    fail_unless(pl->_size >= 40 + 2 * 56, "payload too small: %u", pl->_size);
+    const guint8 *data = (const guint8 *)pl->_data;
+    fail_unless(memcmp(data, "DXMB", 4) == 0, "binary magic expected");
+
+    guint32 total_size, num_objects, record_size;
+    gint32 stream_id;
+    memcpy(&total_size, data + 8, 4);
+    memcpy(&stream_id, data + 12, 4);
+    memcpy(&num_objects, data + 32, 4);
+    fail_unless_equals_int(total_size, pl->_size);
+    fail_unless_equals_int(stream_id, 3);
+    fail_unless_equals_int(num_objects, 2);
+
+    // record_size of the first object leads exactly to the second one,
+    // whose record ends at the end of the message.
+    memcpy(&record_size, data + 40, 4);
+    guint32 second_size;
+    memcpy(&second_size, data + 40 + record_size, 4);
+    fail_unless_equals_int(40 + record_size + second_size, total_size);
+
+    gst_buffer_unref(out);
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_snapshot_inline: include-frame (sync) → frameData in the message itself
+// Target: take_snapshot() synchronous whole-frame path, snapshot-width downscale
+GST_START_TEST(CE_msgconv_snapshot_inline) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, "include-frame", TRUE,
+                 "snapshot-width", 2, nullptr);
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(h, CAPS_STR);
+
+    gst_harness_push(h, make_buf_with_meta(0, 0, 1));
+    GstBuffer *out = gst_harness_pull(h);
+    fail_unless(out != nullptr && has_msg_meta(out));
+    std::string msg = payload_string(out);
+    fail_unless(msg.find("\"frameData\":\"") != std::string::npos,
+                "frameData expected: %s", msg.c_str());
+    fail_unless_equals_int(extra_count(out), 0);
+
+    gst_buffer_unref(out);
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_snapshot_crops: snapshot-mode=crops → one follow-up message with a
+// thumbnail per object, the message itself without frameData
+// Target: capture_snapshot() crops, dx_add_extra_payload_bytes_to_buffer
+GST_START_TEST(CE_msgconv_snapshot_crops) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, "include-frame", TRUE, nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "snapshot-mode", "crops");
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(
+        h, "video/x-raw,format=NV12,width=64,height=48,framerate=30/1");
+
+    gst_harness_push(h, make_nv12_buf_with_meta(64, 48, 2));
+    GstBuffer *out = gst_harness_pull(h);
+    fail_unless(out != nullptr && has_msg_meta(out));
+    fail_unless(payload_string(out).find("frameData") == std::string::npos);
+    fail_unless_equals_int(extra_count(out), 1);
+    std::string crops = extra_string(out, 0);
+    fail_unless(crops.find("\"crops\":[") != std::string::npos, "%s", crops.c_str());
+    fail_unless(crops.find("\"track_id\":100") != std::string::npos, "%s", crops.c_str());
+    fail_unless(crops.find("\"track_id\":101") != std::string::npos, "%s", crops.c_str());
+
+    gst_buffer_unref(out);
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_snapshot_async: snapshot-async=true → message without frameData,
+// the snapshot follows on a later buffer with the same seqId
+// Target: SnapshotEncoder submit/take_finished, transform_ip follow-up attach
+GST_START_TEST(CE_msgconv_snapshot_async) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, "include-frame", TRUE,
+                 "snapshot-async", TRUE, "snapshot-workers", 1, nullptr);
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(
+        h, "video/x-raw,format=NV12,width=64,height=48,framerate=30/1");
+
+    gst_harness_push(h, make_nv12_buf_with_meta(64, 48, 1));
+    GstBuffer *out = gst_harness_pull(h);
+    fail_unless(out != nullptr && has_msg_meta(out));
+    fail_unless(payload_string(out).find("frameData") == std::string::npos);
+    gst_buffer_unref(out);
+
+    // Buffers without DXFrameMeta still carry finished snapshots.
+    std::string snapshot;
+    for (int i = 0; i < 200 && snapshot.empty(); i++) {
+        g_usleep(10000);
+        gst_harness_push(h, gst_buffer_new_allocate(nullptr, 64 * 48 * 3 / 2, nullptr));
+        out = gst_harness_pull(h);
+        if (extra_count(out) > 0)
+            snapshot = extra_string(out, 0);
+        gst_buffer_unref(out);
+    }
+    fail_unless(snapshot.find("\"snapshot\":{\"width\":64,\"height\":48") !=
+                    std::string::npos, "snapshot expected: %s", snapshot.c_str());
+    fail_unless(snapshot.find("\"seqId\":1") != std::string::npos, "%s", snapshot.c_str());
+
+    guint64 dropped = 1;
+    g_object_get(e, "snapshots-dropped", &dropped, nullptr);
+    fail_unless_equals_int(dropped, 0);
+
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_snapshot_async_eos: a snapshot still being encoded at EOS is
+// pushed in a final message-only buffer ahead of the EOS event
+// Target: SnapshotEncoder::drain, sink_event EOS flush
+GST_START_TEST(CE_msgconv_snapshot_async_eos) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, "include-frame", TRUE,
+                 "snapshot-async", TRUE, "snapshot-workers", 1, nullptr);
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(
+        h, "video/x-raw,format=NV12,width=64,height=48,framerate=30/1");
+
+    gst_harness_push(h, make_nv12_buf_with_meta(64, 48, 1));
+    fail_unless(gst_harness_push_event(h, gst_event_new_eos()));
+
+    // The worker may have finished before the first buffer left; otherwise
+    // the snapshot comes in the final buffer.
+    std::string snapshot;
+    GstBuffer *out;
+    while ((out = gst_harness_try_pull(h)) != nullptr) {
+        if (extra_count(out) > 0)
+            snapshot = extra_string(out, 0);
+        gst_buffer_unref(out);
+    }
+    fail_unless(snapshot.find("\"seqId\":1") != std::string::npos,
+                "snapshot expected before EOS: %s", snapshot.c_str());
+
+    GstEvent *ev;
+    bool eos = false;
+    while ((ev = gst_harness_try_pull_event(h)) != nullptr) {
+        eos |= GST_EVENT_TYPE(ev) == GST_EVENT_EOS;
+        gst_event_unref(ev);
+    }
+    fail_unless(eos, "EOS not forwarded");
+
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_emit_on_change: emit-mode=on-change → identical frames send nothing
+// Target: StreamEmitState::changed, convert() on-change branch
+GST_START_TEST(CE_msgconv_emit_on_change) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "emit-mode", "on-change");
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(h, CAPS_STR);
+
+    const int objects[] = {2, 2, 2, 1, 1, 2};
+    std::string sent;
+    for (int i = 0; i < 6; i++) {
+        gst_harness_push(h, make_buf_with_meta(i * GST_SECOND / 30, 0, objects[i]));
+        GstBuffer *out = gst_harness_pull(h);
+        sent += has_msg_meta(out) ? "M" : ".";
+        gst_buffer_unref(out);
+    }
+    fail_unless(sent == "M..M.M", "unexpected emission pattern %s", sent.c_str());
+
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_emit_events: emit-mode=events → enter on first sight, exit after
+// track-timeout unseen; nothing in between
+// Target: StreamEmitState::track, track_events_message
+GST_START_TEST(CE_msgconv_emit_events) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, "track-timeout", 100, nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "emit-mode", "events");
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(h, CAPS_STR);
+
+    std::vector<std::string> messages;
+    for (int i = 0; i < 8; i++) {
+        GstBuffer *in = make_buf(i * 50 * GST_MSECOND);
+        DXFrameMeta *fm = make_frame_meta(in, 0, 4, 4);
+        if (i < 3)
+            add_object_to_frame(fm, 1, 0.9f, 0, 0, 2, 2, 7);
+        gst_harness_push(h, in);
+        GstBuffer *out = gst_harness_pull(h);
+        messages.push_back(payload_string(out));
+        gst_buffer_unref(out);
+    }
+
+    fail_unless(messages[0].find("\"event\":\"enter\",\"track_id\":7") != std::string::npos,
+                "enter expected: %s", messages[0].c_str());
+    // Last seen at 100 ms, unseen for more than 100 ms at 250 ms.
+    for (int i = 1; i < 8; i++) {
+        if (i == 5) {
+            fail_unless(messages[i].find("\"event\":\"exit\"") != std::string::npos,
+                        "exit expected: %s", messages[i].c_str());
+        } else {
+            fail_unless(messages[i].empty(), "frame %d: %s", i, messages[i].c_str());
+        }
+    }
+
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// CE_msgconv_emit_counts: emit-mode=counts → one message per closed
+// count-window; the window still open at EOS is sent before EOS
+// Target: StreamEmitState::count / flush_count, class_counts_message
+GST_START_TEST(CE_msgconv_emit_counts) {
+    GstElement *e = gst_element_factory_make("dxmsgconv", nullptr);
+    g_object_set(e, "library-file-path", MSGCONV_LIB, "count-window", 100, nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "emit-mode", "counts");
+    GstHarness *h = gst_harness_new_with_element(e, "sink", "src");
+    gst_harness_set_src_caps_str(h, CAPS_STR);
+
+    // Frames every 50 ms: track 7 throughout, track 8 joins at 150 ms.
+    std::vector<std::string> messages;
+    for (int i = 0; i < 5; i++) {
+        GstBuffer *in = make_buf(i * 50 * GST_MSECOND);
+        DXFrameMeta *fm = make_frame_meta(in, 0, 4, 4);
+        add_object_to_frame(fm, 1, 0.9f, 0, 0, 2, 2, 7);
+        if (i >= 3)
+            add_object_to_frame(fm, 1, 0.9f, 2, 2, 2, 2, 8);
+        gst_harness_push(h, in);
+        GstBuffer *out = gst_harness_pull(h);
+        messages.push_back(payload_string(out));
+        gst_buffer_unref(out);
+    }
+
+    for (int i : {0, 1, 3})
+        fail_unless(messages[i].empty(), "frame %d: %s", i, messages[i].c_str());
+    fail_unless(messages[2].find("\"window\":{\"start\":0,\"end\":0.1}") !=
+                    std::string::npos, "first window expected: %s", messages[2].c_str());
+    fail_unless(messages[2].find("\"tracks\":1,\"max\":1") != std::string::npos,
+                "%s", messages[2].c_str());
+    fail_unless(messages[4].find("\"window\":{\"start\":0.1,\"end\":0.2}") !=
+                    std::string::npos, "second window expected: %s", messages[4].c_str());
+    fail_unless(messages[4].find("\"tracks\":2,\"max\":2") != std::string::npos,
+                "%s", messages[4].c_str());
+
+    // The window opened by the last frame is flushed at EOS.
+    fail_unless(gst_harness_push_event(h, gst_event_new_eos()));
+    GstBuffer *out = gst_harness_try_pull(h);
+    fail_unless(out != nullptr, "no final message buffer at EOS");
+    fail_unless_equals_int(extra_count(out), 1);
+    std::string last = extra_string(out, 0);
+    fail_unless(last.find("\"window\":{\"start\":0.2,\"end\":0.2}") !=
+                    std::string::npos, "open window expected: %s", last.c_str());
+    fail_unless(last.find("\"tracks\":2,\"max\":2") != std::string::npos,
+                "%s", last.c_str());
+    gst_buffer_unref(out);
+
+    gst_harness_teardown(h);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
 // CE_msgconv_message_interval: message-interval=3 → only every 3rd buffer is converted
 // Target: convert() L383-384 (seq_id % message_interval)
 // MUT: remove L383 condition → all buffers converted
@@ -284,7 +619,15 @@ static Suite *dxmsgconv_suite(void) {
     tcase_add_test(tc, CE_msgconv_bad_config_path_uses_properties);
     tcase_add_test(tc, CE_msgconv_no_meta_passthrough);
     tcase_add_test(tc, CE_msgconv_payload_attached);
+    tcase_add_test(tc, CE_msgconv_binary_format);
+    tcase_add_test(tc, CE_msgconv_snapshot_inline);
+    tcase_add_test(tc, CE_msgconv_snapshot_crops);
+    tcase_add_test(tc, CE_msgconv_snapshot_async);
+    tcase_add_test(tc, CE_msgconv_snapshot_async_eos);
     tcase_add_test(tc, CE_msgconv_message_interval);
+    tcase_add_test(tc, CE_msgconv_emit_on_change);
+    tcase_add_test(tc, CE_msgconv_emit_events);
+    tcase_add_test(tc, CE_msgconv_emit_counts);
     tcase_add_test(tc, CE_msgconv_dlclose_reopen);
     tcase_add_test(tc, CE_msgconv_config_loads_properties);
     return s;
@@ -10,6 +10,7 @@
 #include "meta_helpers.hpp"
 
 #include <cstring>
+#include <vector>
 
 using namespace dxtest;
 
@@ -318,6 +319,110 @@ GST_START_TEST(CE_gather_3branch_pts_match) {
 }
 GST_END_TEST;
 
+// Merged object as seen on the output buffer, for comparing merge paths.
+struct MergedObject {
+    int meta_id;
+    int label;
+    float box_x;
+    std::vector<float> body_feature;
+
+    bool operator==(const MergedObject &o) const {
+        return meta_id == o.meta_id && label == o.label && box_x == o.box_x &&
+               body_feature == o.body_feature;
+    }
+};
+
+// 3 branches x N objects: branch 0 has boxes, branch 1 features for the same
+// meta_ids in reverse order, branch 2 N/2 new meta_ids each listed twice.
+// With keep_branch_refs the test holds branches 1 and 2 while they are
+// merged, so dxgather must copy from them instead of stealing.
+static std::vector<MergedObject> run_indexed_merge(int N, bool keep_branch_refs) {
+    GatherPipeline gp(3);
+
+    GstBuffer *b0 = make_buf(0, 0);
+    GstBuffer *b1 = make_buf(0, 0);
+    GstBuffer *b2 = make_buf(0, 0);
+    DXFrameMeta *fm0 = dx_get_frame_meta(b0);
+    DXFrameMeta *fm1 = dx_get_frame_meta(b1);
+    DXFrameMeta *fm2 = dx_get_frame_meta(b2);
+    for (int i = 0; i < N; i++) {
+        DXObjectMeta *o0 = add_object_to_frame(fm0, 1, 0.9f, i, i, 10, 10);
+        o0->_meta_id = i;
+
+        DXObjectMeta *o1 = dx_acquire_obj_meta_from_pool();
+        o1->_meta_id = N - 1 - i;
+        o1->_body_feature.assign(8, (float)(N - 1 - i));
+        dx_add_obj_meta_to_frame(fm1, o1);
+
+        DXObjectMeta *o2 = add_object_to_frame(fm2, 2, 0.5f, 0, 0, 1, 1);
+        o2->_meta_id = N + i / 2;
+    }
+
+    if (keep_branch_refs) {
+        gst_buffer_ref(b1);
+        gst_buffer_ref(b2);
+    }
+    gp.push(gp.src0, b0);
+    gp.push(gp.src1, b1);
+    gp.push(gp.src2, b2);
+
+    GstBuffer *out = gp.pull();
+    fail_unless(out != nullptr);
+    DXFrameMeta *fm_out = dx_get_frame_meta(out);
+    fail_unless(fm_out != nullptr);
+
+    std::vector<MergedObject> merged;
+    for (auto *obj : fm_out->_object_meta_list)
+        merged.push_back({obj->_meta_id, obj->_label, obj->_box[0], obj->_body_feature});
+    gst_buffer_unref(out);
+
+    if (keep_branch_refs) {
+        // Copy path: the shared branch buffers keep every object and field.
+        fail_unless_equals_int((int)fm1->_object_meta_list.size(), N);
+        for (auto *obj : fm1->_object_meta_list)
+            fail_unless_equals_int((int)obj->_body_feature.size(), 8);
+        fail_unless_equals_int((int)fm2->_object_meta_list.size(), N);
+        gst_buffer_unref(b1);
+        gst_buffer_unref(b2);
+    }
+    return merged;
+}
+
+// CE_gather_indexed_merge_100_objects: 3 branches x 100 objects. Matching
+// meta_ids merge field-by-field, new meta_ids are appended exactly once.
+// Target: frame_meta_merge meta_id index + steal path for discarded buffers
+// MUT: drop the index update after append → duplicates in branch 2
+GST_START_TEST(CE_gather_indexed_merge_100_objects) {
+    const int N = 100;
+    std::vector<MergedObject> merged = run_indexed_merge(N, false);
+    fail_unless_equals_int((int)merged.size(), N + N / 2);
+
+    for (const auto &obj : merged) {
+        if (obj.meta_id < N) {
+            fail_unless_equals_int((int)obj.box_x, obj.meta_id);
+            fail_unless_equals_int((int)obj.body_feature.size(), 8);
+            fail_unless_equals_int((int)obj.body_feature[0], obj.meta_id);
+        } else {
+            fail_unless_equals_int(obj.label, 2);
+        }
+    }
+}
+GST_END_TEST;
+
+// CE_gather_indexed_merge_shared_branches: same merge with branch buffers
+// still referenced elsewhere (as behind a tee) takes the copy path, leaves
+// the branch buffers intact and produces exactly the steal path's objects.
+// Target: frame_meta_merge copy path (gst_buffer_is_writable(buf1) false)
+// MUT: steal regardless of writability → branch 1 features moved out
+GST_START_TEST(CE_gather_indexed_merge_shared_branches) {
+    const int N = 100;
+    std::vector<MergedObject> stolen = run_indexed_merge(N, false);
+    std::vector<MergedObject> copied = run_indexed_merge(N, true);
+    fail_unless_equals_int((int)copied.size(), (int)stolen.size());
+    fail_unless(copied == stolen, "copy and steal paths must merge the same objects");
+}
+GST_END_TEST;
+
 static Suite *dxgather_branches_suite(void) {
     Suite *s = suite_create("dxgather_branches");
     TCase *tc = tcase_create("3branch_merge");
@@ -327,6 +432,8 @@ static Suite *dxgather_branches_suite(void) {
     tcase_add_test(tc, CE_gather_3branch_different_meta_ids);
     tcase_add_test(tc, CE_gather_merge_preserves_existing);
     tcase_add_test(tc, CE_gather_3branch_pts_match);
+    tcase_add_test(tc, CE_gather_indexed_merge_100_objects);
+    tcase_add_test(tc, CE_gather_indexed_merge_shared_branches);
     return s;
 }
 
@@ -0,0 +1,315 @@
+// dxgather skew-tolerant join tests
+// Core: join-mode=partial merges every branch whose head lies within
+// pts-tolerance of the oldest head and marks the others in
+// DXFrameMeta::_skipped_branches instead of dropping frames. With live
+// sources an empty branch is given up on after pad-timeout. join-mode=drop
+// keeps the legacy latest-PTS behaviour.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+#include "meta_helpers.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace dxtest;
+
+static const char *CAPS_RGB_4 =
+    "video/x-raw,format=RGB,width=4,height=4,framerate=30/1";
+static const GstClockTime FRAME = GST_SECOND / 30;
+
+// One object per branch buffer; meta_id = 100 * branch + frame so merged
+// frames carry one object per contributing branch.
+static GstBuffer *make_branch_buf(GstClockTime pts, int branch, int frame) {
+    gsize sz = 4 * 4 * 3;
+    GstBuffer *b = gst_buffer_new_allocate(nullptr, sz, nullptr);
+    GstMapInfo map;
+    gst_buffer_map(b, &map, GST_MAP_WRITE);
+    memset(map.data, 0x80, sz);
+    gst_buffer_unmap(b, &map);
+    GST_BUFFER_PTS(b) = pts;
+    GST_BUFFER_DURATION(b) = FRAME;
+    DXFrameMeta *fm = make_frame_meta(b, 0, 4, 4);
+    DXObjectMeta *obj = dx_acquire_obj_meta_from_pool();
+    obj->_meta_id = 100 * branch + frame;
+    dx_add_obj_meta_to_frame(fm, obj);
+    return b;
+}
+
+struct JoinPipe {
+    GstElement *pipe, *gather, *sink;
+    GstElement *src[2];
+};
+
+static JoinPipe make_join_pipe(const char *join_mode, gboolean live) {
+    JoinPipe p = {};
+    p.pipe = gst_pipeline_new(nullptr);
+    p.gather = gst_element_factory_make("dxgather", "gather");
+    p.sink = gst_element_factory_make("appsink", "sink");
+    gst_util_set_object_arg(G_OBJECT(p.gather), "join-mode", join_mode);
+    g_object_set(p.sink, "sync", FALSE, nullptr);
+    gst_bin_add_many(GST_BIN(p.pipe), p.gather, p.sink, nullptr);
+    gst_element_link(p.gather, p.sink);
+
+    GstCaps *caps = gst_caps_from_string(CAPS_RGB_4);
+    for (int i = 0; i < 2; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "src%d", i);
+        p.src[i] = gst_element_factory_make("appsrc", name);
+        g_object_set(p.src[i], "format", GST_FORMAT_TIME, "is-live", live,
+                     "caps", caps, nullptr);
+        gst_bin_add(GST_BIN(p.pipe), p.src[i]);
+
+        snprintf(name, sizeof(name), "sink_%d", i);
+        GstPad *req = gst_element_get_request_pad(p.gather, name);
+        fail_unless(req != nullptr, "request pad %s failed", name);
+        GstPad *srcpad = gst_element_get_static_pad(p.src[i], "src");
+        fail_unless(gst_pad_link(srcpad, req) == GST_PAD_LINK_OK);
+        gst_object_unref(srcpad);
+        gst_object_unref(req);
+    }
+    gst_caps_unref(caps);
+    return p;
+}
+
+static void free_join_pipe(JoinPipe &p) {
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+
+struct JoinOutput {
+    GstClockTime pts;
+    guint64 skipped;
+    size_t objects;
+};
+
+static std::vector<JoinOutput> pull_until_eos(JoinPipe &p) {
+    std::vector<JoinOutput> out;
+    for (;;) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                    5 * GST_SECOND);
+        if (!s)
+            break;
+        GstBuffer *buf = gst_sample_get_buffer(s);
+        DXFrameMeta *fm = dx_get_frame_meta(buf);
+        fail_unless(fm != nullptr);
+        out.push_back({GST_BUFFER_PTS(buf), fm->_skipped_branches,
+                       fm->_object_meta_list.size()});
+        gst_sample_unref(s);
+    }
+    fail_unless(gst_app_sink_is_eos(GST_APP_SINK(p.sink)), "no EOS");
+    return out;
+}
+
+// Branch 1 has no frame 1; branch 0 delivers all three.
+static void push_gap_pattern(JoinPipe &p) {
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    for (int i = 0; i < 3; i++)
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[0]),
+                                make_branch_buf(i * FRAME, 0, i));
+    for (int i : {0, 2})
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[1]),
+                                make_branch_buf(i * FRAME, 1, i));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[0]));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[1]));
+}
+
+GST_START_TEST(JOIN_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxgather", nullptr);
+    gint mode = -1;
+    guint tolerance = 99, timeout = 0;
+    g_object_get(e, "join-mode", &mode, "pts-tolerance", &tolerance,
+                 "pad-timeout", &timeout, nullptr);
+    fail_unless_equals_int(mode, 0);  // drop
+    fail_unless_equals_int(tolerance, 0);
+    fail_unless_equals_int(timeout, 100);
+
+    gst_util_set_object_arg(G_OBJECT(e), "join-mode", "partial");
+    g_object_set(e, "pts-tolerance", 5u, "pad-timeout", 40u, nullptr);
+    g_object_get(e, "join-mode", &mode, "pts-tolerance", &tolerance,
+                 "pad-timeout", &timeout, nullptr);
+    fail_unless_equals_int(mode, 1);
+    fail_unless_equals_int(tolerance, 5);
+    fail_unless_equals_int(timeout, 40);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// JOIN_partial_merges_missing_branch: the frame branch 1 lacks is still
+// output, carrying only branch 0's object and skipped bit 1.
+GST_START_TEST(JOIN_partial_merges_missing_branch) {
+    JoinPipe p = make_join_pipe("partial", FALSE);
+    push_gap_pattern(p);
+    auto out = pull_until_eos(p);
+
+    fail_unless_equals_int((int)out.size(), 3);
+    for (int i = 0; i < 3; i++)
+        fail_unless_equals_uint64(out[i].pts, i * FRAME);
+    fail_unless_equals_uint64(out[0].skipped, 0);
+    fail_unless_equals_int((int)out[0].objects, 2);
+    fail_unless_equals_uint64(out[1].skipped, 0x2);
+    fail_unless_equals_int((int)out[1].objects, 1);
+    fail_unless_equals_uint64(out[2].skipped, 0);
+    fail_unless_equals_int((int)out[2].objects, 2);
+    free_join_pipe(p);
+}
+GST_END_TEST;
+
+// JOIN_drop_mode_drops_unmatched: the legacy mode drops branch 0's frame 1.
+GST_START_TEST(JOIN_drop_mode_drops_unmatched) {
+    JoinPipe p = make_join_pipe("drop", FALSE);
+    push_gap_pattern(p);
+    auto out = pull_until_eos(p);
+
+    fail_unless_equals_int((int)out.size(), 2);
+    fail_unless_equals_uint64(out[0].pts, 0);
+    fail_unless_equals_uint64(out[1].pts, 2 * FRAME);
+    free_join_pipe(p);
+}
+GST_END_TEST;
+
+// JOIN_tolerance_absorbs_jitter: branch 1 stamps 2 ms late; with a 5 ms
+// tolerance every frame merges both branches.
+GST_START_TEST(JOIN_tolerance_absorbs_jitter) {
+    JoinPipe p = make_join_pipe("partial", FALSE);
+    g_object_set(p.gather, "pts-tolerance", 5u, nullptr);
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    for (int i = 0; i < 3; i++) {
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[0]),
+                                make_branch_buf(i * FRAME, 0, i));
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[1]),
+                                make_branch_buf(i * FRAME + 2 * GST_MSECOND, 1, i));
+    }
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[0]));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[1]));
+    auto out = pull_until_eos(p);
+
+    fail_unless_equals_int((int)out.size(), 3);
+    for (auto &o : out) {
+        fail_unless_equals_uint64(o.skipped, 0);
+        fail_unless_equals_int((int)o.objects, 2);
+    }
+    free_join_pipe(p);
+}
+GST_END_TEST;
+
+// JOIN_live_pad_timeout: with live sources a silent branch does not block
+// the other; its frames are output once pad-timeout expires.
+GST_START_TEST(JOIN_live_pad_timeout) {
+    JoinPipe p = make_join_pipe("partial", TRUE);
+    g_object_set(p.gather, "pad-timeout", 20u, nullptr);
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    gst_app_src_push_buffer(GST_APP_SRC(p.src[0]), make_branch_buf(0, 0, 0));
+
+    GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                5 * GST_SECOND);
+    fail_unless(s != nullptr, "silent branch blocked the join");
+    DXFrameMeta *fm = dx_get_frame_meta(gst_sample_get_buffer(s));
+    fail_unless(fm != nullptr);
+    fail_unless_equals_uint64(fm->_skipped_branches, 0x2);
+    fail_unless_equals_int((int)fm->_object_meta_list.size(), 1);
+    gst_sample_unref(s);
+    free_join_pipe(p);
+}
+GST_END_TEST;
+
+// JOIN_tolerance_wider_than_frame: a branch that missed frame 0 catches up
+// with frame 1. A pts-tolerance above the frame duration must not make its
+// frames look stale; frames 1 and 2 still merge both branches.
+GST_START_TEST(JOIN_tolerance_wider_than_frame) {
+    JoinPipe p = make_join_pipe("partial", TRUE);
+    g_object_set(p.gather, "pad-timeout", 20u, "pts-tolerance", 50u, nullptr);
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    gst_app_src_push_buffer(GST_APP_SRC(p.src[0]), make_branch_buf(0, 0, 0));
+
+    GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                5 * GST_SECOND);
+    fail_unless(s != nullptr, "silent branch blocked the join");
+    gst_sample_unref(s);
+
+    for (int i = 1; i < 3; i++) {
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[1]),
+                                make_branch_buf(i * FRAME, 1, i));
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[0]),
+                                make_branch_buf(i * FRAME, 0, i));
+    }
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[0]));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[1]));
+    auto out = pull_until_eos(p);
+
+    fail_unless_equals_int((int)out.size(), 2);
+    for (int i = 0; i < 2; i++) {
+        fail_unless_equals_uint64(out[i].pts, (i + 1) * FRAME);
+        fail_unless_equals_uint64(out[i].skipped, 0);
+        fail_unless_equals_int((int)out[i].objects, 2);
+    }
+    free_join_pipe(p);
+}
+GST_END_TEST;
+
+static gboolean accept_seek(GstAppSrc *, guint64, gpointer) {
+    return TRUE;
+}
+
+// JOIN_partial_seek_back: after three merged frames a backwards flushing
+// seek replays frames 0 and 1. The flush must clear the last emitted frame,
+// otherwise every replayed head looks stale and nothing is output.
+// Target: gst_dxgather_sink_event FLUSH_STOP (_last_running_time reset)
+// MUT: drop the reset → out is empty after the seek
+GST_START_TEST(JOIN_partial_seek_back) {
+    JoinPipe p = make_join_pipe("partial", FALSE);
+    for (int b = 0; b < 2; b++) {
+        gst_util_set_object_arg(G_OBJECT(p.src[b]), "stream-type", "seekable");
+        g_signal_connect(p.src[b], "seek-data", G_CALLBACK(accept_seek), nullptr);
+    }
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    for (int i = 0; i < 3; i++)
+        for (int b = 0; b < 2; b++)
+            gst_app_src_push_buffer(GST_APP_SRC(p.src[b]),
+                                    make_branch_buf(i * FRAME, b, i));
+    for (int i = 0; i < 3; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                    5 * GST_SECOND);
+        fail_unless(s != nullptr, "frame %d not merged", i);
+        gst_sample_unref(s);
+    }
+
+    fail_unless(gst_element_seek_simple(p.pipe, GST_FORMAT_TIME,
+                                        GST_SEEK_FLAG_FLUSH, 0),
+                "flushing seek failed");
+    for (int i = 0; i < 2; i++)
+        for (int b = 0; b < 2; b++)
+            gst_app_src_push_buffer(GST_APP_SRC(p.src[b]),
+                                    make_branch_buf(i * FRAME, b, i));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[0]));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[1]));
+    auto out = pull_until_eos(p);
+
+    fail_unless_equals_int((int)out.size(), 2);
+    for (int i = 0; i < 2; i++) {
+        fail_unless_equals_uint64(out[i].pts, i * FRAME);
+        fail_unless_equals_uint64(out[i].skipped, 0);
+        fail_unless_equals_int((int)out[i].objects, 2);
+    }
+    free_join_pipe(p);
+}
+GST_END_TEST;
+
+static Suite *dxgather_join_suite(void) {
+    Suite *s = suite_create("dxgather_join");
+    TCase *tc = tcase_create("join");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, JOIN_property_defaults_and_set);
+    tcase_add_test(tc, JOIN_partial_merges_missing_branch);
+    tcase_add_test(tc, JOIN_drop_mode_drops_unmatched);
+    tcase_add_test(tc, JOIN_tolerance_absorbs_jitter);
+    tcase_add_test(tc, JOIN_live_pad_timeout);
+    tcase_add_test(tc, JOIN_tolerance_wider_than_frame);
+    tcase_add_test(tc, JOIN_partial_seek_back);
+    return s;
+}
+
+GST_CHECK_MAIN(dxgather_join);
@@ -0,0 +1,144 @@
+// dxinputselector live-mode tests
+// Core: with live-mode=true and live upstreams, a stream that stops delivering
+// must not block the others. Once the oldest pending frame has waited the
+// latency budget of every empty pad, aggregate(timeout) outputs it and skips
+// the late pads. Without live-mode the element keeps waiting for all pads.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+
+#include <cstring>
+
+static const char *CAPS_RGB_4 =
+    "video/x-raw,format=RGB,width=4,height=4,framerate=30/1";
+
+static GstBuffer *make_buf(GstClockTime pts) {
+    gsize sz = 4 * 4 * 3;
+    GstBuffer *b = gst_buffer_new_allocate(nullptr, sz, nullptr);
+    GstMapInfo map;
+    gst_buffer_map(b, &map, GST_MAP_WRITE);
+    memset(map.data, 0x80, sz);
+    gst_buffer_unmap(b, &map);
+    GST_BUFFER_PTS(b) = pts;
+    GST_BUFFER_DURATION(b) = GST_SECOND / 30;
+    return b;
+}
+
+struct LivePipe {
+    GstElement *pipe, *agg, *sink;
+    GstElement *src[2];
+};
+
+static LivePipe make_live_pipe(gboolean live_mode) {
+    LivePipe p = {};
+    p.pipe = gst_pipeline_new(nullptr);
+    p.agg = gst_element_factory_make("dxinputselector", "agg");
+    p.sink = gst_element_factory_make("appsink", "sink");
+    g_object_set(p.agg, "live-mode", live_mode, "latency-budget", 20u, nullptr);
+    g_object_set(p.sink, "sync", FALSE, nullptr);
+    gst_bin_add_many(GST_BIN(p.pipe), p.agg, p.sink, nullptr);
+    gst_element_link(p.agg, p.sink);
+
+    GstCaps *caps = gst_caps_from_string(CAPS_RGB_4);
+    for (int i = 0; i < 2; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "src%d", i);
+        p.src[i] = gst_element_factory_make("appsrc", name);
+        g_object_set(p.src[i], "format", GST_FORMAT_TIME, "is-live", TRUE,
+                     "caps", caps, nullptr);
+        gst_bin_add(GST_BIN(p.pipe), p.src[i]);
+
+        snprintf(name, sizeof(name), "sink_%d", i);
+        GstPad *req = gst_element_get_request_pad(p.agg, name);
+        fail_unless(req != nullptr, "request pad %s failed", name);
+        GstPad *srcpad = gst_element_get_static_pad(p.src[i], "src");
+        fail_unless(gst_pad_link(srcpad, req) == GST_PAD_LINK_OK);
+        gst_object_unref(srcpad);
+        gst_object_unref(req);
+    }
+    gst_caps_unref(caps);
+    return p;
+}
+
+GST_START_TEST(LIVE_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxinputselector", nullptr);
+    gboolean live = TRUE;
+    guint budget = 99;
+    g_object_get(e, "live-mode", &live, "latency-budget", &budget, nullptr);
+    fail_unless(!live);
+    fail_unless_equals_int(budget, 0);
+
+    GstPad *pad = gst_element_get_request_pad(e, "sink_0");
+    fail_unless(pad != nullptr);
+    gint pad_budget = 0;
+    g_object_get(pad, "latency-budget", &pad_budget, nullptr);
+    fail_unless_equals_int(pad_budget, -1);
+    g_object_set(pad, "latency-budget", 250, nullptr);
+    g_object_get(pad, "latency-budget", &pad_budget, nullptr);
+    fail_unless_equals_int(pad_budget, 250);
+
+    gst_element_release_request_pad(e, pad);
+    gst_object_unref(pad);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// LIVE_stalled_pad_skipped: src1 never delivers; src0's frames still flow.
+GST_START_TEST(LIVE_stalled_pad_skipped) {
+    LivePipe p = make_live_pipe(TRUE);
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+
+    for (int i = 0; i < 3; i++)
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[0]),
+                                make_buf(i * (GST_SECOND / 30)));
+
+    for (int i = 0; i < 3; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                    5 * GST_SECOND);
+        fail_unless(s != nullptr, "frame %d of the healthy stream blocked", i);
+        fail_unless_equals_uint64(GST_BUFFER_PTS(gst_sample_get_buffer(s)),
+                                  i * (GST_SECOND / 30));
+        gst_sample_unref(s);
+    }
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+// LIVE_default_mode_waits: same topology without live-mode keeps the strict
+// min-PTS merge and waits for the silent pad.
+GST_START_TEST(LIVE_default_mode_waits) {
+    LivePipe p = make_live_pipe(FALSE);
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+
+    gst_app_src_push_buffer(GST_APP_SRC(p.src[0]), make_buf(0));
+    GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                500 * GST_MSECOND);
+    fail_unless(s == nullptr, "default mode must wait for every stream");
+
+    gst_app_src_push_buffer(GST_APP_SRC(p.src[1]), make_buf(10 * GST_MSECOND));
+    s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink), 5 * GST_SECOND);
+    fail_unless(s != nullptr);
+    fail_unless_equals_uint64(GST_BUFFER_PTS(gst_sample_get_buffer(s)), 0);
+    gst_sample_unref(s);
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+static Suite *dxinputselector_live_suite(void) {
+    Suite *s = suite_create("dxinputselector_live");
+    TCase *tc = tcase_create("live");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, LIVE_property_defaults_and_set);
+    tcase_add_test(tc, LIVE_stalled_pad_skipped);
+    tcase_add_test(tc, LIVE_default_mode_waits);
+    return s;
+}
+
+GST_CHECK_MAIN(dxinputselector_live);
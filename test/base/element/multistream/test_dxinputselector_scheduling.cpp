@@ -0,0 +1,209 @@
+// dxinputselector scheduling policy tests
+// Core: scheduling=min-pts keeps the global smallest-PTS merge. round-robin,
+// weighted-rr and deficit serve streams by turn/share regardless of PTS, so a
+// stream with a large timestamp offset cannot starve the others. Per-pad
+// forwarded/skipped counters expose the resulting service.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+#include "gstdxstream/gst-dxframemeta.hpp"
+
+#include <cstring>
+#include <vector>
+
+static const char *CAPS_RGB_4 =
+    "video/x-raw,format=RGB,width=4,height=4,framerate=30/1";
+
+static GstBuffer *make_buf(GstClockTime pts) {
+    gsize sz = 4 * 4 * 3;
+    GstBuffer *b = gst_buffer_new_allocate(nullptr, sz, nullptr);
+    GstMapInfo map;
+    gst_buffer_map(b, &map, GST_MAP_WRITE);
+    memset(map.data, 0x80, sz);
+    gst_buffer_unmap(b, &map);
+    GST_BUFFER_PTS(b) = pts;
+    GST_BUFFER_DURATION(b) = GST_SECOND / 30;
+    return b;
+}
+
+struct SchedPipe {
+    GstElement *pipe, *agg, *sink;
+    GstElement *src[2];
+};
+
+static SchedPipe make_sched_pipe(const char *policy) {
+    SchedPipe p = {};
+    p.pipe = gst_pipeline_new(nullptr);
+    p.agg = gst_element_factory_make("dxinputselector", "agg");
+    p.sink = gst_element_factory_make("appsink", "sink");
+    gst_util_set_object_arg(G_OBJECT(p.agg), "scheduling", policy);
+    g_object_set(p.sink, "sync", FALSE, nullptr);
+    gst_bin_add_many(GST_BIN(p.pipe), p.agg, p.sink, nullptr);
+    gst_element_link(p.agg, p.sink);
+
+    GstCaps *caps = gst_caps_from_string(CAPS_RGB_4);
+    for (int i = 0; i < 2; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "src%d", i);
+        p.src[i] = gst_element_factory_make("appsrc", name);
+        g_object_set(p.src[i], "format", GST_FORMAT_TIME, "is-live", FALSE,
+                     "caps", caps, nullptr);
+        gst_bin_add(GST_BIN(p.pipe), p.src[i]);
+
+        snprintf(name, sizeof(name), "sink_%d", i);
+        GstPad *req = gst_element_get_request_pad(p.agg, name);
+        fail_unless(req != nullptr, "request pad %s failed", name);
+        GstPad *srcpad = gst_element_get_static_pad(p.src[i], "src");
+        fail_unless(gst_pad_link(srcpad, req) == GST_PAD_LINK_OK);
+        gst_object_unref(srcpad);
+        gst_object_unref(req);
+    }
+    gst_caps_unref(caps);
+    return p;
+}
+
+static void set_pad_weight(SchedPipe &p, const char *pad_name, guint weight) {
+    GstPad *pad = gst_element_get_static_pad(p.agg, pad_name);
+    fail_unless(pad != nullptr);
+    g_object_set(pad, "weight", weight, nullptr);
+    gst_object_unref(pad);
+}
+
+static guint64 pad_counter(SchedPipe &p, const char *pad_name,
+                           const char *counter) {
+    GstPad *pad = gst_element_get_static_pad(p.agg, pad_name);
+    fail_unless(pad != nullptr);
+    guint64 v = 0;
+    g_object_get(pad, counter, &v, nullptr);
+    gst_object_unref(pad);
+    return v;
+}
+
+// Stream 1 runs 10 s ahead of stream 0. Pushes n0/n1 frames, EOS on both and
+// returns the stream id of every output frame in order.
+static std::vector<int> run_offset_streams(SchedPipe &p, int n0, int n1) {
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    for (int i = 0; i < n0; i++)
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[0]),
+                                make_buf(i * (GST_SECOND / 30)));
+    for (int i = 0; i < n1; i++)
+        gst_app_src_push_buffer(GST_APP_SRC(p.src[1]),
+                                make_buf(10 * GST_SECOND + i * (GST_SECOND / 30)));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[0]));
+    gst_app_src_end_of_stream(GST_APP_SRC(p.src[1]));
+
+    std::vector<int> order;
+    for (int i = 0; i < n0 + n1; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink),
+                                                    5 * GST_SECOND);
+        fail_unless(s != nullptr, "output %d missing", i);
+        DXFrameMeta *fm = dx_get_frame_meta(gst_sample_get_buffer(s));
+        fail_unless(fm != nullptr);
+        order.push_back(fm->_stream_id);
+        gst_sample_unref(s);
+    }
+    return order;
+}
+
+GST_START_TEST(SCH_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxinputselector", nullptr);
+    gint policy = -1;
+    guint window = 0;
+    g_object_get(e, "scheduling", &policy, "fairness-window", &window, nullptr);
+    fail_unless_equals_int(policy, 0);  // min-pts
+    fail_unless_equals_int(window, 1000);
+
+    gst_util_set_object_arg(G_OBJECT(e), "scheduling", "deficit");
+    g_object_set(e, "fairness-window", 250u, nullptr);
+    g_object_get(e, "scheduling", &policy, "fairness-window", &window, nullptr);
+    fail_unless_equals_int(policy, 3);
+    fail_unless_equals_int(window, 250);
+
+    GstPad *pad = gst_element_get_request_pad(e, "sink_0");
+    guint weight = 0;
+    guint64 fwd = 99, skp = 99;
+    g_object_get(pad, "weight", &weight, "forwarded", &fwd, "skipped", &skp,
+                 nullptr);
+    fail_unless_equals_int(weight, 1);
+    fail_unless_equals_uint64(fwd, 0);
+    fail_unless_equals_uint64(skp, 0);
+    gst_element_release_request_pad(e, pad);
+    gst_object_unref(pad);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// SCH_min_pts_starves_offset_stream: the default policy serves stream 1 only
+// after stream 0 has drained, and its counters show the wait.
+GST_START_TEST(SCH_min_pts_starves_offset_stream) {
+    SchedPipe p = make_sched_pipe("min-pts");
+    auto order = run_offset_streams(p, 3, 3);
+    std::vector<int> expected = {0, 0, 0, 1, 1, 1};
+    fail_unless(order == expected, "min-pts must follow PTS order");
+    fail_unless_equals_uint64(pad_counter(p, "sink_1", "forwarded"), 3);
+    fail_unless(pad_counter(p, "sink_1", "skipped") >= 1);
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+GST_START_TEST(SCH_round_robin_alternates) {
+    SchedPipe p = make_sched_pipe("round-robin");
+    auto order = run_offset_streams(p, 3, 3);
+    std::vector<int> expected = {0, 1, 0, 1, 0, 1};
+    fail_unless(order == expected, "round-robin must alternate streams");
+    fail_unless_equals_uint64(pad_counter(p, "sink_0", "forwarded"), 3);
+    fail_unless_equals_uint64(pad_counter(p, "sink_1", "forwarded"), 3);
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+GST_START_TEST(SCH_weighted_rr_honours_weight) {
+    SchedPipe p = make_sched_pipe("weighted-rr");
+    set_pad_weight(p, "sink_0", 2);
+    auto order = run_offset_streams(p, 4, 2);
+    std::vector<int> expected = {0, 0, 1, 0, 0, 1};
+    fail_unless(order == expected, "weighted-rr must give sink_0 two turns");
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+// SCH_deficit_interleaves: equal weights → neither stream gets ahead by more
+// than one frame while both have frames queued.
+GST_START_TEST(SCH_deficit_interleaves) {
+    SchedPipe p = make_sched_pipe("deficit");
+    auto order = run_offset_streams(p, 3, 3);
+    int served[2] = {0, 0};
+    for (size_t i = 0; i < order.size(); i++) {
+        served[order[i]]++;
+        int diff = served[0] - served[1];
+        fail_unless(diff <= 1 && diff >= -1,
+                    "deficit scheduling let one stream run ahead at output %zu", i);
+    }
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+static Suite *dxinputselector_scheduling_suite(void) {
+    Suite *s = suite_create("dxinputselector_scheduling");
+    TCase *tc = tcase_create("scheduling");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, SCH_property_defaults_and_set);
+    tcase_add_test(tc, SCH_min_pts_starves_offset_stream);
+    tcase_add_test(tc, SCH_round_robin_alternates);
+    tcase_add_test(tc, SCH_weighted_rr_honours_weight);
+    tcase_add_test(tc, SCH_deficit_interleaves);
+    return s;
+}
+
+GST_CHECK_MAIN(dxinputselector_scheduling);
@@ -0,0 +1,191 @@
+// dxoutputselector per-stream output queue tests
+// Core: with max-queue-size > 0 every src pad pushes from its own thread, so
+// a stalled sink on one stream does not block the others. A full queue
+// blocks upstream (leaky=no) or drops and counts buffers on that stream's
+// "dropped" pad property (leaky=upstream/downstream).
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+#include "meta_helpers.hpp"
+
+#include <cstring>
+
+using namespace dxtest;
+
+static const char *CAPS_STR =
+    "video/x-raw,format=RGB,width=4,height=4,framerate=30/1";
+
+static GstBuffer *make_buf_with_meta(GstClockTime pts, int stream_id) {
+    gsize sz = 4 * 4 * 3;
+    GstBuffer *b = gst_buffer_new_allocate(nullptr, sz, nullptr);
+    GstMapInfo map;
+    gst_buffer_map(b, &map, GST_MAP_WRITE);
+    memset(map.data, 0x80, sz);
+    gst_buffer_unmap(b, &map);
+    GST_BUFFER_PTS(b) = pts;
+    GST_BUFFER_DURATION(b) = GST_SECOND / 30;
+    make_frame_meta(b, stream_id, 4, 4);
+    return b;
+}
+
+static void setup_sel_stream(GstElement *sel, int stream_id) {
+    char padname[32];
+    snprintf(padname, sizeof(padname), "src_%d", stream_id);
+    GstPad *srcpad = gst_element_get_static_pad(sel, padname);
+    fail_unless(srcpad != nullptr);
+
+    char sid[32];
+    snprintf(sid, sizeof(sid), "stream%d", stream_id);
+    gst_pad_push_event(srcpad, gst_event_new_stream_start(sid));
+    GstCaps *caps = gst_caps_from_string(CAPS_STR);
+    gst_pad_push_event(srcpad, gst_event_new_caps(caps));
+    gst_caps_unref(caps);
+    GstSegment seg;
+    gst_segment_init(&seg, GST_FORMAT_TIME);
+    gst_pad_push_event(srcpad, gst_event_new_segment(&seg));
+    gst_object_unref(srcpad);
+}
+
+// src_0 feeds an appsink that holds a single buffer and is never pulled, so
+// the stream stalls; src_1 feeds a normal appsink.
+struct QueuePipe {
+    GstElement *pipe, *src, *sel;
+    GstElement *sink[2];
+};
+
+static QueuePipe make_queue_pipe(guint max_queue_size, const char *leaky) {
+    QueuePipe p = {};
+    p.pipe = gst_pipeline_new(nullptr);
+    p.src = gst_element_factory_make("appsrc", "src");
+    p.sel = gst_element_factory_make("dxoutputselector", "sel");
+    g_object_set(p.sel, "max-queue-size", max_queue_size, nullptr);
+    gst_util_set_object_arg(G_OBJECT(p.sel), "leaky", leaky);
+
+    GstCaps *caps = gst_caps_from_string(CAPS_STR);
+    g_object_set(p.src, "format", GST_FORMAT_TIME, "is-live", FALSE,
+                 "caps", caps, nullptr);
+    gst_caps_unref(caps);
+    gst_bin_add_many(GST_BIN(p.pipe), p.src, p.sel, nullptr);
+    gst_element_link(p.src, p.sel);
+
+    for (int i = 0; i < 2; i++) {
+        char sn[32], pn[32];
+        snprintf(sn, sizeof(sn), "sink%d", i);
+        snprintf(pn, sizeof(pn), "src_%d", i);
+        p.sink[i] = gst_element_factory_make("appsink", sn);
+        g_object_set(p.sink[i], "sync", FALSE, "async", FALSE, nullptr);
+        if (i == 0)
+            g_object_set(p.sink[i], "max-buffers", 1u, "drop", FALSE, nullptr);
+        gst_bin_add(GST_BIN(p.pipe), p.sink[i]);
+
+        GstPad *selSrc = gst_element_get_request_pad(p.sel, pn);
+        GstPad *sinkPad = gst_element_get_static_pad(p.sink[i], "sink");
+        fail_unless(gst_pad_link(selSrc, sinkPad) == GST_PAD_LINK_OK);
+        gst_object_unref(selSrc);
+        gst_object_unref(sinkPad);
+    }
+    gst_element_set_state(p.pipe, GST_STATE_PLAYING);
+    setup_sel_stream(p.sel, 0);
+    setup_sel_stream(p.sel, 1);
+    return p;
+}
+
+static guint64 pad_dropped(QueuePipe &p, const char *pad_name) {
+    GstPad *pad = gst_element_get_static_pad(p.sel, pad_name);
+    fail_unless(pad != nullptr);
+    guint64 v = 0;
+    g_object_get(pad, "dropped", &v, nullptr);
+    gst_object_unref(pad);
+    return v;
+}
+
+GST_START_TEST(OQ_property_defaults_and_set) {
+    GstElement *e = gst_element_factory_make("dxoutputselector", nullptr);
+    guint size = 99;
+    gint leaky = -1;
+    g_object_get(e, "max-queue-size", &size, "leaky", &leaky, nullptr);
+    fail_unless_equals_int(size, 0);
+    fail_unless_equals_int(leaky, 0);  // no
+
+    g_object_set(e, "max-queue-size", 8u, nullptr);
+    gst_util_set_object_arg(G_OBJECT(e), "leaky", "downstream");
+    g_object_get(e, "max-queue-size", &size, "leaky", &leaky, nullptr);
+    fail_unless_equals_int(size, 8);
+    fail_unless_equals_int(leaky, 2);
+
+    GstPad *pad = gst_element_get_request_pad(e, "src_0");
+    fail_unless(pad != nullptr);
+    guint64 dropped = 99;
+    g_object_get(pad, "dropped", &dropped, nullptr);
+    fail_unless_equals_uint64(dropped, 0);
+    gst_element_release_request_pad(e, pad);
+    gst_object_unref(pad);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// OQ_stalled_stream_isolated: stream 0 stalls; stream 1 still receives all
+// of its frames and stream 0's overflow is counted as dropped.
+GST_START_TEST(OQ_stalled_stream_isolated) {
+    QueuePipe p = make_queue_pipe(2, "downstream");
+
+    const int n = 10;
+    for (int i = 0; i < n; i++) {
+        gst_app_src_push_buffer(GST_APP_SRC(p.src),
+                                make_buf_with_meta(i * GST_MSECOND, 0));
+        gst_app_src_push_buffer(GST_APP_SRC(p.src),
+                                make_buf_with_meta(i * GST_MSECOND, 1));
+    }
+    for (int i = 0; i < n; i++) {
+        GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink[1]),
+                                                    5 * GST_SECOND);
+        fail_unless(s != nullptr, "stream 1 frame %d blocked by stream 0", i);
+        gst_sample_unref(s);
+    }
+    fail_unless(pad_dropped(p, "src_0") > 0);
+    fail_unless_equals_uint64(pad_dropped(p, "src_1"), 0);
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+// OQ_leaky_upstream_keeps_oldest: the stalled stream keeps the first frames
+// and drops the newer ones.
+GST_START_TEST(OQ_leaky_upstream_keeps_oldest) {
+    QueuePipe p = make_queue_pipe(2, "upstream");
+
+    for (int i = 0; i < 10; i++)
+        gst_app_src_push_buffer(GST_APP_SRC(p.src),
+                                make_buf_with_meta(i * GST_MSECOND, 0));
+    gst_app_src_push_buffer(GST_APP_SRC(p.src), make_buf_with_meta(0, 1));
+    GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink[1]),
+                                                5 * GST_SECOND);
+    fail_unless(s != nullptr);
+    gst_sample_unref(s);
+    fail_unless(pad_dropped(p, "src_0") > 0);
+
+    s = gst_app_sink_try_pull_sample(GST_APP_SINK(p.sink[0]), 5 * GST_SECOND);
+    fail_unless(s != nullptr);
+    fail_unless_equals_uint64(GST_BUFFER_PTS(gst_sample_get_buffer(s)), 0);
+    gst_sample_unref(s);
+
+    gst_element_set_state(p.pipe, GST_STATE_NULL);
+    gst_object_unref(p.pipe);
+}
+GST_END_TEST;
+
+static Suite *dxoutputselector_queues_suite(void) {
+    Suite *s = suite_create("dxoutputselector_queues");
+    TCase *tc = tcase_create("queues");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, OQ_property_defaults_and_set);
+    tcase_add_test(tc, OQ_stalled_stream_isolated);
+    tcase_add_test(tc, OQ_leaky_upstream_keeps_oldest);
+    return s;
+}
+
+GST_CHECK_MAIN(dxoutputselector_queues);
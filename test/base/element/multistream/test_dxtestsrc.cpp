@@ -0,0 +1,186 @@
+// dxtestsrc tests
+// Core: num-streams streams are interleaved frame by frame, each buffer
+// carrying a DXFrameMeta with its stream_id; synthetic detections move with
+// the motion model and keep their ground-truth track ids; a recorded tensor
+// set from tensor-dir is attached as _output_tensors[infer-id].
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <glib/gstdio.h>
+#include "gstdxstream/gst-dxframemeta.hpp"
+#include "gstdxstream/gst-dxobjectmeta.hpp"
+
+#include <string>
+#include <vector>
+
+static GstElement *make_pipeline(const char *src_props, GstElement **sink) {
+    gchar *desc = g_strdup_printf(
+        "dxtestsrc name=src %s ! appsink name=sink sync=false", src_props);
+    GError *err = nullptr;
+    GstElement *pipe = gst_parse_launch(desc, &err);
+    g_free(desc);
+    fail_unless(err == nullptr && pipe != nullptr);
+    *sink = gst_bin_get_by_name(GST_BIN(pipe), "sink");
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    return pipe;
+}
+
+static GstSample *pull(GstElement *sink) {
+    GstSample *s = gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 5 * GST_SECOND);
+    fail_unless(s != nullptr, "timeout waiting for a buffer");
+    return s;
+}
+
+static void stop_pipeline(GstElement *pipe, GstElement *sink) {
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(sink);
+    gst_object_unref(pipe);
+}
+
+GST_START_TEST(TSRC_property_defaults) {
+    GstElement *e = gst_element_factory_make("dxtestsrc", nullptr);
+    fail_unless(e != nullptr);
+    guint streams = 0, objects = 99;
+    gint width = 0, height = 0, motion = -1;
+    g_object_get(e, "num-streams", &streams, "width", &width, "height", &height,
+                 "num-objects", &objects, "motion", &motion, nullptr);
+    fail_unless_equals_int(streams, 1);
+    fail_unless_equals_int(width, 1920);
+    fail_unless_equals_int(height, 1080);
+    fail_unless_equals_int(objects, 0);
+    fail_unless_equals_int(motion, 1);  // linear
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+// TSRC_streams_interleaved: 3 streams from id 5; buffers cycle 5,6,7 and
+// the three buffers of one frame share a PTS.
+GST_START_TEST(TSRC_streams_interleaved) {
+    GstElement *sink;
+    GstElement *pipe = make_pipeline(
+        "num-streams=3 first-stream-id=5 width=64 height=32 format=RGB "
+        "num-buffers=9",
+        &sink);
+
+    for (int i = 0; i < 9; i++) {
+        GstSample *s = pull(sink);
+        GstBuffer *buf = gst_sample_get_buffer(s);
+        DXFrameMeta *fm = dx_get_frame_meta(buf);
+        fail_unless(fm != nullptr);
+        fail_unless_equals_int(fm->_stream_id, 5 + i % 3);
+        fail_unless_equals_int(fm->_width, 64);
+        fail_unless_equals_int(fm->_height, 32);
+        fail_unless(fm->_format == "RGB");
+        fail_unless_equals_uint64(GST_BUFFER_PTS(buf),
+                                  (guint64)(i / 3) * GST_SECOND / 30);
+        fail_unless_equals_int((int)gst_buffer_get_size(buf), 64 * 32 * 3);
+        gst_sample_unref(s);
+    }
+    stop_pipeline(pipe, sink);
+}
+GST_END_TEST;
+
+// TSRC_objects_move: with linear motion and track-ids, the objects of a
+// stream keep their ids, stay inside the frame and move between frames.
+GST_START_TEST(TSRC_objects_move) {
+    GstElement *sink;
+    GstElement *pipe = make_pipeline(
+        "num-streams=2 width=320 height=240 num-objects=5 motion=linear "
+        "track-ids=true num-buffers=20",
+        &sink);
+
+    std::vector<float> first_x;
+    gboolean moved = FALSE;
+    for (int i = 0; i < 20; i++) {
+        GstSample *s = pull(sink);
+        DXFrameMeta *fm = dx_get_frame_meta(gst_sample_get_buffer(s));
+        fail_unless_equals_int((int)fm->_object_meta_list.size(), 5);
+        for (size_t o = 0; o < fm->_object_meta_list.size(); o++) {
+            DXObjectMeta *obj = fm->_object_meta_list[o];
+            fail_unless_equals_int(obj->_track_id, (int)o);
+            fail_unless(obj->_box[0] >= 0 && obj->_box[2] <= 320);
+            fail_unless(obj->_box[1] >= 0 && obj->_box[3] <= 240);
+            fail_unless(obj->_label >= 0 && obj->_label < 80);
+            if (fm->_stream_id != 0)
+                continue;
+            if (first_x.size() < 5)
+                first_x.push_back(obj->_box[0]);
+            else if (obj->_box[0] != first_x[o])
+                moved = TRUE;
+        }
+        gst_sample_unref(s);
+    }
+    fail_unless(moved, "no object moved in 10 frames");
+    stop_pipeline(pipe, sink);
+}
+GST_END_TEST;
+
+// TSRC_recorded_tensors: a manifest with one FLOAT tensor is attached to
+// every frame under infer-id.
+GST_START_TEST(TSRC_recorded_tensors) {
+    gchar *dir = g_dir_make_tmp("dxtestsrc_XXXXXX", nullptr);
+    fail_unless(dir != nullptr);
+    std::string manifest = std::string(dir) + "/manifest.json";
+    std::string tensor = std::string(dir) + "/out.bin";
+    const char *json =
+        "{\"width\":640,\"height\":480,\"tensors\":[{\"name\":\"output0\","
+        "\"type\":\"FLOAT\",\"shape\":[1,2,3],\"file\":\"out.bin\"}]}";
+    const float values[6] = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
+    fail_unless(g_file_set_contents(manifest.c_str(), json, -1, nullptr));
+    fail_unless(g_file_set_contents(tensor.c_str(), (const gchar *)values,
+                                    sizeof(values), nullptr));
+
+    gchar *props = g_strdup_printf(
+        "width=64 height=64 tensor-dir=%s infer-id=2 num-buffers=2", dir);
+    GstElement *sink;
+    GstElement *pipe = make_pipeline(props, &sink);
+    g_free(props);
+
+    for (int i = 0; i < 2; i++) {
+        GstSample *s = pull(sink);
+        DXFrameMeta *fm = dx_get_frame_meta(gst_sample_get_buffer(s));
+        auto it = fm->_output_tensors.find(2);
+        fail_unless(it != fm->_output_tensors.end());
+        fail_unless_equals_int((int)it->second._tensors.size(), 1);
+        const dxs::DXTensor &t = it->second._tensors[0];
+        fail_unless(t._name == "output0");
+        fail_unless_equals_int((int)t._shape.size(), 3);
+        fail_unless_equals_int(t._type, dxs::FLOAT);
+        fail_unless_equals_float(static_cast<const float *>(t._data)[5], 5.0f);
+        gst_sample_unref(s);
+    }
+    stop_pipeline(pipe, sink);
+
+    g_remove(manifest.c_str());
+    g_remove(tensor.c_str());
+    g_rmdir(dir);
+    g_free(dir);
+}
+GST_END_TEST;
+
+// TSRC_missing_tensor_dir_errors: an unreadable tensor-dir fails start.
+GST_START_TEST(TSRC_missing_tensor_dir_errors) {
+    GstElement *e = gst_element_factory_make("dxtestsrc", nullptr);
+    g_object_set(e, "tensor-dir", "/nonexistent/dxtestsrc", nullptr);
+    fail_unless_equals_int(gst_element_set_state(e, GST_STATE_PAUSED),
+                           GST_STATE_CHANGE_FAILURE);
+    gst_element_set_state(e, GST_STATE_NULL);
+    gst_object_unref(e);
+}
+GST_END_TEST;
+
+static Suite *dxtestsrc_suite(void) {
+    Suite *s = suite_create("dxtestsrc");
+    TCase *tc = tcase_create("testsrc");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, TSRC_property_defaults);
+    tcase_add_test(tc, TSRC_streams_interleaved);
+    tcase_add_test(tc, TSRC_objects_move);
+    tcase_add_test(tc, TSRC_recorded_tensors);
+    tcase_add_test(tc, TSRC_missing_tensor_dir_errors);
+    return s;
+}
+
+GST_CHECK_MAIN(dxtestsrc);
@@ -92,6 +92,16 @@ GST_START_TEST(TPL_dxconvert_not_any) {
 }
 GST_END_TEST;
 
+GST_START_TEST(TPL_dxtestsrc_not_any) {
+    assert_no_any_template("dxtestsrc");
+}
+GST_END_TEST;
+
+GST_START_TEST(TPL_dxtensorcapture_not_any) {
+    assert_no_any_template("dxtensorcapture");
+}
+GST_END_TEST;
+
 GST_START_TEST(TPL_dxmsgconv_not_any) {
     assert_no_any_template("dxmsgconv");
 }
@@ -122,6 +132,8 @@ static Suite *pad_templates_suite(void) {
     tcase_add_test(tc, TPL_dxtracker_not_any);
     tcase_add_test(tc, TPL_dxscale_not_any);
     tcase_add_test(tc, TPL_dxconvert_not_any);
+    tcase_add_test(tc, TPL_dxtestsrc_not_any);
+    tcase_add_test(tc, TPL_dxtensorcapture_not_any);
     tcase_add_test(tc, TPL_dxmsgconv_not_any);
     tcase_add_test(tc, TPL_dxinputselector_not_any);
     tcase_add_test(tc, TPL_dxoutputselector_not_any);
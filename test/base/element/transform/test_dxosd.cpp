@@ -224,6 +224,283 @@ GST_START_TEST(CE_osd_scale_adjusts_bbox) {
 }
 GST_END_TEST;
 
+static GstBuffer *push_tracked_object(Harness &h, int W, int H, GstClockTime pts) {
+    GstBuffer *b = make_rgb_buffer(W, H, pts);
+    DXFrameMeta *fm = make_frame_meta(b, 0, W, H);
+    DXObjectMeta *o = add_object_to_frame(fm, 1, 0.9f, 200.0f, 200.0f, 400.0f, 400.0f, 5);
+    o->_label_name = "person";
+    gst_harness_push(h.h, b);
+    return gst_harness_try_pull(h.h);
+}
+
+// CE_osd_label_text_cached: the track-id label is blended as white text over
+// its background, and the cached sprite draws the same pixels again
+// Target: draw_label_or_id (OsdRenderCache label sprite + blit_text)
+// MUT: skip blit_text → no pixel brighter than the label background
+GST_START_TEST(CE_osd_label_text_cached) {
+    Harness h("dxosd");
+    gst_harness_set_src_caps_str(h.h,
+        "video/x-raw,format=RGB,width=640,height=480,framerate=30/1");
+
+    int W = 640, H = 480;
+    GstBuffer *first = push_tracked_object(h, W, H, 0);
+    GstBuffer *second = push_tracked_object(h, W, H, GST_SECOND / 30);
+    fail_unless(first != nullptr && second != nullptr);
+
+    GstMapInfo m1, m2;
+    gst_buffer_map(first, &m1, GST_MAP_READ);
+    gst_buffer_map(second, &m2, GST_MAP_READ);
+    fail_unless_equals_int(m1.size, m2.size);
+    fail_unless(memcmp(m1.data, m2.data, m1.size) == 0,
+                "cached label must render identically");
+
+    // Label band above the box; its background (COLORS[5]) has channel 0 = 23.
+    int text_px = 0;
+    for (int y = 180; y < 200; y++) {
+        for (int x = 200; x < 240; x++) {
+            if (m1.data[(y * W + x) * 3] > 60)
+                text_px++;
+        }
+    }
+    gst_buffer_unmap(first, &m1);
+    gst_buffer_unmap(second, &m2);
+    fail_unless(text_px > 0, "label text must be drawn above the box");
+    gst_buffer_unref(first);
+    gst_buffer_unref(second);
+}
+GST_END_TEST;
+
+static GstBuffer *push_untracked_object(Harness &h, const char *name, GstClockTime pts) {
+    GstBuffer *b = make_rgb_buffer(640, 480, pts);
+    DXFrameMeta *fm = make_frame_meta(b, 0, 640, 480);
+    DXObjectMeta *o = add_object_to_frame(fm, 1, 0.9f, 200.0f, 200.0f, 400.0f, 400.0f, -1);
+    o->_label_name = name;
+    gst_harness_push(h.h, b);
+    return gst_harness_try_pull(h.h);
+}
+
+// CE_osd_render_cache_invalidates: an untracked object keeps its cache entry
+// (label 1, confidence 0.90) across frames, but a new label name re-renders
+// the sprite instead of reusing the stale one
+// Target: OsdRenderCache::entry (name check)
+// MUT: drop the name comparison → "person" sprite drawn for "car" → fail
+GST_START_TEST(CE_osd_render_cache_invalidates) {
+    Harness h("dxosd");
+    gst_harness_set_src_caps_str(h.h,
+        "video/x-raw,format=RGB,width=640,height=480,framerate=30/1");
+
+    GstBuffer *person = push_untracked_object(h, "person", 0);
+    GstBuffer *car = push_untracked_object(h, "car", GST_SECOND / 30);
+    GstBuffer *person_again = push_untracked_object(h, "person", 2 * GST_SECOND / 30);
+    fail_unless(person != nullptr && car != nullptr && person_again != nullptr);
+
+    GstMapInfo m1, m2, m3;
+    gst_buffer_map(person, &m1, GST_MAP_READ);
+    gst_buffer_map(car, &m2, GST_MAP_READ);
+    gst_buffer_map(person_again, &m3, GST_MAP_READ);
+    fail_unless(memcmp(m1.data, m2.data, m1.size) != 0, "renamed label must be re-rendered");
+    fail_unless(memcmp(m1.data, m3.data, m1.size) == 0, "same label must render identically");
+    gst_buffer_unmap(person, &m1);
+    gst_buffer_unmap(car, &m2);
+    gst_buffer_unmap(person_again, &m3);
+    gst_buffer_unref(person);
+    gst_buffer_unref(car);
+    gst_buffer_unref(person_again);
+}
+GST_END_TEST;
+
+// CE_osd_semantic_seg_blend: 2x2 class map upscaled nearest-neighbour and
+// blended at ~40% in place: black + class 0 (56,56,255) → (22,22,102)
+// Target: draw_semantic_segmentation (blend_seg_plane, BGR LUT)
+// MUT: wrong source column mapping → class 1 colour in the left half → fail
+GST_START_TEST(CE_osd_semantic_seg_blend) {
+    Harness h("dxosd");
+    gst_harness_set_src_caps_str(h.h, CAPS_RGB_320);
+
+    int W = 320, H = 240;
+    GstBuffer *b = make_rgb_buffer(W, H, 0);
+    DXFrameMeta *fm = make_frame_meta(b, 0, W, H);
+    fm->_seg_data = {0, 1, 1, 0};
+    fm->_seg_width = 2;
+    fm->_seg_height = 2;
+
+    gst_harness_push(h.h, b);
+    GstBuffer *out = gst_harness_try_pull(h.h);
+    fail_unless(out != nullptr);
+
+    GstMapInfo map;
+    gst_buffer_map(out, &map, GST_MAP_READ);
+    const guint8 *tl = map.data + (10 * W + 10) * 3;
+    const guint8 *tr = map.data + (10 * W + 300) * 3;
+    const guint8 *br = map.data + (230 * W + 300) * 3;
+    fail_unless(tl[0] == 22 && tl[1] == 22 && tl[2] == 102,
+                "class 0 blend, got %d,%d,%d", tl[0], tl[1], tl[2]);
+    fail_unless(memcmp(tl, br, 3) == 0, "bottom-right must be class 0 as well");
+    fail_unless(memcmp(tl, tr, 3) != 0, "top-right must be class 1");
+    gst_buffer_unmap(out, &map);
+    gst_buffer_unref(out);
+}
+GST_END_TEST;
+
+// Renders the same busy frame of `format` and height H with `render_threads`
+// bands. With 4 threads a 479-row frame is cut at every 60th row; the extra
+// boxes, label backgrounds and rotated boxes sit on odd rows around those
+// edges, so their 4:2:0 chroma rows straddle them.
+static GstBuffer *render_busy_frame(guint render_threads, const char *format = "RGB",
+                                    int H = 480) {
+    Harness h("dxosd", [render_threads](GstElement *e) {
+        g_object_set(e, "render-threads", render_threads, nullptr);
+    });
+    int W = 640;
+    gchar *caps = g_strdup_printf(
+        "video/x-raw,format=%s,width=%d,height=%d,framerate=30/1", format, W, H);
+    gst_harness_set_src_caps_str(h.h, caps);
+    g_free(caps);
+
+    GstVideoInfo info;
+    gst_video_info_set_format(&info, gst_video_format_from_string(format), W, H);
+    GstBuffer *b = gst_buffer_new_allocate(nullptr, GST_VIDEO_INFO_SIZE(&info), nullptr);
+    gst_buffer_memset(b, 0, 0x80, GST_VIDEO_INFO_SIZE(&info));
+    DXFrameMeta *fm = make_frame_meta(b, 0, W, H, format);
+    fm->_seg_data = {0, 1, 2, 3};
+    fm->_seg_width = 2;
+    fm->_seg_height = 2;
+    for (int i = 0; i < 8; i++) {
+        float x = 30.0f + i * 70.0f, y = 20.0f + i * 50.0f;
+        DXObjectMeta *o = add_object_to_frame(fm, i, 0.8f, x, y, x + 120.0f, y + 150.0f,
+                                              i % 2 ? i : -1);
+        o->_label_name = "person";
+        o->_keypoints.resize(17 * 3);
+        for (int k = 0; k < 17; k++) {
+            o->_keypoints[k * 3] = x + (k * 37) % 120;
+            o->_keypoints[k * 3 + 1] = y + k * 9;
+            o->_keypoints[k * 3 + 2] = 0.9f;
+        }
+        o->_seg_data = {1, 0, 0, 1};
+        o->_seg_width = 2;
+        o->_seg_height = 2;
+    }
+    for (int k = 1; k <= 6; k++) {
+        // Odd top edge one row above a band edge, or a label background
+        // reaching 9 rows below it; odd bottom edge one row below the next.
+        float x = 15.0f + (k - 1) * 100.0f;
+        float y = k % 2 ? 60.0f * k - 1 : 60.0f * k + 9;
+        DXObjectMeta *o = add_object_to_frame(fm, 10 + k, 0.7f, x, y, x + 75.0f,
+                                              60.0f * k + 61, 20 + k);
+        o->_label_name = "car";
+    }
+    for (int k = 0; k < 2; k++) {
+        DXObjectMeta *o = add_object_to_frame(fm, 20 + k, 0.6f, 0, 0, 0, 0);
+        o->_obb = {k ? 150.0f : 500.0f, k ? 299.0f : 181.0f, 91.0f, 51.0f, 0.5f};
+    }
+    gst_harness_push(h.h, b);
+    return gst_harness_try_pull(h.h);
+}
+
+static void check_render_threads_identical(const char *format, int H) {
+    GstBuffer *serial = render_busy_frame(1, format, H);
+    GstBuffer *parallel = render_busy_frame(4, format, H);
+    fail_unless(serial != nullptr && parallel != nullptr);
+
+    GstMapInfo m1, m2;
+    gst_buffer_map(serial, &m1, GST_MAP_READ);
+    gst_buffer_map(parallel, &m2, GST_MAP_READ);
+    fail_unless_equals_int(m1.size, m2.size);
+    fail_unless(memcmp(m1.data, m2.data, m1.size) == 0,
+                "%s: render-threads=4 must match render-threads=1 byte for byte", format);
+    gst_buffer_unmap(serial, &m1);
+    gst_buffer_unmap(parallel, &m2);
+    gst_buffer_unref(serial);
+    gst_buffer_unref(parallel);
+}
+
+// CE_osd_render_threads_identical: band-parallel rendering (lines, circles
+// and boxes crossing band edges, masks, labels) equals serial rendering
+// Target: gst_dxosd_transform_ip (BandPool) + draw_frame_meta band clipping
+// MUT: draw primitives unclipped per band, or drop a band → output differs
+GST_START_TEST(CE_osd_render_threads_identical) {
+    check_render_threads_identical("RGB", 480);
+}
+GST_END_TEST;
+
+// CE_osd_render_threads_identical_yuv: the same for NV12 and I420 with an
+// odd frame height, where chroma rows of boxes, label backgrounds, rotated
+// boxes and the segmentation blend straddle band edges
+// Target: draw_rectangle_*/draw_filled_rect_*/draw_obb_* chroma band
+//         clipping, blend_seg_plane with subsample 2
+// MUT: blend chroma rows without the band clip → blended once per band
+GST_START_TEST(CE_osd_render_threads_identical_yuv) {
+    check_render_threads_identical("NV12", 479);
+    check_render_threads_identical("I420", 479);
+}
+GST_END_TEST;
+
+static GstBuffer *push_composed_object(Harness &h, GstClockTime pts) {
+    GstBuffer *b = make_rgb_buffer(320, 240, pts);
+    DXFrameMeta *fm = make_frame_meta(b, 0, 320, 240);
+    DXObjectMeta *o = add_object_to_frame(fm, 1, 0.9f, 50.0f, 60.0f, 150.0f, 200.0f, 5);
+    o->_label_name = "person";
+    gst_harness_push(h.h, b);
+    return gst_harness_try_pull(h.h);
+}
+
+// CE_osd_composition_meta: output-mode=composition with a downstream that
+// accepts the meta leaves the pixels alone and attaches 4 box edges + the
+// label; the label's pixel buffer is reused for the same track
+// Target: attach_composition + OverlayCache::compose / label
+// MUT: map and draw anyway → nonzero pixels; rebuild labels → new buffer
+GST_START_TEST(CE_osd_composition_meta) {
+    Harness h("dxosd", [](GstElement *e) {
+        gst_util_set_object_arg(G_OBJECT(e), "output-mode", "composition");
+    });
+    gst_harness_add_propose_allocation_meta(h.h, GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE,
+                                            nullptr);
+    gst_harness_set_src_caps_str(h.h, CAPS_RGB_320);
+    gst_harness_negotiate(h.h);
+
+    GstBuffer *first = push_composed_object(h, 0);
+    GstBuffer *second = push_composed_object(h, GST_SECOND / 30);
+    fail_unless(first != nullptr && second != nullptr);
+    fail_unless_equals_int(count_nonzero_bytes(first), 0);
+
+    GstVideoOverlayCompositionMeta *m1 = gst_buffer_get_video_overlay_composition_meta(first);
+    GstVideoOverlayCompositionMeta *m2 = gst_buffer_get_video_overlay_composition_meta(second);
+    fail_unless(m1 != nullptr && m2 != nullptr, "composition meta must be attached");
+    fail_unless_equals_int(gst_video_overlay_composition_n_rectangles(m1->overlay), 5);
+
+    GstVideoOverlayRectangle *l1 = gst_video_overlay_composition_get_rectangle(m1->overlay, 4);
+    GstVideoOverlayRectangle *l2 = gst_video_overlay_composition_get_rectangle(m2->overlay, 4);
+    gint x, y;
+    guint w, hgt;
+    gst_video_overlay_rectangle_get_render_rectangle(l1, &x, &y, &w, &hgt);
+    fail_unless(x < 50 && y < 60 && y + (gint)hgt > 50, "label must sit above the box");
+    fail_unless(gst_video_overlay_rectangle_get_pixels_raw(l1, GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE) ==
+                gst_video_overlay_rectangle_get_pixels_raw(l2, GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE),
+                "label pixels must be reused for the same track");
+    gst_buffer_unref(first);
+    gst_buffer_unref(second);
+}
+GST_END_TEST;
+
+// CE_osd_composition_blend_fallback: without downstream support the
+// composition is blended into the frame and no meta is attached
+// Target: attach_composition (gst_video_overlay_composition_blend path)
+// MUT: attach the meta regardless → pixels untouched → fail
+GST_START_TEST(CE_osd_composition_blend_fallback) {
+    Harness h("dxosd", [](GstElement *e) {
+        gst_util_set_object_arg(G_OBJECT(e), "output-mode", "composition");
+    });
+    gst_harness_set_src_caps_str(h.h, CAPS_RGB_320);
+
+    GstBuffer *out = push_composed_object(h, 0);
+    fail_unless(out != nullptr);
+    fail_unless(gst_buffer_get_video_overlay_composition_meta(out) == nullptr);
+    fail_unless(count_nonzero_in_row(out, 320, 200, 60, 140) > 0,
+                "bottom box edge must be blended into the frame");
+    gst_buffer_unref(out);
+}
+GST_END_TEST;
+
 static Suite *dxosd_suite(void) {
     Suite *s = suite_create("dxosd");
     TCase *tc = tcase_create("contract");
@@ -237,6 +514,13 @@ static Suite *dxosd_suite(void) {
     tcase_add_test(tc, CE_osd_bbox_draws_at_location);
     tcase_add_test(tc, CE_osd_wrapped_caps_stream_draw);
     tcase_add_test(tc, CE_osd_scale_adjusts_bbox);
+    tcase_add_test(tc, CE_osd_label_text_cached);
+    tcase_add_test(tc, CE_osd_render_cache_invalidates);
+    tcase_add_test(tc, CE_osd_semantic_seg_blend);
+    tcase_add_test(tc, CE_osd_render_threads_identical);
+    tcase_add_test(tc, CE_osd_render_threads_identical_yuv);
+    tcase_add_test(tc, CE_osd_composition_meta);
+    tcase_add_test(tc, CE_osd_composition_blend_fallback);
     return s;
 }
 
@@ -8,6 +8,7 @@
 #include <gst/gst.h>
 #include "harness_helpers.hpp"
 
+#include <cstring>
 #include <vector>
 
 using namespace dxtest;
@@ -45,6 +46,14 @@ static void push_frames(GstHarness *h, guint n, guint fps) {
     }
 }
 
+static std::vector<GstBuffer *> pull_all_buffers(GstHarness *h) {
+    std::vector<GstBuffer *> v;
+    GstBuffer *out;
+    while ((out = gst_harness_try_pull(h)) != nullptr)
+        v.push_back(out);
+    return v;
+}
+
 static std::vector<GstClockTime> pull_all_pts(GstHarness *h) {
     std::vector<GstClockTime> v;
     GstBuffer *out;
@@ -74,6 +83,12 @@ GST_START_TEST(CA2_property_defaults_and_set) {
     g_object_get(e, "framerate", &fr, "throttle", &th, nullptr);
     fail_unless_equals_int(fr, 15);
     fail_unless(th == TRUE);
+    gboolean zc = FALSE;
+    g_object_get(e, "zero-copy", &zc, nullptr);
+    fail_unless(zc == TRUE);
+    g_object_set(e, "zero-copy", FALSE, nullptr);
+    g_object_get(e, "zero-copy", &zc, nullptr);
+    fail_unless(zc == FALSE);
     gst_object_unref(e);
 }
 GST_END_TEST;
@@ -260,6 +275,57 @@ GST_START_TEST(CE_rate_same_fps) {
 }
 GST_END_TEST;
 
+// CE_rate_zero_copy_duplicates: 10fps→30fps duplicates share the input
+// GstMemory, and a write map on one duplicate must not leak into another.
+// Target: gst_dxrate_flush_prev (gst_buffer_copy vs gst_buffer_copy_deep)
+// MUT: always deep copy → no shared memory → fail
+GST_START_TEST(CE_rate_zero_copy_duplicates) {
+    const gboolean modes[] = {TRUE, FALSE};
+    for (gboolean zero_copy : modes) {
+        DxRateHarness h(30u);
+        g_object_set(h.element(), "zero-copy", zero_copy, nullptr);
+        gst_harness_set_src_caps_str(
+            h.h, "video/x-raw,format=I420,width=320,height=240,framerate=10/1");
+
+        push_frames(h.h, 4, 10);
+        push_eos(h.h);
+
+        auto bufs = pull_all_buffers(h.h);
+        fail_unless(bufs.size() >= 6, "10→30fps: expected duplicates, got %zu",
+                    bufs.size());
+
+        guint shared = 0;
+        for (size_t i = 1; i < bufs.size(); i++) {
+            if (gst_buffer_peek_memory(bufs[i], 0) ==
+                gst_buffer_peek_memory(bufs[i - 1], 0))
+                shared++;
+        }
+        if (zero_copy)
+            fail_unless(shared > 0, "duplicates must share input memory");
+        else
+            fail_unless_equals_int(shared, 0);
+
+        // Copy-on-write: scribbling over bufs[0] leaves bufs[1] intact.
+        GstMapInfo ro;
+        fail_unless(gst_buffer_map(bufs[1], &ro, GST_MAP_READ));
+        guint8 before = ro.data[0];
+        gst_buffer_unmap(bufs[1], &ro);
+
+        GstMapInfo rw;
+        fail_unless(gst_buffer_map(bufs[0], &rw, GST_MAP_WRITE));
+        memset(rw.data, before ^ 0xff, rw.size);
+        gst_buffer_unmap(bufs[0], &rw);
+
+        fail_unless(gst_buffer_map(bufs[1], &ro, GST_MAP_READ));
+        fail_unless_equals_int(ro.data[0], before);
+        gst_buffer_unmap(bufs[1], &ro);
+
+        for (GstBuffer *b : bufs)
+            gst_buffer_unref(b);
+    }
+}
+GST_END_TEST;
+
 static Suite *dxrate_suite(void) {
     Suite *s = suite_create("dxrate");
     TCase *tc = tcase_create("contract");
@@ -276,6 +342,7 @@ static Suite *dxrate_suite(void) {
     tcase_add_test(tc, CE_rate_latency);
     tcase_add_test(tc, CE_rate_flush_resets);
     tcase_add_test(tc, CE_rate_same_fps);
+    tcase_add_test(tc, CE_rate_zero_copy_duplicates);
     return s;
 }
 
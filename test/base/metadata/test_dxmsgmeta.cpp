@@ -64,8 +64,8 @@ GST_START_TEST(TC3_add_payload_deep_copy) {
 }
 GST_END_TEST;
 
-// ---- TC4: transform deep copy (C6) ----
-GST_START_TEST(TC4_transform_deep_copy) {
+// ---- TC4: transform shares the payload bytes (C6) ----
+GST_START_TEST(TC4_transform_shares_payload) {
     GstBuffer *src = fresh_buf();
     DxMsgPayload p;
     std::string json = "{\"a\":1}";
@@ -79,15 +79,35 @@ GST_START_TEST(TC4_transform_deep_copy) {
     fail_unless(dm != nullptr);
     auto *sp = (DxMsgPayload *)sm->_payload;
     auto *dp = (DxMsgPayload *)dm->_payload;
-    fail_unless(sp->_data != dp->_data, "transform must deep-copy payload");
+    fail_unless(sm->_bytes == dm->_bytes, "transform must reference, not copy");
+    fail_unless(sp->_data == dp->_data);
     fail_unless_equals_int((int)dp->_size, (int)sp->_size);
-    fail_unless(std::memcmp(sp->_data, dp->_data, sp->_size) == 0);
 
+    // the copy keeps the payload alive on its own
     gst_buffer_unref(src);
+    fail_unless(std::memcmp(dp->_data, json.data(), json.size()) == 0);
     gst_buffer_unref(dup);
 }
 GST_END_TEST;
 
+// ---- TC4b: take_payload adopts the data without copying ----
+GST_START_TEST(TC4b_take_payload_no_copy) {
+    GstBuffer *buf = fresh_buf();
+    auto *p = g_new0(DxMsgPayload, 1);
+    std::string json = "{\"t\":2}";
+    fill_payload(p, json);
+    gpointer data = p->_data;
+    dx_take_payload_to_buffer(buf, p);  // frees p
+
+    GstDxMsgMeta *m = dx_get_msg_meta(buf);
+    fail_unless(m != nullptr && m->_bytes != nullptr);
+    auto *stored = (DxMsgPayload *)m->_payload;
+    fail_unless(stored->_data == data, "take must not copy");
+    fail_unless_equals_int((int)stored->_size, (int)json.size());
+    gst_buffer_unref(buf);
+}
+GST_END_TEST;
+
 // ---- TC5: transform with null payload → dst null (C7) ----
 GST_START_TEST(TC5_transform_null_payload) {
     GstBuffer *src = dx_create_msg_meta(fresh_buf());
@@ -143,7 +163,8 @@ static Suite *dxmsgmeta_suite(void) {
     tcase_add_test(tc, TC1_create_get_basic);
     tcase_add_test(tc, TC2_double_create);
     tcase_add_test(tc, TC3_add_payload_deep_copy);
-    tcase_add_test(tc, TC4_transform_deep_copy);
+    tcase_add_test(tc, TC4_transform_shares_payload);
+    tcase_add_test(tc, TC4b_take_payload_no_copy);
     tcase_add_test(tc, TC5_transform_null_payload);
     tcase_add_test(tc, TC6_double_add_pin);
     return s;
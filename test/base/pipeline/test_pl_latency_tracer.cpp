@@ -0,0 +1,95 @@
+// dxlatency tracer tests
+// Core: with GST_TRACERS=dxlatency(file=...,stats=...) every buffer passing
+// a DX element yields one Chrome-trace "X" event named after the element,
+// and the per-element/per-stream histograms are written when the pipeline
+// stops. The tracer has to be requested before gst_init, so this file sets
+// GST_TRACERS in its own main() instead of using GST_CHECK_MAIN.
+
+#include <gst/check/gstcheck.h>
+#include <gst/gst.h>
+#include <glib/gstdio.h>
+
+#include <string>
+
+static std::string trace_path() {
+    return std::string(g_get_tmp_dir()) + "/dxlatency_test_trace.json";
+}
+
+static std::string stats_path() {
+    return std::string(g_get_tmp_dir()) + "/dxlatency_test_stats.json";
+}
+
+static std::string read_file(const std::string &path) {
+    gchar *contents = nullptr;
+    if (!g_file_get_contents(path.c_str(), &contents, nullptr, nullptr))
+        return std::string();
+    std::string s(contents);
+    g_free(contents);
+    return s;
+}
+
+static size_t count_occurrences(const std::string &haystack, const char *needle) {
+    size_t n = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos;
+         pos = haystack.find(needle, pos + 1))
+        n++;
+    return n;
+}
+
+static void run_to_eos(const char *launch) {
+    GError *err = nullptr;
+    GstElement *pipe = gst_parse_launch(launch, &err);
+    fail_unless(err == nullptr && pipe != nullptr);
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipe));
+    gst_element_set_state(pipe, GST_STATE_PLAYING);
+    GstMessage *msg = gst_bus_timed_pop_filtered(bus, 10 * GST_SECOND,
+        (GstMessageType)(GST_MESSAGE_ERROR | GST_MESSAGE_EOS));
+    fail_unless(msg != nullptr, "timeout waiting for EOS");
+    fail_unless_equals_int(GST_MESSAGE_TYPE(msg), GST_MESSAGE_EOS);
+    gst_message_unref(msg);
+    gst_element_set_state(pipe, GST_STATE_NULL);
+    gst_object_unref(bus);
+    gst_object_unref(pipe);
+}
+
+// PL_tracer_events_per_element: 10 frames through dxscale + dxconvert give
+// 10 complete events for each, and the stats file lists both elements.
+GST_START_TEST(PL_tracer_events_per_element) {
+    run_to_eos(
+        "videotestsrc num-buffers=10 "
+        "! video/x-raw,format=I420,width=64,height=64,framerate=30/1 "
+        "! dxscale name=scale width=32 height=32 ! dxconvert name=conv "
+        "! fakesink sync=false");
+
+    std::string trace = read_file(trace_path());
+    fail_unless(!trace.empty(), "trace file missing");
+    fail_unless_equals_int((int)count_occurrences(trace, "\"name\":\"scale\""), 10);
+    fail_unless_equals_int((int)count_occurrences(trace, "\"name\":\"conv\""), 10);
+    fail_unless(count_occurrences(trace, "\"ph\":\"X\"") == 20);
+
+    std::string stats = read_file(stats_path());
+    fail_unless(stats.find("\"name\":\"scale\"") != std::string::npos);
+    fail_unless(stats.find("\"name\":\"conv\"") != std::string::npos);
+    fail_unless(stats.find("\"count\":10") != std::string::npos);
+}
+GST_END_TEST;
+
+static Suite *dxlatency_tracer_suite(void) {
+    Suite *s = suite_create("dxlatency_tracer");
+    TCase *tc = tcase_create("tracer");
+    tcase_set_timeout(tc, 30.0);
+    suite_add_tcase(s, tc);
+    tcase_add_test(tc, PL_tracer_events_per_element);
+    return s;
+}
+
+int main(int argc, char **argv) {
+    gchar *tracers = g_strdup_printf("dxlatency(file=%s,stats=%s)",
+                                     trace_path().c_str(), stats_path().c_str());
+    g_setenv("GST_TRACERS", tracers, TRUE);
+    g_free(tracers);
+    g_remove(trace_path().c_str());
+    gst_check_init(&argc, &argv);
+    return gst_check_run_suite(dxlatency_tracer_suite(), "dxlatency_tracer",
+                               __FILE__);
+}